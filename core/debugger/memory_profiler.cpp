@@ -0,0 +1,261 @@
+/**************************************************************************/
+/*  memory_profiler.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "memory_profiler.h"
+
+#include "core/config/engine.h"
+#include "core/debugger/engine_debugger.h"
+#include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/sort_array.h"
+
+MemoryProfiler *MemoryProfiler::active = nullptr;
+Mutex MemoryProfiler::mutex;
+// Set while the profiler itself is allocating, so it doesn't sample itself.
+thread_local bool MemoryProfiler::recording = false;
+
+String MemoryProfiler::_get_site_name(void *p_callsite) const {
+	for (int i = 0; i < ScriptServer::get_language_count(); i++) {
+		ScriptLanguage *language = ScriptServer::get_language(i);
+		if (language->debug_get_stack_level_count() > 0) {
+			return vformat("%s:%d in %s()", language->debug_get_stack_level_source(0), language->debug_get_stack_level_line(0), language->debug_get_stack_level_function(0));
+		}
+	}
+
+	String task = WorkerThreadPool::get_caller_task_description();
+	if (!task.is_empty()) {
+		return "Task: " + task;
+	}
+
+	return "0x" + String::num_uint64((uint64_t)p_callsite, 16);
+}
+
+uint32_t MemoryProfiler::_get_site_id(const String &p_name) {
+	const uint32_t *id = site_ids.getptr(p_name);
+	if (id) {
+		return *id;
+	}
+	uint32_t new_id = site_names.size();
+	site_ids.insert(p_name, new_id);
+	site_names.push_back(p_name);
+	return new_id;
+}
+
+bool MemoryProfiler::_alloc_sampled(void *p_ptr, size_t p_bytes, void *p_callsite) {
+	if (recording) {
+		return false;
+	}
+	recording = true;
+
+	bool tracked = false;
+	{
+		MutexLock lock(mutex);
+		if (active) {
+			Sample sample;
+			sample.site = active->_get_site_id(active->_get_site_name(p_callsite));
+			sample.bytes = p_bytes;
+			active->live_samples.insert(p_ptr, sample);
+
+			SiteStats &stats = active->frame_sites[sample.site];
+			stats.count++;
+			stats.bytes += p_bytes;
+			active->frame_total.count++;
+			active->frame_total.bytes += p_bytes;
+			tracked = true;
+		}
+	}
+
+	recording = false;
+	return tracked;
+}
+
+void MemoryProfiler::_free_sampled(void *p_ptr, size_t p_bytes) {
+	// Even if the profiler is running on this thread, the block was sampled before and must stop being live.
+	bool was_recording = recording;
+	recording = true;
+	{
+		MutexLock lock(mutex);
+		if (active) {
+			active->live_samples.erase(p_ptr);
+		}
+	}
+	recording = was_recording;
+}
+
+void MemoryProfiler::_send_histogram() {
+	Array arr;
+	arr.push_back(interval);
+	for (uint32_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+		arr.push_back(histogram[i]);
+	}
+	EngineDebugger::get_singleton()->send_message("memory:frame_histogram", arr);
+}
+
+void MemoryProfiler::toggle(bool p_enable, const Array &p_opts) {
+#ifdef DEBUG_ENABLED
+	recording = true;
+	if (p_enable) {
+		{
+			MutexLock lock(mutex);
+			interval = p_opts.size() > 0 ? MAX(1, (int)p_opts[0]) : DEFAULT_INTERVAL;
+			live_samples.clear();
+			frame_sites.clear();
+			frame_total = SiteStats();
+			memset(histogram, 0, sizeof(histogram));
+			active = this;
+		}
+		Memory::set_alloc_sampling(interval, &_alloc_sampled, &_free_sampled);
+	} else {
+		Memory::set_alloc_sampling(0, nullptr, nullptr);
+		{
+			MutexLock lock(mutex);
+			active = nullptr;
+		}
+		_send_histogram();
+	}
+	recording = false;
+#endif
+}
+
+void MemoryProfiler::tick(double p_frame_time, double p_process_time, double p_physics_time, double p_physics_frame_time) {
+	recording = true;
+
+	Array names;
+	Array frame;
+	{
+		MutexLock lock(mutex);
+
+		if (site_names_sent < site_names.size()) {
+			names.push_back(site_names_sent);
+			for (uint32_t i = site_names_sent; i < site_names.size(); i++) {
+				names.push_back(site_names[i]);
+			}
+			site_names_sent = site_names.size();
+		}
+
+		frame.push_back(Engine::get_singleton()->get_process_frames());
+		frame.push_back(interval);
+		frame.push_back(frame_total.count);
+		frame.push_back(frame_total.bytes);
+		for (const KeyValue<uint32_t, SiteStats> &E : frame_sites) {
+			frame.push_back(E.key);
+			frame.push_back(E.value.count);
+			frame.push_back(E.value.bytes);
+		}
+
+		uint32_t bucket = 0;
+		uint64_t estimated_allocs = frame_total.count * interval;
+		while (estimated_allocs > 1 && bucket < HISTOGRAM_BUCKETS - 1) {
+			estimated_allocs >>= 1;
+			bucket++;
+		}
+		histogram[bucket]++;
+
+		frame_sites.clear();
+		frame_total = SiteStats();
+	}
+
+	if (!names.is_empty()) {
+		EngineDebugger::get_singleton()->send_message("memory:site_names", names);
+	}
+	EngineDebugger::get_singleton()->send_message("memory:profile_frame", frame);
+
+	recording = false;
+}
+
+Array MemoryProfiler::get_heap_snapshot() {
+	struct SiteBytes {
+		uint32_t site = 0;
+		SiteStats stats;
+		bool operator<(const SiteBytes &p_other) const { return stats.bytes > p_other.stats.bytes; }
+	};
+
+	recording = true;
+
+	Array snapshot;
+	{
+		MutexLock lock(mutex);
+
+		HashMap<uint32_t, SiteStats> live_sites;
+		SiteStats total;
+		for (const KeyValue<void *, Sample> &E : live_samples) {
+			SiteStats &stats = live_sites[E.value.site];
+			stats.count++;
+			stats.bytes += E.value.bytes;
+			total.count++;
+			total.bytes += E.value.bytes;
+		}
+
+		LocalVector<SiteBytes> sorted;
+		sorted.reserve(live_sites.size());
+		for (const KeyValue<uint32_t, SiteStats> &E : live_sites) {
+			SiteBytes site_bytes;
+			site_bytes.site = E.key;
+			site_bytes.stats = E.value;
+			sorted.push_back(site_bytes);
+		}
+		sorted.sort();
+
+		snapshot.push_back(interval);
+		snapshot.push_back(total.count);
+		snapshot.push_back(total.bytes);
+		for (const SiteBytes &site_bytes : sorted) {
+			snapshot.push_back(site_bytes.site);
+			snapshot.push_back(site_bytes.stats.count);
+			snapshot.push_back(site_bytes.stats.bytes);
+		}
+	}
+
+	recording = false;
+	return snapshot;
+}
+
+void MemoryProfiler::send_heap_snapshot() {
+	Array snapshot = get_heap_snapshot();
+	recording = true;
+	EngineDebugger::get_singleton()->send_message("memory:heap_snapshot", snapshot);
+	recording = false;
+}
+
+String MemoryProfiler::get_site_name(uint32_t p_site) {
+	MutexLock lock(mutex);
+	ERR_FAIL_UNSIGNED_INDEX_V(p_site, site_names.size(), String());
+	return site_names[p_site];
+}
+
+MemoryProfiler::~MemoryProfiler() {
+#ifdef DEBUG_ENABLED
+	if (active == this) {
+		Memory::set_alloc_sampling(0, nullptr, nullptr);
+		MutexLock lock(mutex);
+		active = nullptr;
+	}
+#endif
+}
@@ -0,0 +1,97 @@
+/**************************************************************************/
+/*  memory_profiler.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef MEMORY_PROFILER_H
+#define MEMORY_PROFILER_H
+
+#include "core/debugger/engine_profiler.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+// Sampling allocation profiler, only available in debug builds.
+// Every Nth allocation (the first toggle option, DEFAULT_INTERVAL otherwise) is attributed to a site,
+// which is the innermost script function being run, the description of the WorkerThreadPool task
+// being run or, failing those, the address of the caller of the allocator.
+// Messages sent to the debugger:
+// - "memory:site_names": [first site id, name, name...], whenever new sites appear.
+// - "memory:profile_frame": [frame, interval, sampled allocations, sampled bytes, (site id, allocations, bytes)...], every frame.
+// - "memory:heap_snapshot": [interval, live samples, live bytes, (site id, samples, bytes)...], on "memory:snapshot" requests.
+// - "memory:frame_histogram": [interval, frame count per power-of-two bucket of estimated allocations...], when disabled.
+class MemoryProfiler : public EngineProfiler {
+	static constexpr uint32_t DEFAULT_INTERVAL = 256;
+	static constexpr uint32_t HISTOGRAM_BUCKETS = 32;
+
+	struct Sample {
+		uint32_t site = 0;
+		uint64_t bytes = 0;
+	};
+
+	struct SiteStats {
+		uint64_t count = 0;
+		uint64_t bytes = 0;
+	};
+
+	static MemoryProfiler *active;
+	// Recursive, as sampled blocks can be freed by the profiler's own code while it holds it.
+	static Mutex mutex;
+	static thread_local bool recording;
+
+	uint32_t interval = DEFAULT_INTERVAL;
+	HashMap<void *, Sample> live_samples;
+	HashMap<String, uint32_t> site_ids;
+	LocalVector<String> site_names;
+	uint32_t site_names_sent = 0;
+
+	HashMap<uint32_t, SiteStats> frame_sites;
+	SiteStats frame_total;
+	uint64_t histogram[HISTOGRAM_BUCKETS] = {};
+
+	static bool _alloc_sampled(void *p_ptr, size_t p_bytes, void *p_callsite);
+	static void _free_sampled(void *p_ptr, size_t p_bytes);
+
+	String _get_site_name(void *p_callsite) const;
+	uint32_t _get_site_id(const String &p_name);
+	void _send_histogram();
+
+public:
+	void toggle(bool p_enable, const Array &p_opts) override;
+	void add(const Array &p_data) override {}
+	void tick(double p_frame_time, double p_process_time, double p_physics_time, double p_physics_frame_time) override;
+
+	// In the "memory:heap_snapshot" message format.
+	Array get_heap_snapshot();
+	void send_heap_snapshot();
+	String get_site_name(uint32_t p_site);
+
+	~MemoryProfiler();
+};
+
+#endif // MEMORY_PROFILER_H
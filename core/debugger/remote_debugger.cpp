@@ -34,6 +34,7 @@
 #include "core/debugger/debugger_marshalls.h"
 #include "core/debugger/engine_debugger.h"
 #include "core/debugger/engine_profiler.h"
+#include "core/debugger/memory_profiler.h"
 #include "core/debugger/script_debugger.h"
 #include "core/input/input.h"
 #include "core/io/resource_loader.h"
@@ -692,6 +693,16 @@ Error RemoteDebugger::_profiler_capture(const String &p_cmd, const Array &p_data
 	return OK;
 }
 
+Error RemoteDebugger::_memory_capture(const String &p_cmd, const Array &p_data, bool &r_captured) {
+	r_captured = false;
+	ERR_FAIL_COND_V(memory_profiler.is_null(), ERR_UNAVAILABLE);
+	if (p_cmd == "snapshot") {
+		r_captured = true;
+		memory_profiler->send_heap_snapshot();
+	}
+	return OK;
+}
+
 RemoteDebugger::RemoteDebugger(Ref<RemoteDebuggerPeer> p_peer) {
 	peer = p_peer;
 	max_chars_per_second = GLOBAL_GET("network/limits/debugger/max_chars_per_second");
@@ -706,6 +717,17 @@ RemoteDebugger::RemoteDebugger(Ref<RemoteDebuggerPeer> p_peer) {
 		profiler_enable("performance", true);
 	}
 
+#ifdef DEBUG_ENABLED
+	// Memory Profiler (sampled allocations, enabled on request).
+	memory_profiler.instantiate();
+	memory_profiler->bind("memory");
+	Capture memory_cap(this,
+			[](void *p_user, const String &p_cmd, const Array &p_data, bool &r_captured) {
+				return static_cast<RemoteDebugger *>(p_user)->_memory_capture(p_cmd, p_data, r_captured);
+			});
+	register_message_capture("memory", memory_cap);
+#endif
+
 	// Core and profiler captures.
 	Capture core_cap(this,
 			[](void *p_user, const String &p_cmd, const Array &p_data, bool &r_captured) {
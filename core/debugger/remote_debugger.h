@@ -39,6 +39,8 @@
 #include "core/string/ustring.h"
 #include "core/variant/array.h"
 
+class MemoryProfiler;
+
 class RemoteDebugger : public EngineDebugger {
 public:
 	enum MessageType {
@@ -53,6 +55,7 @@ private:
 	class PerformanceProfiler;
 
 	Ref<PerformanceProfiler> performance_profiler;
+	Ref<MemoryProfiler> memory_profiler;
 
 	Ref<RemoteDebuggerPeer> peer;
 
@@ -107,6 +110,7 @@ private:
 
 	Error _profiler_capture(const String &p_cmd, const Array &p_data, bool &r_captured);
 	Error _core_capture(const String &p_cmd, const Array &p_data, bool &r_captured);
+	Error _memory_capture(const String &p_cmd, const Array &p_data, bool &r_captured);
 
 	template <typename T>
 	void _bind_profiler(const String &p_name, T *p_prof);
@@ -0,0 +1,446 @@
+/**************************************************************************/
+/*  bulk_math.cpp                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "bulk_math.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BULK_MATH_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#define BULK_MATH_NEON
+#include <arm_neon.h>
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define BULK_MATH_NEON_DOUBLE
+#endif
+#endif
+
+namespace {
+
+// One SIMD register of `T`. Kernels are written once against this interface, each specialization
+// wraps the intrinsics of one instruction set. The generic version holds a single element.
+// `Sum` accumulates lanes in double precision, one partial sum per lane.
+template <typename T>
+struct Lanes {
+	static constexpr int64_t COUNT = 1;
+	typedef T Reg;
+	typedef double Sum;
+
+	static _FORCE_INLINE_ Reg load(const T *p_ptr) { return *p_ptr; }
+	static _FORCE_INLINE_ void store(T *p_ptr, Reg p_reg) { *p_ptr = p_reg; }
+	static _FORCE_INLINE_ Reg splat(T p_value) { return p_value; }
+	static _FORCE_INLINE_ Reg add(Reg p_a, Reg p_b) { return p_a + p_b; }
+	static _FORCE_INLINE_ Reg sub(Reg p_a, Reg p_b) { return p_a - p_b; }
+	static _FORCE_INLINE_ Reg mul(Reg p_a, Reg p_b) { return p_a * p_b; }
+	static _FORCE_INLINE_ Reg min(Reg p_a, Reg p_b) { return MIN(p_a, p_b); }
+	static _FORCE_INLINE_ Reg max(Reg p_a, Reg p_b) { return MAX(p_a, p_b); }
+	static _FORCE_INLINE_ void store_all(T *r_lanes, Reg p_reg) { r_lanes[0] = p_reg; }
+
+	static _FORCE_INLINE_ Sum zero_sum() { return 0.0; }
+	static _FORCE_INLINE_ void accumulate(Sum &r_sum, Reg p_reg) { r_sum += p_reg; }
+	static _FORCE_INLINE_ double reduce(const Sum &p_sum) { return p_sum; }
+};
+
+#if defined(BULK_MATH_SSE2)
+template <>
+struct Lanes<float> {
+	static constexpr int64_t COUNT = 4;
+	typedef __m128 Reg;
+	struct Sum {
+		__m128d low;
+		__m128d high;
+	};
+
+	static _FORCE_INLINE_ Reg load(const float *p_ptr) { return _mm_loadu_ps(p_ptr); }
+	static _FORCE_INLINE_ void store(float *p_ptr, Reg p_reg) { _mm_storeu_ps(p_ptr, p_reg); }
+	static _FORCE_INLINE_ Reg splat(float p_value) { return _mm_set1_ps(p_value); }
+	static _FORCE_INLINE_ Reg add(Reg p_a, Reg p_b) { return _mm_add_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Reg sub(Reg p_a, Reg p_b) { return _mm_sub_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Reg mul(Reg p_a, Reg p_b) { return _mm_mul_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Reg min(Reg p_a, Reg p_b) { return _mm_min_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Reg max(Reg p_a, Reg p_b) { return _mm_max_ps(p_a, p_b); }
+	static _FORCE_INLINE_ void store_all(float *r_lanes, Reg p_reg) { _mm_storeu_ps(r_lanes, p_reg); }
+
+	static _FORCE_INLINE_ Sum zero_sum() { return { _mm_setzero_pd(), _mm_setzero_pd() }; }
+	static _FORCE_INLINE_ void accumulate(Sum &r_sum, Reg p_reg) {
+		r_sum.low = _mm_add_pd(r_sum.low, _mm_cvtps_pd(p_reg));
+		r_sum.high = _mm_add_pd(r_sum.high, _mm_cvtps_pd(_mm_movehl_ps(p_reg, p_reg)));
+	}
+	static _FORCE_INLINE_ double reduce(const Sum &p_sum) {
+		double lanes[2];
+		_mm_storeu_pd(lanes, _mm_add_pd(p_sum.low, p_sum.high));
+		return lanes[0] + lanes[1];
+	}
+};
+
+template <>
+struct Lanes<double> {
+	static constexpr int64_t COUNT = 2;
+	typedef __m128d Reg;
+	typedef __m128d Sum;
+
+	static _FORCE_INLINE_ Reg load(const double *p_ptr) { return _mm_loadu_pd(p_ptr); }
+	static _FORCE_INLINE_ void store(double *p_ptr, Reg p_reg) { _mm_storeu_pd(p_ptr, p_reg); }
+	static _FORCE_INLINE_ Reg splat(double p_value) { return _mm_set1_pd(p_value); }
+	static _FORCE_INLINE_ Reg add(Reg p_a, Reg p_b) { return _mm_add_pd(p_a, p_b); }
+	static _FORCE_INLINE_ Reg sub(Reg p_a, Reg p_b) { return _mm_sub_pd(p_a, p_b); }
+	static _FORCE_INLINE_ Reg mul(Reg p_a, Reg p_b) { return _mm_mul_pd(p_a, p_b); }
+	static _FORCE_INLINE_ Reg min(Reg p_a, Reg p_b) { return _mm_min_pd(p_a, p_b); }
+	static _FORCE_INLINE_ Reg max(Reg p_a, Reg p_b) { return _mm_max_pd(p_a, p_b); }
+	static _FORCE_INLINE_ void store_all(double *r_lanes, Reg p_reg) { _mm_storeu_pd(r_lanes, p_reg); }
+
+	static _FORCE_INLINE_ Sum zero_sum() { return _mm_setzero_pd(); }
+	static _FORCE_INLINE_ void accumulate(Sum &r_sum, Reg p_reg) { r_sum = _mm_add_pd(r_sum, p_reg); }
+	static _FORCE_INLINE_ double reduce(const Sum &p_sum) {
+		double lanes[2];
+		_mm_storeu_pd(lanes, p_sum);
+		return lanes[0] + lanes[1];
+	}
+};
+#elif defined(BULK_MATH_NEON)
+template <>
+struct Lanes<float> {
+	static constexpr int64_t COUNT = 4;
+	typedef float32x4_t Reg;
+#if defined(BULK_MATH_NEON_DOUBLE)
+	struct Sum {
+		float64x2_t low;
+		float64x2_t high;
+	};
+#else
+	typedef double Sum; // No double precision lanes, lanes are added one by one.
+#endif
+
+	static _FORCE_INLINE_ Reg load(const float *p_ptr) { return vld1q_f32(p_ptr); }
+	static _FORCE_INLINE_ void store(float *p_ptr, Reg p_reg) { vst1q_f32(p_ptr, p_reg); }
+	static _FORCE_INLINE_ Reg splat(float p_value) { return vdupq_n_f32(p_value); }
+	static _FORCE_INLINE_ Reg add(Reg p_a, Reg p_b) { return vaddq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ Reg sub(Reg p_a, Reg p_b) { return vsubq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ Reg mul(Reg p_a, Reg p_b) { return vmulq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ Reg min(Reg p_a, Reg p_b) { return vminq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ Reg max(Reg p_a, Reg p_b) { return vmaxq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ void store_all(float *r_lanes, Reg p_reg) { vst1q_f32(r_lanes, p_reg); }
+
+#if defined(BULK_MATH_NEON_DOUBLE)
+	static _FORCE_INLINE_ Sum zero_sum() { return { vdupq_n_f64(0.0), vdupq_n_f64(0.0) }; }
+	static _FORCE_INLINE_ void accumulate(Sum &r_sum, Reg p_reg) {
+		r_sum.low = vaddq_f64(r_sum.low, vcvt_f64_f32(vget_low_f32(p_reg)));
+		r_sum.high = vaddq_f64(r_sum.high, vcvt_high_f64_f32(p_reg));
+	}
+	static _FORCE_INLINE_ double reduce(const Sum &p_sum) { return vaddvq_f64(vaddq_f64(p_sum.low, p_sum.high)); }
+#else
+	static _FORCE_INLINE_ Sum zero_sum() { return 0.0; }
+	static _FORCE_INLINE_ void accumulate(Sum &r_sum, Reg p_reg) {
+		float lanes[4];
+		vst1q_f32(lanes, p_reg);
+		r_sum += (double)lanes[0] + (double)lanes[1] + (double)lanes[2] + (double)lanes[3];
+	}
+	static _FORCE_INLINE_ double reduce(const Sum &p_sum) { return p_sum; }
+#endif
+};
+
+#if defined(BULK_MATH_NEON_DOUBLE)
+template <>
+struct Lanes<double> {
+	static constexpr int64_t COUNT = 2;
+	typedef float64x2_t Reg;
+	typedef float64x2_t Sum;
+
+	static _FORCE_INLINE_ Reg load(const double *p_ptr) { return vld1q_f64(p_ptr); }
+	static _FORCE_INLINE_ void store(double *p_ptr, Reg p_reg) { vst1q_f64(p_ptr, p_reg); }
+	static _FORCE_INLINE_ Reg splat(double p_value) { return vdupq_n_f64(p_value); }
+	static _FORCE_INLINE_ Reg add(Reg p_a, Reg p_b) { return vaddq_f64(p_a, p_b); }
+	static _FORCE_INLINE_ Reg sub(Reg p_a, Reg p_b) { return vsubq_f64(p_a, p_b); }
+	static _FORCE_INLINE_ Reg mul(Reg p_a, Reg p_b) { return vmulq_f64(p_a, p_b); }
+	static _FORCE_INLINE_ Reg min(Reg p_a, Reg p_b) { return vminq_f64(p_a, p_b); }
+	static _FORCE_INLINE_ Reg max(Reg p_a, Reg p_b) { return vmaxq_f64(p_a, p_b); }
+	static _FORCE_INLINE_ void store_all(double *r_lanes, Reg p_reg) { vst1q_f64(r_lanes, p_reg); }
+
+	static _FORCE_INLINE_ Sum zero_sum() { return vdupq_n_f64(0.0); }
+	static _FORCE_INLINE_ void accumulate(Sum &r_sum, Reg p_reg) { r_sum = vaddq_f64(r_sum, p_reg); }
+	static _FORCE_INLINE_ double reduce(const Sum &p_sum) { return vaddvq_f64(p_sum); }
+};
+#endif
+#endif
+
+// Each kernel runs full registers first, then finishes the last elements one by one.
+
+template <typename T>
+void _add(T *r_values, const T *p_other, int64_t p_count) {
+	typedef Lanes<T> L;
+	int64_t i = 0;
+	for (; i + L::COUNT <= p_count; i += L::COUNT) {
+		L::store(r_values + i, L::add(L::load(r_values + i), L::load(p_other + i)));
+	}
+	for (; i < p_count; i++) {
+		r_values[i] += p_other[i];
+	}
+}
+
+template <typename T>
+void _multiply(T *r_values, const T *p_other, int64_t p_count) {
+	typedef Lanes<T> L;
+	int64_t i = 0;
+	for (; i + L::COUNT <= p_count; i += L::COUNT) {
+		L::store(r_values + i, L::mul(L::load(r_values + i), L::load(p_other + i)));
+	}
+	for (; i < p_count; i++) {
+		r_values[i] *= p_other[i];
+	}
+}
+
+template <typename T>
+void _lerp(T *r_values, const T *p_to, T p_weight, int64_t p_count) {
+	typedef Lanes<T> L;
+	const typename L::Reg weight = L::splat(p_weight);
+	int64_t i = 0;
+	for (; i + L::COUNT <= p_count; i += L::COUNT) {
+		const typename L::Reg from = L::load(r_values + i);
+		L::store(r_values + i, L::add(from, L::mul(L::sub(L::load(p_to + i), from), weight)));
+	}
+	for (; i < p_count; i++) {
+		r_values[i] = Math::lerp(r_values[i], p_to[i], p_weight);
+	}
+}
+
+template <typename T>
+void _clamp(T *r_values, T p_min, T p_max, int64_t p_count) {
+	typedef Lanes<T> L;
+	const typename L::Reg min = L::splat(p_min);
+	const typename L::Reg max = L::splat(p_max);
+	int64_t i = 0;
+	for (; i + L::COUNT <= p_count; i += L::COUNT) {
+		L::store(r_values + i, L::min(L::max(L::load(r_values + i), min), max));
+	}
+	for (; i < p_count; i++) {
+		r_values[i] = MIN(MAX(r_values[i], p_min), p_max);
+	}
+}
+
+template <typename T>
+double _dot(const T *p_a, const T *p_b, int64_t p_count) {
+	typedef Lanes<T> L;
+	typename L::Sum sum = L::zero_sum();
+	int64_t i = 0;
+	for (; i + L::COUNT <= p_count; i += L::COUNT) {
+		L::accumulate(sum, L::mul(L::load(p_a + i), L::load(p_b + i)));
+	}
+	double result = L::reduce(sum);
+	for (; i < p_count; i++) {
+		result += (double)(p_a[i] * p_b[i]);
+	}
+	return result;
+}
+
+template <typename T>
+double _sum(const T *p_values, int64_t p_count) {
+	typedef Lanes<T> L;
+	typename L::Sum sum = L::zero_sum();
+	int64_t i = 0;
+	for (; i + L::COUNT <= p_count; i += L::COUNT) {
+		L::accumulate(sum, L::load(p_values + i));
+	}
+	double result = L::reduce(sum);
+	for (; i < p_count; i++) {
+		result += (double)p_values[i];
+	}
+	return result;
+}
+
+template <typename T, bool IS_MIN>
+T _extreme(const T *p_values, int64_t p_count) {
+	typedef Lanes<T> L;
+	ERR_FAIL_COND_V(p_count <= 0, T());
+	T result = p_values[0];
+	int64_t i = 0;
+	if (p_count >= L::COUNT) {
+		typename L::Reg extreme = L::load(p_values);
+		for (i = L::COUNT; i + L::COUNT <= p_count; i += L::COUNT) {
+			const typename L::Reg values = L::load(p_values + i);
+			extreme = IS_MIN ? L::min(extreme, values) : L::max(extreme, values);
+		}
+		T lanes[L::COUNT];
+		L::store_all(lanes, extreme);
+		for (int64_t j = 0; j < L::COUNT; j++) {
+			result = IS_MIN ? MIN(result, lanes[j]) : MAX(result, lanes[j]);
+		}
+	}
+	for (; i < p_count; i++) {
+		result = IS_MIN ? MIN(result, p_values[i]) : MAX(result, p_values[i]);
+	}
+	return result;
+}
+
+} // namespace
+
+void BulkMath::add(float *r_values, const float *p_other, int64_t p_count) {
+	_add(r_values, p_other, p_count);
+}
+
+void BulkMath::add(double *r_values, const double *p_other, int64_t p_count) {
+	_add(r_values, p_other, p_count);
+}
+
+void BulkMath::multiply(float *r_values, const float *p_other, int64_t p_count) {
+	_multiply(r_values, p_other, p_count);
+}
+
+void BulkMath::multiply(double *r_values, const double *p_other, int64_t p_count) {
+	_multiply(r_values, p_other, p_count);
+}
+
+void BulkMath::lerp(float *r_values, const float *p_to, float p_weight, int64_t p_count) {
+	_lerp(r_values, p_to, p_weight, p_count);
+}
+
+void BulkMath::lerp(double *r_values, const double *p_to, double p_weight, int64_t p_count) {
+	_lerp(r_values, p_to, p_weight, p_count);
+}
+
+void BulkMath::clamp(float *r_values, float p_min, float p_max, int64_t p_count) {
+	_clamp(r_values, p_min, p_max, p_count);
+}
+
+void BulkMath::clamp(double *r_values, double p_min, double p_max, int64_t p_count) {
+	_clamp(r_values, p_min, p_max, p_count);
+}
+
+double BulkMath::dot(const float *p_a, const float *p_b, int64_t p_count) {
+	return _dot(p_a, p_b, p_count);
+}
+
+double BulkMath::dot(const double *p_a, const double *p_b, int64_t p_count) {
+	return _dot(p_a, p_b, p_count);
+}
+
+double BulkMath::sum(const float *p_values, int64_t p_count) {
+	return _sum(p_values, p_count);
+}
+
+double BulkMath::sum(const double *p_values, int64_t p_count) {
+	return _sum(p_values, p_count);
+}
+
+float BulkMath::min(const float *p_values, int64_t p_count) {
+	return _extreme<float, true>(p_values, p_count);
+}
+
+double BulkMath::min(const double *p_values, int64_t p_count) {
+	return _extreme<double, true>(p_values, p_count);
+}
+
+float BulkMath::max(const float *p_values, int64_t p_count) {
+	return _extreme<float, false>(p_values, p_count);
+}
+
+double BulkMath::max(const double *p_values, int64_t p_count) {
+	return _extreme<double, false>(p_values, p_count);
+}
+
+void BulkMath::transform(Vector2 *r_points, const Transform2D &p_transform, int64_t p_count) {
+	int64_t i = 0;
+#if !defined(REAL_T_IS_DOUBLE) && (defined(BULK_MATH_SSE2) || defined(BULK_MATH_NEON))
+	// Two points per register, as (x0, y0, x1, y1).
+	float *values = reinterpret_cast<float *>(r_points);
+	const Vector2 &x_axis = p_transform.columns[0];
+	const Vector2 &y_axis = p_transform.columns[1];
+	const Vector2 &origin = p_transform.columns[2];
+#if defined(BULK_MATH_SSE2)
+	const __m128 x_axes = _mm_setr_ps(x_axis.x, x_axis.y, x_axis.x, x_axis.y);
+	const __m128 y_axes = _mm_setr_ps(y_axis.x, y_axis.y, y_axis.x, y_axis.y);
+	const __m128 origins = _mm_setr_ps(origin.x, origin.y, origin.x, origin.y);
+	for (; i + 2 <= p_count; i += 2) {
+		const __m128 points = _mm_loadu_ps(values + i * 2);
+		const __m128 xs = _mm_shuffle_ps(points, points, _MM_SHUFFLE(2, 2, 0, 0));
+		const __m128 ys = _mm_shuffle_ps(points, points, _MM_SHUFFLE(3, 3, 1, 1));
+		_mm_storeu_ps(values + i * 2, _mm_add_ps(_mm_add_ps(_mm_mul_ps(xs, x_axes), _mm_mul_ps(ys, y_axes)), origins));
+	}
+#else
+	const float x_axes_lanes[4] = { x_axis.x, x_axis.y, x_axis.x, x_axis.y };
+	const float y_axes_lanes[4] = { y_axis.x, y_axis.y, y_axis.x, y_axis.y };
+	const float origins_lanes[4] = { origin.x, origin.y, origin.x, origin.y };
+	const float32x4_t x_axes = vld1q_f32(x_axes_lanes);
+	const float32x4_t y_axes = vld1q_f32(y_axes_lanes);
+	const float32x4_t origins = vld1q_f32(origins_lanes);
+	for (; i + 2 <= p_count; i += 2) {
+		const float32x4_t points = vld1q_f32(values + i * 2);
+		const float32x4x2_t split = vtrnq_f32(points, points); // (x0, x0, x1, x1) and (y0, y0, y1, y1).
+		vst1q_f32(values + i * 2, vaddq_f32(vaddq_f32(vmulq_f32(split.val[0], x_axes), vmulq_f32(split.val[1], y_axes)), origins));
+	}
+#endif
+#endif
+	for (; i < p_count; i++) {
+		r_points[i] = p_transform.xform(r_points[i]);
+	}
+}
+
+void BulkMath::transform(Vector3 *r_points, const Transform3D &p_transform, int64_t p_count) {
+	int64_t i = 0;
+#if !defined(REAL_T_IS_DOUBLE) && (defined(BULK_MATH_SSE2) || defined(BULK_MATH_NEON))
+	// One point per register, loaded with the x of the next point in the last lane. That lane is
+	// written back unchanged, so the last point, which has no next one, is done separately.
+	float *values = reinterpret_cast<float *>(r_points);
+	const Basis &basis = p_transform.basis;
+	const Vector3 &origin = p_transform.origin;
+#if defined(BULK_MATH_SSE2)
+	const __m128 x_axis = _mm_setr_ps(basis.rows[0].x, basis.rows[1].x, basis.rows[2].x, 0.0f);
+	const __m128 y_axis = _mm_setr_ps(basis.rows[0].y, basis.rows[1].y, basis.rows[2].y, 0.0f);
+	const __m128 z_axis = _mm_setr_ps(basis.rows[0].z, basis.rows[1].z, basis.rows[2].z, 0.0f);
+	const __m128 origins = _mm_setr_ps(origin.x, origin.y, origin.z, 0.0f);
+	const __m128 xyz_mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+	for (; i + 1 < p_count; i++) {
+		float *point = values + i * 3;
+		const __m128 loaded = _mm_loadu_ps(point);
+		const __m128 xs = _mm_shuffle_ps(loaded, loaded, _MM_SHUFFLE(0, 0, 0, 0));
+		const __m128 ys = _mm_shuffle_ps(loaded, loaded, _MM_SHUFFLE(1, 1, 1, 1));
+		const __m128 zs = _mm_shuffle_ps(loaded, loaded, _MM_SHUFFLE(2, 2, 2, 2));
+		const __m128 result = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(xs, x_axis), _mm_mul_ps(ys, y_axis)), _mm_mul_ps(zs, z_axis)), origins);
+		_mm_storeu_ps(point, _mm_or_ps(_mm_and_ps(xyz_mask, result), _mm_andnot_ps(xyz_mask, loaded)));
+	}
+#else
+	const float x_axis_lanes[4] = { basis.rows[0].x, basis.rows[1].x, basis.rows[2].x, 0.0f };
+	const float y_axis_lanes[4] = { basis.rows[0].y, basis.rows[1].y, basis.rows[2].y, 0.0f };
+	const float z_axis_lanes[4] = { basis.rows[0].z, basis.rows[1].z, basis.rows[2].z, 0.0f };
+	const float origin_lanes[4] = { origin.x, origin.y, origin.z, 0.0f };
+	const float32x4_t x_axis = vld1q_f32(x_axis_lanes);
+	const float32x4_t y_axis = vld1q_f32(y_axis_lanes);
+	const float32x4_t z_axis = vld1q_f32(z_axis_lanes);
+	const float32x4_t origins = vld1q_f32(origin_lanes);
+	for (; i + 1 < p_count; i++) {
+		float *point = values + i * 3;
+		const float32x4_t loaded = vld1q_f32(point);
+		float32x4_t result = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(x_axis, vgetq_lane_f32(loaded, 0)), vmulq_n_f32(y_axis, vgetq_lane_f32(loaded, 1))), vmulq_n_f32(z_axis, vgetq_lane_f32(loaded, 2))), origins);
+		vst1q_f32(point, vsetq_lane_f32(vgetq_lane_f32(loaded, 3), result, 3));
+	}
+#endif
+#endif
+	for (; i < p_count; i++) {
+		r_points[i] = p_transform.xform(r_points[i]);
+	}
+}
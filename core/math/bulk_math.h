@@ -0,0 +1,67 @@
+/**************************************************************************/
+/*  bulk_math.h                                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BULK_MATH_H
+#define BULK_MATH_H
+
+#include "core/math/transform_2d.h"
+#include "core/math/transform_3d.h"
+
+// Kernels processing whole arrays at once, behind the bulk math methods of packed arrays.
+// They use SSE2 or NEON when available and scalar loops otherwise. Arrays of vectors are
+// processed as flat arrays of real_t by the element-wise kernels.
+class BulkMath {
+public:
+	// Element-wise, in place. `p_other` and `p_to` have `p_count` elements too.
+	static void add(float *r_values, const float *p_other, int64_t p_count);
+	static void add(double *r_values, const double *p_other, int64_t p_count);
+	static void multiply(float *r_values, const float *p_other, int64_t p_count);
+	static void multiply(double *r_values, const double *p_other, int64_t p_count);
+	static void lerp(float *r_values, const float *p_to, float p_weight, int64_t p_count);
+	static void lerp(double *r_values, const double *p_to, double p_weight, int64_t p_count);
+	static void clamp(float *r_values, float p_min, float p_max, int64_t p_count);
+	static void clamp(double *r_values, double p_min, double p_max, int64_t p_count);
+
+	// Reductions. Sums are accumulated in double precision. `min()` and `max()` need at least one element.
+	static double dot(const float *p_a, const float *p_b, int64_t p_count);
+	static double dot(const double *p_a, const double *p_b, int64_t p_count);
+	static double sum(const float *p_values, int64_t p_count);
+	static double sum(const double *p_values, int64_t p_count);
+	static float min(const float *p_values, int64_t p_count);
+	static double min(const double *p_values, int64_t p_count);
+	static float max(const float *p_values, int64_t p_count);
+	static double max(const double *p_values, int64_t p_count);
+
+	// Same results as calling `xform()` on each point, in place.
+	static void transform(Vector2 *r_points, const Transform2D &p_transform, int64_t p_count);
+	static void transform(Vector3 *r_points, const Transform3D &p_transform, int64_t p_count);
+};
+
+#endif // BULK_MATH_H
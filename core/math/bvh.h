@@ -88,6 +88,13 @@ public:
 		tree.params_set_pairing_expansion(p_value);
 	}
 
+	// Spreads the refit and the search for new pairs in update() over the WorkerThreadPool, when there
+	// is enough work. Pair callbacks are still sent from the calling thread, in the same order as without.
+	void params_set_parallel_update(bool p_enable) {
+		BVH_LOCKED_FUNCTION
+		tree._parallel_update = p_enable;
+	}
+
 	void set_pair_callback(PairCallback p_callback, void *p_userdata) {
 		BVH_LOCKED_FUNCTION
 		pair_callback = p_callback;
@@ -381,6 +388,42 @@ public:
 		return params.result_count_overall;
 	}
 
+	// Batched versions of cull_segment() and cull_aabb(), see BVH_Tree::cull_packet().
+	// `r_hit.hit(query, userdata, subindex)` receives every hit. These don't lock, so several
+	// batches can be culled at once, but the caller must make sure the tree isn't modified meanwhile.
+	template <typename HIT>
+	void cull_segments(const POINT *p_from, const POINT *p_to, int p_count, HIT &r_hit, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF) {
+		struct SegmentTest {
+			const POINT *from;
+			const POINT *to;
+			bool intersects(uint32_t p_query, const BVHABB_CLASS &p_abb) const {
+				BOUNDS bounds;
+				p_abb.to(bounds);
+				return bounds.intersects_segment(from[p_query], to[p_query]);
+			}
+		};
+
+		tree.cull_packet(p_count, SegmentTest{ p_from, p_to }, r_hit, p_tester, p_tree_collision_mask);
+	}
+
+	template <typename HIT>
+	void cull_aabbs(const BOUNDS *p_aabbs, int p_count, HIT &r_hit, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF) {
+		LocalVector<BVHABB_CLASS> abbs;
+		abbs.resize(p_count);
+		for (int i = 0; i < p_count; i++) {
+			abbs[i].from(p_aabbs[i]);
+		}
+
+		struct AABBTest {
+			const BVHABB_CLASS *abbs;
+			bool intersects(uint32_t p_query, const BVHABB_CLASS &p_abb) const {
+				return p_abb.intersects(abbs[p_query]);
+			}
+		};
+
+		tree.cull_packet(p_count, AABBTest{ abbs.ptr() }, r_hit, p_tester, p_tree_collision_mask);
+	}
+
 	int cull_point(const POINT &p_point, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
 		BVH_LOCKED_FUNCTION
 		typename BVHTREE_CLASS::CullParams params;
@@ -444,6 +487,11 @@ private:
 		params.result_array = nullptr;
 		params.subindex_array = nullptr;
 
+		if (tree._parallel_update && changed_items.size() >= PARALLEL_PAIRING_MIN_ITEMS) {
+			_check_for_collisions_parallel(p_full_check);
+			return;
+		}
+
 		for (const BVHHandle &h : changed_items) {
 			// use the expanded aabb for pairing
 			const BOUNDS &expanded_aabb = tree._pairs[h.id()].expanded_aabb;
@@ -480,6 +528,52 @@ private:
 		_reset();
 	}
 
+	void _cull_changed_item_thread(uint32_t p_index, void *p_unused) {
+		BVHHandle h = changed_items[p_index];
+
+		typename BVHTREE_CLASS::CullParams params;
+		params.result_count_overall = 0;
+		params.result_max = INT_MAX;
+		params.result_array = nullptr;
+		params.subindex_array = nullptr;
+		tree.item_fill_cullparams(h, params);
+		params.abb.from(tree._pairs[h.id()].expanded_aabb);
+
+		tree.cull_aabb_into(params, changed_item_hits[p_index]);
+	}
+
+	// Same as _check_for_collisions(), but the culls of all the changed items are done first on the
+	// worker threads. They only read the tree and the expanded AABBs, which pairing doesn't modify,
+	// so the pairs found and the order of the callbacks are the same.
+	void _check_for_collisions_parallel(bool p_full_check) {
+		if (changed_item_hits.size() < changed_items.size()) {
+			changed_item_hits.resize(changed_items.size());
+		}
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &BVH_Manager::_cull_changed_item_thread, (void *)nullptr, changed_items.size(), -1, true, SNAME("BVHPairing"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (uint32_t n = 0; n < changed_items.size(); n++) {
+			BVHHandle h = changed_items[n];
+
+			BVHABB_CLASS abb;
+			abb.from(tree._pairs[h.id()].expanded_aabb);
+			_find_leavers(h, abb, p_full_check);
+
+			for (const uint32_t ref_id : changed_item_hits[n]) {
+				// don't collide against ourself
+				if (ref_id == h.id()) {
+					continue;
+				}
+
+				BVHHandle h_collidee;
+				h_collidee.set_id(ref_id);
+				_collide(h, h_collidee);
+			}
+		}
+		_reset();
+	}
+
 public:
 	void item_get_AABB(BVHHandle p_handle, BOUNDS &r_aabb) {
 		DEV_ASSERT(!p_handle.is_invalid());
@@ -773,6 +867,13 @@ private:
 	LocalVector<BVHHandle, uint32_t, true> changed_items;
 	uint32_t _tick = 1; // Start from 1 so items with 0 indicate never updated.
 
+	// with parallel updates, the cull hits of each changed item, kept to reuse the allocations
+	LocalVector<LocalVector<uint32_t, uint32_t, true>> changed_item_hits;
+	enum {
+		// below this, pairing isn't worth the threading overhead
+		PARALLEL_PAIRING_MIN_ITEMS = 512,
+	};
+
 	class BVHLockedFunction {
 	public:
 		BVHLockedFunction(Mutex *p_mutex, bool p_thread_safe) {
@@ -1761,6 +1761,41 @@ StringName ClassDB::get_property_getter(const StringName &p_class, const StringN
 	return StringName();
 }
 
+MethodBind *ClassDB::get_property_setter_method(const StringName &p_class, const StringName &p_property) {
+	ClassInfo *type = classes.getptr(p_class);
+	ClassInfo *check = type;
+	while (check) {
+		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		if (psg) {
+			return psg->index < 0 ? psg->_setptr : nullptr;
+		}
+
+		check = check->inherits_ptr;
+	}
+
+	return nullptr;
+}
+
+MethodBind *ClassDB::get_property_getter_method(const StringName &p_class, const StringName &p_property) {
+	ClassInfo *type = classes.getptr(p_class);
+	ClassInfo *check = type;
+	while (check) {
+		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		if (psg) {
+			return psg->index < 0 ? psg->_getptr : nullptr;
+		}
+
+		// Same lookup order as get_property().
+		if (check->constant_map.has(p_property) || check->method_map.has(p_property) || check->signal_map.has(p_property)) {
+			return nullptr;
+		}
+
+		check = check->inherits_ptr;
+	}
+
+	return nullptr;
+}
+
 bool ClassDB::has_property(const StringName &p_class, const StringName &p_property, bool p_no_inheritance) {
 	ClassInfo *type = classes.getptr(p_class);
 	ClassInfo *check = type;
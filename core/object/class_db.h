@@ -439,6 +439,10 @@ public:
 	static Variant::Type get_property_type(const StringName &p_class, const StringName &p_property, bool *r_is_valid = nullptr);
 	static StringName get_property_setter(const StringName &p_class, const StringName &p_property);
 	static StringName get_property_getter(const StringName &p_class, const StringName &p_property);
+	// The bound methods set_property() and get_property() call for p_property, or null when they would go through
+	// anything else (indexed, unbound or missing accessors, or a constant, method or signal shadowing the property).
+	static MethodBind *get_property_setter_method(const StringName &p_class, const StringName &p_property);
+	static MethodBind *get_property_getter_method(const StringName &p_class, const StringName &p_property);
 
 	static bool has_method(const StringName &p_class, const StringName &p_method, bool p_no_inheritance = false);
 	static void set_method_flags(const StringName &p_class, const StringName &p_method, int p_flags);
@@ -43,21 +43,6 @@
 
 #ifdef DEBUG_ENABLED
 
-struct _ObjectDebugLock {
-	ObjectID obj_id;
-
-	_ObjectDebugLock(Object *p_obj) {
-		obj_id = p_obj->get_instance_id();
-		p_obj->_lock_index.ref();
-	}
-	~_ObjectDebugLock() {
-		Object *obj_ptr = ObjectDB::get_instance(obj_id);
-		if (likely(obj_ptr)) {
-			obj_ptr->_lock_index.unref();
-		}
-	}
-};
-
 #define OBJ_DEBUG_LOCK _ObjectDebugLock _debug_lock(this);
 
 #else
@@ -1127,6 +1112,50 @@ Error Object::_emit_signal(const Variant **p_args, int p_argcount, Callable::Cal
 	return emit_signalp(signal, args, argc);
 }
 
+// Connections to bound methods taking typed arguments can skip Object::callp() and the argument
+// validation of MethodBind::call() on emission, as long as the emitted arguments have the right types.
+static const MethodBind *_get_signal_validated_method(Object *p_target, const Callable &p_callable, uint32_t p_flags) {
+	if (!p_target || !p_callable.is_standard() || (p_flags & Object::CONNECT_DEFERRED)) {
+		return nullptr;
+	}
+
+	const MethodBind *method = ClassDB::get_method(p_target->get_class_name(), p_callable.get_method());
+	if (!method || method->is_vararg() || method->is_static()) {
+		return nullptr;
+	}
+	for (int i = 0; i < method->get_argument_count(); i++) {
+		switch (method->get_argument_type(i)) {
+			case Variant::OBJECT: {
+				return nullptr; // Objects may have been freed, leave their validation to the regular call.
+			}
+			case Variant::ARRAY:
+			case Variant::DICTIONARY: {
+				// Only the container type is matched on emission, typed ones must validate their elements.
+				PropertyHint hint = method->get_argument_info(i).hint;
+				if (hint == PROPERTY_HINT_ARRAY_TYPE || hint == PROPERTY_HINT_DICTIONARY_TYPE) {
+					return nullptr;
+				}
+			} break;
+			default: {
+			}
+		}
+	}
+	return method;
+}
+
+static _FORCE_INLINE_ bool _signal_arguments_match(const MethodBind *p_method, const Variant **p_args, int p_argcount) {
+	if (p_argcount != p_method->get_argument_count()) {
+		return false;
+	}
+	for (int i = 0; i < p_argcount; i++) {
+		Variant::Type type = p_method->get_argument_type(i);
+		if (type != Variant::NIL && p_args[i]->get_type() != type) {
+			return false;
+		}
+	}
+	return true;
+}
+
 Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount) {
 	if (_block_signals) {
 		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
@@ -1143,23 +1172,41 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		return ERR_UNAVAILABLE;
 	}
 
+	if (s->slot_map.is_empty()) {
+		return OK;
+	}
+
 	// If this is a ref-counted object, prevent it from being destroyed during signal emission,
 	// which is needed in certain edge cases; e.g., https://github.com/godotengine/godot/issues/73889.
 	Ref<RefCounted> rc = Ref<RefCounted>(Object::cast_to<RefCounted>(this));
 
 	// Ensure that disconnecting the signal or even deleting the object
 	// will not affect the signal calling.
-	Callable *slot_callables = (Callable *)alloca(sizeof(Callable) * s->slot_map.size());
-	uint32_t *slot_flags = (uint32_t *)alloca(sizeof(uint32_t) * s->slot_map.size());
-	uint32_t slot_count = 0;
-
-	for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
-		memnew_placement(&slot_callables[slot_count], Callable(slot_kv.value.conn.callable));
-		slot_flags[slot_count] = slot_kv.value.conn.flags;
-		++slot_count;
+	SignalData::Snapshot *snapshot = s->snapshot.load(std::memory_order_acquire);
+	if (!snapshot) {
+		SignalData::Snapshot *new_snapshot = memnew(SignalData::Snapshot);
+		new_snapshot->refcount.init();
+		new_snapshot->callables.reserve(s->slot_map.size());
+		new_snapshot->flags.reserve(s->slot_map.size());
+		new_snapshot->validated_methods.reserve(s->slot_map.size());
+		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
+			new_snapshot->callables.push_back(slot_kv.value.conn.callable);
+			new_snapshot->flags.push_back(slot_kv.value.conn.flags);
+			new_snapshot->validated_methods.push_back(slot_kv.value.validated_method);
+		}
+		// Emitting only reads the signal data, so another thread may have published one meanwhile.
+		if (s->snapshot.compare_exchange_strong(snapshot, new_snapshot, std::memory_order_acq_rel)) {
+			snapshot = new_snapshot;
+		} else {
+			memdelete(new_snapshot);
+		}
 	}
 
-	DEV_ASSERT(slot_count == s->slot_map.size());
+	snapshot->refcount.ref();
+	const Callable *slot_callables = snapshot->callables.ptr();
+	const uint32_t *slot_flags = snapshot->flags.ptr();
+	const MethodBind *const *slot_methods = snapshot->validated_methods.ptr();
+	const uint32_t slot_count = snapshot->callables.size();
 
 	// Disconnect all one-shot connections before emitting to prevent recursion.
 	for (uint32_t i = 0; i < slot_count; ++i) {
@@ -1183,6 +1230,27 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		const Callable &callable = slot_callables[i];
 		const uint32_t &flags = slot_flags[i];
 
+		if (slot_methods[i]) {
+			Object *target = ObjectDB::get_instance(callable.get_object_id());
+			if (!target) {
+				// Target might have been deleted during signal callback, this is expected and OK.
+				continue;
+			}
+			// A script instance may have been attached since connecting, and it takes precedence.
+			if (!target->script_instance && _signal_arguments_match(slot_methods[i], p_args, p_argcount)) {
+				_emitting = true;
+				{
+#ifdef DEBUG_ENABLED
+					_ObjectDebugLock target_lock(target);
+#endif
+					Variant ret;
+					slot_methods[i]->validated_call(target, p_args, &ret);
+				}
+				_emitting = false;
+				continue;
+			}
+		}
+
 		if (!callable.is_valid()) {
 			// Target might have been deleted during signal callback, this is expected and OK.
 			continue;
@@ -1217,8 +1285,8 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		}
 	}
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		slot_callables[i].~Callable();
+	if (snapshot->refcount.unref()) {
+		memdelete(snapshot);
 	}
 
 	return err;
@@ -1425,6 +1493,7 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 	conn.signal = ::Signal(this, p_signal);
 	conn.flags = p_flags;
 	slot.conn = conn;
+	slot.validated_method = _get_signal_validated_method(target_object, p_callable, p_flags);
 	if (target_object) {
 		slot.cE = target_object->connections.push_back(conn);
 	}
@@ -1434,6 +1503,7 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 
 	//use callable version as key, so binds can be ignored
 	s->slot_map[*p_callable.get_base_comparator()] = slot;
+	s->invalidate_snapshot();
 
 	return OK;
 }
@@ -1509,6 +1579,7 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 	}
 
 	s->slot_map.erase(*p_callable.get_base_comparator());
+	s->invalidate_snapshot();
 
 	if (s->slot_map.is_empty() && ClassDB::has_signal(get_class_name(), p_signal)) {
 		//not user signal, delete
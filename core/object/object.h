@@ -39,6 +39,7 @@
 #include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rb_map.h"
 #include "core/templates/safe_refcount.h"
 #include "core/variant/callable_bind.h"
@@ -602,11 +603,46 @@ private:
 			int reference_count = 0;
 			Connection conn;
 			List<Connection>::Element *cE = nullptr;
+			// Method of a standard callable with typed arguments, called with validated_call() when the emitted arguments match.
+			const MethodBind *validated_method = nullptr;
+		};
+
+		// Immutable copy of the connections iterated by emit_signalp(). It is rebuilt by the first
+		// emission after the connections change, and emissions in flight keep their own reference,
+		// so connecting and disconnecting while emitting is safe without copying on every emission.
+		// Concurrent emissions may both build one, only the first to publish it is kept.
+		struct Snapshot {
+			SafeRefCount refcount;
+			LocalVector<Callable> callables;
+			LocalVector<uint32_t> flags;
+			LocalVector<const MethodBind *> validated_methods;
 		};
 
 		MethodInfo user;
 		HashMap<Callable, Slot, HashableHasher<Callable>> slot_map;
+		std::atomic<Snapshot *> snapshot = nullptr;
 		bool removable = false;
+
+		void invalidate_snapshot() {
+			Snapshot *old_snapshot = snapshot.exchange(nullptr, std::memory_order_acq_rel);
+			if (old_snapshot && old_snapshot->refcount.unref()) {
+				memdelete(old_snapshot);
+			}
+		}
+
+		SignalData() {}
+		SignalData(const SignalData &p_other) :
+				user(p_other.user), slot_map(p_other.slot_map), removable(p_other.removable) {}
+		SignalData &operator=(const SignalData &p_other) {
+			if (this != &p_other) {
+				invalidate_snapshot();
+				user = p_other.user;
+				slot_map = p_other.slot_map;
+				removable = p_other.removable;
+			}
+			return *this;
+		}
+		~SignalData() { invalidate_snapshot(); }
 	};
 
 	HashMap<StringName, SignalData> signal_map;
@@ -1053,4 +1089,25 @@ public:
 	static int get_object_count();
 };
 
+#ifdef DEBUG_ENABLED
+
+// Keeps an object from being freed while one of its methods runs.
+// Code that calls methods without going through Object::callp() must hold it too.
+struct _ObjectDebugLock {
+	ObjectID obj_id;
+
+	_ObjectDebugLock(Object *p_obj) {
+		obj_id = p_obj->get_instance_id();
+		p_obj->_lock_index.ref();
+	}
+	~_ObjectDebugLock() {
+		Object *obj_ptr = ObjectDB::get_instance(obj_id);
+		if (likely(obj_ptr)) {
+			obj_ptr->_lock_index.unref();
+		}
+	}
+};
+
+#endif
+
 #endif // OBJECT_H
@@ -85,6 +85,11 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 	bool low_priority = p_task->low_priority;
 #endif
 
+	LocalVector<Task *> ready_dependents;
+
+	// Tasks can be nested on the same thread while waiting, so only give back what this one used.
+	uint64_t frame_arena_mark = FrameAllocator::get_mark();
+
 	if (p_task->group) {
 		// Handling a group
 		bool do_post = false;
@@ -118,6 +123,11 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		if (do_post) {
 			p_task->group->done_semaphore.post();
 			p_task->group->completed.set_to(true);
+
+			// Completion is flagged before locking, so a dependency registered from now on
+			// will either be seen here or never be added at all.
+			MutexLock task_lock(task_mutex);
+			_collect_ready_dependents(p_task->group->dependents, ready_dependents);
 		}
 		uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = p_task->group->finished.increment();
@@ -148,6 +158,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		if (p_task->waiting_user) {
 			p_task->done_semaphore.post(p_task->waiting_user);
 		}
+		_collect_ready_dependents(p_task->dependents, ready_dependents);
 		// Let awaiters know.
 		for (uint32_t i = 0; i < threads.size(); i++) {
 			if (threads[i].awaited_task == p_task) {
@@ -176,14 +187,27 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 	set_current_thread_safe_for_nodes(safe_for_nodes_backup);
 	MessageQueue::set_thread_singleton_override(call_queue_backup);
 #endif
+
+	FrameAllocator::rewind(frame_arena_mark);
+
+	if (ready_dependents.size()) {
+		MutexLock lock(task_mutex);
+		_post_ready_tasks(ready_dependents, lock);
+	}
 }
 
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
 
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
+		// Lock-free fast path: own tasks first (most recent first, as they are likely hot in cache),
+		// then the oldest ones from other threads.
+		Task *task_to_process = thread_data->local_queue.pop();
+		if (!task_to_process) {
+			task_to_process = singleton->_steal_task(thread_data);
+		}
+
+		if (!task_to_process) {
 			MutexLock lock(singleton->task_mutex);
 
 			bool exit = singleton->_handle_runlevel(thread_data, lock);
@@ -197,7 +221,12 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 				task_to_process = singleton->task_queue.first()->self();
 				singleton->task_queue.remove(singleton->task_queue.first());
 			} else {
-				thread_data->cond_var.wait(lock);
+				// Local queues are only pushed to with the mutex held, so checking them
+				// again here can't miss a task whose notification would arrive before the wait.
+				task_to_process = singleton->_steal_task(thread_data);
+				if (!task_to_process) {
+					thread_data->cond_var.wait(lock);
+				}
 			}
 		}
 
@@ -233,7 +262,11 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
 		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
-			task_queue.add_last(&p_tasks[i]->task_elem);
+			// Tasks posted from a pool thread stay in its local queue, unless full.
+			// Other threads will steal them if they are idle.
+			if (!caller_pool_thread || !caller_pool_thread->local_queue.push(p_tasks[i])) {
+				task_queue.add_last(&p_tasks[i]->task_elem);
+			}
 			if (!p_high_priority) {
 				low_priority_threads_used++;
 			}
@@ -312,6 +345,91 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 	}
 }
 
+// Returns how many of the dependencies are still pending. The same count applies to each of the tasks.
+uint32_t WorkerThreadPool::_register_dependencies(TaskID p_self, Task **p_tasks, uint32_t p_count, const Vector<TaskID> &p_dependencies) {
+	uint32_t pending = 0;
+	for (const TaskID &dependency : p_dependencies) {
+		// Only older IDs are valid, which also rules out cycles.
+		ERR_CONTINUE_MSG(dependency <= 0 || dependency >= p_self, vformat("Invalid task dependency ID: %d.", dependency));
+
+		LocalVector<Task *> *dependents = nullptr;
+		Task **taskp = tasks.getptr(dependency);
+		if (taskp) {
+			if (!(*taskp)->completed) {
+				dependents = &(*taskp)->dependents;
+			}
+		} else {
+			Group **groupp = groups.getptr(dependency);
+			if (groupp && !(*groupp)->completed.is_set()) {
+				dependents = &(*groupp)->dependents;
+			}
+		}
+		// Otherwise, it's already been completed and awaited.
+
+		if (dependents) {
+			for (uint32_t i = 0; i < p_count; i++) {
+				dependents->push_back(p_tasks[i]);
+				p_tasks[i]->pending_dependencies++;
+			}
+			pending++;
+		}
+	}
+	return pending;
+}
+
+void WorkerThreadPool::_collect_ready_dependents(LocalVector<Task *> &p_dependents, LocalVector<Task *> &r_ready) {
+	for (Task *dependent : p_dependents) {
+		DEV_ASSERT(dependent->pending_dependencies > 0);
+		dependent->pending_dependencies--;
+		if (dependent->pending_dependencies == 0) {
+			r_ready.push_back(dependent);
+		}
+	}
+	p_dependents.clear();
+}
+
+void WorkerThreadPool::_post_ready_tasks(LocalVector<Task *> &p_ready, MutexLock<BinaryMutex> &p_lock) {
+	// Tasks keep the priority they were added with.
+	uint32_t high_priority_count = 0;
+	for (uint32_t i = 0; i < p_ready.size(); i++) {
+		if (!p_ready[i]->low_priority) {
+			SWAP(p_ready[i], p_ready[high_priority_count]);
+			high_priority_count++;
+		}
+	}
+	if (high_priority_count) {
+		_post_tasks(p_ready.ptr(), high_priority_count, true, p_lock);
+	}
+	if (high_priority_count < p_ready.size()) {
+		_post_tasks(p_ready.ptr() + high_priority_count, p_ready.size() - high_priority_count, false, p_lock);
+	}
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_steal_task(const ThreadData *p_thief) {
+	uint32_t thread_count = threads.size();
+	// Start at the next thread so thieves spread across victims.
+	for (uint32_t i = 1; i < thread_count; i++) {
+		ThreadData &victim = threads[(p_thief->index + i) % thread_count];
+		while (!victim.local_queue.is_empty()) {
+			Task *task = victim.local_queue.steal();
+			if (task) {
+				return task;
+			}
+			// Lost the race against another thread; try again while there's something left.
+		}
+	}
+	return nullptr;
+}
+
+bool WorkerThreadPool::_has_stealable_tasks() const {
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		if (!threads[i].local_queue.is_empty()) {
+			return true;
+		}
+	}
+	return false;
+}
+
 bool WorkerThreadPool::_try_promote_low_priority_task() {
 	if (low_priority_task_queue.first()) {
 		Task *low_prio_task = low_priority_task_queue.first()->self();
@@ -325,10 +443,14 @@ bool WorkerThreadPool::_try_promote_low_priority_task() {
 }
 
 WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
-	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, Vector<TaskID>());
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_task_with_dependencies(const Vector<TaskID> &p_dependencies, void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, p_dependencies);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies) {
 	MutexLock<BinaryMutex> lock(task_mutex);
 
 	// Get a free task
@@ -340,15 +462,22 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 	task->native_func_userdata = p_userdata;
 	task->description = p_description;
 	task->template_userdata = p_template_userdata;
+	task->low_priority = !p_high_priority;
 	tasks.insert(id, task);
 
-	_post_tasks(&task, 1, p_high_priority, lock);
+	if (_register_dependencies(id, &task, 1, p_dependencies) == 0) {
+		_post_tasks(&task, 1, p_high_priority, lock);
+	}
 
 	return id;
 }
 
 WorkerThreadPool::TaskID WorkerThreadPool::add_task(const Callable &p_action, bool p_high_priority, const String &p_description) {
-	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description);
+	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, Vector<TaskID>());
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::add_task_with_dependencies(const Vector<TaskID> &p_dependencies, const Callable &p_action, bool p_high_priority, const String &p_description) {
+	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, p_dependencies);
 }
 
 bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
@@ -479,7 +608,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = (task_queue.first() || _has_stealable_tasks()) ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
@@ -497,10 +626,15 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				}
 			}
 
-			if (singleton->task_queue.first()) {
+			// Own tasks first, since the awaited one is most likely among the last posted.
+			task_to_process = p_caller_pool_thread->local_queue.pop();
+			if (!task_to_process && task_queue.first()) {
 				task_to_process = task_queue.first()->self();
 				task_queue.remove(task_queue.first());
 			}
+			if (!task_to_process) {
+				task_to_process = _steal_task(p_caller_pool_thread);
+			}
 
 			if (!task_to_process) {
 				p_caller_pool_thread->awaited_task = p_task;
@@ -543,7 +677,7 @@ bool WorkerThreadPool::_handle_runlevel(ThreadData *p_thread_data, MutexLock<Bin
 		} break;
 		case RUNLEVEL_PRE_EXIT_LANGUAGES: {
 			if (!p_thread_data->pre_exited_languages) {
-				if (!task_queue.first() && !low_priority_task_queue.first()) {
+				if (!task_queue.first() && !low_priority_task_queue.first() && !_has_stealable_tasks()) {
 					p_thread_data->pre_exited_languages = true;
 					runlevel_data.pre_exit_languages.num_idle_threads++;
 					control_cond_var.notify_all();
@@ -606,7 +740,7 @@ void WorkerThreadPool::notify_yield_over(TaskID p_task_id) {
 	td.cond_var.notify_one();
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies) {
 	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
 	if (p_tasks < 0) {
 		p_tasks = MAX(1u, threads.size());
@@ -622,6 +756,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 	Task **tasks_posted = nullptr;
 	if (p_elements == 0) {
 		// Should really not call it with zero Elements, but at least it should work.
+		// Dependencies are ignored in this case, since there's nothing to run after them.
 		group->completed.set_to(true);
 		group->done_semaphore.post();
 		group->tasks_used = 0;
@@ -641,24 +776,37 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 			task->group = group;
 			task->callable = p_callable;
 			task->template_userdata = p_template_userdata;
+			task->low_priority = !p_high_priority;
 			tasks_posted[i] = task;
 			// No task ID is used.
 		}
 	}
 
+	uint32_t pending_dependencies = p_tasks ? _register_dependencies(id, tasks_posted, p_tasks, p_dependencies) : 0;
+
 	groups[id] = group;
 
-	_post_tasks(tasks_posted, p_tasks, p_high_priority, lock);
+	if (pending_dependencies == 0) {
+		_post_tasks(tasks_posted, p_tasks, p_high_priority, lock);
+	}
 
 	return id;
 }
 
 WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
-	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description);
+	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description, Vector<TaskID>());
 }
 
 WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_action, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
-	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description);
+	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description, Vector<TaskID>());
+}
+
+WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task_with_dependencies(const Vector<TaskID> &p_dependencies, void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+}
+
+WorkerThreadPool::GroupID WorkerThreadPool::add_group_task_with_dependencies(const Vector<TaskID> &p_dependencies, const Callable &p_action, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
 }
 
 uint32_t WorkerThreadPool::get_group_processed_element_count(GroupID p_group) const {
@@ -723,6 +871,15 @@ WorkerThreadPool::TaskID WorkerThreadPool::get_caller_task_id() {
 	}
 }
 
+String WorkerThreadPool::get_caller_task_description() {
+	int th_index = get_thread_index();
+	if (th_index != -1 && singleton->threads[th_index].current_task) {
+		return singleton->threads[th_index].current_task->description;
+	} else {
+		return String();
+	}
+}
+
 #ifdef THREADS_ENABLED
 uint32_t WorkerThreadPool::_thread_enter_unlock_allowance_zone(THREADING_NAMESPACE::unique_lock<THREADING_NAMESPACE::mutex> &p_ulock) {
 	for (uint32_t i = 0; i < MAX_UNLOCKABLE_LOCKS; i++) {
@@ -825,11 +982,13 @@ void WorkerThreadPool::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("add_task", "action", "high_priority", "description"), &WorkerThreadPool::add_task, DEFVAL(false), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("is_task_completed", "task_id"), &WorkerThreadPool::is_task_completed);
 	ClassDB::bind_method(D_METHOD("wait_for_task_completion", "task_id"), &WorkerThreadPool::wait_for_task_completion);
+	ClassDB::bind_method(D_METHOD("add_task_with_dependencies", "dependencies", "action", "high_priority", "description"), &WorkerThreadPool::add_task_with_dependencies, DEFVAL(false), DEFVAL(String()));
 
 	ClassDB::bind_method(D_METHOD("add_group_task", "action", "elements", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("is_group_task_completed", "group_id"), &WorkerThreadPool::is_group_task_completed);
 	ClassDB::bind_method(D_METHOD("get_group_processed_element_count", "group_id"), &WorkerThreadPool::get_group_processed_element_count);
 	ClassDB::bind_method(D_METHOD("wait_for_group_task_completion", "group_id"), &WorkerThreadPool::wait_for_group_task_completion);
+	ClassDB::bind_method(D_METHOD("add_group_task_with_dependencies", "dependencies", "action", "elements", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task_with_dependencies, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
 }
 
 WorkerThreadPool::WorkerThreadPool() {
@@ -40,6 +40,7 @@
 #include "core/templates/paged_allocator.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_deque.h"
 
 class WorkerThreadPool : public Object {
 	GDCLASS(WorkerThreadPool, Object)
@@ -69,6 +70,7 @@ private:
 		SafeFlag completed;
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
+		LocalVector<Task *> dependents; // Tasks to post once the group is completed.
 	};
 
 	struct Task {
@@ -88,6 +90,8 @@ private:
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
 		int pool_thread_index = -1;
+		uint32_t pending_dependencies = 0; // Not posted until it reaches zero.
+		LocalVector<Task *> dependents; // Tasks to post once this one is completed.
 
 		void free_template_userdata();
 		Task() :
@@ -98,6 +102,7 @@ private:
 
 	static const uint32_t TASKS_PAGE_SIZE = 1024;
 	static const uint32_t GROUPS_PAGE_SIZE = 256;
+	static const uint32_t LOCAL_QUEUE_SIZE = 256;
 
 	PagedAllocator<Task, false, TASKS_PAGE_SIZE> task_allocator;
 	PagedAllocator<Group, false, GROUPS_PAGE_SIZE> group_allocator;
@@ -119,6 +124,8 @@ private:
 		Task *current_task = nullptr;
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
+		// Tasks posted from this thread. Only this thread pushes and pops; other threads steal.
+		WorkStealingDeque<Task, LOCAL_QUEUE_SIZE> local_queue;
 
 		ThreadData() :
 				signaled(false),
@@ -175,6 +182,13 @@ private:
 
 	bool _try_promote_low_priority_task();
 
+	uint32_t _register_dependencies(TaskID p_self, Task **p_tasks, uint32_t p_count, const Vector<TaskID> &p_dependencies);
+	void _collect_ready_dependents(LocalVector<Task *> &p_dependents, LocalVector<Task *> &r_ready);
+	void _post_ready_tasks(LocalVector<Task *> &p_ready, MutexLock<BinaryMutex> &p_lock);
+
+	Task *_steal_task(const ThreadData *p_thief);
+	bool _has_stealable_tasks() const;
+
 	static WorkerThreadPool *singleton;
 
 #ifdef THREADS_ENABLED
@@ -186,8 +200,8 @@ private:
 	static thread_local UnlockableLocks unlockable_locks[MAX_UNLOCKABLE_LOCKS];
 #endif
 
-	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description);
-	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description);
+	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies);
+	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies);
 
 	template <typename C, typename M, typename U>
 	struct TaskUserData : public BaseTemplateUserdata {
@@ -232,11 +246,25 @@ public:
 		ud->instance = p_instance;
 		ud->method = p_method;
 		ud->userdata = p_userdata;
-		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description);
+		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description, Vector<TaskID>());
 	}
 	TaskID add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String());
 	TaskID add_task(const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
 
+	// Dependencies can be task or group IDs. The task is only posted once all of them are completed.
+	// They must still be awaited as usual, which won't block if they are already completed.
+	template <typename C, typename M, typename U>
+	TaskID add_template_task_with_dependencies(const Vector<TaskID> &p_dependencies, C *p_instance, M p_method, U p_userdata, bool p_high_priority = false, const String &p_description = String()) {
+		typedef TaskUserData<C, M, U> TUD;
+		TUD *ud = memnew(TUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description, p_dependencies);
+	}
+	TaskID add_native_task_with_dependencies(const Vector<TaskID> &p_dependencies, void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String());
+	TaskID add_task_with_dependencies(const Vector<TaskID> &p_dependencies, const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
+
 	bool is_task_completed(TaskID p_task_id) const;
 	Error wait_for_task_completion(TaskID p_task_id);
 
@@ -250,10 +278,22 @@ public:
 		ud->instance = p_instance;
 		ud->method = p_method;
 		ud->userdata = p_userdata;
-		return _add_group_task(Callable(), nullptr, nullptr, ud, p_elements, p_tasks, p_high_priority, p_description);
+		return _add_group_task(Callable(), nullptr, nullptr, ud, p_elements, p_tasks, p_high_priority, p_description, Vector<TaskID>());
 	}
 	GroupID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
 	GroupID add_group_task(const Callable &p_action, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+
+	template <typename C, typename M, typename U>
+	GroupID add_template_group_task_with_dependencies(const Vector<TaskID> &p_dependencies, C *p_instance, M p_method, U p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String()) {
+		typedef GroupUserData<C, M, U> GroupUD;
+		GroupUD *ud = memnew(GroupUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_group_task(Callable(), nullptr, nullptr, ud, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+	}
+	GroupID add_native_group_task_with_dependencies(const Vector<TaskID> &p_dependencies, void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+	GroupID add_group_task_with_dependencies(const Vector<TaskID> &p_dependencies, const Callable &p_action, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
 	uint32_t get_group_processed_element_count(GroupID p_group) const;
 	bool is_group_task_completed(GroupID p_group) const;
 	void wait_for_group_task_completion(GroupID p_group);
@@ -263,6 +303,7 @@ public:
 	static WorkerThreadPool *get_singleton() { return singleton; }
 	static int get_thread_index();
 	static TaskID get_caller_task_id();
+	static String get_caller_task_description();
 
 #ifdef THREADS_ENABLED
 	_ALWAYS_INLINE_ static uint32_t thread_enter_unlock_allowance_zone(const MutexLock<BinaryMutex> &p_lock) { return _thread_enter_unlock_allowance_zone(p_lock._get_lock()); }
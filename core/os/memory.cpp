@@ -62,6 +62,40 @@ void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_d
 #ifdef DEBUG_ENABLED
 SafeNumeric<uint64_t> Memory::mem_usage;
 SafeNumeric<uint64_t> Memory::max_usage;
+
+SafeNumeric<uint32_t> Memory::sample_interval;
+Memory::AllocSampleFunc Memory::alloc_sample_func = nullptr;
+Memory::FreeSampleFunc Memory::free_sample_func = nullptr;
+
+#if defined(__GNUC__) || defined(__clang__)
+#define MEMORY_CALLSITE __builtin_return_address(0)
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define MEMORY_CALLSITE _ReturnAddress()
+#else
+#define MEMORY_CALLSITE nullptr
+#endif
+
+static thread_local uint32_t sample_countdown = 0;
+
+bool Memory::_sample_alloc(void *p_ptr, size_t p_bytes, void *p_callsite) {
+	if (sample_countdown > 0) {
+		sample_countdown--;
+		return false;
+	}
+	sample_countdown = sample_interval.get() - 1;
+	AllocSampleFunc func = alloc_sample_func;
+	return func && func(p_ptr, p_bytes, p_callsite);
+}
+
+void Memory::set_alloc_sampling(uint32_t p_interval, AllocSampleFunc p_alloc_func, FreeSampleFunc p_free_func) {
+	if (p_interval) {
+		alloc_sample_func = p_alloc_func;
+		free_sample_func = p_free_func;
+	}
+	// Callbacks are kept after disabling, since other threads may be in the middle of calling them.
+	sample_interval.set(p_interval);
+}
 #endif
 
 SafeNumeric<uint64_t> Memory::alloc_count;
@@ -120,6 +154,10 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 #ifdef DEBUG_ENABLED
 		uint64_t new_mem_usage = mem_usage.add(p_bytes);
 		max_usage.exchange_if_greater(new_mem_usage);
+
+		if (unlikely(sample_interval.get()) && _sample_alloc(s8 + DATA_OFFSET, p_bytes, MEMORY_CALLSITE)) {
+			*s |= SAMPLED_BIT;
+		}
 #endif
 		return s8 + DATA_OFFSET;
 	} else {
@@ -145,11 +183,17 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
 
 #ifdef DEBUG_ENABLED
-		if (p_bytes > *s) {
-			uint64_t new_mem_usage = mem_usage.add(p_bytes - *s);
+		bool sampled = *s & SAMPLED_BIT;
+		uint64_t prev_bytes = *s & ~SAMPLED_BIT;
+		if (p_bytes > prev_bytes) {
+			uint64_t new_mem_usage = mem_usage.add(p_bytes - prev_bytes);
 			max_usage.exchange_if_greater(new_mem_usage);
 		} else {
-			mem_usage.sub(*s - p_bytes);
+			mem_usage.sub(prev_bytes - p_bytes);
+		}
+
+		if (unlikely(sampled) && free_sample_func) {
+			free_sample_func(p_memory, prev_bytes);
 		}
 #endif
 
@@ -166,6 +210,13 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 			*s = p_bytes;
 
+#ifdef DEBUG_ENABLED
+			// Keep following it, now attributed to whoever made it grow.
+			if (unlikely(sampled) && sample_interval.get() && alloc_sample_func && alloc_sample_func(mem + DATA_OFFSET, p_bytes, MEMORY_CALLSITE)) {
+				*s |= SAMPLED_BIT;
+			}
+#endif
+
 			return mem + DATA_OFFSET;
 		}
 	} else {
@@ -195,7 +246,11 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 
 #ifdef DEBUG_ENABLED
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
-		mem_usage.sub(*s);
+		mem_usage.sub(*s & ~SAMPLED_BIT);
+
+		if (unlikely(*s & SAMPLED_BIT) && free_sample_func) {
+			free_sample_func(p_ptr, *s & ~SAMPLED_BIT);
+		}
 #endif
 
 		free(mem);
@@ -224,6 +279,176 @@ uint64_t Memory::get_mem_max_usage() {
 #endif
 }
 
+SafeNumeric<uint64_t> FrameAllocator::arena_bytes;
+SafeNumeric<uint64_t> FrameAllocator::heap_bytes;
+uint64_t FrameAllocator::last_frame_arena_bytes = 0;
+uint64_t FrameAllocator::last_frame_heap_bytes = 0;
+
+namespace {
+
+// Every allocation is preceded by its size, with the highest bit telling if it comes from the heap.
+static constexpr size_t FRAME_HEADER_SIZE = alignof(max_align_t) > sizeof(uint64_t) ? alignof(max_align_t) : sizeof(uint64_t);
+static constexpr uint64_t FRAME_HEAP_BIT = uint64_t(1) << 63;
+
+struct FrameArena {
+	uint8_t *blocks[FrameAllocator::MAX_BLOCKS] = {};
+	uint32_t block_count = 0;
+	uint32_t block = 0;
+	uint32_t offset = 0;
+	uint8_t *last_alloc = nullptr;
+
+	// Accumulated here to avoid atomics on every allocation. Flushed on rewind.
+	uint64_t arena_bytes = 0;
+	uint64_t heap_bytes = 0;
+
+	~FrameArena() {
+		for (uint32_t i = 0; i < block_count; i++) {
+			Memory::free_static(blocks[i]);
+		}
+	}
+};
+
+static thread_local FrameArena frame_arena;
+
+_FORCE_INLINE_ size_t _frame_align(size_t p_bytes) {
+	return (p_bytes + FRAME_HEADER_SIZE - 1) & ~(FRAME_HEADER_SIZE - 1);
+}
+
+} // namespace
+
+void *FrameAllocator::alloc(size_t p_bytes) {
+	FrameArena &arena = frame_arena;
+	size_t needed = FRAME_HEADER_SIZE + _frame_align(p_bytes);
+
+	if (likely(needed <= BLOCK_SIZE)) {
+		if (unlikely(arena.block_count == 0 || arena.offset + needed > BLOCK_SIZE)) {
+			// Move on to the next block, reusing it if it was already allocated in a previous frame.
+			if (arena.block + 1 < arena.block_count) {
+				arena.block++;
+				arena.offset = 0;
+			} else if (arena.block_count < MAX_BLOCKS) {
+				uint8_t *new_block = (uint8_t *)Memory::alloc_static(BLOCK_SIZE);
+				ERR_FAIL_NULL_V(new_block, nullptr);
+				if (arena.block_count) {
+					arena.block++;
+				}
+				arena.blocks[arena.block_count++] = new_block;
+				arena.offset = 0;
+			} else {
+				needed = 0; // Exhausted.
+			}
+		}
+
+		if (likely(needed)) {
+			uint8_t *mem = arena.blocks[arena.block] + arena.offset;
+			*(uint64_t *)mem = p_bytes;
+			arena.offset += needed;
+			arena.arena_bytes += p_bytes;
+			arena.last_alloc = mem + FRAME_HEADER_SIZE;
+			return arena.last_alloc;
+		}
+	}
+
+	uint8_t *mem = (uint8_t *)Memory::alloc_static(FRAME_HEADER_SIZE + p_bytes);
+	ERR_FAIL_NULL_V(mem, nullptr);
+	*(uint64_t *)mem = p_bytes | FRAME_HEAP_BIT;
+	arena.heap_bytes += p_bytes;
+	return mem + FRAME_HEADER_SIZE;
+}
+
+void *FrameAllocator::realloc(void *p_memory, size_t p_bytes) {
+	if (p_memory == nullptr) {
+		return alloc(p_bytes);
+	}
+	if (p_bytes == 0) {
+		free(p_memory);
+		return nullptr;
+	}
+
+	FrameArena &arena = frame_arena;
+	uint8_t *mem = (uint8_t *)p_memory;
+	uint64_t header = *(uint64_t *)(mem - FRAME_HEADER_SIZE);
+	size_t prev_bytes = header & ~FRAME_HEAP_BIT;
+
+	if (header & FRAME_HEAP_BIT) {
+		uint8_t *new_mem = (uint8_t *)Memory::realloc_static(mem - FRAME_HEADER_SIZE, FRAME_HEADER_SIZE + p_bytes);
+		ERR_FAIL_NULL_V(new_mem, nullptr);
+		*(uint64_t *)new_mem = p_bytes | FRAME_HEAP_BIT;
+		if (p_bytes > prev_bytes) {
+			arena.heap_bytes += p_bytes - prev_bytes;
+		}
+		return new_mem + FRAME_HEADER_SIZE;
+	}
+
+	if (mem == arena.last_alloc) {
+		// Grow or shrink in place if it still fits the block.
+		size_t start = mem - arena.blocks[arena.block];
+		if (start + _frame_align(p_bytes) <= BLOCK_SIZE) {
+			*(uint64_t *)(mem - FRAME_HEADER_SIZE) = p_bytes;
+			arena.offset = start + _frame_align(p_bytes);
+			if (p_bytes > prev_bytes) {
+				arena.arena_bytes += p_bytes - prev_bytes;
+			}
+			return mem;
+		}
+	}
+
+	void *new_mem = alloc(p_bytes);
+	ERR_FAIL_NULL_V(new_mem, nullptr);
+	memcpy(new_mem, mem, MIN(prev_bytes, p_bytes));
+	return new_mem;
+}
+
+void FrameAllocator::free(void *p_memory) {
+	ERR_FAIL_NULL(p_memory);
+
+	FrameArena &arena = frame_arena;
+	uint8_t *mem = (uint8_t *)p_memory;
+	uint64_t header = *(uint64_t *)(mem - FRAME_HEADER_SIZE);
+
+	if (header & FRAME_HEAP_BIT) {
+		Memory::free_static(mem - FRAME_HEADER_SIZE);
+	} else if (mem == arena.last_alloc) {
+		arena.offset = mem - FRAME_HEADER_SIZE - arena.blocks[arena.block];
+		arena.last_alloc = nullptr;
+	}
+}
+
+uint64_t FrameAllocator::get_mark() {
+	const FrameArena &arena = frame_arena;
+	return (uint64_t(arena.block) << 32) | arena.offset;
+}
+
+void FrameAllocator::rewind(uint64_t p_mark) {
+	FrameArena &arena = frame_arena;
+	arena.block = p_mark >> 32;
+	arena.offset = p_mark & UINT32_MAX;
+	arena.last_alloc = nullptr;
+
+	if (arena.arena_bytes || arena.heap_bytes) {
+		_flush_counters(arena.arena_bytes, arena.heap_bytes);
+		arena.arena_bytes = 0;
+		arena.heap_bytes = 0;
+	}
+}
+
+void FrameAllocator::new_frame() {
+	rewind(0);
+
+	uint64_t arena_total = arena_bytes.get();
+	arena_bytes.sub(arena_total);
+	last_frame_arena_bytes = arena_total;
+
+	uint64_t heap_total = heap_bytes.get();
+	heap_bytes.sub(heap_total);
+	last_frame_heap_bytes = heap_total;
+}
+
+void FrameAllocator::_flush_counters(uint64_t p_arena_bytes, uint64_t p_heap_bytes) {
+	arena_bytes.add(p_arena_bytes);
+	heap_bytes.add(p_heap_bytes);
+}
+
 _GlobalNil::_GlobalNil() {
 	left = this;
 	right = this;
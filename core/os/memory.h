@@ -40,8 +40,22 @@
 
 class Memory {
 #ifdef DEBUG_ENABLED
+public:
+	// Return whether the allocation is tracked, so the free callback is called for it.
+	typedef bool (*AllocSampleFunc)(void *p_ptr, size_t p_bytes, void *p_callsite);
+	typedef void (*FreeSampleFunc)(void *p_ptr, size_t p_bytes);
+
+private:
 	static SafeNumeric<uint64_t> mem_usage;
 	static SafeNumeric<uint64_t> max_usage;
+
+	// Sampled allocations are flagged in the size stored in their header.
+	static constexpr uint64_t SAMPLED_BIT = uint64_t(1) << 63;
+	static SafeNumeric<uint32_t> sample_interval;
+	static AllocSampleFunc alloc_sample_func;
+	static FreeSampleFunc free_sample_func;
+
+	static bool _sample_alloc(void *p_ptr, size_t p_bytes, void *p_callsite);
 #endif
 
 	static SafeNumeric<uint64_t> alloc_count;
@@ -89,14 +103,57 @@ public:
 	static uint64_t get_mem_available();
 	static uint64_t get_mem_usage();
 	static uint64_t get_mem_max_usage();
+
+#ifdef DEBUG_ENABLED
+	// Every p_interval-th allocation done by each thread is passed to p_alloc_func. Zero disables sampling.
+	static void set_alloc_sampling(uint32_t p_interval, AllocSampleFunc p_alloc_func, FreeSampleFunc p_free_func);
+#endif
 };
 
 class DefaultAllocator {
 public:
 	_FORCE_INLINE_ static void *alloc(size_t p_memory) { return Memory::alloc_static(p_memory, false); }
+	_FORCE_INLINE_ static void *realloc(void *p_ptr, size_t p_memory) { return Memory::realloc_static(p_ptr, p_memory, false); }
 	_FORCE_INLINE_ static void free(void *p_ptr) { Memory::free_static(p_ptr, false); }
 };
 
+// Bump allocator for temporaries that don't outlive the current frame, with one arena per thread.
+// It follows the same interface as DefaultAllocator, so it can be plugged into containers,
+// like FrameLocalVector or List<T, FrameAllocator>. Freeing is only mandatory for memory that
+// didn't fit in the arena (the containers take care of that), and is otherwise a no-op, unless
+// it's the last allocation, which is then given back to the arena.
+// The main thread arena is reset by Main::iteration() at the start of every frame, and the
+// WorkerThreadPool rewinds the arena of its threads after every task. Other threads have to
+// rewind by themselves (see get_mark()/rewind()); otherwise, once their arena is exhausted,
+// everything is served from the heap.
+class FrameAllocator {
+	static SafeNumeric<uint64_t> arena_bytes;
+	static SafeNumeric<uint64_t> heap_bytes;
+	static uint64_t last_frame_arena_bytes;
+	static uint64_t last_frame_heap_bytes;
+
+	static void _flush_counters(uint64_t p_arena_bytes, uint64_t p_heap_bytes);
+
+public:
+	static constexpr uint32_t BLOCK_SIZE = 256 * 1024;
+	static constexpr uint32_t MAX_BLOCKS = 64;
+
+	static void *alloc(size_t p_bytes);
+	static void *realloc(void *p_memory, size_t p_bytes);
+	static void free(void *p_memory);
+
+	// Everything allocated from the calling thread's arena after get_mark() becomes invalid after rewind().
+	static uint64_t get_mark();
+	static void rewind(uint64_t p_mark);
+
+	// Main thread only.
+	static void new_frame();
+
+	// Bytes served from all the arenas, or from the heap because they were full, during the last frame.
+	static uint64_t get_last_frame_arena_bytes() { return last_frame_arena_bytes; }
+	static uint64_t get_last_frame_heap_bytes() { return last_frame_heap_bytes; }
+};
+
 void *operator new(size_t p_size, const char *p_description); ///< operator new that takes a description and uses MemoryStaticPool
 void *operator new(size_t p_size, void *(*p_allocfunc)(size_t p_size)); ///< operator new that takes a description and uses MemoryStaticPool
 
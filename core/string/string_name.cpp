@@ -67,10 +67,82 @@ StringName _scs_create(const char *p_chr, bool p_static) {
 	return (p_chr[0] ? StringName(StaticCString::create(p_chr), p_static) : StringName());
 }
 
+template <typename T>
+StringName::_Data *StringName::_find(const Shard &p_shard, uint32_t p_hash, const T &p_name) {
+	_Data *d = p_shard.buckets[p_hash & p_shard.mask];
+	while (d) {
+		// compare hash first, and skip names being released, which are waiting for the lock to unlink themselves.
+		if (d->hash == p_hash && d->refcount.get() != 0 && d->operator==(p_name)) {
+			return d;
+		}
+		d = d->next;
+	}
+	return nullptr;
+}
+
+void StringName::_link(Shard &p_shard, _Data *p_data) {
+	if (p_shard.count > p_shard.mask) {
+		// Keep chains short by doubling the buckets, names are relinked in place.
+		uint32_t new_mask = (p_shard.mask << 1) | 1;
+		_Data **new_buckets = memnew_arr(_Data *, new_mask + 1);
+		for (uint32_t i = 0; i <= new_mask; i++) {
+			new_buckets[i] = nullptr;
+		}
+		for (uint32_t i = 0; i <= p_shard.mask; i++) {
+			_Data *d = p_shard.buckets[i];
+			while (d) {
+				_Data *next = d->next;
+				_Data *&bucket = new_buckets[d->hash & new_mask];
+				d->prev = nullptr;
+				d->next = bucket;
+				if (bucket) {
+					bucket->prev = d;
+				}
+				bucket = d;
+				d = next;
+			}
+		}
+		memdelete_arr(p_shard.buckets);
+		p_shard.buckets = new_buckets;
+		p_shard.mask = new_mask;
+	}
+
+	_Data *&bucket = p_shard.buckets[p_data->hash & p_shard.mask];
+	p_data->prev = nullptr;
+	p_data->next = bucket;
+	if (bucket) {
+		bucket->prev = p_data;
+	}
+	bucket = p_data;
+	p_shard.count++;
+}
+
+void StringName::_unlink(Shard &p_shard, _Data *p_data) {
+	if (p_data->prev) {
+		p_data->prev->next = p_data->next;
+	} else {
+		_Data *&bucket = p_shard.buckets[p_data->hash & p_shard.mask];
+		if (bucket != p_data) {
+			ERR_PRINT("BUG!");
+		}
+		bucket = p_data->next;
+	}
+
+	if (p_data->next) {
+		p_data->next->prev = p_data->prev;
+	}
+	p_shard.count--;
+}
+
 void StringName::setup() {
 	ERR_FAIL_COND(configured);
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-		_table[i] = nullptr;
+	for (Shard &shard : _shards) {
+		shard.mask = (1 << STRING_TABLE_BITS) - 1;
+		shard.count = 0;
+		shard.buckets = memnew_arr(_Data *, shard.mask + 1);
+		for (uint32_t i = 0; i <= shard.mask; i++) {
+			shard.buckets[i] = nullptr;
+		}
 	}
 	configured = true;
 }
@@ -81,11 +153,13 @@ void StringName::cleanup() {
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
 		Vector<_Data *> data;
-		for (int i = 0; i < STRING_TABLE_LEN; i++) {
-			_Data *d = _table[i];
-			while (d) {
-				data.push_back(d);
-				d = d->next;
+		for (const Shard &shard : _shards) {
+			for (uint32_t i = 0; i <= shard.mask; i++) {
+				_Data *d = shard.buckets[i];
+				while (d) {
+					data.push_back(d);
+					d = d->next;
+				}
 			}
 		}
 
@@ -108,22 +182,29 @@ void StringName::cleanup() {
 	}
 #endif
 	int lost_strings = 0;
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-		while (_table[i]) {
-			_Data *d = _table[i];
-			if (d->static_count.get() != d->refcount.get()) {
-				lost_strings++;
-
-				if (OS::get_singleton()->is_stdout_verbose()) {
-					String dname = String(d->cname ? d->cname : d->name);
-
-					print_line(vformat("Orphan StringName: %s (static: %d, total: %d)", dname, d->static_count.get(), d->refcount.get()));
+	for (Shard &shard : _shards) {
+		MutexLock shard_lock(shard.mutex);
+		for (uint32_t i = 0; i <= shard.mask; i++) {
+			while (shard.buckets[i]) {
+				_Data *d = shard.buckets[i];
+				if (d->static_count.get() != d->refcount.get()) {
+					lost_strings++;
+
+					if (OS::get_singleton()->is_stdout_verbose()) {
+						String dname = String(d->cname ? d->cname : d->name);
+
+						print_line(vformat("Orphan StringName: %s (static: %d, total: %d)", dname, d->static_count.get(), d->refcount.get()));
+					}
 				}
-			}
 
-			_table[i] = _table[i]->next;
-			memdelete(d);
+				shard.buckets[i] = shard.buckets[i]->next;
+				memdelete(d);
+			}
 		}
+		memdelete_arr(shard.buckets);
+		shard.buckets = nullptr;
+		shard.mask = 0;
+		shard.count = 0;
 	}
 	if (lost_strings) {
 		print_verbose(vformat("StringName: %d unclaimed string names at exit.", lost_strings));
@@ -134,8 +215,10 @@ void StringName::cleanup() {
 void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
+	// Dropping a reference is lock-free, only the last one takes the lock of its shard.
 	if (_data && _data->refcount.unref()) {
-		MutexLock lock(mutex);
+		Shard &shard = _get_shard(_data->hash);
+		MutexLock lock(shard.mutex);
 
 		if (CoreGlobals::leak_reporting_enabled && _data->static_count.get() > 0) {
 			if (_data->cname) {
@@ -144,18 +227,7 @@ void StringName::unref() {
 				ERR_PRINT("BUG: Unreferenced static string to 0: " + String(_data->name));
 			}
 		}
-		if (_data->prev) {
-			_data->prev->next = _data->next;
-		} else {
-			if (_table[_data->idx] != _data) {
-				ERR_PRINT("BUG!");
-			}
-			_table[_data->idx] = _data->next;
-		}
-
-		if (_data->next) {
-			_data->next->prev = _data->prev;
-		}
+		_unlink(shard, _data);
 		memdelete(_data);
 	}
 
@@ -275,21 +347,11 @@ StringName::StringName(const char *p_name, bool p_static) {
 		return; //empty, ignore
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
+	Shard &shard = _get_shard(hash);
+	MutexLock lock(shard.mutex);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->operator==(p_name)) {
-			break;
-		}
-		_data = _data->next;
-	}
+	_data = _find(shard, hash, p_name);
 
 	if (_data && _data->refcount.ref()) {
 		// exists
@@ -309,10 +371,7 @@ StringName::StringName(const char *p_name, bool p_static) {
 	_data->refcount.init();
 	_data->static_count.set(p_static ? 1 : 0);
 	_data->hash = hash;
-	_data->idx = idx;
 	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
 
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
@@ -321,10 +380,7 @@ StringName::StringName(const char *p_name, bool p_static) {
 		_data->static_count.increment();
 	}
 #endif
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
+	_link(shard, _data);
 }
 
 StringName::StringName(const StaticCString &p_static_string, bool p_static) {
@@ -334,21 +390,11 @@ StringName::StringName(const StaticCString &p_static_string, bool p_static) {
 
 	ERR_FAIL_COND(!p_static_string.ptr || !p_static_string.ptr[0]);
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_static_string.ptr);
+	Shard &shard = _get_shard(hash);
+	MutexLock lock(shard.mutex);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->operator==(p_static_string.ptr)) {
-			break;
-		}
-		_data = _data->next;
-	}
+	_data = _find(shard, hash, p_static_string.ptr);
 
 	if (_data && _data->refcount.ref()) {
 		// exists
@@ -368,10 +414,7 @@ StringName::StringName(const StaticCString &p_static_string, bool p_static) {
 	_data->refcount.init();
 	_data->static_count.set(p_static ? 1 : 0);
 	_data->hash = hash;
-	_data->idx = idx;
 	_data->cname = p_static_string.ptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
 		// Keep in memory, force static.
@@ -379,10 +422,7 @@ StringName::StringName(const StaticCString &p_static_string, bool p_static) {
 		_data->static_count.increment();
 	}
 #endif
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
+	_link(shard, _data);
 }
 
 StringName::StringName(const String &p_name, bool p_static) {
@@ -394,19 +434,11 @@ StringName::StringName(const String &p_name, bool p_static) {
 		return;
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = p_name.hash();
-	uint32_t idx = hash & STRING_TABLE_MASK;
+	Shard &shard = _get_shard(hash);
+	MutexLock lock(shard.mutex);
 
-	_data = _table[idx];
-
-	while (_data) {
-		if (_data->hash == hash && _data->operator==(p_name)) {
-			break;
-		}
-		_data = _data->next;
-	}
+	_data = _find(shard, hash, p_name);
 
 	if (_data && _data->refcount.ref()) {
 		// exists
@@ -426,10 +458,7 @@ StringName::StringName(const String &p_name, bool p_static) {
 	_data->refcount.init();
 	_data->static_count.set(p_static ? 1 : 0);
 	_data->hash = hash;
-	_data->idx = idx;
 	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
 		// Keep in memory, force static.
@@ -438,10 +467,7 @@ StringName::StringName(const String &p_name, bool p_static) {
 	}
 #endif
 
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
+	_link(shard, _data);
 }
 
 StringName StringName::search(const char *p_name) {
@@ -452,20 +478,11 @@ StringName StringName::search(const char *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
+	Shard &shard = _get_shard(hash);
+	MutexLock lock(shard.mutex);
 
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->operator==(p_name)) {
-			break;
-		}
-		_data = _data->next;
-	}
+	_Data *_data = _find(shard, hash, p_name);
 
 	if (_data && _data->refcount.ref()) {
 #ifdef DEBUG_ENABLED
@@ -488,21 +505,11 @@ StringName StringName::search(const char32_t *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
+	Shard &shard = _get_shard(hash);
+	MutexLock lock(shard.mutex);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->operator==(p_name)) {
-			break;
-		}
-		_data = _data->next;
-	}
+	_Data *_data = _find(shard, hash, p_name);
 
 	if (_data && _data->refcount.ref()) {
 		return StringName(_data);
@@ -514,21 +521,11 @@ StringName StringName::search(const char32_t *p_name) {
 StringName StringName::search(const String &p_name) {
 	ERR_FAIL_COND_V(p_name.is_empty(), StringName());
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = p_name.hash();
+	Shard &shard = _get_shard(hash);
+	MutexLock lock(shard.mutex);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->operator==(p_name)) {
-			break;
-		}
-		_data = _data->next;
-	}
+	_Data *_data = _find(shard, hash, p_name);
 
 	if (_data && _data->refcount.ref()) {
 #ifdef DEBUG_ENABLED
@@ -45,10 +45,12 @@ struct StaticCString {
 };
 
 class StringName {
+	// The table is split in shards with their own lock and buckets, so that threads
+	// interning different names rarely wait on each other.
 	enum {
-		STRING_TABLE_BITS = 16,
-		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		SHARD_BITS = 6,
+		SHARD_COUNT = 1 << SHARD_BITS,
+		STRING_TABLE_BITS = 10, // Initial bucket count of each shard, grows with the names in it.
 	};
 
 	struct _Data {
@@ -65,14 +67,31 @@ class StringName {
 		bool operator==(const char *p_name) const;
 		bool operator!=(const char *p_name) const;
 
-		int idx = 0;
 		uint32_t hash = 0;
 		_Data *prev = nullptr;
 		_Data *next = nullptr;
 		_Data() {}
 	};
 
-	static inline _Data *_table[STRING_TABLE_LEN];
+	// No default member initializers, they can't be used by the static array below.
+	// Being static, it's zero-initialized anyway, and filled in setup().
+	struct Shard {
+		Mutex mutex;
+		_Data **buckets;
+		uint32_t mask;
+		uint32_t count;
+	};
+
+	static inline Shard _shards[SHARD_COUNT];
+
+	// String hashes are weak in the high bits for short names, mix them before picking a shard.
+	static _FORCE_INLINE_ Shard &_get_shard(uint32_t p_hash) {
+		return _shards[(p_hash * 0x9E3779B9u) >> (32 - SHARD_BITS)];
+	}
+	template <typename T>
+	static _Data *_find(const Shard &p_shard, uint32_t p_hash, const T &p_name);
+	static void _link(Shard &p_shard, _Data *p_data);
+	static void _unlink(Shard &p_shard, _Data *p_data);
 
 	_Data *_data = nullptr;
 
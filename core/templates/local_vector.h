@@ -41,7 +41,8 @@
 
 // If tight, it grows strictly as much as needed.
 // Otherwise, it grows exponentially (the default and what you want in most cases).
-template <typename T, typename U = uint32_t, bool force_trivial = false, bool tight = false>
+// The allocator must provide static realloc() and free().
+template <typename T, typename U = uint32_t, bool force_trivial = false, bool tight = false, typename A = DefaultAllocator>
 class LocalVector {
 private:
 	U count = 0;
@@ -60,7 +61,7 @@ public:
 	_FORCE_INLINE_ void push_back(T p_elem) {
 		if (unlikely(count == capacity)) {
 			capacity = tight ? (capacity + 1) : MAX((U)1, capacity << 1);
-			data = (T *)memrealloc(data, capacity * sizeof(T));
+			data = (T *)A::realloc(data, capacity * sizeof(T));
 			CRASH_COND_MSG(!data, "Out of memory");
 		}
 
@@ -130,7 +131,7 @@ public:
 	_FORCE_INLINE_ void reset() {
 		clear();
 		if (data) {
-			memfree(data);
+			A::free(data);
 			data = nullptr;
 			capacity = 0;
 		}
@@ -141,7 +142,7 @@ public:
 		p_size = tight ? p_size : nearest_power_of_2_templated(p_size);
 		if (p_size > capacity) {
 			capacity = p_size;
-			data = (T *)memrealloc(data, capacity * sizeof(T));
+			data = (T *)A::realloc(data, capacity * sizeof(T));
 			CRASH_COND_MSG(!data, "Out of memory");
 		}
 	}
@@ -158,7 +159,7 @@ public:
 		} else if (p_size > count) {
 			if (unlikely(p_size > capacity)) {
 				capacity = tight ? p_size : nearest_power_of_2_templated(p_size);
-				data = (T *)memrealloc(data, capacity * sizeof(T));
+				data = (T *)A::realloc(data, capacity * sizeof(T));
 				CRASH_COND_MSG(!data, "Out of memory");
 			}
 			if constexpr (!std::is_trivially_constructible_v<T> && !force_trivial) {
@@ -345,4 +346,8 @@ public:
 template <typename T, typename U = uint32_t, bool force_trivial = false>
 using TightLocalVector = LocalVector<T, U, force_trivial, true>;
 
+// Backed by the calling thread's frame arena. Must not outlive the current frame (see FrameAllocator).
+template <typename T, typename U = uint32_t, bool force_trivial = false>
+using FrameLocalVector = LocalVector<T, U, force_trivial, false, FrameAllocator>;
+
 #endif // LOCAL_VECTOR_H
@@ -33,9 +33,11 @@
 
 #include "core/os/memory.h"
 #include "core/os/mutex.h"
+#include "core/os/thread.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/oa_hash_map.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
@@ -67,63 +69,118 @@ public:
 	virtual ~RID_AllocBase() {}
 };
 
+// When THREAD_SAFE, lookups (get_or_null() and owns()) don't lock: chunks are only ever appended
+// to a table allocated upfront, and published after being initialized. Free indices are spread over
+// several free lists picked by the caller thread, so that allocating and freeing from many threads
+// rarely contends on the same lock.
 template <typename T, bool THREAD_SAFE = false>
 class RID_Alloc : public RID_AllocBase {
 	struct Chunk {
 		T data;
-		uint32_t validator;
+		SafeNumeric<uint32_t> validator;
 	};
+
+	static constexpr uint32_t FREE_LIST_COUNT = THREAD_SAFE ? 8 : 1;
+
+	struct FreeList {
+		BinaryMutex mutex;
+		LocalVector<uint32_t> indices; // Used as a stack, the next index to allocate is at the end.
+	};
+
 	Chunk **chunks = nullptr;
-	uint32_t **free_list_chunks = nullptr;
+	FreeList free_lists[FREE_LIST_COUNT];
 
 	uint32_t elements_in_chunk;
-	uint32_t max_alloc = 0;
-	uint32_t alloc_count = 0;
+	SafeNumeric<uint32_t> max_alloc;
+	SafeNumeric<uint32_t> alloc_count;
 	uint32_t chunk_limit = 0;
 
 	const char *description = nullptr;
 
-	mutable Mutex mutex;
+	mutable BinaryMutex chunk_mutex;
 
-	_FORCE_INLINE_ RID _allocate_rid() {
+	_FORCE_INLINE_ FreeList &_get_free_list() {
 		if constexpr (THREAD_SAFE) {
-			mutex.lock();
+			return free_lists[Thread::get_caller_id() % FREE_LIST_COUNT];
+		} else {
+			return free_lists[0];
 		}
+	}
 
-		if (alloc_count == max_alloc) {
-			//allocate a new chunk
-			uint32_t chunk_count = alloc_count == 0 ? 0 : (max_alloc / elements_in_chunk);
-			if (THREAD_SAFE && chunk_count == chunk_limit) {
-				mutex.unlock();
-				if (description != nullptr) {
-					ERR_FAIL_V_MSG(RID(), vformat("Element limit for RID of type '%s' reached.", String(description)));
-				} else {
-					ERR_FAIL_V_MSG(RID(), "Element limit reached.");
+	// Called with the lock of p_free_list held, when it's empty.
+	bool _refill_free_list(FreeList &p_free_list) {
+		if constexpr (THREAD_SAFE) {
+			// Take half the indices of another list, skipping those in use to avoid waiting (and deadlocks).
+			for (FreeList &other : free_lists) {
+				if (&other == &p_free_list || !other.mutex.try_lock()) {
+					continue;
+				}
+				uint32_t available = other.indices.size();
+				uint32_t take = (available + 1) / 2;
+				for (uint32_t i = 0; i < take; i++) {
+					p_free_list.indices.push_back(other.indices[available - take + i]);
+				}
+				other.indices.resize(available - take);
+				other.mutex.unlock();
+				if (take > 0) {
+					return true;
 				}
 			}
 
-			//grow chunks
-			if constexpr (!THREAD_SAFE) {
-				chunks = (Chunk **)memrealloc(chunks, sizeof(Chunk *) * (chunk_count + 1));
-			}
-			chunks[chunk_count] = (Chunk *)memalloc(sizeof(Chunk) * elements_in_chunk); //but don't initialize
-			//grow free lists
-			if constexpr (!THREAD_SAFE) {
-				free_list_chunks = (uint32_t **)memrealloc(free_list_chunks, sizeof(uint32_t *) * (chunk_count + 1));
-			}
-			free_list_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
+			chunk_mutex.lock();
+		}
 
-			//initialize
-			for (uint32_t i = 0; i < elements_in_chunk; i++) {
-				// Don't initialize chunk.
-				chunks[chunk_count][i].validator = 0xFFFFFFFF;
-				free_list_chunks[chunk_count][i] = alloc_count + i;
-			}
+		//allocate a new chunk
+		uint32_t first_index = max_alloc.get();
+		uint32_t chunk_count = first_index / elements_in_chunk;
+		if (THREAD_SAFE && chunk_count == chunk_limit) {
+			chunk_mutex.unlock();
+			return false;
+		}
+
+		//grow chunks
+		if constexpr (!THREAD_SAFE) {
+			chunks = (Chunk **)memrealloc(chunks, sizeof(Chunk *) * (chunk_count + 1));
+		}
+		Chunk *chunk = (Chunk *)memalloc(sizeof(Chunk) * elements_in_chunk); //but don't initialize
+		for (uint32_t i = 0; i < elements_in_chunk; i++) {
+			chunk[i].validator.set(0xFFFFFFFF);
+		}
+		chunks[chunk_count] = chunk;
+
+		// Pushed in reverse, so the lowest index is allocated first.
+		for (uint32_t i = elements_in_chunk; i > 0; i--) {
+			p_free_list.indices.push_back(first_index + i - 1);
+		}
+
+		// Publish the chunk last, lookups only see it once it's initialized.
+		max_alloc.set(first_index + elements_in_chunk);
 
-			max_alloc += elements_in_chunk;
+		if constexpr (THREAD_SAFE) {
+			chunk_mutex.unlock();
 		}
+		return true;
+	}
 
-		uint32_t free_index = free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk];
+	_FORCE_INLINE_ RID _allocate_rid() {
+		FreeList &free_list = _get_free_list();
+		if constexpr (THREAD_SAFE) {
+			free_list.mutex.lock();
+		}
+
+		if (unlikely(free_list.indices.is_empty()) && !_refill_free_list(free_list)) {
+			if constexpr (THREAD_SAFE) {
+				free_list.mutex.unlock();
+			}
+			if (description != nullptr) {
+				ERR_FAIL_V_MSG(RID(), vformat("Element limit for RID of type '%s' reached.", String(description)));
+			} else {
+				ERR_FAIL_V_MSG(RID(), "Element limit reached.");
+			}
+		}
+
+		uint32_t free_index = free_list.indices[free_list.indices.size() - 1];
+		free_list.indices.resize(free_list.indices.size() - 1);
 
 		uint32_t free_chunk = free_index / elements_in_chunk;
 		uint32_t free_element = free_index % elements_in_chunk;
@@ -134,18 +191,33 @@ class RID_Alloc : public RID_AllocBase {
 		id <<= 32;
 		id |= free_index;
 
-		chunks[free_chunk][free_element].validator = validator;
-		chunks[free_chunk][free_element].validator |= 0x80000000; //mark uninitialized bit
+		chunks[free_chunk][free_element].validator.set(validator | 0x80000000); //mark uninitialized bit
 
-		alloc_count++;
+		alloc_count.increment();
 
 		if constexpr (THREAD_SAFE) {
-			mutex.unlock();
+			free_list.mutex.unlock();
 		}
 
 		return _make_from_id(id);
 	}
 
+	void _lock_free_lists() const {
+		if constexpr (THREAD_SAFE) {
+			for (const FreeList &free_list : free_lists) {
+				free_list.mutex.lock();
+			}
+		}
+	}
+
+	void _unlock_free_lists() const {
+		if constexpr (THREAD_SAFE) {
+			for (const FreeList &free_list : free_lists) {
+				free_list.mutex.unlock();
+			}
+		}
+	}
+
 public:
 	RID make_rid() {
 		RID rid = _allocate_rid();
@@ -170,7 +242,7 @@ public:
 
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
+		if (unlikely(idx >= max_alloc.get())) {
 			return nullptr;
 		}
 
@@ -180,19 +252,20 @@ public:
 		uint32_t validator = uint32_t(id >> 32);
 
 		Chunk &c = chunks[idx_chunk][idx_element];
+		uint32_t c_validator = c.validator.get();
 		if (unlikely(p_initialize)) {
-			if (unlikely(!(c.validator & 0x80000000))) {
+			if (unlikely(!(c_validator & 0x80000000))) {
 				ERR_FAIL_V_MSG(nullptr, "Initializing already initialized RID");
 			}
 
-			if (unlikely((c.validator & 0x7FFFFFFF) != validator)) {
+			if (unlikely((c_validator & 0x7FFFFFFF) != validator)) {
 				ERR_FAIL_V_MSG(nullptr, "Attempting to initialize the wrong RID");
 			}
 
-			c.validator &= 0x7FFFFFFF; //initialized
+			c.validator.set(c_validator & 0x7FFFFFFF); //initialized
 
-		} else if (unlikely(c.validator != validator)) {
-			if ((c.validator & 0x80000000) && c.validator != 0xFFFFFFFF) {
+		} else if (unlikely(c_validator != validator)) {
+			if ((c_validator & 0x80000000) && c_validator != 0xFFFFFFFF) {
 				ERR_FAIL_V_MSG(nullptr, "Attempting to use an uninitialized RID");
 			}
 			return nullptr;
@@ -214,16 +287,9 @@ public:
 	}
 
 	_FORCE_INLINE_ bool owns(const RID &p_rid) const {
-		if constexpr (THREAD_SAFE) {
-			mutex.lock();
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
-			}
+		if (unlikely(idx >= max_alloc.get())) {
 			return false;
 		}
 
@@ -232,91 +298,72 @@ public:
 
 		uint32_t validator = uint32_t(id >> 32);
 
-		bool owned = (validator != 0x7FFFFFFF) && (chunks[idx_chunk][idx_element].validator & 0x7FFFFFFF) == validator;
-
-		if constexpr (THREAD_SAFE) {
-			mutex.unlock();
-		}
-
-		return owned;
+		return (validator != 0x7FFFFFFF) && (chunks[idx_chunk][idx_element].validator.get() & 0x7FFFFFFF) == validator;
 	}
 
 	_FORCE_INLINE_ void free(const RID &p_rid) {
-		if constexpr (THREAD_SAFE) {
-			mutex.lock();
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
-			}
-			ERR_FAIL();
-		}
+		ERR_FAIL_COND(idx >= max_alloc.get());
 
 		uint32_t idx_chunk = idx / elements_in_chunk;
 		uint32_t idx_element = idx % elements_in_chunk;
 
 		uint32_t validator = uint32_t(id >> 32);
-		if (unlikely(chunks[idx_chunk][idx_element].validator & 0x80000000)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
-			}
-			ERR_FAIL_MSG("Attempted to free an uninitialized or invalid RID");
-		} else if (unlikely(chunks[idx_chunk][idx_element].validator != validator)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
+		Chunk &c = chunks[idx_chunk][idx_element];
+
+		// Go invalid before destroying the element, so lock-free lookups stop returning it first.
+		// Only one of several concurrent frees of the same RID can succeed.
+		if (unlikely(!c.validator.compare_exchange(validator, 0xFFFFFFFF))) {
+			if (c.validator.get() & 0x80000000) {
+				ERR_FAIL_MSG("Attempted to free an uninitialized or invalid RID");
 			}
 			ERR_FAIL();
 		}
 
-		chunks[idx_chunk][idx_element].data.~T();
-		chunks[idx_chunk][idx_element].validator = 0xFFFFFFFF; // go invalid
+		c.data.~T();
+
+		FreeList &free_list = _get_free_list();
+		if constexpr (THREAD_SAFE) {
+			free_list.mutex.lock();
+		}
 
-		alloc_count--;
-		free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk] = idx;
+		free_list.indices.push_back(idx);
+		alloc_count.decrement();
 
 		if constexpr (THREAD_SAFE) {
-			mutex.unlock();
+			free_list.mutex.unlock();
 		}
 	}
 
 	_FORCE_INLINE_ uint32_t get_rid_count() const {
-		return alloc_count;
+		return alloc_count.get();
 	}
 	void get_owned_list(List<RID> *p_owned) const {
-		if constexpr (THREAD_SAFE) {
-			mutex.lock();
-		}
-		for (size_t i = 0; i < max_alloc; i++) {
-			uint64_t validator = chunks[i / elements_in_chunk][i % elements_in_chunk].validator;
+		_lock_free_lists();
+		uint32_t max = max_alloc.get();
+		for (size_t i = 0; i < max; i++) {
+			uint64_t validator = chunks[i / elements_in_chunk][i % elements_in_chunk].validator.get();
 			if (validator != 0xFFFFFFFF) {
 				p_owned->push_back(_make_from_id((validator << 32) | i));
 			}
 		}
-		if constexpr (THREAD_SAFE) {
-			mutex.unlock();
-		}
+		_unlock_free_lists();
 	}
 
 	//used for fast iteration in the elements or RIDs
 	void fill_owned_buffer(RID *p_rid_buffer) const {
-		if constexpr (THREAD_SAFE) {
-			mutex.lock();
-		}
+		_lock_free_lists();
 		uint32_t idx = 0;
-		for (size_t i = 0; i < max_alloc; i++) {
-			uint64_t validator = chunks[i / elements_in_chunk][i % elements_in_chunk].validator;
+		uint32_t max = max_alloc.get();
+		for (size_t i = 0; i < max; i++) {
+			uint64_t validator = chunks[i / elements_in_chunk][i % elements_in_chunk].validator.get();
 			if (validator != 0xFFFFFFFF) {
 				p_rid_buffer[idx] = _make_from_id((validator << 32) | i);
 				idx++;
 			}
 		}
-
-		if constexpr (THREAD_SAFE) {
-			mutex.unlock();
-		}
+		_unlock_free_lists();
 	}
 
 	void set_description(const char *p_descrption) {
@@ -328,17 +375,17 @@ public:
 		if constexpr (THREAD_SAFE) {
 			chunk_limit = (p_maximum_number_of_elements / elements_in_chunk) + 1;
 			chunks = (Chunk **)memalloc(sizeof(Chunk *) * chunk_limit);
-			free_list_chunks = (uint32_t **)memalloc(sizeof(uint32_t *) * chunk_limit);
 		}
 	}
 
 	~RID_Alloc() {
-		if (alloc_count) {
+		uint32_t max = max_alloc.get();
+		if (alloc_count.get()) {
 			print_error(vformat("ERROR: %d RID allocations of type '%s' were leaked at exit.",
-					alloc_count, description ? description : typeid(T).name()));
+					alloc_count.get(), description ? description : typeid(T).name()));
 
-			for (size_t i = 0; i < max_alloc; i++) {
-				uint64_t validator = chunks[i / elements_in_chunk][i % elements_in_chunk].validator;
+			for (size_t i = 0; i < max; i++) {
+				uint64_t validator = chunks[i / elements_in_chunk][i % elements_in_chunk].validator.get();
 				if (validator & 0x80000000) {
 					continue; //uninitialized
 				}
@@ -348,15 +395,13 @@ public:
 			}
 		}
 
-		uint32_t chunk_count = max_alloc / elements_in_chunk;
+		uint32_t chunk_count = max / elements_in_chunk;
 		for (uint32_t i = 0; i < chunk_count; i++) {
 			memfree(chunks[i]);
-			memfree(free_list_chunks[i]);
 		}
 
 		if (chunks) {
 			memfree(chunks);
-			memfree(free_list_chunks);
 		}
 	}
 };
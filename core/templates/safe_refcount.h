@@ -134,6 +134,11 @@ public:
 		}
 	}
 
+	// Only sets p_value if the current value is p_expected. Returns whether it did.
+	_ALWAYS_INLINE_ bool compare_exchange(T p_expected, T p_value) {
+		return value.compare_exchange_strong(p_expected, p_value, std::memory_order_acq_rel);
+	}
+
 	_ALWAYS_INLINE_ T conditional_increment() {
 		while (true) {
 			T c = value.load(std::memory_order_acquire);
@@ -0,0 +1,321 @@
+/**************************************************************************/
+/*  small_vector.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include "core/error/error_macros.h"
+#include "core/os/memory.h"
+#include "core/templates/vector.h"
+
+#include <initializer_list>
+#include <type_traits>
+
+// Vector with inline storage for up to N elements, so that tiny arrays don't allocate.
+// Growing past N moves the elements to a copy-on-write Vector, which is kept even if
+// the size drops back under N. Converting to Vector shares that storage, so it only
+// copies while the elements are still inline.
+template <typename T, uint32_t N>
+class SmallVector {
+	static_assert(N > 0, "SmallVector needs at least one inline element, use Vector otherwise.");
+
+public:
+	typedef typename Vector<T>::Size Size;
+
+private:
+	alignas(T) uint8_t inline_data[sizeof(T) * N];
+	uint32_t inline_count = 0;
+	bool spilled = false;
+	Vector<T> heap;
+
+	_FORCE_INLINE_ T *_inline_ptr() { return reinterpret_cast<T *>(inline_data); }
+	_FORCE_INLINE_ const T *_inline_ptr() const { return reinterpret_cast<const T *>(inline_data); }
+
+	void _destroy_inline(uint32_t p_from) {
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			T *data = _inline_ptr();
+			for (uint32_t i = p_from; i < inline_count; i++) {
+				data[i].~T();
+			}
+		}
+		inline_count = p_from;
+	}
+
+	// Moves the inline elements to the heap, reserving room for p_size elements.
+	void _spill(Size p_size) {
+		heap.resize(p_size);
+		T *w = heap.ptrw();
+		const T *r = _inline_ptr();
+		for (uint32_t i = 0; i < inline_count; i++) {
+			w[i] = r[i];
+		}
+		_destroy_inline(0);
+		spilled = true;
+	}
+
+	void _copy_from(const SmallVector &p_from) {
+		if (p_from.spilled) {
+			heap = p_from.heap;
+			spilled = true;
+			return;
+		}
+		const T *r = p_from._inline_ptr();
+		for (uint32_t i = 0; i < p_from.inline_count; i++) {
+			memnew_placement(&_inline_ptr()[i], T(r[i]));
+		}
+		inline_count = p_from.inline_count;
+	}
+
+public:
+	_FORCE_INLINE_ T *ptrw() { return spilled ? heap.ptrw() : _inline_ptr(); }
+	_FORCE_INLINE_ const T *ptr() const { return spilled ? heap.ptr() : _inline_ptr(); }
+	_FORCE_INLINE_ Size size() const { return spilled ? heap.size() : Size(inline_count); }
+	_FORCE_INLINE_ bool is_empty() const { return size() == 0; }
+	_FORCE_INLINE_ bool is_inline() const { return !spilled; }
+	static constexpr uint32_t get_inline_capacity() { return N; }
+
+	_FORCE_INLINE_ void push_back(const T &p_elem) {
+		if (likely(!spilled && inline_count < N)) {
+			memnew_placement(&_inline_ptr()[inline_count++], T(p_elem));
+			return;
+		}
+		if (!spilled) {
+			// p_elem may be one of the inline elements, copy it before they are destroyed.
+			T elem = p_elem;
+			_spill(inline_count + 1);
+			heap.set(N, elem);
+			return;
+		}
+		heap.push_back(p_elem);
+	}
+	_FORCE_INLINE_ void append(const T &p_elem) { push_back(p_elem); } //alias
+
+	Error insert(Size p_pos, const T &p_val) {
+		if (spilled) {
+			return heap.insert(p_pos, p_val);
+		}
+		ERR_FAIL_INDEX_V(p_pos, Size(inline_count) + 1, ERR_INVALID_PARAMETER);
+		if (inline_count == N) {
+			// p_val may be one of the inline elements, copy it before they are destroyed.
+			T val = p_val;
+			_spill(inline_count);
+			return heap.insert(p_pos, val);
+		}
+		T *data = _inline_ptr();
+		if (p_pos == Size(inline_count)) {
+			memnew_placement(&data[inline_count], T(p_val));
+		} else {
+			T val = p_val;
+			memnew_placement(&data[inline_count], T(data[inline_count - 1]));
+			for (uint32_t i = inline_count - 1; i > uint32_t(p_pos); i--) {
+				data[i] = data[i - 1];
+			}
+			data[p_pos] = val;
+		}
+		inline_count++;
+		return OK;
+	}
+
+	void ordered_insert(const T &p_val) {
+		const T *data = ptr();
+		const Size count = size();
+		Size i;
+		for (i = 0; i < count; i++) {
+			if (p_val < data[i]) {
+				break;
+			}
+		}
+		insert(i, p_val);
+	}
+
+	void remove_at(Size p_index) {
+		if (spilled) {
+			heap.remove_at(p_index);
+			return;
+		}
+		ERR_FAIL_INDEX(p_index, Size(inline_count));
+		T *data = _inline_ptr();
+		for (uint32_t i = p_index; i + 1 < inline_count; i++) {
+			data[i] = data[i + 1];
+		}
+		_destroy_inline(inline_count - 1);
+	}
+
+	bool erase(const T &p_val) {
+		Size idx = find(p_val);
+		if (idx >= 0) {
+			remove_at(idx);
+			return true;
+		}
+		return false;
+	}
+
+	Error resize(Size p_size) {
+		ERR_FAIL_COND_V(p_size < 0, ERR_INVALID_PARAMETER);
+		if (spilled) {
+			return heap.resize(p_size);
+		}
+		if (p_size > Size(N)) {
+			_spill(p_size);
+			return OK;
+		}
+		if (p_size < Size(inline_count)) {
+			_destroy_inline(p_size);
+		} else {
+			T *data = _inline_ptr();
+			for (uint32_t i = inline_count; i < p_size; i++) {
+				if constexpr (std::is_trivially_constructible_v<T>) {
+					data[i] = T();
+				} else {
+					memnew_placement(&data[i], T);
+				}
+			}
+			inline_count = p_size;
+		}
+		return OK;
+	}
+
+	// Goes back to inline storage, releasing the heap copy if any.
+	void clear() {
+		if (spilled) {
+			heap.clear();
+			spilled = false;
+		} else {
+			_destroy_inline(0);
+		}
+	}
+
+	Size find(const T &p_val, Size p_from = 0) const {
+		const T *data = ptr();
+		const Size count = size();
+		for (Size i = MAX(p_from, Size(0)); i < count; i++) {
+			if (data[i] == p_val) {
+				return i;
+			}
+		}
+		return -1;
+	}
+	_FORCE_INLINE_ bool has(const T &p_val) const { return find(p_val) != -1; }
+
+	void sort() {
+		sort_custom<_DefaultComparator<T>>();
+	}
+
+	template <typename Comparator, bool Validate = SORT_ARRAY_VALIDATE_ENABLED, typename... Args>
+	void sort_custom(Args &&...args) {
+		const Size len = size();
+		if (len == 0) {
+			return;
+		}
+		SortArray<T, Comparator, Validate> sorter{ args... };
+		sorter.sort(ptrw(), len);
+	}
+
+	_FORCE_INLINE_ const T &get(Size p_index) const {
+		CRASH_BAD_INDEX(p_index, size());
+		return ptr()[p_index];
+	}
+	_FORCE_INLINE_ void set(Size p_index, const T &p_elem) {
+		ERR_FAIL_INDEX(p_index, size());
+		ptrw()[p_index] = p_elem;
+	}
+	_FORCE_INLINE_ const T &operator[](Size p_index) const {
+		CRASH_BAD_INDEX(p_index, size());
+		return ptr()[p_index];
+	}
+	_FORCE_INLINE_ T &operator[](Size p_index) {
+		CRASH_BAD_INDEX(p_index, size());
+		return ptrw()[p_index];
+	}
+
+	void append_array(const Vector<T> &p_other) {
+		const Size ds = p_other.size();
+		for (Size i = 0; i < ds; i++) {
+			push_back(p_other[i]);
+		}
+	}
+
+	// Shares the heap storage when spilled, copies the inline elements otherwise.
+	Vector<T> to_vector() const {
+		if (spilled) {
+			return heap;
+		}
+		Vector<T> ret;
+		ret.resize(inline_count);
+		T *w = ret.ptrw();
+		for (uint32_t i = 0; i < inline_count; i++) {
+			w[i] = _inline_ptr()[i];
+		}
+		return ret;
+	}
+	operator Vector<T>() const { return to_vector(); }
+
+	_FORCE_INLINE_ T *begin() { return ptrw(); }
+	_FORCE_INLINE_ T *end() { return ptrw() + size(); }
+	_FORCE_INLINE_ const T *begin() const { return ptr(); }
+	_FORCE_INLINE_ const T *end() const { return ptr() + size(); }
+
+	void operator=(const SmallVector &p_from) {
+		if (this == &p_from) {
+			return;
+		}
+		clear();
+		_copy_from(p_from);
+	}
+
+	// Takes a reference to the Vector storage instead of copying it, even for small sizes.
+	void operator=(const Vector<T> &p_from) {
+		clear();
+		if (!p_from.is_empty()) {
+			heap = p_from;
+			spilled = true;
+		}
+	}
+
+	_FORCE_INLINE_ SmallVector() {}
+	_FORCE_INLINE_ SmallVector(std::initializer_list<T> p_init) {
+		for (const T &element : p_init) {
+			push_back(element);
+		}
+	}
+	SmallVector(const SmallVector &p_from) { _copy_from(p_from); }
+	SmallVector(const Vector<T> &p_from) {
+		if (!p_from.is_empty()) {
+			heap = p_from;
+			spilled = true;
+		}
+	}
+
+	_FORCE_INLINE_ ~SmallVector() {
+		_destroy_inline(0);
+	}
+};
+
+#endif // SMALL_VECTOR_H
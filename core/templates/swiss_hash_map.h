@@ -0,0 +1,549 @@
+/**************************************************************************/
+/*  swiss_hash_map.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SWISS_HASH_MAP_H
+#define SWISS_HASH_MAP_H
+
+#include "core/os/memory.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/pair.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SWISS_HASH_MAP_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#define SWISS_HASH_MAP_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/**
+ * A HashMap implementation in the style of Swiss tables.
+ *
+ * Key/value pairs are stored inline in a single slot array, next to an array
+ * of one control byte per slot. A control byte is either empty, deleted, or
+ * holds the lowest 7 bits of the hash of the key in that slot. Lookups probe
+ * groups of 16 control bytes at a time (using SSE2 or NEON when available) and
+ * only compare keys whose 7 bits match, so most misses never touch the slots.
+ *
+ * It has the same API as HashMap with two differences: iteration follows slot
+ * order instead of insertion order, and inserting may invalidate iterators
+ * and pointers to values. Erasing never moves other elements, so it is safe to
+ * erase the element being iterated. Use HashMap when the order matters.
+ *
+ * The assignment operator copy the pairs from one map to the other.
+ */
+
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class SwissHashMap {
+public:
+	static constexpr uint32_t GROUP_SIZE = 16;
+	static constexpr uint32_t MIN_CAPACITY = GROUP_SIZE; // Must be a power of two.
+
+private:
+	typedef KeyValue<TKey, TValue> Slot;
+
+	static constexpr int8_t CTRL_EMPTY = -128;
+	static constexpr int8_t CTRL_DELETED = -2;
+
+	struct Group {
+#if defined(SWISS_HASH_MAP_SSE2)
+		typedef uint32_t Mask;
+		static constexpr uint32_t MASK_SHIFT = 0; // One bit per control byte.
+		__m128i ctrl;
+
+		_FORCE_INLINE_ explicit Group(const int8_t *p_ctrl) { ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_ctrl)); }
+		_FORCE_INLINE_ Mask match(int8_t p_h2) const { return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(p_h2), ctrl)); }
+		// Empty and deleted are the only negative control bytes.
+		_FORCE_INLINE_ Mask match_empty_or_deleted() const { return _mm_movemask_epi8(ctrl); }
+#elif defined(SWISS_HASH_MAP_NEON)
+		typedef uint64_t Mask;
+		static constexpr uint32_t MASK_SHIFT = 2; // One nibble per control byte, only its top bit is kept.
+		int8x16_t ctrl;
+
+		static _FORCE_INLINE_ Mask _to_mask(uint8x16_t p_cmp) {
+			uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(p_cmp), 4);
+			return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ull;
+		}
+
+		_FORCE_INLINE_ explicit Group(const int8_t *p_ctrl) { ctrl = vld1q_s8(p_ctrl); }
+		_FORCE_INLINE_ Mask match(int8_t p_h2) const { return _to_mask(vceqq_s8(vdupq_n_s8(p_h2), ctrl)); }
+		_FORCE_INLINE_ Mask match_empty_or_deleted() const { return _to_mask(vcltq_s8(ctrl, vdupq_n_s8(0))); }
+#else
+		typedef uint32_t Mask;
+		static constexpr uint32_t MASK_SHIFT = 0;
+		const int8_t *ctrl;
+
+		_FORCE_INLINE_ explicit Group(const int8_t *p_ctrl) { ctrl = p_ctrl; }
+		_FORCE_INLINE_ Mask match(int8_t p_h2) const {
+			Mask mask = 0;
+			for (uint32_t i = 0; i < GROUP_SIZE; i++) {
+				mask |= Mask(ctrl[i] == p_h2) << i;
+			}
+			return mask;
+		}
+		_FORCE_INLINE_ Mask match_empty_or_deleted() const {
+			Mask mask = 0;
+			for (uint32_t i = 0; i < GROUP_SIZE; i++) {
+				mask |= Mask(ctrl[i] < 0) << i;
+			}
+			return mask;
+		}
+#endif
+		_FORCE_INLINE_ Mask match_empty() const { return match(CTRL_EMPTY); }
+	};
+
+	// One control byte per slot, followed by a copy of the first GROUP_SIZE - 1
+	// bytes so that a group can be loaded from any position without wrapping.
+	int8_t *ctrl = nullptr;
+	KeyValue<TKey, TValue> *slots = nullptr;
+
+	uint32_t capacity = 0;
+	uint32_t num_elements = 0;
+	uint32_t growth_left = 0; // Empty slots that can be used before rehashing, deleted ones don't count.
+
+	static _FORCE_INLINE_ uint32_t _first_index(uint64_t p_mask, uint32_t p_shift) {
+#if defined(_MSC_VER) && !defined(__clang__)
+		unsigned long index;
+		if (_BitScanForward(&index, (unsigned long)p_mask)) {
+			return index >> p_shift;
+		}
+		_BitScanForward(&index, (unsigned long)(p_mask >> 32));
+		return (index + 32) >> p_shift;
+#else
+		return __builtin_ctzll(p_mask) >> p_shift;
+#endif
+	}
+
+	static _FORCE_INLINE_ uint32_t _max_load(uint32_t p_capacity) {
+		return p_capacity - p_capacity / 8;
+	}
+
+	static _FORCE_INLINE_ int8_t _h2(uint32_t p_hash) {
+		return int8_t(p_hash & 0x7F);
+	}
+
+	_FORCE_INLINE_ void _set_ctrl(uint32_t p_index, int8_t p_value) {
+		ctrl[p_index] = p_value;
+		ctrl[((p_index - (GROUP_SIZE - 1)) & (capacity - 1)) + (GROUP_SIZE - 1)] = p_value;
+	}
+
+	bool _lookup_pos(const TKey &p_key, uint32_t &r_pos) const {
+		if (num_elements == 0) {
+			return false; // Failed lookups, no elements
+		}
+
+		const uint32_t hash = Hasher::hash(p_key);
+		const int8_t h2 = _h2(hash);
+		const uint32_t mask = capacity - 1;
+		uint32_t pos = (hash >> 7) & mask;
+		uint32_t step = 0;
+
+		while (true) {
+			Group group(ctrl + pos);
+			for (typename Group::Mask match = group.match(h2); match; match &= match - 1) {
+				uint32_t index = (pos + _first_index(match, Group::MASK_SHIFT)) & mask;
+				if (likely(Comparator::compare(slots[index].key, p_key))) {
+					r_pos = index;
+					return true;
+				}
+			}
+
+			if (group.match_empty()) {
+				return false;
+			}
+
+			// Triangular probing over groups, visits every slot when the capacity is a power of two.
+			step += GROUP_SIZE;
+			pos = (pos + step) & mask;
+		}
+	}
+
+	uint32_t _find_free_pos(uint32_t p_hash) const {
+		const uint32_t mask = capacity - 1;
+		uint32_t pos = (p_hash >> 7) & mask;
+		uint32_t step = 0;
+
+		while (true) {
+			typename Group::Mask free = Group(ctrl + pos).match_empty_or_deleted();
+			if (free) {
+				return (pos + _first_index(free, Group::MASK_SHIFT)) & mask;
+			}
+			step += GROUP_SIZE;
+			pos = (pos + step) & mask;
+		}
+	}
+
+	void _resize_and_rehash(uint32_t p_new_capacity) {
+		int8_t *old_ctrl = ctrl;
+		KeyValue<TKey, TValue> *old_slots = slots;
+		uint32_t old_capacity = capacity;
+
+		capacity = p_new_capacity;
+		ctrl = reinterpret_cast<int8_t *>(Memory::alloc_static(capacity + GROUP_SIZE));
+		slots = reinterpret_cast<KeyValue<TKey, TValue> *>(Memory::alloc_static(sizeof(KeyValue<TKey, TValue>) * capacity));
+		memset(ctrl, CTRL_EMPTY, capacity + GROUP_SIZE);
+		growth_left = _max_load(capacity) - num_elements;
+
+		if (old_ctrl == nullptr) {
+			return;
+		}
+
+		for (uint32_t i = 0; i < old_capacity; i++) {
+			if (old_ctrl[i] < 0) {
+				continue;
+			}
+			const uint32_t hash = Hasher::hash(old_slots[i].key);
+			const uint32_t pos = _find_free_pos(hash);
+			memnew_placement(&slots[pos], Slot(old_slots[i]));
+			old_slots[i].~KeyValue<TKey, TValue>();
+			_set_ctrl(pos, _h2(hash));
+		}
+
+		Memory::free_static(old_ctrl);
+		Memory::free_static(old_slots);
+	}
+
+	// Returns capacity when the table can't grow anymore.
+	uint32_t _insert_new(const TKey &p_key, const TValue &p_value) {
+		if (unlikely(growth_left == 0)) {
+			if (capacity == 0) {
+				_resize_and_rehash(MIN_CAPACITY);
+			} else if (num_elements <= _max_load(capacity) / 2) {
+				// Mostly deleted slots, rehashing in place reclaims them.
+				_resize_and_rehash(capacity);
+			} else {
+				ERR_FAIL_COND_V_MSG(capacity > (UINT32_MAX >> 1), capacity, "Hash table maximum capacity reached, aborting insertion.");
+				_resize_and_rehash(capacity * 2);
+			}
+		}
+
+		const uint32_t hash = Hasher::hash(p_key);
+		const uint32_t pos = _find_free_pos(hash);
+		if (ctrl[pos] == CTRL_EMPTY) {
+			growth_left--;
+		}
+		memnew_placement(&slots[pos], Slot(p_key, p_value));
+		_set_ctrl(pos, _h2(hash));
+		num_elements++;
+		return pos;
+	}
+
+	_FORCE_INLINE_ uint32_t _insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t pos = 0;
+		if (_lookup_pos(p_key, pos)) {
+			slots[pos].value = p_value;
+			return pos;
+		}
+		return _insert_new(p_key, p_value);
+	}
+
+	void _erase_pos(uint32_t p_pos) {
+		slots[p_pos].~KeyValue<TKey, TValue>();
+		_set_ctrl(p_pos, CTRL_DELETED);
+		num_elements--;
+	}
+
+	void _copy_from(const SwissHashMap &p_other) {
+		capacity = p_other.capacity;
+		num_elements = p_other.num_elements;
+		growth_left = p_other.growth_left;
+		if (p_other.ctrl == nullptr) {
+			return;
+		}
+
+		ctrl = reinterpret_cast<int8_t *>(Memory::alloc_static(capacity + GROUP_SIZE));
+		slots = reinterpret_cast<KeyValue<TKey, TValue> *>(Memory::alloc_static(sizeof(KeyValue<TKey, TValue>) * capacity));
+		memcpy(ctrl, p_other.ctrl, capacity + GROUP_SIZE);
+		for (uint32_t i = 0; i < capacity; i++) {
+			if (ctrl[i] >= 0) {
+				memnew_placement(&slots[i], Slot(p_other.slots[i]));
+			}
+		}
+	}
+
+	void _free() {
+		clear();
+		if (ctrl != nullptr) {
+			Memory::free_static(ctrl);
+			Memory::free_static(slots);
+			ctrl = nullptr;
+			slots = nullptr;
+		}
+		capacity = 0;
+		growth_left = 0;
+	}
+
+	_FORCE_INLINE_ uint32_t _next_full(uint32_t p_index) const {
+		while (p_index < capacity && ctrl[p_index] < 0) {
+			p_index++;
+		}
+		return p_index;
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t get_capacity() const { return capacity; }
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+
+	/* Standard Godot Container API */
+
+	bool is_empty() const {
+		return num_elements == 0;
+	}
+
+	void clear() {
+		if (ctrl == nullptr) {
+			return;
+		}
+		if (num_elements != 0) {
+			for (uint32_t i = 0; i < capacity; i++) {
+				if (ctrl[i] >= 0) {
+					slots[i].~KeyValue<TKey, TValue>();
+				}
+			}
+		}
+		memset(ctrl, CTRL_EMPTY, capacity + GROUP_SIZE);
+		num_elements = 0;
+		growth_left = _max_load(capacity);
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return slots[pos].value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return slots[pos].value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t pos = 0;
+		if (_lookup_pos(p_key, pos)) {
+			return &slots[pos].value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t pos = 0;
+		if (_lookup_pos(p_key, pos)) {
+			return &slots[pos].value;
+		}
+		return nullptr;
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		uint32_t _pos = 0;
+		return _lookup_pos(p_key, _pos);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t pos = 0;
+		if (!_lookup_pos(p_key, pos)) {
+			return false;
+		}
+		_erase_pos(pos);
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	void reserve(uint32_t p_new_capacity) {
+		uint32_t new_capacity = MAX(capacity, MIN_CAPACITY);
+		while (_max_load(new_capacity) < p_new_capacity) {
+			ERR_FAIL_COND_MSG(new_capacity > (UINT32_MAX >> 1), "Hash table maximum capacity reached, aborting reserve.");
+			new_capacity *= 2;
+		}
+		if (new_capacity != capacity) {
+			_resize_and_rehash(new_capacity);
+		}
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> &operator*() const {
+			return map->slots[index];
+		}
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> *operator->() const { return &map->slots[index]; }
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			if (map) {
+				index = map->_next_full(index + 1);
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return index == b.index; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return index != b.index; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return map != nullptr && index < map->capacity;
+		}
+
+		_FORCE_INLINE_ ConstIterator(const SwissHashMap *p_map, uint32_t p_index) {
+			map = p_map;
+			index = p_index;
+		}
+		_FORCE_INLINE_ ConstIterator() {}
+
+	private:
+		const SwissHashMap *map = nullptr;
+		uint32_t index = 0;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ KeyValue<TKey, TValue> &operator*() const {
+			return map->slots[index];
+		}
+		_FORCE_INLINE_ KeyValue<TKey, TValue> *operator->() const { return &map->slots[index]; }
+		_FORCE_INLINE_ Iterator &operator++() {
+			if (map) {
+				index = map->_next_full(index + 1);
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return index == b.index; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return index != b.index; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return map != nullptr && index < map->capacity;
+		}
+
+		_FORCE_INLINE_ Iterator(SwissHashMap *p_map, uint32_t p_index) {
+			map = p_map;
+			index = p_index;
+		}
+		_FORCE_INLINE_ Iterator() {}
+
+		operator ConstIterator() const {
+			return ConstIterator(map, index);
+		}
+
+	private:
+		friend class SwissHashMap;
+		SwissHashMap *map = nullptr;
+		uint32_t index = 0;
+	};
+
+	_FORCE_INLINE_ Iterator begin() {
+		return Iterator(this, _next_full(0));
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator(this, capacity);
+	}
+
+	_FORCE_INLINE_ Iterator find(const TKey &p_key) {
+		uint32_t pos = 0;
+		if (!_lookup_pos(p_key, pos)) {
+			return end();
+		}
+		return Iterator(this, pos);
+	}
+
+	_FORCE_INLINE_ void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			_erase_pos(p_iter.index);
+		}
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(this, _next_full(0));
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator(this, capacity);
+	}
+
+	_FORCE_INLINE_ ConstIterator find(const TKey &p_key) const {
+		uint32_t pos = 0;
+		if (!_lookup_pos(p_key, pos)) {
+			return end();
+		}
+		return ConstIterator(this, pos);
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND(!exists);
+		return slots[pos].value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		uint32_t pos = 0;
+		if (!_lookup_pos(p_key, pos)) {
+			pos = _insert_new(p_key, TValue());
+		}
+		return slots[pos].value;
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t pos = _insert(p_key, p_value);
+		return pos < capacity ? Iterator(this, pos) : end();
+	}
+
+	/* Constructors */
+
+	SwissHashMap(const SwissHashMap &p_other) {
+		_copy_from(p_other);
+	}
+
+	void operator=(const SwissHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+		_free();
+		_copy_from(p_other);
+	}
+
+	SwissHashMap(uint32_t p_initial_capacity) {
+		reserve(p_initial_capacity);
+	}
+	SwissHashMap() {}
+
+	~SwissHashMap() {
+		_free();
+	}
+};
+
+#endif // SWISS_HASH_MAP_H
@@ -0,0 +1,124 @@
+/**************************************************************************/
+/*  work_stealing_deque.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef WORK_STEALING_DEQUE_H
+#define WORK_STEALING_DEQUE_H
+
+#include "core/typedefs.h"
+
+#include <atomic>
+
+// Bounded single-producer, multi-consumer deque (Chase-Lev).
+// The owner thread pushes and pops at the bottom (LIFO), while any other thread
+// may steal from the top (FIFO). The owner never blocks on thieves and thieves
+// only contend among themselves on a single CAS.
+// Being bounded, the ring is never reallocated, so no memory reclamation scheme
+// is needed; push() fails when full and the caller must use some other queue.
+
+template <typename T, uint32_t CAPACITY = 256>
+class WorkStealingDeque {
+	static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "Capacity must be a power of two.");
+	static constexpr int64_t MASK = CAPACITY - 1;
+
+	// Padded apart so thieves hitting top don't invalidate the line the owner keeps bottom in.
+	// Not using alignas() because instances may live in memory from Memory::alloc_static().
+	std::atomic<int64_t> top = 0;
+	uint8_t _top_padding[64 - sizeof(std::atomic<int64_t>)];
+	std::atomic<int64_t> bottom = 0;
+	uint8_t _bottom_padding[64 - sizeof(std::atomic<int64_t>)];
+	std::atomic<T *> buffer[CAPACITY] = {};
+
+public:
+	// Owner thread only.
+	_FORCE_INLINE_ bool push(T *p_value) {
+		int64_t b = bottom.load(std::memory_order_relaxed);
+		int64_t t = top.load(std::memory_order_acquire);
+		if (b - t >= (int64_t)CAPACITY) {
+			return false;
+		}
+		buffer[b & MASK].store(p_value, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	// Owner thread only.
+	_FORCE_INLINE_ T *pop() {
+		int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t t = top.load(std::memory_order_relaxed);
+
+		if (t > b) {
+			// Empty.
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		T *value = buffer[b & MASK].load(std::memory_order_relaxed);
+		if (t == b) {
+			// Last element, race against thieves for it.
+			if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+				value = nullptr;
+			}
+			bottom.store(b + 1, std::memory_order_relaxed);
+		}
+		return value;
+	}
+
+	// Any thread. May spuriously return null if another thief wins the race,
+	// so check is_empty() before giving up.
+	_FORCE_INLINE_ T *steal() {
+		int64_t t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t b = bottom.load(std::memory_order_acquire);
+
+		if (t >= b) {
+			return nullptr;
+		}
+
+		T *value = buffer[t & MASK].load(std::memory_order_relaxed);
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			return nullptr;
+		}
+		return value;
+	}
+
+	// Any thread. Only a hint unless called by the owner.
+	_FORCE_INLINE_ bool is_empty() const {
+		int64_t b = bottom.load(std::memory_order_acquire);
+		int64_t t = top.load(std::memory_order_acquire);
+		return b <= t;
+	}
+
+	_FORCE_INLINE_ uint32_t get_capacity() const { return CAPACITY; }
+};
+
+#endif // WORK_STEALING_DEQUE_H
@@ -34,6 +34,7 @@
 #include "core/debugger/engine_debugger.h"
 #include "core/io/compression.h"
 #include "core/io/marshalls.h"
+#include "core/math/bulk_math.h"
 #include "core/object/class_db.h"
 #include "core/os/os.h"
 #include "core/templates/local_vector.h"
@@ -1034,6 +1035,73 @@ struct _VariantCall {
 		return len;
 	}
 
+#define VARCALL_PACKED_BULK_MATH(m_packed_type, m_type)                                                                    \
+	static void func_##m_packed_type##_add_array(m_packed_type *p_instance, const m_packed_type &p_values) {               \
+		ERR_FAIL_COND_MSG(p_instance->size() != p_values.size(), "Both arrays must have the same size.");                  \
+		m_type *w = p_instance->ptrw();                                                                                    \
+		BulkMath::add(w, p_values.ptr(), p_values.size());                                                                 \
+	}                                                                                                                      \
+	static void func_##m_packed_type##_multiply_array(m_packed_type *p_instance, const m_packed_type &p_values) {          \
+		ERR_FAIL_COND_MSG(p_instance->size() != p_values.size(), "Both arrays must have the same size.");                  \
+		m_type *w = p_instance->ptrw();                                                                                    \
+		BulkMath::multiply(w, p_values.ptr(), p_values.size());                                                            \
+	}                                                                                                                      \
+	static void func_##m_packed_type##_lerp_array(m_packed_type *p_instance, const m_packed_type &p_to, double p_weight) { \
+		ERR_FAIL_COND_MSG(p_instance->size() != p_to.size(), "Both arrays must have the same size.");                      \
+		m_type *w = p_instance->ptrw();                                                                                    \
+		BulkMath::lerp(w, p_to.ptr(), (m_type)p_weight, p_to.size());                                                      \
+	}                                                                                                                      \
+	static void func_##m_packed_type##_clamp(m_packed_type *p_instance, double p_min, double p_max) {                      \
+		BulkMath::clamp(p_instance->ptrw(), (m_type)p_min, (m_type)p_max, p_instance->size());                             \
+	}                                                                                                                      \
+	static double func_##m_packed_type##_dot(m_packed_type *p_instance, const m_packed_type &p_values) {                   \
+		ERR_FAIL_COND_V_MSG(p_instance->size() != p_values.size(), 0.0, "Both arrays must have the same size.");           \
+		return BulkMath::dot(p_instance->ptr(), p_values.ptr(), p_values.size());                                          \
+	}                                                                                                                      \
+	static double func_##m_packed_type##_sum(m_packed_type *p_instance) {                                                  \
+		return BulkMath::sum(p_instance->ptr(), p_instance->size());                                                       \
+	}                                                                                                                      \
+	static double func_##m_packed_type##_min(m_packed_type *p_instance) {                                                  \
+		ERR_FAIL_COND_V_MSG(p_instance->is_empty(), 0.0, "Can't take the minimum of an empty array.");                     \
+		return BulkMath::min(p_instance->ptr(), p_instance->size());                                                       \
+	}                                                                                                                      \
+	static double func_##m_packed_type##_max(m_packed_type *p_instance) {                                                  \
+		ERR_FAIL_COND_V_MSG(p_instance->is_empty(), 0.0, "Can't take the maximum of an empty array.");                     \
+		return BulkMath::max(p_instance->ptr(), p_instance->size());                                                       \
+	}
+
+	VARCALL_PACKED_BULK_MATH(PackedFloat32Array, float)
+	VARCALL_PACKED_BULK_MATH(PackedFloat64Array, double)
+
+	// Vector arrays go through the same kernels, as flat arrays of components.
+#define VARCALL_PACKED_VECTOR_BULK_MATH(m_packed_type, m_type)                                                               \
+	static void func_##m_packed_type##_add_array(m_packed_type *p_instance, const m_packed_type &p_values) {                 \
+		ERR_FAIL_COND_MSG(p_instance->size() != p_values.size(), "Both arrays must have the same size.");                    \
+		real_t *w = reinterpret_cast<real_t *>(p_instance->ptrw());                                                          \
+		BulkMath::add(w, reinterpret_cast<const real_t *>(p_values.ptr()), p_values.size() * m_type::AXIS_COUNT);            \
+	}                                                                                                                        \
+	static void func_##m_packed_type##_multiply_array(m_packed_type *p_instance, const m_packed_type &p_values) {            \
+		ERR_FAIL_COND_MSG(p_instance->size() != p_values.size(), "Both arrays must have the same size.");                    \
+		real_t *w = reinterpret_cast<real_t *>(p_instance->ptrw());                                                          \
+		BulkMath::multiply(w, reinterpret_cast<const real_t *>(p_values.ptr()), p_values.size() * m_type::AXIS_COUNT);       \
+	}                                                                                                                        \
+	static void func_##m_packed_type##_lerp_array(m_packed_type *p_instance, const m_packed_type &p_to, double p_weight) {   \
+		ERR_FAIL_COND_MSG(p_instance->size() != p_to.size(), "Both arrays must have the same size.");                        \
+		real_t *w = reinterpret_cast<real_t *>(p_instance->ptrw());                                                          \
+		BulkMath::lerp(w, reinterpret_cast<const real_t *>(p_to.ptr()), (real_t)p_weight, p_to.size() * m_type::AXIS_COUNT); \
+	}
+
+	VARCALL_PACKED_VECTOR_BULK_MATH(PackedVector2Array, Vector2)
+	VARCALL_PACKED_VECTOR_BULK_MATH(PackedVector3Array, Vector3)
+
+	static void func_PackedVector2Array_transform(PackedVector2Array *p_instance, const Transform2D &p_transform) {
+		BulkMath::transform(p_instance->ptrw(), p_transform, p_instance->size());
+	}
+
+	static void func_PackedVector3Array_transform(PackedVector3Array *p_instance, const Transform3D &p_transform) {
+		BulkMath::transform(p_instance->ptrw(), p_transform, p_instance->size());
+	}
+
 	static void func_Callable_call(Variant *v, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
 		Callable *callable = VariantGetInternalPtr<Callable>::get_ptr(v);
 		callable->callp(p_args, p_argcount, r_ret, r_error);
@@ -2505,6 +2573,14 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedFloat32Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedFloat32Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedFloat32Array, count, sarray("value"), varray());
+	bind_functionnc(PackedFloat32Array, add_array, _VariantCall::func_PackedFloat32Array_add_array, sarray("values"), varray());
+	bind_functionnc(PackedFloat32Array, multiply_array, _VariantCall::func_PackedFloat32Array_multiply_array, sarray("values"), varray());
+	bind_functionnc(PackedFloat32Array, lerp_array, _VariantCall::func_PackedFloat32Array_lerp_array, sarray("to", "weight"), varray());
+	bind_functionnc(PackedFloat32Array, clamp, _VariantCall::func_PackedFloat32Array_clamp, sarray("min", "max"), varray());
+	bind_function(PackedFloat32Array, dot, _VariantCall::func_PackedFloat32Array_dot, sarray("values"), varray());
+	bind_function(PackedFloat32Array, sum, _VariantCall::func_PackedFloat32Array_sum, sarray(), varray());
+	bind_function(PackedFloat32Array, min, _VariantCall::func_PackedFloat32Array_min, sarray(), varray());
+	bind_function(PackedFloat32Array, max, _VariantCall::func_PackedFloat32Array_max, sarray(), varray());
 
 	/* Float64 Array */
 
@@ -2529,6 +2605,14 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedFloat64Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedFloat64Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedFloat64Array, count, sarray("value"), varray());
+	bind_functionnc(PackedFloat64Array, add_array, _VariantCall::func_PackedFloat64Array_add_array, sarray("values"), varray());
+	bind_functionnc(PackedFloat64Array, multiply_array, _VariantCall::func_PackedFloat64Array_multiply_array, sarray("values"), varray());
+	bind_functionnc(PackedFloat64Array, lerp_array, _VariantCall::func_PackedFloat64Array_lerp_array, sarray("to", "weight"), varray());
+	bind_functionnc(PackedFloat64Array, clamp, _VariantCall::func_PackedFloat64Array_clamp, sarray("min", "max"), varray());
+	bind_function(PackedFloat64Array, dot, _VariantCall::func_PackedFloat64Array_dot, sarray("values"), varray());
+	bind_function(PackedFloat64Array, sum, _VariantCall::func_PackedFloat64Array_sum, sarray(), varray());
+	bind_function(PackedFloat64Array, min, _VariantCall::func_PackedFloat64Array_min, sarray(), varray());
+	bind_function(PackedFloat64Array, max, _VariantCall::func_PackedFloat64Array_max, sarray(), varray());
 
 	/* String Array */
 
@@ -2577,6 +2661,10 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedVector2Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedVector2Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedVector2Array, count, sarray("value"), varray());
+	bind_functionnc(PackedVector2Array, add_array, _VariantCall::func_PackedVector2Array_add_array, sarray("values"), varray());
+	bind_functionnc(PackedVector2Array, multiply_array, _VariantCall::func_PackedVector2Array_multiply_array, sarray("values"), varray());
+	bind_functionnc(PackedVector2Array, lerp_array, _VariantCall::func_PackedVector2Array_lerp_array, sarray("to", "weight"), varray());
+	bind_functionnc(PackedVector2Array, transform, _VariantCall::func_PackedVector2Array_transform, sarray("transform"), varray());
 
 	/* Vector3 Array */
 
@@ -2601,6 +2689,10 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedVector3Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedVector3Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedVector3Array, count, sarray("value"), varray());
+	bind_functionnc(PackedVector3Array, add_array, _VariantCall::func_PackedVector3Array_add_array, sarray("values"), varray());
+	bind_functionnc(PackedVector3Array, multiply_array, _VariantCall::func_PackedVector3Array_multiply_array, sarray("values"), varray());
+	bind_functionnc(PackedVector3Array, lerp_array, _VariantCall::func_PackedVector3Array_lerp_array, sarray("to", "weight"), varray());
+	bind_functionnc(PackedVector3Array, transform, _VariantCall::func_PackedVector3Array_transform, sarray("transform"), varray());
 
 	/* Color Array */
 
@@ -128,6 +128,7 @@
 
 #ifdef MODULE_GDSCRIPT_ENABLED
 #include "modules/gdscript/gdscript.h"
+#include "modules/gdscript/gdscript_sampling_profiler.h"
 #if defined(TOOLS_ENABLED) && !defined(GDSCRIPT_NO_LSP)
 #include "modules/gdscript/language_server/gdscript_language_server.h"
 #endif // TOOLS_ENABLED && !GDSCRIPT_NO_LSP
@@ -625,6 +626,9 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("-d, --debug", "Debug (local stdout debugger).\n");
 	print_help_option("-b, --breakpoints", "Breakpoint list as source::line comma-separated pairs, no spaces (use %%20 instead).\n");
 	print_help_option("--profiling", "Enable profiling in the script debugger.\n");
+#if defined(MODULE_GDSCRIPT_ENABLED) && defined(DEBUG_ENABLED)
+	print_help_option("--profile-gdscript <file>", "Sample GDScript call stacks during the run and save them on exit, as a Chrome trace if <file> ends in \".json\", as collapsed stacks for flame graph tools otherwise. The path should be absolute.\n", CLI_OPTION_AVAILABILITY_TEMPLATE_DEBUG);
+#endif
 	print_help_option("--gpu-profile", "Show a GPU profile of the tasks that took the most time during frame rendering.\n");
 	print_help_option("--gpu-validation", "Enable graphics API validation layers for debugging.\n");
 #ifdef DEBUG_ENABLED
@@ -1781,6 +1785,16 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 				goto error;
 			}
 #endif // TOOLS_ENABLED && MODULE_GDSCRIPT_ENABLED && !GDSCRIPT_NO_LSP
+#if defined(MODULE_GDSCRIPT_ENABLED) && defined(DEBUG_ENABLED)
+		} else if (arg == "--profile-gdscript") {
+			if (N) {
+				GDScriptSamplingProfiler::output_path = N->get();
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing <file> argument for --profile-gdscript <file>.\n");
+				goto error;
+			}
+#endif // MODULE_GDSCRIPT_ENABLED && DEBUG_ENABLED
 #if defined(TOOLS_ENABLED)
 		} else if (arg == "--dap-port") {
 			if (N) {
@@ -4320,6 +4334,11 @@ static uint64_t navigation_process_max = 0;
 bool Main::iteration() {
 	iterating++;
 
+	if (iterating == 1) {
+		// Nested iterations would pull the rug from under the outer one.
+		FrameAllocator::new_frame();
+	}
+
 	const uint64_t ticks = OS::get_singleton()->get_ticks_usec();
 	Engine::get_singleton()->_frame_ticks = ticks;
 	main_timer_sync.set_cpu_ticks_usec(ticks);
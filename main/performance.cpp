@@ -97,6 +97,8 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(PIPELINE_COMPILATIONS_SURFACE);
 	BIND_ENUM_CONSTANT(PIPELINE_COMPILATIONS_DRAW);
 	BIND_ENUM_CONSTANT(PIPELINE_COMPILATIONS_SPECIALIZATION);
+	BIND_ENUM_CONSTANT(MEMORY_FRAME_ARENA);
+	BIND_ENUM_CONSTANT(MEMORY_FRAME_ARENA_OVERFLOW);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -153,6 +155,8 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("pipeline/compilations_surface"),
 		PNAME("pipeline/compilations_draw"),
 		PNAME("pipeline/compilations_specialization"),
+		PNAME("memory/frame_arena"),
+		PNAME("memory/frame_arena_overflow"),
 	};
 
 	return names[p_monitor];
@@ -174,6 +178,10 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return Memory::get_mem_max_usage();
 		case MEMORY_MESSAGE_BUFFER_MAX:
 			return MessageQueue::get_singleton()->get_max_buffer_usage();
+		case MEMORY_FRAME_ARENA:
+			return FrameAllocator::get_last_frame_arena_bytes();
+		case MEMORY_FRAME_ARENA_OVERFLOW:
+			return FrameAllocator::get_last_frame_heap_bytes();
 		case OBJECT_COUNT:
 			return ObjectDB::get_object_count();
 		case OBJECT_RESOURCE_COUNT:
@@ -296,6 +304,13 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
 
 	};
 
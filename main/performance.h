@@ -106,6 +106,8 @@ public:
 		PIPELINE_COMPILATIONS_SURFACE,
 		PIPELINE_COMPILATIONS_DRAW,
 		PIPELINE_COMPILATIONS_SPECIALIZATION,
+		MEMORY_FRAME_ARENA,
+		MEMORY_FRAME_ARENA_OVERFLOW,
 		MONITOR_MAX
 	};
 
@@ -3,6 +3,18 @@ def can_build(env, platform):
     return True
 
 
+def get_opts(platform):
+    from SCons.Variables import BoolVariable
+
+    return [
+        BoolVariable(
+            "gdscript_opcode_pair_statistics",
+            "Count executed GDScript opcode pairs in debug builds (slows down every instruction)",
+            False,
+        ),
+    ]
+
+
 def configure(env):
     pass
 
@@ -31,6 +31,7 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
@@ -592,10 +593,12 @@ bool GDScript::_update_exports(bool *r_err, bool p_recursive_call, PlaceHolderSc
 				}
 				valid = false; // to show error in the editor
 				base_cache->valid = false;
+				base_cache->_invalidate_inline_caches();
 				base_cache->inheriters_cache.clear(); // to prevent future stackoverflows
 				base_cache.unref();
 				base.unref();
 				_base = nullptr;
+				_invalidate_inline_caches();
 				ERR_FAIL_V_MSG(false, "Cyclic inheritance in script class.");
 			}
 		}
@@ -774,6 +777,8 @@ Error GDScript::reload(bool p_keep_state) {
 				MutexLock lock(GDScriptCache::singleton->mutex);
 				GDScriptCache::singleton->shallow_gdscript_cache[source_path] = Ref<GDScript>(this);
 			}
+			// Parsed ahead from the file, which may differ from the source being compiled.
+			GDScriptCache::_discard_prefetched_parsers(source_path);
 			if (GDScriptCache::has_parser(source_path)) {
 				Error err = OK;
 				Ref<GDScriptParserRef> parser_ref = GDScriptCache::get_parser(source_path, GDScriptParserRef::EMPTY, err);
@@ -801,6 +806,25 @@ Error GDScript::reload(bool p_keep_state) {
 #endif
 
 	valid = false;
+	_invalidate_inline_caches();
+
+	if (!bytecode_cache.is_empty()) {
+		// Only the first load uses the cache, reloads compile from the tokens.
+		Vector<uint8_t> cache = bytecode_cache;
+		bytecode_cache.clear();
+		if (!has_instances) {
+			Error err = GDScriptBytecodeCache::load(this, cache);
+			if (valid) {
+				// Loaded. Errors come from compiling dependencies, as in `GDScriptCompiler::compile()`.
+				if (err == OK && (ScriptServer::is_scripting_enabled() || is_tool())) {
+					err = _static_init();
+				}
+				reloading = false;
+				return err;
+			}
+		}
+	}
+
 	GDScriptParser parser;
 	Error err;
 	if (!binary_tokens.is_empty()) {
@@ -1407,6 +1431,8 @@ GDScript::GDScript() :
 	}
 
 	path = vformat("gdscript://%d.gd", get_instance_id());
+	// Inline caches are keyed on the script's address, which may be reused.
+	_invalidate_inline_caches();
 }
 
 void GDScript::_save_orphaned_subclasses(ClearData *p_clear_data) {
@@ -1559,6 +1585,7 @@ void GDScript::clear(ClearData *p_clear_data) {
 		clear_data->functions.insert(E.value);
 	}
 	member_functions.clear();
+	_invalidate_inline_caches();
 
 	for (KeyValue<StringName, MemberInfo> &E : member_indices) {
 		clear_data->scripts.insert(E.value.data_type.script_type_ref);
@@ -2268,6 +2295,17 @@ void GDScriptLanguage::init() {
 	}
 #endif
 
+#ifdef DEBUG_ENABLED
+#ifdef GDSCRIPT_OPCODE_PAIR_STATISTICS
+	if (GLOBAL_GET("debug/settings/gdscript/opcode_pair_statistics")) {
+		GDScriptFunction::start_opcode_pair_statistics();
+	}
+#endif
+	if (!GDScriptSamplingProfiler::output_path.is_empty()) {
+		GDScriptSamplingProfiler::start();
+	}
+#endif
+
 #ifdef TESTS_ENABLED
 	GDScriptTests::GDScriptTestRunner::handle_cmdline();
 #endif
@@ -2309,6 +2347,19 @@ void GDScriptLanguage::finish() {
 	}
 	finishing = true;
 
+#ifdef DEBUG_ENABLED
+#ifdef GDSCRIPT_OPCODE_PAIR_STATISTICS
+	GDScriptFunction::finish_opcode_pair_statistics(32);
+#endif
+	if (!GDScriptSamplingProfiler::output_path.is_empty()) {
+		GDScriptSamplingProfiler::stop();
+		if (GDScriptSamplingProfiler::save(GDScriptSamplingProfiler::output_path) == OK) {
+			print_line(vformat("GDScript profile (%d samples) saved to \"%s\".", GDScriptSamplingProfiler::get_sample_count(), GDScriptSamplingProfiler::output_path));
+		}
+	}
+	GDScriptSamplingProfiler::clear();
+#endif
+
 	_call_stack.free();
 
 	// Clear the cache before parsing the script_list
@@ -2345,6 +2396,8 @@ void GDScriptLanguage::finish() {
 	script_list.clear();
 	function_list.clear();
 
+	GDScriptFunctionState::clear_frame_pool();
+
 	finishing = false;
 }
 
@@ -2363,6 +2416,8 @@ void GDScriptLanguage::profiling_start() {
 		elem->self()->profile.last_frame_call_count = 0;
 		elem->self()->profile.last_frame_self_time = 0;
 		elem->self()->profile.last_frame_total_time = 0;
+		elem->self()->profile.inline_cache_hits.set(0);
+		elem->self()->profile.inline_cache_misses.set(0);
 		elem->self()->profile.native_calls.clear();
 		elem->self()->profile.last_native_calls.clear();
 		elem = elem->next();
@@ -2387,6 +2442,21 @@ void GDScriptLanguage::profiling_stop() {
 #endif
 }
 
+void GDScriptLanguage::profiling_get_inline_cache_data(uint64_t &r_hits, uint64_t &r_misses) {
+	r_hits = 0;
+	r_misses = 0;
+#ifdef DEBUG_ENABLED
+	MutexLock lock(mutex);
+
+	SelfList<GDScriptFunction> *elem = function_list.first();
+	while (elem) {
+		r_hits += elem->self()->profile.inline_cache_hits.get();
+		r_misses += elem->self()->profile.inline_cache_misses.get();
+		elem = elem->next();
+	}
+#endif
+}
+
 int GDScriptLanguage::profiling_get_accumulated_data(ProfilingInfo *p_info_arr, int p_info_max) {
 	int current = 0;
 #ifdef DEBUG_ENABLED
@@ -2931,15 +3001,11 @@ GDScriptLanguage::GDScriptLanguage() {
 
 	int dmcs = GLOBAL_DEF(PropertyInfo(Variant::INT, "debug/settings/gdscript/max_call_stack", PROPERTY_HINT_RANGE, "512," + itos(GDScriptFunction::MAX_CALL_DEPTH - 1) + ",1"), 1024);
 
-	if (EngineDebugger::is_active()) {
-		//debugging enabled!
-
-		_debug_max_call_stack = dmcs;
-	} else {
-		_debug_max_call_stack = 0;
-	}
+	// Also used without a debugger, by the sampling profiler.
+	_debug_max_call_stack = dmcs;
 
 #ifdef DEBUG_ENABLED
+	GLOBAL_DEF("debug/settings/gdscript/opcode_pair_statistics", false);
 	GLOBAL_DEF("debug/gdscript/warnings/enable", true);
 	GLOBAL_DEF("debug/gdscript/warnings/exclude_addons", true);
 	for (int i = 0; i < (int)GDScriptWarning::WARNING_MAX; i++) {
@@ -32,6 +32,7 @@
 #define GDSCRIPT_H
 
 #include "gdscript_function.h"
+#include "gdscript_sampling_profiler.h"
 
 #include "core/debugger/engine_debugger.h"
 #include "core/debugger/script_debugger.h"
@@ -84,6 +85,9 @@ class GDScript : public Script {
 	friend class GDScriptInstance;
 	friend class GDScriptFunction;
 	friend class GDScriptAnalyzer;
+	friend class GDScriptBytecodeCache;
+	friend class GDScriptBytecodeCacheWriter;
+	friend class GDScriptCache;
 	friend class GDScriptCompiler;
 	friend class GDScriptDocGen;
 	friend class GDScriptLambdaCallable;
@@ -96,6 +100,21 @@ class GDScript : public Script {
 	GDScript *_base = nullptr; //fast pointer access
 	GDScript *_owner = nullptr; //for subclasses
 
+	// Changes whenever the members, functions or validity of this script change, so inline
+	// caches stop trusting what they resolved against it. Unique across scripts.
+	SafeNumeric<uint64_t> inline_cache_version;
+
+	void _invalidate_inline_caches() { inline_cache_version.set(GDScriptFunction::new_inline_cache_version()); }
+	// Versions only grow, so the newest one in the inheritance chain changes whenever any
+	// class of the chain, or the chain itself, does.
+	_FORCE_INLINE_ uint64_t _get_inline_cache_version() const {
+		uint64_t version = 0;
+		for (const GDScript *sptr = this; sptr; sptr = sptr->_base) {
+			version = MAX(version, sptr->inline_cache_version.get());
+		}
+		return version;
+	}
+
 	// Members are just indices to the instantiated script.
 	HashMap<StringName, MemberInfo> member_indices; // Includes member info of all base GDScript classes.
 	HashSet<StringName> members; // Only members of the current class.
@@ -178,6 +197,7 @@ private:
 	//exported members
 	String source;
 	Vector<uint8_t> binary_tokens;
+	Vector<uint8_t> bytecode_cache; // Compiled bytecode to load instead of compiling, see `GDScriptBytecodeCache`.
 	String path;
 	bool path_valid = false; // False if using default path.
 	StringName local_name; // Inner class identifier or `class_name`.
@@ -433,6 +453,8 @@ class GDScriptLanguage : public ScriptLanguage {
 	struct CallStack {
 		CallLevel *levels = nullptr;
 		int stack_pos = 0;
+		// Calls past `_debug_max_call_stack` while only the sampling profiler tracks the stack.
+		int untracked_levels = 0;
 
 		void free() {
 			if (levels) {
@@ -452,6 +474,7 @@ class GDScriptLanguage : public ScriptLanguage {
 	void _remove_global(const StringName &p_name);
 
 	friend class GDScriptInstance;
+	friend class GDScriptSamplingProfiler;
 
 	Mutex mutex;
 
@@ -485,17 +508,29 @@ public:
 			_call_stack.levels = memnew_arr(CallLevel, _debug_max_call_stack + 1);
 		}
 
-		if (EngineDebugger::get_script_debugger()->get_lines_left() > 0 && EngineDebugger::get_script_debugger()->get_depth() >= 0) {
-			EngineDebugger::get_script_debugger()->set_depth(EngineDebugger::get_script_debugger()->get_depth() + 1);
+		// The call stack is also tracked for the sampling profiler, without a debugger.
+		ScriptDebugger *script_debugger = EngineDebugger::get_script_debugger();
+		if (script_debugger && script_debugger->get_lines_left() > 0 && script_debugger->get_depth() >= 0) {
+			script_debugger->set_depth(script_debugger->get_depth() + 1);
 		}
 
 		if (_call_stack.stack_pos >= _debug_max_call_stack) {
+			if (!script_debugger) {
+				_call_stack.untracked_levels++;
+				return;
+			}
 			//stack overflow
 			_debug_error = vformat("Stack overflow (stack size: %s). Check for infinite recursion in your script.", _debug_max_call_stack);
-			EngineDebugger::get_script_debugger()->debug(this);
+			script_debugger->debug(this);
 			return;
 		}
 
+#ifdef DEBUG_ENABLED
+		if (_call_stack.stack_pos == 0) {
+			GDScriptSamplingProfiler::sync_thread();
+		}
+#endif
+
 		_call_stack.levels[_call_stack.stack_pos].stack = p_stack;
 		_call_stack.levels[_call_stack.stack_pos].instance = p_instance;
 		_call_stack.levels[_call_stack.stack_pos].function = p_function;
@@ -505,13 +540,21 @@ public:
 	}
 
 	_FORCE_INLINE_ void exit_function() {
-		if (EngineDebugger::get_script_debugger()->get_lines_left() > 0 && EngineDebugger::get_script_debugger()->get_depth() >= 0) {
-			EngineDebugger::get_script_debugger()->set_depth(EngineDebugger::get_script_debugger()->get_depth() - 1);
+		ScriptDebugger *script_debugger = EngineDebugger::get_script_debugger();
+		if (script_debugger && script_debugger->get_lines_left() > 0 && script_debugger->get_depth() >= 0) {
+			script_debugger->set_depth(script_debugger->get_depth() - 1);
+		}
+
+		if (_call_stack.untracked_levels > 0) {
+			_call_stack.untracked_levels--;
+			return;
 		}
 
 		if (_call_stack.stack_pos == 0) {
 			_debug_error = "Stack Underflow (Engine Bug)";
-			EngineDebugger::get_script_debugger()->debug(this);
+			if (script_debugger) {
+				script_debugger->debug(this);
+			}
 			return;
 		}
 
@@ -622,6 +665,8 @@ public:
 
 	virtual int profiling_get_accumulated_data(ProfilingInfo *p_info_arr, int p_info_max) override;
 	virtual int profiling_get_frame_data(ProfilingInfo *p_info_arr, int p_info_max) override;
+	// Inline cache hits and misses of property accesses and calls, summed over all functions since profiling_start().
+	void profiling_get_inline_cache_data(uint64_t &r_hits, uint64_t &r_misses);
 
 	/* LOADER FUNCTIONS */
 
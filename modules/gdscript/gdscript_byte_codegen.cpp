@@ -178,6 +178,91 @@ void GDScriptByteCodeGenerator::write_start(GDScript *p_script, const StringName
 	function->_argument_count = 0;
 }
 
+void GDScriptByteCodeGenerator::fuse_instructions() {
+	// Fusing happens in place: the superinstruction replaces the opcode of the operator and skips the instruction
+	// following it, which is left intact. Jumps landing on either instruction thus remain valid without patching.
+	int *code = opcodes.ptrw();
+	for (uint32_t i = 0; i + 1 < instruction_starts.size(); i++) {
+		const int first = instruction_starts[i];
+		const int second = instruction_starts[i + 1];
+		if (second - first < 4) {
+			continue; // Too short to be an operator.
+		}
+		const GDScriptFunction::Opcode first_opcode = GDScriptFunction::Opcode(code[first]);
+		const GDScriptFunction::Opcode second_opcode = GDScriptFunction::Opcode(code[second]);
+		const int result = code[first + 3]; // Target address of any operator.
+
+		if (second_opcode == GDScriptFunction::OPCODE_JUMP_IF_NOT && code[second + 1] == result) {
+			switch (first_opcode) {
+				case GDScriptFunction::OPCODE_OPERATOR_EQUAL_INT:
+					code[first] = GDScriptFunction::OPCODE_OPERATOR_EQUAL_INT_JUMP_IF_NOT;
+					break;
+				case GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_INT:
+					code[first] = GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_INT_JUMP_IF_NOT;
+					break;
+				case GDScriptFunction::OPCODE_OPERATOR_LESS_INT:
+					code[first] = GDScriptFunction::OPCODE_OPERATOR_LESS_INT_JUMP_IF_NOT;
+					break;
+				case GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_INT:
+					code[first] = GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_INT_JUMP_IF_NOT;
+					break;
+				case GDScriptFunction::OPCODE_OPERATOR_GREATER_INT:
+					code[first] = GDScriptFunction::OPCODE_OPERATOR_GREATER_INT_JUMP_IF_NOT;
+					break;
+				case GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_INT:
+					code[first] = GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_INT_JUMP_IF_NOT;
+					break;
+				case GDScriptFunction::OPCODE_OPERATOR_LESS_FLOAT:
+					code[first] = GDScriptFunction::OPCODE_OPERATOR_LESS_FLOAT_JUMP_IF_NOT;
+					break;
+				case GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_FLOAT:
+					code[first] = GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_FLOAT_JUMP_IF_NOT;
+					break;
+				case GDScriptFunction::OPCODE_OPERATOR_GREATER_FLOAT:
+					code[first] = GDScriptFunction::OPCODE_OPERATOR_GREATER_FLOAT_JUMP_IF_NOT;
+					break;
+				case GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_FLOAT:
+					code[first] = GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_FLOAT_JUMP_IF_NOT;
+					break;
+				case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+					code[first] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT;
+					break;
+				default:
+					break;
+			}
+		} else if (second_opcode == GDScriptFunction::OPCODE_ASSIGN && code[second + 2] == result) {
+			switch (first_opcode) {
+				case GDScriptFunction::OPCODE_OPERATOR_ADD_INT:
+					code[first] = GDScriptFunction::OPCODE_OPERATOR_ADD_INT_ASSIGN;
+					break;
+				case GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_INT:
+					code[first] = GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_INT_ASSIGN;
+					break;
+				case GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_INT:
+					code[first] = GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_INT_ASSIGN;
+					break;
+				case GDScriptFunction::OPCODE_OPERATOR_ADD_FLOAT:
+					code[first] = GDScriptFunction::OPCODE_OPERATOR_ADD_FLOAT_ASSIGN;
+					break;
+				case GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_FLOAT:
+					code[first] = GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_FLOAT_ASSIGN;
+					break;
+				case GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_FLOAT:
+					code[first] = GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_FLOAT_ASSIGN;
+					break;
+				case GDScriptFunction::OPCODE_OPERATOR_DIVIDE_FLOAT:
+					code[first] = GDScriptFunction::OPCODE_OPERATOR_DIVIDE_FLOAT_ASSIGN;
+					break;
+				case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+					code[first] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_ASSIGN;
+					break;
+				default:
+					break;
+			}
+		}
+	}
+}
+
 GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 #ifdef DEBUG_ENABLED
 	if (!used_temporaries.is_empty()) {
@@ -196,6 +281,8 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		}
 	}
 
+	fuse_instructions();
+
 	if (constant_map.size()) {
 		function->_constant_count = constant_map.size();
 		function->constants.resize(constant_map.size());
@@ -395,11 +482,17 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_lambdas_count = 0;
 	}
 
+	if (inline_cache_count) {
+		function->_inline_caches_ptr = memnew_arr(GDScriptFunction::InlineCache, inline_cache_count);
+		function->_inline_caches_count = inline_cache_count;
+	}
+
 	if (debug_stack) {
 		function->stack_debug = stack_debug;
 	}
 	function->_stack_size = GDScriptFunction::FIXED_ADDRESSES_MAX + max_locals + temporaries.size();
 	function->_instruction_args_size = instr_args_max;
+	function->_update_frame_layout();
 
 #ifdef DEBUG_ENABLED
 	function->operator_names = operator_names;
@@ -584,6 +677,67 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 	}
 }
 
+// Returns the opcode working directly on the payloads of two int or two float operands, or OPCODE_END if there is none.
+static GDScriptFunction::Opcode get_typed_operator_opcode(Variant::Operator p_operator, Variant::Type p_left_type, Variant::Type p_right_type) {
+	if (p_left_type != p_right_type) {
+		return GDScriptFunction::OPCODE_END;
+	}
+
+	if (p_left_type == Variant::INT) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return GDScriptFunction::OPCODE_OPERATOR_ADD_INT;
+			case Variant::OP_SUBTRACT:
+				return GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_INT;
+			case Variant::OP_MULTIPLY:
+				return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_INT;
+			case Variant::OP_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_EQUAL_INT;
+			case Variant::OP_NOT_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_INT;
+			case Variant::OP_LESS:
+				return GDScriptFunction::OPCODE_OPERATOR_LESS_INT;
+			case Variant::OP_LESS_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_INT;
+			case Variant::OP_GREATER:
+				return GDScriptFunction::OPCODE_OPERATOR_GREATER_INT;
+			case Variant::OP_GREATER_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_INT;
+			default:
+				return GDScriptFunction::OPCODE_END;
+		}
+	}
+
+	if (p_left_type == Variant::FLOAT) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return GDScriptFunction::OPCODE_OPERATOR_ADD_FLOAT;
+			case Variant::OP_SUBTRACT:
+				return GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_FLOAT;
+			case Variant::OP_MULTIPLY:
+				return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_FLOAT;
+			case Variant::OP_DIVIDE:
+				return GDScriptFunction::OPCODE_OPERATOR_DIVIDE_FLOAT;
+			case Variant::OP_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_EQUAL_FLOAT;
+			case Variant::OP_NOT_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_FLOAT;
+			case Variant::OP_LESS:
+				return GDScriptFunction::OPCODE_OPERATOR_LESS_FLOAT;
+			case Variant::OP_LESS_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_FLOAT;
+			case Variant::OP_GREATER:
+				return GDScriptFunction::OPCODE_OPERATOR_GREATER_FLOAT;
+			case Variant::OP_GREATER_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_FLOAT;
+			default:
+				return GDScriptFunction::OPCODE_END;
+		}
+	}
+
+	return GDScriptFunction::OPCODE_END;
+}
+
 void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand, const Address &p_right_operand) {
 	// Avoid validated evaluator for modulo and division when operands are int, since there's no check for division by zero.
 	if (HAS_BUILTIN_TYPE(p_left_operand) && HAS_BUILTIN_TYPE(p_right_operand) && ((p_operator != Variant::OP_DIVIDE && p_operator != Variant::OP_MODULE) || p_left_operand.type.builtin_type != Variant::INT || p_right_operand.type.builtin_type != Variant::INT)) {
@@ -595,6 +749,15 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 			}
 		}
 
+		GDScriptFunction::Opcode typed_opcode = get_typed_operator_opcode(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
+		if (typed_opcode != GDScriptFunction::OPCODE_END) {
+			append_opcode(typed_opcode);
+			append(p_left_operand);
+			append(p_right_operand);
+			append(p_target);
+			return;
+		}
+
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
@@ -771,8 +934,45 @@ void GDScriptByteCodeGenerator::write_end_ternary() {
 	ternary_result.pop_back();
 }
 
+// Returns the opcode accessing elements of the given packed array type directly, or OPCODE_END if it isn't one.
+static GDScriptFunction::Opcode get_packed_array_indexed_opcode(Variant::Type p_type, bool p_set) {
+	switch (p_type) {
+		case Variant::PACKED_BYTE_ARRAY:
+			return p_set ? GDScriptFunction::OPCODE_SET_INDEXED_PACKED_BYTE_ARRAY : GDScriptFunction::OPCODE_GET_INDEXED_PACKED_BYTE_ARRAY;
+		case Variant::PACKED_INT32_ARRAY:
+			return p_set ? GDScriptFunction::OPCODE_SET_INDEXED_PACKED_INT32_ARRAY : GDScriptFunction::OPCODE_GET_INDEXED_PACKED_INT32_ARRAY;
+		case Variant::PACKED_INT64_ARRAY:
+			return p_set ? GDScriptFunction::OPCODE_SET_INDEXED_PACKED_INT64_ARRAY : GDScriptFunction::OPCODE_GET_INDEXED_PACKED_INT64_ARRAY;
+		case Variant::PACKED_FLOAT32_ARRAY:
+			return p_set ? GDScriptFunction::OPCODE_SET_INDEXED_PACKED_FLOAT32_ARRAY : GDScriptFunction::OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY;
+		case Variant::PACKED_FLOAT64_ARRAY:
+			return p_set ? GDScriptFunction::OPCODE_SET_INDEXED_PACKED_FLOAT64_ARRAY : GDScriptFunction::OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY;
+		case Variant::PACKED_STRING_ARRAY:
+			return p_set ? GDScriptFunction::OPCODE_SET_INDEXED_PACKED_STRING_ARRAY : GDScriptFunction::OPCODE_GET_INDEXED_PACKED_STRING_ARRAY;
+		case Variant::PACKED_VECTOR2_ARRAY:
+			return p_set ? GDScriptFunction::OPCODE_SET_INDEXED_PACKED_VECTOR2_ARRAY : GDScriptFunction::OPCODE_GET_INDEXED_PACKED_VECTOR2_ARRAY;
+		case Variant::PACKED_VECTOR3_ARRAY:
+			return p_set ? GDScriptFunction::OPCODE_SET_INDEXED_PACKED_VECTOR3_ARRAY : GDScriptFunction::OPCODE_GET_INDEXED_PACKED_VECTOR3_ARRAY;
+		case Variant::PACKED_COLOR_ARRAY:
+			return p_set ? GDScriptFunction::OPCODE_SET_INDEXED_PACKED_COLOR_ARRAY : GDScriptFunction::OPCODE_GET_INDEXED_PACKED_COLOR_ARRAY;
+		case Variant::PACKED_VECTOR4_ARRAY:
+			return p_set ? GDScriptFunction::OPCODE_SET_INDEXED_PACKED_VECTOR4_ARRAY : GDScriptFunction::OPCODE_GET_INDEXED_PACKED_VECTOR4_ARRAY;
+		default:
+			return GDScriptFunction::OPCODE_END;
+	}
+}
+
 void GDScriptByteCodeGenerator::write_set(const Address &p_target, const Address &p_index, const Address &p_source) {
 	if (HAS_BUILTIN_TYPE(p_target)) {
+		GDScriptFunction::Opcode packed_opcode = get_packed_array_indexed_opcode(p_target.type.builtin_type, true);
+		if (packed_opcode != GDScriptFunction::OPCODE_END && IS_BUILTIN_TYPE(p_index, Variant::INT) &&
+				IS_BUILTIN_TYPE(p_source, Variant::get_indexed_element_type(p_target.type.builtin_type))) {
+			append_opcode(packed_opcode);
+			append(p_target);
+			append(p_index);
+			append(p_source);
+			return;
+		}
 		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_setter(p_target.type.builtin_type) &&
 				IS_BUILTIN_TYPE(p_source, Variant::get_indexed_element_type(p_target.type.builtin_type))) {
 			// Use indexed setter instead.
@@ -802,6 +1002,14 @@ void GDScriptByteCodeGenerator::write_set(const Address &p_target, const Address
 
 void GDScriptByteCodeGenerator::write_get(const Address &p_target, const Address &p_index, const Address &p_source) {
 	if (HAS_BUILTIN_TYPE(p_source)) {
+		GDScriptFunction::Opcode packed_opcode = get_packed_array_indexed_opcode(p_source.type.builtin_type, false);
+		if (packed_opcode != GDScriptFunction::OPCODE_END && IS_BUILTIN_TYPE(p_index, Variant::INT)) {
+			append_opcode(packed_opcode);
+			append(p_source);
+			append(p_index);
+			append(p_target);
+			return;
+		}
 		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_getter(p_source.type.builtin_type)) {
 			// Use indexed getter instead.
 			Variant::ValidatedIndexedGetter getter = Variant::get_member_validated_indexed_getter(p_source.type.builtin_type);
@@ -844,6 +1052,7 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 	append(p_target);
 	append(p_source);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
@@ -862,6 +1071,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -1009,12 +1219,18 @@ void GDScriptByteCodeGenerator::write_assign_default_parameter(const Address &p_
 }
 
 void GDScriptByteCodeGenerator::write_store_global(const Address &p_dst, int p_global_index) {
+#ifdef TOOLS_ENABLED
+	function->global_instructions.push_back(opcodes.size());
+#endif
 	append_opcode(GDScriptFunction::OPCODE_STORE_GLOBAL);
 	append(p_dst);
 	append(p_global_index);
 }
 
 void GDScriptByteCodeGenerator::write_store_named_global(const Address &p_dst, const StringName &p_global) {
+#ifdef TOOLS_ENABLED
+	function->global_instructions.push_back(opcodes.size());
+#endif
 	append_opcode(GDScriptFunction::OPCODE_STORE_NAMED_GLOBAL);
 	append(p_dst);
 	append(p_global);
@@ -1076,6 +1292,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1101,6 +1318,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1335,6 +1553,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1348,6 +1567,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1361,6 +1581,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1847,6 +2068,9 @@ void GDScriptByteCodeGenerator::write_return(const Address &p_return_value) {
 }
 
 void GDScriptByteCodeGenerator::write_assert(const Address &p_test, const Address &p_message) {
+#ifdef TOOLS_ENABLED
+	function->has_debug_code = true;
+#endif
 	append_opcode(GDScriptFunction::OPCODE_ASSERT);
 	append(p_test);
 	append(p_message);
@@ -35,6 +35,8 @@
 #include "gdscript_function.h"
 #include "gdscript_utility_functions.h"
 
+#include "core/templates/local_vector.h"
+
 class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	struct StackSlot {
 		Variant::Type type = Variant::NIL;
@@ -78,6 +80,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	bool debug_stack = false;
 
 	Vector<int> opcodes;
+	LocalVector<int> instruction_starts; // Position of every instruction in `opcodes`, for fuse_instructions().
 	List<RBMap<StringName, int>> stack_id_stack;
 	RBMap<StringName, int> stack_identifiers;
 	List<int> stack_identifiers_counts;
@@ -98,6 +101,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	int max_locals = 0;
 	int current_line = 0;
 	int instr_args_max = 0;
+	int inline_cache_count = 0; // Instructions that carry an inline cache index.
 
 #ifdef DEBUG_ENABLED
 	List<int> temp_stack;
@@ -374,10 +378,12 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	}
 
 	void append_opcode(GDScriptFunction::Opcode p_code) {
+		instruction_starts.push_back(opcodes.size());
 		opcodes.push_back(p_code);
 	}
 
 	void append_opcode_and_argcount(GDScriptFunction::Opcode p_code, int p_argument_count) {
+		instruction_starts.push_back(opcodes.size());
 		opcodes.push_back(p_code);
 		opcodes.push_back(p_argument_count);
 		instr_args_max = MAX(instr_args_max, p_argument_count);
@@ -447,10 +453,16 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		opcodes.push_back(get_lambda_function_pos(p_lambda_function));
 	}
 
+	void append_inline_cache() {
+		opcodes.push_back(inline_cache_count++);
+	}
+
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
 	}
 
+	void fuse_instructions();
+
 public:
 	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
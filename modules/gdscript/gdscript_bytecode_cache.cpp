@@ -0,0 +1,1447 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "gdscript_cache.h"
+
+#include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/version.h"
+
+static const uint8_t BYTECODE_CACHE_MAGIC[4] = { 'G', 'D', 'B', 'C' };
+
+struct GDScriptBytecodeCache::Reader {
+	const uint8_t *buffer = nullptr;
+	uint32_t size = 0;
+	uint32_t position = 0;
+	bool failed = false;
+	GDScript *root = nullptr;
+
+	bool has(uint32_t p_bytes) {
+		if (failed || p_bytes > size - position) {
+			failed = true;
+			return false;
+		}
+		return true;
+	}
+
+	uint8_t get_u8() {
+		if (!has(1)) {
+			return 0;
+		}
+		return buffer[position++];
+	}
+
+	uint32_t get_u32() {
+		if (!has(4)) {
+			return 0;
+		}
+		uint32_t value = decode_uint32(&buffer[position]);
+		position += 4;
+		return value;
+	}
+
+	int get_int() {
+		return int32_t(get_u32());
+	}
+
+	// Every element takes at least one byte, so corrupt counts fail before allocating.
+	uint32_t get_count() {
+		uint32_t count = get_u32();
+		return has(count) ? count : 0;
+	}
+
+	String get_string() {
+		uint32_t length = get_u32();
+		if (!has(length)) {
+			return String();
+		}
+		String string;
+		string.parse_utf8(reinterpret_cast<const char *>(&buffer[position]), length);
+		position += length;
+		return string;
+	}
+
+	StringName get_string_name() {
+		return StringName(get_string());
+	}
+
+	Variant get_plain_variant() {
+		uint32_t length = get_u32();
+		if (!has(length)) {
+			return Variant();
+		}
+		Variant value;
+		if (decode_variant(value, &buffer[position], length, nullptr, false) != OK) {
+			failed = true;
+			return Variant();
+		}
+		position += length;
+		return value;
+	}
+
+	Reader(const Vector<uint8_t> &p_buffer) {
+		buffer = p_buffer.ptr();
+		size = p_buffer.size();
+	}
+};
+
+uint32_t GDScriptBytecodeCache::_get_engine_hash() {
+	uint32_t hash = hash_murmur3_one_32(FORMAT_VERSION);
+	hash = hash_murmur3_one_32(String(VERSION_FULL_CONFIG).hash(), hash);
+	hash = hash_murmur3_one_32(String(VERSION_HASH).hash(), hash);
+	hash = hash_murmur3_one_32(GDScriptFunction::OPCODE_END, hash);
+	hash = hash_murmur3_one_32(Variant::VARIANT_MAX, hash);
+	return hash_murmur3_one_32(Variant::OP_MAX, hash);
+}
+
+bool GDScriptBytecodeCache::_read_header(Reader &p_reader, uint32_t &r_tokens_hash, uint32_t &r_flags) {
+	for (int i = 0; i < 4; i++) {
+		if (p_reader.get_u8() != BYTECODE_CACHE_MAGIC[i]) {
+			return false;
+		}
+	}
+	if (p_reader.get_u32() != FORMAT_VERSION || p_reader.get_u32() != _get_engine_hash()) {
+		return false;
+	}
+	r_tokens_hash = p_reader.get_u32();
+	r_flags = p_reader.get_u32();
+	return !p_reader.failed;
+}
+
+void GDScriptBytecodeCache::_read_class_tree(Reader &p_reader, GDScript *p_script) {
+	// Same as `GDScriptCompiler::make_scripts()`, keeping the state of existing subclasses.
+	p_script->local_name = p_reader.get_string_name();
+	p_script->global_name = p_reader.get_string_name();
+	p_script->simplified_icon_path = p_reader.get_string();
+
+	HashMap<StringName, Ref<GDScript>> old_subclasses = p_script->subclasses;
+	p_script->subclasses.clear();
+
+	uint32_t subclass_count = p_reader.get_count();
+	for (uint32_t i = 0; i < subclass_count && !p_reader.failed; i++) {
+		StringName name = p_reader.get_string_name();
+		String fully_qualified_name = p_reader.get_string();
+
+		Ref<GDScript> subclass;
+		if (old_subclasses.has(name)) {
+			subclass = old_subclasses[name];
+		} else {
+			subclass = GDScriptLanguage::get_singleton()->get_orphan_subclass(fully_qualified_name);
+		}
+		if (subclass.is_null()) {
+			subclass.instantiate();
+		}
+
+		subclass->_owner = p_script;
+		subclass->path = p_script->path;
+		subclass->fully_qualified_name = fully_qualified_name;
+		p_script->subclasses.insert(name, subclass);
+
+		_read_class_tree(p_reader, subclass.ptr());
+	}
+}
+
+Ref<Script> GDScriptBytecodeCache::_read_script(Reader &p_reader, bool &r_local) {
+	r_local = false;
+	switch (p_reader.get_u8()) {
+		case SCRIPT_NONE:
+			return Ref<Script>();
+		case SCRIPT_GDSCRIPT: {
+			String path = p_reader.get_string();
+			String fully_qualified_name = p_reader.get_string();
+			if (p_reader.failed) {
+				return Ref<Script>();
+			}
+
+			Ref<GDScript> root;
+			if (path == p_reader.root->path) {
+				root = Ref<GDScript>(p_reader.root);
+				r_local = true;
+			} else {
+				Error err = OK;
+				root = GDScriptCache::get_shallow_script(path, err, p_reader.root->path);
+			}
+
+			GDScript *script = root.is_valid() ? root->find_class(fully_qualified_name) : nullptr;
+			if (script == nullptr) {
+				p_reader.failed = true;
+				return Ref<Script>();
+			}
+			return Ref<Script>(script);
+		}
+		case SCRIPT_RESOURCE: {
+			Ref<Script> script = ResourceLoader::load(p_reader.get_string());
+			if (script.is_null()) {
+				p_reader.failed = true;
+			}
+			return script;
+		}
+		default:
+			p_reader.failed = true;
+			return Ref<Script>();
+	}
+}
+
+Variant GDScriptBytecodeCache::_read_variant(Reader &p_reader) {
+	switch (p_reader.get_u8()) {
+		case VARIANT_PLAIN:
+			return p_reader.get_plain_variant();
+		case VARIANT_GLOBAL: {
+			StringName name = p_reader.get_string_name();
+			HashMap<StringName, int>::ConstIterator E = GDScriptLanguage::get_singleton()->get_global_map().find(name);
+			if (!E) {
+				p_reader.failed = true;
+				return Variant();
+			}
+			return GDScriptLanguage::get_singleton()->get_global_array()[E->value];
+		}
+		case VARIANT_SCRIPT: {
+			bool local = false;
+			return _read_script(p_reader, local);
+		}
+		case VARIANT_RESOURCE: {
+			Ref<Resource> resource = ResourceLoader::load(p_reader.get_string());
+			if (resource.is_null()) {
+				p_reader.failed = true;
+			}
+			return resource;
+		}
+		case VARIANT_ARRAY: {
+			bool read_only = p_reader.get_u8();
+			Array array;
+			if (p_reader.get_u8()) {
+				uint32_t type = p_reader.get_u32();
+				StringName class_name = p_reader.get_string_name();
+				Variant script = _read_variant(p_reader);
+				if (p_reader.failed || type >= Variant::VARIANT_MAX) {
+					p_reader.failed = true;
+					return Variant();
+				}
+				array.set_typed(type, class_name, script);
+			}
+			uint32_t size = p_reader.get_count();
+			for (uint32_t i = 0; i < size && !p_reader.failed; i++) {
+				array.push_back(_read_variant(p_reader));
+			}
+			if (read_only) {
+				array.make_read_only();
+			}
+			return array;
+		}
+		case VARIANT_DICTIONARY: {
+			bool read_only = p_reader.get_u8();
+			Dictionary dictionary;
+			if (p_reader.get_u8()) {
+				uint32_t key_type = p_reader.get_u32();
+				StringName key_class_name = p_reader.get_string_name();
+				Variant key_script = _read_variant(p_reader);
+				uint32_t value_type = p_reader.get_u32();
+				StringName value_class_name = p_reader.get_string_name();
+				Variant value_script = _read_variant(p_reader);
+				if (p_reader.failed || key_type >= Variant::VARIANT_MAX || value_type >= Variant::VARIANT_MAX) {
+					p_reader.failed = true;
+					return Variant();
+				}
+				dictionary.set_typed(key_type, key_class_name, key_script, value_type, value_class_name, value_script);
+			}
+			uint32_t size = p_reader.get_count();
+			for (uint32_t i = 0; i < size && !p_reader.failed; i++) {
+				Variant key = _read_variant(p_reader);
+				dictionary[key] = _read_variant(p_reader);
+			}
+			if (read_only) {
+				dictionary.make_read_only();
+			}
+			return dictionary;
+		}
+		default:
+			p_reader.failed = true;
+			return Variant();
+	}
+}
+
+void GDScriptBytecodeCache::_read_data_type(Reader &p_reader, GDScriptDataType &r_type) {
+	r_type.has_type = p_reader.get_u8();
+	uint8_t kind = p_reader.get_u8();
+	uint32_t builtin_type = p_reader.get_u32();
+	if (kind > GDScriptDataType::GDSCRIPT || builtin_type >= Variant::VARIANT_MAX) {
+		p_reader.failed = true;
+		return;
+	}
+	r_type.kind = GDScriptDataType::Kind(kind);
+	r_type.builtin_type = Variant::Type(builtin_type);
+	r_type.native_type = p_reader.get_string_name();
+
+	// Like the compiler, only hold a strong reference to classes of other scripts.
+	bool strong = p_reader.get_u8();
+	bool local = false;
+	Ref<Script> script = _read_script(p_reader, local);
+	r_type.script_type = script.ptr();
+	if (strong) {
+		r_type.script_type_ref = script;
+	}
+
+	uint32_t element_count = p_reader.get_count();
+	for (uint32_t i = 0; i < element_count && !p_reader.failed; i++) {
+		GDScriptDataType element_type;
+		_read_data_type(p_reader, element_type);
+		r_type.set_container_element_type(i, element_type);
+	}
+}
+
+void GDScriptBytecodeCache::_read_member_info(Reader &p_reader, GDScript::MemberInfo &r_info) {
+	r_info.index = p_reader.get_int();
+	r_info.setter = p_reader.get_string_name();
+	r_info.getter = p_reader.get_string_name();
+	_read_data_type(p_reader, r_info.data_type);
+	r_info.property_info = PropertyInfo::from_dict(_read_variant(p_reader));
+}
+
+GDScriptFunction *GDScriptBytecodeCache::_read_function(Reader &p_reader, GDScript *p_script) {
+	GDScriptFunction *function = memnew(GDScriptFunction);
+	function->name = p_reader.get_string_name();
+	function->_script = p_script;
+	function->source = p_script->get_script_path();
+
+#ifdef DEBUG_ENABLED
+	function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+	function->_func_cname = function->func_cname.get_data();
+#endif
+
+	function->_static = p_reader.get_u8();
+	function->_argument_count = p_reader.get_int();
+	uint32_t argument_type_count = p_reader.get_count();
+	function->argument_types.resize(argument_type_count);
+	for (uint32_t i = 0; i < argument_type_count; i++) {
+		_read_data_type(p_reader, function->argument_types.write[i]);
+	}
+	_read_data_type(p_reader, function->return_type);
+	function->method_info = MethodInfo::from_dict(_read_variant(p_reader));
+	function->rpc_config = _read_variant(p_reader);
+	function->_initial_line = p_reader.get_int();
+	function->_stack_size = p_reader.get_int();
+	function->_instruction_args_size = p_reader.get_int();
+
+	uint32_t temporary_count = p_reader.get_count();
+	for (uint32_t i = 0; i < temporary_count; i++) {
+		int slot = p_reader.get_int();
+		uint32_t type = p_reader.get_u32();
+		if (type >= Variant::VARIANT_MAX) {
+			p_reader.failed = true;
+			break;
+		}
+		function->temporary_slots[slot] = Variant::Type(type);
+	}
+
+	uint32_t code_size = p_reader.get_count();
+	function->code.resize(code_size);
+	for (uint32_t i = 0; i < code_size; i++) {
+		function->code.write[i] = p_reader.get_int();
+	}
+
+	uint32_t default_argument_count = p_reader.get_count();
+	function->default_arguments.resize(default_argument_count);
+	for (uint32_t i = 0; i < default_argument_count; i++) {
+		function->default_arguments.write[i] = p_reader.get_int();
+	}
+
+	uint32_t constant_count = p_reader.get_count();
+	function->constants.resize(constant_count);
+	for (uint32_t i = 0; i < constant_count && !p_reader.failed; i++) {
+		function->constants.write[i] = _read_variant(p_reader);
+	}
+
+	uint32_t global_name_count = p_reader.get_count();
+	for (uint32_t i = 0; i < global_name_count; i++) {
+		function->global_names.push_back(p_reader.get_string_name());
+	}
+
+	// Validated calls are stored by name, their function pointers are only valid in this build.
+	uint32_t operator_count = p_reader.get_count();
+	for (uint32_t i = 0; i < operator_count && !p_reader.failed; i++) {
+		uint32_t op = p_reader.get_u32();
+		uint32_t left = p_reader.get_u32();
+		uint32_t right = p_reader.get_u32();
+		Variant::ValidatedOperatorEvaluator evaluator = nullptr;
+		if (op < Variant::OP_MAX && left < Variant::VARIANT_MAX && right < Variant::VARIANT_MAX) {
+			evaluator = Variant::get_validated_operator_evaluator(Variant::Operator(op), Variant::Type(left), Variant::Type(right));
+		}
+		p_reader.failed = p_reader.failed || evaluator == nullptr;
+		function->operator_funcs.push_back(evaluator);
+	}
+
+	uint32_t setter_count = p_reader.get_count();
+	for (uint32_t i = 0; i < setter_count && !p_reader.failed; i++) {
+		uint32_t type = p_reader.get_u32();
+		StringName member = p_reader.get_string_name();
+		Variant::ValidatedSetter setter = type < Variant::VARIANT_MAX ? Variant::get_member_validated_setter(Variant::Type(type), member) : nullptr;
+		p_reader.failed = p_reader.failed || setter == nullptr;
+		function->setters.push_back(setter);
+	}
+
+	uint32_t getter_count = p_reader.get_count();
+	for (uint32_t i = 0; i < getter_count && !p_reader.failed; i++) {
+		uint32_t type = p_reader.get_u32();
+		StringName member = p_reader.get_string_name();
+		Variant::ValidatedGetter getter = type < Variant::VARIANT_MAX ? Variant::get_member_validated_getter(Variant::Type(type), member) : nullptr;
+		p_reader.failed = p_reader.failed || getter == nullptr;
+		function->getters.push_back(getter);
+	}
+
+	uint32_t keyed_setter_count = p_reader.get_count();
+	for (uint32_t i = 0; i < keyed_setter_count && !p_reader.failed; i++) {
+		uint32_t type = p_reader.get_u32();
+		Variant::ValidatedKeyedSetter setter = type < Variant::VARIANT_MAX ? Variant::get_member_validated_keyed_setter(Variant::Type(type)) : nullptr;
+		p_reader.failed = p_reader.failed || setter == nullptr;
+		function->keyed_setters.push_back(setter);
+	}
+
+	uint32_t keyed_getter_count = p_reader.get_count();
+	for (uint32_t i = 0; i < keyed_getter_count && !p_reader.failed; i++) {
+		uint32_t type = p_reader.get_u32();
+		Variant::ValidatedKeyedGetter getter = type < Variant::VARIANT_MAX ? Variant::get_member_validated_keyed_getter(Variant::Type(type)) : nullptr;
+		p_reader.failed = p_reader.failed || getter == nullptr;
+		function->keyed_getters.push_back(getter);
+	}
+
+	uint32_t indexed_setter_count = p_reader.get_count();
+	for (uint32_t i = 0; i < indexed_setter_count && !p_reader.failed; i++) {
+		uint32_t type = p_reader.get_u32();
+		Variant::ValidatedIndexedSetter setter = type < Variant::VARIANT_MAX ? Variant::get_member_validated_indexed_setter(Variant::Type(type)) : nullptr;
+		p_reader.failed = p_reader.failed || setter == nullptr;
+		function->indexed_setters.push_back(setter);
+	}
+
+	uint32_t indexed_getter_count = p_reader.get_count();
+	for (uint32_t i = 0; i < indexed_getter_count && !p_reader.failed; i++) {
+		uint32_t type = p_reader.get_u32();
+		Variant::ValidatedIndexedGetter getter = type < Variant::VARIANT_MAX ? Variant::get_member_validated_indexed_getter(Variant::Type(type)) : nullptr;
+		p_reader.failed = p_reader.failed || getter == nullptr;
+		function->indexed_getters.push_back(getter);
+	}
+
+	uint32_t builtin_method_count = p_reader.get_count();
+	for (uint32_t i = 0; i < builtin_method_count && !p_reader.failed; i++) {
+		uint32_t type = p_reader.get_u32();
+		StringName method = p_reader.get_string_name();
+		Variant::ValidatedBuiltInMethod builtin_method = type < Variant::VARIANT_MAX ? Variant::get_validated_builtin_method(Variant::Type(type), method) : nullptr;
+		p_reader.failed = p_reader.failed || builtin_method == nullptr;
+		function->builtin_methods.push_back(builtin_method);
+	}
+
+	uint32_t constructor_count = p_reader.get_count();
+	for (uint32_t i = 0; i < constructor_count && !p_reader.failed; i++) {
+		uint32_t type = p_reader.get_u32();
+		int index = p_reader.get_int();
+		Variant::ValidatedConstructor constructor = nullptr;
+		if (type < Variant::VARIANT_MAX && index >= 0 && index < Variant::get_constructor_count(Variant::Type(type))) {
+			constructor = Variant::get_validated_constructor(Variant::Type(type), index);
+		}
+		p_reader.failed = p_reader.failed || constructor == nullptr;
+		function->constructors.push_back(constructor);
+	}
+
+	uint32_t utility_count = p_reader.get_count();
+	for (uint32_t i = 0; i < utility_count && !p_reader.failed; i++) {
+		Variant::ValidatedUtilityFunction utility = Variant::get_validated_utility_function(p_reader.get_string_name());
+		p_reader.failed = p_reader.failed || utility == nullptr;
+		function->utilities.push_back(utility);
+	}
+
+	uint32_t gds_utility_count = p_reader.get_count();
+	for (uint32_t i = 0; i < gds_utility_count && !p_reader.failed; i++) {
+		GDScriptUtilityFunctions::FunctionPtr utility = GDScriptUtilityFunctions::get_function(p_reader.get_string_name());
+		p_reader.failed = p_reader.failed || utility == nullptr;
+		function->gds_utilities.push_back(utility);
+	}
+
+	uint32_t method_count = p_reader.get_count();
+	for (uint32_t i = 0; i < method_count && !p_reader.failed; i++) {
+		StringName class_name = p_reader.get_string_name();
+		MethodBind *method = ClassDB::get_method(class_name, p_reader.get_string_name());
+		p_reader.failed = p_reader.failed || method == nullptr;
+		function->methods.push_back(method);
+	}
+
+	// Global indices differ between the editor and export templates, so relink them by name.
+	uint32_t global_count = p_reader.get_count();
+	for (uint32_t i = 0; i < global_count && !p_reader.failed; i++) {
+		int position = p_reader.get_int();
+		StringName name = p_reader.get_string_name();
+		if (position < 0 || position + 2 >= function->code.size()) {
+			p_reader.failed = true;
+			break;
+		}
+
+		int *instruction = function->code.ptrw() + position;
+		HashMap<StringName, int>::ConstIterator global = GDScriptLanguage::get_singleton()->get_global_map().find(name);
+		if (global) {
+			instruction[0] = GDScriptFunction::OPCODE_STORE_GLOBAL;
+			instruction[2] = global->value;
+		} else if (GDScriptLanguage::get_singleton()->get_named_globals_map().has(name)) {
+			int name_index = function->global_names.find(name);
+			if (name_index < 0) {
+				name_index = function->global_names.size();
+				function->global_names.push_back(name);
+			}
+			instruction[0] = GDScriptFunction::OPCODE_STORE_NAMED_GLOBAL;
+			instruction[2] = name_index;
+		} else {
+			p_reader.failed = true;
+		}
+	}
+
+	uint32_t lambda_count = p_reader.get_count();
+	for (uint32_t i = 0; i < lambda_count && !p_reader.failed; i++) {
+		bool has_info = p_reader.get_u8();
+		GDScript::LambdaInfo info;
+		info.capture_count = p_reader.get_int();
+		info.use_self = p_reader.get_u8();
+
+		GDScriptFunction *lambda = _read_function(p_reader, p_script);
+		if (lambda == nullptr) {
+			break;
+		}
+		function->lambdas.push_back(lambda);
+		if (has_info) {
+			p_script->lambda_info.insert(lambda, info);
+		}
+	}
+
+	int inline_cache_count = p_reader.get_int();
+	if (p_reader.failed || inline_cache_count < 0) {
+		memdelete(function);
+		p_reader.failed = true;
+		return nullptr;
+	}
+
+	if (inline_cache_count) {
+		function->_inline_caches_ptr = memnew_arr(GDScriptFunction::InlineCache, inline_cache_count);
+		function->_inline_caches_count = inline_cache_count;
+	}
+
+	function->_code_ptr = function->code.ptrw();
+	function->_code_size = function->code.size();
+	function->_default_arg_ptr = function->default_arguments.ptr();
+	function->_default_arg_count = MAX(0, function->default_arguments.size() - 1);
+	function->_constants_ptr = function->constants.ptrw();
+	function->_constant_count = function->constants.size();
+	function->_global_names_ptr = function->global_names.ptr();
+	function->_global_names_count = function->global_names.size();
+	function->_operator_funcs_ptr = function->operator_funcs.ptr();
+	function->_operator_funcs_count = function->operator_funcs.size();
+	function->_setters_ptr = function->setters.ptr();
+	function->_setters_count = function->setters.size();
+	function->_getters_ptr = function->getters.ptr();
+	function->_getters_count = function->getters.size();
+	function->_keyed_setters_ptr = function->keyed_setters.ptr();
+	function->_keyed_setters_count = function->keyed_setters.size();
+	function->_keyed_getters_ptr = function->keyed_getters.ptr();
+	function->_keyed_getters_count = function->keyed_getters.size();
+	function->_indexed_setters_ptr = function->indexed_setters.ptr();
+	function->_indexed_setters_count = function->indexed_setters.size();
+	function->_indexed_getters_ptr = function->indexed_getters.ptr();
+	function->_indexed_getters_count = function->indexed_getters.size();
+	function->_builtin_methods_ptr = function->builtin_methods.ptr();
+	function->_builtin_methods_count = function->builtin_methods.size();
+	function->_constructors_ptr = function->constructors.ptr();
+	function->_constructors_count = function->constructors.size();
+	function->_utilities_ptr = function->utilities.ptr();
+	function->_utilities_count = function->utilities.size();
+	function->_gds_utilities_ptr = function->gds_utilities.ptr();
+	function->_gds_utilities_count = function->gds_utilities.size();
+	function->_methods_ptr = function->methods.ptrw();
+	function->_methods_count = function->methods.size();
+	function->_lambdas_ptr = function->lambdas.ptrw();
+	function->_lambdas_count = function->lambdas.size();
+	function->_update_frame_layout();
+
+	return function;
+}
+
+void GDScriptBytecodeCache::_read_class(Reader &p_reader, GDScript *p_script) {
+	p_script->_invalidate_inline_caches();
+	p_script->tool = p_reader.get_u8();
+
+	HashMap<StringName, int>::ConstIterator native = GDScriptLanguage::get_singleton()->get_global_map().find(p_reader.get_string_name());
+	if (native) {
+		p_script->native = GDScriptLanguage::get_singleton()->get_global_array()[native->value];
+	}
+	if (p_script->native.is_null()) {
+		p_reader.failed = true;
+		return;
+	}
+
+	if (p_reader.get_u8()) {
+		bool local = false;
+		Ref<GDScript> base = _read_script(p_reader, local);
+		if (base.is_null()) {
+			p_reader.failed = true;
+			return;
+		}
+		p_script->base = base;
+		p_script->_base = base.ptr();
+	}
+
+	uint32_t member_count = p_reader.get_count();
+	for (uint32_t i = 0; i < member_count && !p_reader.failed; i++) {
+		StringName name = p_reader.get_string_name();
+		_read_member_info(p_reader, p_script->member_indices[name]);
+	}
+
+	uint32_t own_member_count = p_reader.get_count();
+	for (uint32_t i = 0; i < own_member_count; i++) {
+		p_script->members.insert(p_reader.get_string_name());
+	}
+
+	uint32_t static_variable_count = p_reader.get_count();
+	for (uint32_t i = 0; i < static_variable_count && !p_reader.failed; i++) {
+		StringName name = p_reader.get_string_name();
+		_read_member_info(p_reader, p_script->static_variables_indices[name]);
+	}
+	p_script->static_variables.resize(p_script->static_variables_indices.size());
+
+	uint32_t constant_count = p_reader.get_count();
+	for (uint32_t i = 0; i < constant_count && !p_reader.failed; i++) {
+		StringName name = p_reader.get_string_name();
+		p_script->constants.insert(name, _read_variant(p_reader));
+	}
+
+	uint32_t signal_count = p_reader.get_count();
+	for (uint32_t i = 0; i < signal_count && !p_reader.failed; i++) {
+		StringName name = p_reader.get_string_name();
+		p_script->_signals[name] = MethodInfo::from_dict(_read_variant(p_reader));
+	}
+
+	p_script->rpc_config = _read_variant(p_reader);
+
+	uint32_t function_count = p_reader.get_count();
+	for (uint32_t i = 0; i < function_count && !p_reader.failed; i++) {
+		GDScriptFunction *function = _read_function(p_reader, p_script);
+		if (function == nullptr) {
+			return;
+		}
+		p_script->member_functions[function->name] = function;
+		if (function->name == GDScriptLanguage::get_singleton()->strings._init) {
+			p_script->initializer = function;
+		}
+	}
+
+	if (p_reader.get_u8()) {
+		p_script->implicit_initializer = _read_function(p_reader, p_script);
+	}
+	if (p_reader.get_u8()) {
+		p_script->implicit_ready = _read_function(p_reader, p_script);
+	}
+	if (p_reader.get_u8()) {
+		p_script->static_initializer = _read_function(p_reader, p_script);
+	}
+
+	uint32_t subclass_count = p_reader.get_count();
+	for (uint32_t i = 0; i < subclass_count && !p_reader.failed; i++) {
+		HashMap<StringName, Ref<GDScript>>::Iterator subclass = p_script->subclasses.find(p_reader.get_string_name());
+		if (!subclass) {
+			p_reader.failed = true;
+			return;
+		}
+		_read_class(p_reader, subclass->value.ptr());
+	}
+
+	if (p_reader.failed) {
+		return;
+	}
+
+	p_script->_static_default_init();
+	p_script->valid = true;
+	p_script->_invalidate_inline_caches();
+}
+
+void GDScriptBytecodeCache::_clear_class(GDScript *p_script) {
+	// Undoes a partial load, so the script can be compiled from its tokens instead.
+	p_script->clearing = true;
+
+	HashMap<StringName, GDScriptFunction *> member_functions = p_script->member_functions;
+	p_script->member_functions.clear();
+	for (const KeyValue<StringName, GDScriptFunction *> &E : member_functions) {
+		memdelete(E.value);
+	}
+	if (p_script->implicit_initializer) {
+		memdelete(p_script->implicit_initializer);
+	}
+	if (p_script->implicit_ready) {
+		memdelete(p_script->implicit_ready);
+	}
+	if (p_script->static_initializer) {
+		memdelete(p_script->static_initializer);
+	}
+
+	p_script->native = Ref<GDScriptNativeClass>();
+	p_script->base = Ref<GDScript>();
+	p_script->_base = nullptr;
+	p_script->members.clear();
+	p_script->member_indices.clear();
+	p_script->static_variables_indices.clear();
+	p_script->static_variables.clear();
+	p_script->constants.clear();
+	p_script->_signals.clear();
+	p_script->rpc_config.clear();
+	p_script->lambda_info.clear();
+	p_script->initializer = nullptr;
+	p_script->implicit_initializer = nullptr;
+	p_script->implicit_ready = nullptr;
+	p_script->static_initializer = nullptr;
+	p_script->valid = false;
+	p_script->_invalidate_inline_caches();
+
+	p_script->clearing = false;
+
+	for (KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		_clear_class(E.value.ptr());
+	}
+}
+
+String GDScriptBytecodeCache::get_cache_path(const String &p_binary_tokens_path) {
+	return p_binary_tokens_path.get_basename() + ".gdbc";
+}
+
+bool GDScriptBytecodeCache::is_valid(const Vector<uint8_t> &p_buffer, const Vector<uint8_t> &p_binary_tokens) {
+	Reader reader(p_buffer);
+	uint32_t tokens_hash = 0;
+	uint32_t flags = 0;
+	if (!_read_header(reader, tokens_hash, flags)) {
+		return false;
+	}
+
+#ifndef DEBUG_ENABLED
+	if (flags & FLAG_DEBUG_CODE) {
+		return false; // Compile it instead, so assertions are left out.
+	}
+#endif
+
+	return tokens_hash == hash_djb2_buffer(p_binary_tokens.ptr(), p_binary_tokens.size());
+}
+
+bool GDScriptBytecodeCache::has_debug_code(const Vector<uint8_t> &p_buffer) {
+	Reader reader(p_buffer);
+	uint32_t tokens_hash = 0;
+	uint32_t flags = 0;
+	if (!_read_header(reader, tokens_hash, flags)) {
+		return false;
+	}
+	return flags & FLAG_DEBUG_CODE;
+}
+
+Error GDScriptBytecodeCache::make_scripts(GDScript *p_script, const Vector<uint8_t> &p_buffer) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+
+	Reader reader(p_buffer);
+	uint32_t tokens_hash = 0;
+	uint32_t flags = 0;
+	if (!_read_header(reader, tokens_hash, flags)) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+
+	uint32_t dependency_count = reader.get_count();
+	for (uint32_t i = 0; i < dependency_count; i++) {
+		reader.get_string();
+		reader.get_u32();
+	}
+
+	p_script->fully_qualified_name = reader.get_string();
+	_read_class_tree(reader, p_script);
+
+	return reader.failed ? ERR_FILE_CORRUPT : OK;
+}
+
+Error GDScriptBytecodeCache::load(GDScript *p_script, const Vector<uint8_t> &p_buffer) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+
+	if (!p_script->member_functions.is_empty() || p_script->implicit_initializer) {
+		return ERR_ALREADY_IN_USE; // Only scripts that were never compiled load from the cache.
+	}
+
+	Reader reader(p_buffer);
+	reader.root = p_script;
+	uint32_t tokens_hash = 0;
+	uint32_t flags = 0;
+	if (!_read_header(reader, tokens_hash, flags) || tokens_hash != hash_djb2_buffer(p_script->binary_tokens.ptr(), p_script->binary_tokens.size())) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+
+	// Indices of members and static variables of other scripts are part of the bytecode, so those
+	// scripts must be the ones it was compiled against.
+	uint32_t dependency_count = reader.get_count();
+	for (uint32_t i = 0; i < dependency_count && !reader.failed; i++) {
+		String path = reader.get_string();
+		uint32_t dependency_hash = reader.get_u32();
+		if (reader.failed) {
+			break;
+		}
+
+		Error err = OK;
+		Ref<GDScript> dependency = GDScriptCache::get_shallow_script(path, err, p_script->path);
+		if (err != OK || dependency.is_null() || dependency->binary_tokens.is_empty()) {
+			return ERR_FILE_MISSING_DEPENDENCIES;
+		}
+		if (hash_djb2_buffer(dependency->binary_tokens.ptr(), dependency->binary_tokens.size()) != dependency_hash) {
+			return ERR_FILE_MISSING_DEPENDENCIES;
+		}
+	}
+
+	p_script->fully_qualified_name = reader.get_string();
+	_read_class_tree(reader, p_script);
+
+	p_script->_owner = nullptr;
+	_read_class(reader, p_script);
+
+	if (reader.failed) {
+		_clear_class(p_script);
+		return ERR_FILE_CORRUPT;
+	}
+
+	if (flags & FLAG_STATIC_SCRIPT) {
+		GDScriptCache::add_static_script(p_script);
+	}
+
+	return GDScriptCache::finish_compiling(p_script->path);
+}
+
+#ifdef TOOLS_ENABLED
+struct GDScriptBytecodeCacheWriter::Writer {
+	Vector<uint8_t> data;
+	bool failed = false;
+	String error;
+	const GDScript *root = nullptr;
+	HashSet<String> dependencies;
+	bool debug_code = false;
+
+	void fail(const String &p_error) {
+		if (!failed) {
+			failed = true;
+			error = p_error;
+		}
+	}
+
+	void put_u8(uint8_t p_value) {
+		data.push_back(p_value);
+	}
+
+	void put_u32(uint32_t p_value) {
+		int position = data.size();
+		data.resize(position + 4);
+		encode_uint32(p_value, data.ptrw() + position);
+	}
+
+	void put_int(int p_value) {
+		put_u32(uint32_t(p_value));
+	}
+
+	void put_string(const String &p_string) {
+		CharString utf8 = p_string.utf8();
+		put_u32(utf8.length());
+		if (utf8.length()) {
+			int position = data.size();
+			data.resize(position + utf8.length());
+			memcpy(data.ptrw() + position, utf8.get_data(), utf8.length());
+		}
+	}
+
+	void put_plain_variant(const Variant &p_variant) {
+		int length = 0;
+		if (encode_variant(p_variant, nullptr, length, false) != OK) {
+			fail(vformat("constant of type %s can't be stored", Variant::get_type_name(p_variant.get_type())));
+			return;
+		}
+		put_u32(length);
+		int position = data.size();
+		data.resize(position + length);
+		encode_variant(p_variant, data.ptrw() + position, length, false);
+	}
+};
+
+uint32_t GDScriptBytecodeCacheWriter::_get_dependency_hash(const String &p_path) {
+	if (HashMap<String, uint32_t>::Iterator E = dependency_hashes.find(p_path)) {
+		return E->value;
+	}
+
+	// Hash the tokens the dependency is exported as, which is what the loader compares against.
+	Vector<uint8_t> tokens = FileAccess::get_file_as_bytes(p_path);
+	if (p_path.get_extension().to_lower() != "gdc") {
+		String source;
+		source.parse_utf8(reinterpret_cast<const char *>(tokens.ptr()), tokens.size());
+		tokens = GDScriptTokenizerBuffer::parse_code_string(source, compress_mode);
+	}
+	uint32_t hash = hash_djb2_buffer(tokens.ptr(), tokens.size());
+
+	dependency_hashes.insert(p_path, hash);
+	return hash;
+}
+
+void GDScriptBytecodeCacheWriter::_write_class_tree(Writer &p_writer, const GDScript *p_script) {
+	p_writer.put_string(p_script->local_name);
+	p_writer.put_string(p_script->global_name);
+	p_writer.put_string(p_script->simplified_icon_path);
+
+	p_writer.put_u32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		p_writer.put_string(E.key);
+		p_writer.put_string(E.value->fully_qualified_name);
+		_write_class_tree(p_writer, E.value.ptr());
+	}
+}
+
+void GDScriptBytecodeCacheWriter::_write_script(Writer &p_writer, const Script *p_script) {
+	if (p_script == nullptr) {
+		p_writer.put_u8(GDScriptBytecodeCache::SCRIPT_NONE);
+		return;
+	}
+
+	const GDScript *gdscript = Object::cast_to<GDScript>(p_script);
+	if (gdscript == nullptr) {
+		if (p_script->is_built_in()) {
+			p_writer.fail(vformat(R"(built-in script "%s" can't be referenced)", p_script->get_path()));
+			return;
+		}
+		p_writer.put_u8(GDScriptBytecodeCache::SCRIPT_RESOURCE);
+		p_writer.put_string(p_script->get_path());
+		return;
+	}
+
+	const GDScript *root = gdscript;
+	while (root->_owner) {
+		root = root->_owner;
+	}
+	if (root->path.is_empty() || root->path.contains("::")) {
+		p_writer.fail(vformat(R"(built-in script "%s" can't be referenced)", root->path));
+		return;
+	}
+	if (root != p_writer.root) {
+		p_writer.dependencies.insert(root->path);
+	}
+
+	p_writer.put_u8(GDScriptBytecodeCache::SCRIPT_GDSCRIPT);
+	p_writer.put_string(root->path);
+	p_writer.put_string(gdscript->fully_qualified_name);
+}
+
+void GDScriptBytecodeCacheWriter::_write_variant(Writer &p_writer, const Variant &p_variant) {
+	switch (p_variant.get_type()) {
+		case Variant::OBJECT: {
+			Object *object = p_variant.get_validated_object();
+			if (object == nullptr) {
+				p_writer.put_u8(GDScriptBytecodeCache::VARIANT_PLAIN);
+				p_writer.put_plain_variant(Variant());
+				return;
+			}
+
+			if (HashMap<ObjectID, StringName>::Iterator E = global_objects.find(object->get_instance_id())) {
+				p_writer.put_u8(GDScriptBytecodeCache::VARIANT_GLOBAL);
+				p_writer.put_string(E->value);
+				return;
+			}
+
+			if (const GDScript *script = Object::cast_to<GDScript>(object)) {
+				p_writer.put_u8(GDScriptBytecodeCache::VARIANT_SCRIPT);
+				_write_script(p_writer, script);
+				return;
+			}
+
+			const Resource *resource = Object::cast_to<Resource>(object);
+			if (resource == nullptr || resource->is_built_in()) {
+				p_writer.fail(vformat(R"(constant of class "%s" has no path to load it from)", object->get_class()));
+				return;
+			}
+			p_writer.put_u8(GDScriptBytecodeCache::VARIANT_RESOURCE);
+			p_writer.put_string(resource->get_path());
+		} break;
+		case Variant::ARRAY: {
+			const Array array = p_variant;
+			p_writer.put_u8(GDScriptBytecodeCache::VARIANT_ARRAY);
+			p_writer.put_u8(array.is_read_only());
+			p_writer.put_u8(array.is_typed());
+			if (array.is_typed()) {
+				p_writer.put_u32(array.get_typed_builtin());
+				p_writer.put_string(array.get_typed_class_name());
+				_write_variant(p_writer, array.get_typed_script());
+			}
+			p_writer.put_u32(array.size());
+			for (int i = 0; i < array.size(); i++) {
+				_write_variant(p_writer, array[i]);
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			const Dictionary dictionary = p_variant;
+			p_writer.put_u8(GDScriptBytecodeCache::VARIANT_DICTIONARY);
+			p_writer.put_u8(dictionary.is_read_only());
+			p_writer.put_u8(dictionary.is_typed());
+			if (dictionary.is_typed()) {
+				p_writer.put_u32(dictionary.get_typed_key_builtin());
+				p_writer.put_string(dictionary.get_typed_key_class_name());
+				_write_variant(p_writer, dictionary.get_typed_key_script());
+				p_writer.put_u32(dictionary.get_typed_value_builtin());
+				p_writer.put_string(dictionary.get_typed_value_class_name());
+				_write_variant(p_writer, dictionary.get_typed_value_script());
+			}
+			const Array keys = dictionary.keys();
+			p_writer.put_u32(keys.size());
+			for (int i = 0; i < keys.size(); i++) {
+				_write_variant(p_writer, keys[i]);
+				_write_variant(p_writer, dictionary[keys[i]]);
+			}
+		} break;
+		case Variant::RID:
+		case Variant::CALLABLE:
+		case Variant::SIGNAL: {
+			p_writer.fail(vformat("constant of type %s can't be stored", Variant::get_type_name(p_variant.get_type())));
+		} break;
+		default: {
+			p_writer.put_u8(GDScriptBytecodeCache::VARIANT_PLAIN);
+			p_writer.put_plain_variant(p_variant);
+		} break;
+	}
+}
+
+void GDScriptBytecodeCacheWriter::_write_data_type(Writer &p_writer, const GDScriptDataType &p_type) {
+	p_writer.put_u8(p_type.has_type);
+	p_writer.put_u8(p_type.kind);
+	p_writer.put_u32(p_type.builtin_type);
+	p_writer.put_string(p_type.native_type);
+	p_writer.put_u8(p_type.script_type_ref.is_valid());
+	_write_script(p_writer, p_type.script_type);
+
+	p_writer.put_u32(p_type.container_element_types.size());
+	for (const GDScriptDataType &element_type : p_type.container_element_types) {
+		_write_data_type(p_writer, element_type);
+	}
+}
+
+void GDScriptBytecodeCacheWriter::_write_member_info(Writer &p_writer, const GDScript::MemberInfo &p_info) {
+	p_writer.put_int(p_info.index);
+	p_writer.put_string(p_info.setter);
+	p_writer.put_string(p_info.getter);
+	_write_data_type(p_writer, p_info.data_type);
+	_write_variant(p_writer, Dictionary(p_info.property_info));
+}
+
+void GDScriptBytecodeCacheWriter::_write_function(Writer &p_writer, const GDScriptFunction *p_function) {
+	p_writer.put_string(p_function->name);
+	p_writer.put_u8(p_function->_static);
+	p_writer.put_int(p_function->_argument_count);
+	p_writer.put_u32(p_function->argument_types.size());
+	for (const GDScriptDataType &argument_type : p_function->argument_types) {
+		_write_data_type(p_writer, argument_type);
+	}
+	_write_data_type(p_writer, p_function->return_type);
+	_write_variant(p_writer, Dictionary(p_function->method_info));
+	_write_variant(p_writer, p_function->rpc_config);
+	p_writer.put_int(p_function->_initial_line);
+	p_writer.put_int(p_function->_stack_size);
+	p_writer.put_int(p_function->_instruction_args_size);
+
+	p_writer.put_u32(p_function->temporary_slots.size());
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		p_writer.put_int(E.key);
+		p_writer.put_u32(E.value);
+	}
+
+	p_writer.put_u32(p_function->code.size());
+	for (int word : p_function->code) {
+		p_writer.put_int(word);
+	}
+
+	p_writer.put_u32(p_function->default_arguments.size());
+	for (int address : p_function->default_arguments) {
+		p_writer.put_int(address);
+	}
+
+	p_writer.put_u32(p_function->constants.size());
+	for (const Variant &constant : p_function->constants) {
+		_write_variant(p_writer, constant);
+	}
+
+	p_writer.put_u32(p_function->global_names.size());
+	for (const StringName &name : p_function->global_names) {
+		p_writer.put_string(name);
+	}
+
+	p_writer.put_u32(p_function->operator_funcs.size());
+	for (Variant::ValidatedOperatorEvaluator evaluator : p_function->operator_funcs) {
+		RBMap<Variant::ValidatedOperatorEvaluator, OperatorKey>::Element *E = operator_keys.find(evaluator);
+		if (E == nullptr) {
+			p_writer.fail("unknown operator evaluator");
+			return;
+		}
+		p_writer.put_u32(E->get().op);
+		p_writer.put_u32(E->get().left);
+		p_writer.put_u32(E->get().right);
+	}
+
+	p_writer.put_u32(p_function->setters.size());
+	for (Variant::ValidatedSetter setter : p_function->setters) {
+		RBMap<Variant::ValidatedSetter, Pair<Variant::Type, StringName>>::Element *E = setter_keys.find(setter);
+		if (E == nullptr) {
+			p_writer.fail("unknown member setter");
+			return;
+		}
+		p_writer.put_u32(E->get().first);
+		p_writer.put_string(E->get().second);
+	}
+
+	p_writer.put_u32(p_function->getters.size());
+	for (Variant::ValidatedGetter getter : p_function->getters) {
+		RBMap<Variant::ValidatedGetter, Pair<Variant::Type, StringName>>::Element *E = getter_keys.find(getter);
+		if (E == nullptr) {
+			p_writer.fail("unknown member getter");
+			return;
+		}
+		p_writer.put_u32(E->get().first);
+		p_writer.put_string(E->get().second);
+	}
+
+	p_writer.put_u32(p_function->keyed_setters.size());
+	for (Variant::ValidatedKeyedSetter setter : p_function->keyed_setters) {
+		RBMap<Variant::ValidatedKeyedSetter, Variant::Type>::Element *E = keyed_setter_keys.find(setter);
+		if (E == nullptr) {
+			p_writer.fail("unknown keyed setter");
+			return;
+		}
+		p_writer.put_u32(E->get());
+	}
+
+	p_writer.put_u32(p_function->keyed_getters.size());
+	for (Variant::ValidatedKeyedGetter getter : p_function->keyed_getters) {
+		RBMap<Variant::ValidatedKeyedGetter, Variant::Type>::Element *E = keyed_getter_keys.find(getter);
+		if (E == nullptr) {
+			p_writer.fail("unknown keyed getter");
+			return;
+		}
+		p_writer.put_u32(E->get());
+	}
+
+	p_writer.put_u32(p_function->indexed_setters.size());
+	for (Variant::ValidatedIndexedSetter setter : p_function->indexed_setters) {
+		RBMap<Variant::ValidatedIndexedSetter, Variant::Type>::Element *E = indexed_setter_keys.find(setter);
+		if (E == nullptr) {
+			p_writer.fail("unknown indexed setter");
+			return;
+		}
+		p_writer.put_u32(E->get());
+	}
+
+	p_writer.put_u32(p_function->indexed_getters.size());
+	for (Variant::ValidatedIndexedGetter getter : p_function->indexed_getters) {
+		RBMap<Variant::ValidatedIndexedGetter, Variant::Type>::Element *E = indexed_getter_keys.find(getter);
+		if (E == nullptr) {
+			p_writer.fail("unknown indexed getter");
+			return;
+		}
+		p_writer.put_u32(E->get());
+	}
+
+	p_writer.put_u32(p_function->builtin_methods.size());
+	for (Variant::ValidatedBuiltInMethod method : p_function->builtin_methods) {
+		RBMap<Variant::ValidatedBuiltInMethod, Pair<Variant::Type, StringName>>::Element *E = builtin_method_keys.find(method);
+		if (E == nullptr) {
+			p_writer.fail("unknown built-in method");
+			return;
+		}
+		p_writer.put_u32(E->get().first);
+		p_writer.put_string(E->get().second);
+	}
+
+	p_writer.put_u32(p_function->constructors.size());
+	for (Variant::ValidatedConstructor constructor : p_function->constructors) {
+		RBMap<Variant::ValidatedConstructor, Pair<Variant::Type, int>>::Element *E = constructor_keys.find(constructor);
+		if (E == nullptr) {
+			p_writer.fail("unknown constructor");
+			return;
+		}
+		p_writer.put_u32(E->get().first);
+		p_writer.put_int(E->get().second);
+	}
+
+	p_writer.put_u32(p_function->utilities.size());
+	for (Variant::ValidatedUtilityFunction utility : p_function->utilities) {
+		RBMap<Variant::ValidatedUtilityFunction, StringName>::Element *E = utility_keys.find(utility);
+		if (E == nullptr) {
+			p_writer.fail("unknown utility function");
+			return;
+		}
+		p_writer.put_string(E->get());
+	}
+
+	p_writer.put_u32(p_function->gds_utilities.size());
+	for (GDScriptUtilityFunctions::FunctionPtr utility : p_function->gds_utilities) {
+		RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName>::Element *E = gds_utility_keys.find(utility);
+		if (E == nullptr) {
+			p_writer.fail("unknown GDScript utility function");
+			return;
+		}
+		p_writer.put_string(E->get());
+	}
+
+	p_writer.put_u32(p_function->methods.size());
+	for (const MethodBind *method : p_function->methods) {
+		p_writer.put_string(method->get_instance_class());
+		p_writer.put_string(method->get_name());
+	}
+
+	p_writer.put_u32(p_function->global_instructions.size());
+	for (int position : p_function->global_instructions) {
+		const int operand = p_function->code[position + 2];
+		StringName name;
+		if (p_function->code[position] == GDScriptFunction::OPCODE_STORE_GLOBAL) {
+			HashMap<int, StringName>::Iterator E = global_indices.find(operand);
+			if (!E) {
+				p_writer.fail("unknown global");
+				return;
+			}
+			name = E->value;
+		} else {
+			name = p_function->global_names[operand];
+		}
+		p_writer.put_int(position);
+		p_writer.put_string(name);
+	}
+	p_writer.debug_code = p_writer.debug_code || p_function->has_debug_code;
+
+	p_writer.put_u32(p_function->lambdas.size());
+	for (const GDScriptFunction *lambda : p_function->lambdas) {
+		HashMap<GDScriptFunction *, GDScript::LambdaInfo>::ConstIterator info = lambda->_script->lambda_info.find(const_cast<GDScriptFunction *>(lambda));
+		p_writer.put_u8(bool(info));
+		p_writer.put_int(info ? info->value.capture_count : 0);
+		p_writer.put_u8(info ? info->value.use_self : false);
+		_write_function(p_writer, lambda);
+	}
+
+	p_writer.put_int(p_function->_inline_caches_count);
+}
+
+void GDScriptBytecodeCacheWriter::_write_class(Writer &p_writer, const GDScript *p_script) {
+	p_writer.put_u8(p_script->tool);
+	p_writer.put_string(p_script->native.is_valid() ? p_script->native->get_name() : StringName());
+
+	p_writer.put_u8(p_script->base.is_valid());
+	if (p_script->base.is_valid()) {
+		_write_script(p_writer, p_script->base.ptr());
+	}
+
+	p_writer.put_u32(p_script->member_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->member_indices) {
+		p_writer.put_string(E.key);
+		_write_member_info(p_writer, E.value);
+	}
+
+	p_writer.put_u32(p_script->members.size());
+	for (const StringName &member : p_script->members) {
+		p_writer.put_string(member);
+	}
+
+	p_writer.put_u32(p_script->static_variables_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->static_variables_indices) {
+		p_writer.put_string(E.key);
+		_write_member_info(p_writer, E.value);
+	}
+
+	p_writer.put_u32(p_script->constants.size());
+	for (const KeyValue<StringName, Variant> &E : p_script->constants) {
+		p_writer.put_string(E.key);
+		_write_variant(p_writer, E.value);
+	}
+
+	p_writer.put_u32(p_script->_signals.size());
+	for (const KeyValue<StringName, MethodInfo> &E : p_script->_signals) {
+		p_writer.put_string(E.key);
+		_write_variant(p_writer, Dictionary(E.value));
+	}
+
+	_write_variant(p_writer, p_script->rpc_config);
+
+	p_writer.put_u32(p_script->member_functions.size());
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		_write_function(p_writer, E.value);
+	}
+
+	const GDScriptFunction *implicit_functions[3] = { p_script->implicit_initializer, p_script->implicit_ready, p_script->static_initializer };
+	for (const GDScriptFunction *function : implicit_functions) {
+		p_writer.put_u8(function != nullptr);
+		if (function) {
+			_write_function(p_writer, function);
+		}
+	}
+
+	p_writer.put_u32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		p_writer.put_string(E.key);
+		_write_class(p_writer, E.value.ptr());
+	}
+}
+
+Error GDScriptBytecodeCacheWriter::write(const Ref<GDScript> &p_script, const Vector<uint8_t> &p_binary_tokens, Vector<uint8_t> &r_buffer) {
+	ERR_FAIL_COND_V(p_script.is_null(), ERR_INVALID_PARAMETER);
+	if (!p_script->is_valid()) {
+		return ERR_INVALID_DATA;
+	}
+
+	Writer body;
+	body.root = p_script.ptr();
+	_write_class(body, p_script.ptr());
+	if (body.failed) {
+		print_verbose(vformat(R"(GDScript: Not caching the bytecode of "%s", %s.)", p_script->get_path(), body.error));
+		return ERR_UNAVAILABLE;
+	}
+
+	uint32_t flags = 0;
+	if (body.debug_code) {
+		flags |= GDScriptBytecodeCache::FLAG_DEBUG_CODE;
+	}
+	{
+		MutexLock lock(GDScriptCache::mutex);
+		if (GDScriptCache::singleton->static_gdscript_cache.has(p_script->fully_qualified_name)) {
+			flags |= GDScriptBytecodeCache::FLAG_STATIC_SCRIPT;
+		}
+	}
+
+	Writer header;
+	for (int i = 0; i < 4; i++) {
+		header.put_u8(BYTECODE_CACHE_MAGIC[i]);
+	}
+	header.put_u32(GDScriptBytecodeCache::FORMAT_VERSION);
+	header.put_u32(GDScriptBytecodeCache::_get_engine_hash());
+	header.put_u32(hash_djb2_buffer(p_binary_tokens.ptr(), p_binary_tokens.size()));
+	header.put_u32(flags);
+
+	header.put_u32(body.dependencies.size());
+	for (const String &dependency : body.dependencies) {
+		header.put_string(dependency);
+		header.put_u32(_get_dependency_hash(dependency));
+	}
+
+	header.put_string(p_script->fully_qualified_name);
+	_write_class_tree(header, p_script.ptr());
+
+	r_buffer = header.data;
+	r_buffer.append_array(body.data);
+	return OK;
+}
+
+GDScriptBytecodeCacheWriter::GDScriptBytecodeCacheWriter(GDScriptTokenizerBuffer::CompressMode p_compress_mode) {
+	compress_mode = p_compress_mode;
+
+	for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+		const Variant::Type type = Variant::Type(i);
+
+		for (int op = 0; op < Variant::OP_MAX; op++) {
+			for (int j = 0; j < Variant::VARIANT_MAX; j++) {
+				Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(Variant::Operator(op), type, Variant::Type(j));
+				if (evaluator && !operator_keys.has(evaluator)) {
+					operator_keys.insert(evaluator, { Variant::Operator(op), type, Variant::Type(j) });
+				}
+			}
+		}
+
+		List<StringName> members;
+		Variant::get_member_list(type, &members);
+		for (const StringName &member : members) {
+			Variant::ValidatedSetter setter = Variant::get_member_validated_setter(type, member);
+			if (setter && !setter_keys.has(setter)) {
+				setter_keys.insert(setter, Pair<Variant::Type, StringName>(type, member));
+			}
+			Variant::ValidatedGetter getter = Variant::get_member_validated_getter(type, member);
+			if (getter && !getter_keys.has(getter)) {
+				getter_keys.insert(getter, Pair<Variant::Type, StringName>(type, member));
+			}
+		}
+
+		Variant::ValidatedKeyedSetter keyed_setter = Variant::get_member_validated_keyed_setter(type);
+		if (keyed_setter && !keyed_setter_keys.has(keyed_setter)) {
+			keyed_setter_keys.insert(keyed_setter, type);
+		}
+		Variant::ValidatedKeyedGetter keyed_getter = Variant::get_member_validated_keyed_getter(type);
+		if (keyed_getter && !keyed_getter_keys.has(keyed_getter)) {
+			keyed_getter_keys.insert(keyed_getter, type);
+		}
+		Variant::ValidatedIndexedSetter indexed_setter = Variant::get_member_validated_indexed_setter(type);
+		if (indexed_setter && !indexed_setter_keys.has(indexed_setter)) {
+			indexed_setter_keys.insert(indexed_setter, type);
+		}
+		Variant::ValidatedIndexedGetter indexed_getter = Variant::get_member_validated_indexed_getter(type);
+		if (indexed_getter && !indexed_getter_keys.has(indexed_getter)) {
+			indexed_getter_keys.insert(indexed_getter, type);
+		}
+
+		List<StringName> methods;
+		Variant::get_builtin_method_list(type, &methods);
+		for (const StringName &method : methods) {
+			Variant::ValidatedBuiltInMethod builtin_method = Variant::get_validated_builtin_method(type, method);
+			if (builtin_method && !builtin_method_keys.has(builtin_method)) {
+				builtin_method_keys.insert(builtin_method, Pair<Variant::Type, StringName>(type, method));
+			}
+		}
+
+		for (int j = 0; j < Variant::get_constructor_count(type); j++) {
+			Variant::ValidatedConstructor constructor = Variant::get_validated_constructor(type, j);
+			if (constructor && !constructor_keys.has(constructor)) {
+				constructor_keys.insert(constructor, Pair<Variant::Type, int>(type, j));
+			}
+		}
+	}
+
+	List<StringName> utilities;
+	Variant::get_utility_function_list(&utilities);
+	for (const StringName &utility : utilities) {
+		Variant::ValidatedUtilityFunction function = Variant::get_validated_utility_function(utility);
+		if (function && !utility_keys.has(function)) {
+			utility_keys.insert(function, utility);
+		}
+	}
+
+	List<StringName> gds_utilities;
+	GDScriptUtilityFunctions::get_function_list(&gds_utilities);
+	for (const StringName &utility : gds_utilities) {
+		GDScriptUtilityFunctions::FunctionPtr function = GDScriptUtilityFunctions::get_function(utility);
+		if (function && !gds_utility_keys.has(function)) {
+			gds_utility_keys.insert(function, utility);
+		}
+	}
+
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	for (const KeyValue<StringName, int> &E : language->get_global_map()) {
+		global_indices.insert(E.value, E.key);
+		Object *object = language->get_global_array()[E.value].get_validated_object();
+		if (object && !global_objects.has(object->get_instance_id())) {
+			global_objects.insert(object->get_instance_id(), E.key);
+		}
+	}
+}
+#endif // TOOLS_ENABLED
@@ -0,0 +1,137 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_BYTECODE_CACHE_H
+#define GDSCRIPT_BYTECODE_CACHE_H
+
+#include "gdscript.h"
+#include "gdscript_tokenizer_buffer.h"
+
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/rb_map.h"
+
+// Compiled bytecode of an exported script, stored next to its binary tokens (`.gdc`) as a `.gdbc`
+// file. Loading it skips parsing, analysis and code generation. References to engine and script
+// entities are stored by name and resolved again when loading, so a cache is only rejected when
+// the engine version, the script tokens or the tokens of a script it depends on change.
+class GDScriptBytecodeCache {
+	friend class GDScriptBytecodeCacheWriter;
+
+	static constexpr uint32_t FORMAT_VERSION = 1;
+
+	enum Flags {
+		FLAG_DEBUG_CODE = 1, // Has code that release builds compile out, such as assertions.
+		FLAG_STATIC_SCRIPT = 2, // Keeps its static data loaded, see `GDScriptCache::add_static_script()`.
+	};
+
+	enum VariantTag {
+		VARIANT_PLAIN,
+		VARIANT_GLOBAL,
+		VARIANT_SCRIPT,
+		VARIANT_RESOURCE,
+		VARIANT_ARRAY,
+		VARIANT_DICTIONARY,
+	};
+
+	enum ScriptTag {
+		SCRIPT_NONE,
+		SCRIPT_GDSCRIPT,
+		SCRIPT_RESOURCE,
+	};
+
+	struct Reader;
+
+	static uint32_t _get_engine_hash();
+	static bool _read_header(Reader &p_reader, uint32_t &r_tokens_hash, uint32_t &r_flags);
+	static void _read_class_tree(Reader &p_reader, GDScript *p_script);
+	static Ref<Script> _read_script(Reader &p_reader, bool &r_local);
+	static Variant _read_variant(Reader &p_reader);
+	static void _read_data_type(Reader &p_reader, GDScriptDataType &r_type);
+	static void _read_member_info(Reader &p_reader, GDScript::MemberInfo &r_info);
+	static GDScriptFunction *_read_function(Reader &p_reader, GDScript *p_script);
+	static void _read_class(Reader &p_reader, GDScript *p_script);
+	static void _clear_class(GDScript *p_script);
+
+public:
+	static String get_cache_path(const String &p_binary_tokens_path);
+	static bool is_valid(const Vector<uint8_t> &p_buffer, const Vector<uint8_t> &p_binary_tokens);
+	// Whether release builds reject the cache, see `is_valid()`.
+	static bool has_debug_code(const Vector<uint8_t> &p_buffer);
+	static Error make_scripts(GDScript *p_script, const Vector<uint8_t> &p_buffer);
+	static Error load(GDScript *p_script, const Vector<uint8_t> &p_buffer);
+};
+
+#ifdef TOOLS_ENABLED
+// Serializes compiled scripts on export. Keeps the lookup tables mapping validated function
+// pointers back to their names, so one writer should be reused for a whole export.
+class GDScriptBytecodeCacheWriter {
+	struct Writer;
+
+	struct OperatorKey {
+		Variant::Operator op = Variant::OP_MAX;
+		Variant::Type left = Variant::NIL;
+		Variant::Type right = Variant::NIL;
+	};
+
+	GDScriptTokenizerBuffer::CompressMode compress_mode = GDScriptTokenizerBuffer::COMPRESS_NONE;
+
+	RBMap<Variant::ValidatedOperatorEvaluator, OperatorKey> operator_keys;
+	RBMap<Variant::ValidatedSetter, Pair<Variant::Type, StringName>> setter_keys;
+	RBMap<Variant::ValidatedGetter, Pair<Variant::Type, StringName>> getter_keys;
+	RBMap<Variant::ValidatedKeyedSetter, Variant::Type> keyed_setter_keys;
+	RBMap<Variant::ValidatedKeyedGetter, Variant::Type> keyed_getter_keys;
+	RBMap<Variant::ValidatedIndexedSetter, Variant::Type> indexed_setter_keys;
+	RBMap<Variant::ValidatedIndexedGetter, Variant::Type> indexed_getter_keys;
+	RBMap<Variant::ValidatedBuiltInMethod, Pair<Variant::Type, StringName>> builtin_method_keys;
+	RBMap<Variant::ValidatedConstructor, Pair<Variant::Type, int>> constructor_keys;
+	RBMap<Variant::ValidatedUtilityFunction, StringName> utility_keys;
+	RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName> gds_utility_keys;
+	HashMap<ObjectID, StringName> global_objects;
+	HashMap<int, StringName> global_indices;
+	HashMap<String, uint32_t> dependency_hashes;
+
+	uint32_t _get_dependency_hash(const String &p_path);
+	void _write_class_tree(Writer &p_writer, const GDScript *p_script);
+	void _write_script(Writer &p_writer, const Script *p_script);
+	void _write_variant(Writer &p_writer, const Variant &p_variant);
+	void _write_data_type(Writer &p_writer, const GDScriptDataType &p_type);
+	void _write_member_info(Writer &p_writer, const GDScript::MemberInfo &p_info);
+	void _write_function(Writer &p_writer, const GDScriptFunction *p_function);
+	void _write_class(Writer &p_writer, const GDScript *p_script);
+
+public:
+	Error write(const Ref<GDScript> &p_script, const Vector<uint8_t> &p_binary_tokens, Vector<uint8_t> &r_buffer);
+
+	GDScriptBytecodeCacheWriter(GDScriptTokenizerBuffer::CompressMode p_compress_mode);
+};
+#endif // TOOLS_ENABLED
+
+#endif // GDSCRIPT_BYTECODE_CACHE_H
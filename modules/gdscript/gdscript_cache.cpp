@@ -32,11 +32,13 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
 #include "core/io/file_access.h"
 #include "core/templates/vector.h"
+#include "servers/text_server.h"
 
 GDScriptParserRef::Status GDScriptParserRef::get_status() const {
 	return status;
@@ -85,6 +87,9 @@ Error GDScriptParserRef::raise_status(Status p_new_status) {
 					source_hash = source.hash();
 					result = get_parser()->parse(source, path, false);
 				}
+				if (result == OK) {
+					GDScriptCache::_prefetch_dependencies(this);
+				}
 			} break;
 			case PARSED: {
 				status = INHERITANCE_SOLVED;
@@ -143,6 +148,7 @@ GDScriptParserRef::~GDScriptParserRef() {
 }
 
 GDScriptCache *GDScriptCache::singleton = nullptr;
+bool GDScriptCache::parallel_parsing = true;
 
 SafeBinaryMutex<GDScriptCache::BINARY_MUTEX_TAG> &_get_gdscript_cache_mutex() {
 	return GDScriptCache::mutex;
@@ -198,6 +204,8 @@ void GDScriptCache::remove_script(const String &p_path) {
 
 	singleton->abandoned_parser_map.erase(p_path);
 
+	_discard_prefetched_parsers(p_path);
+
 	if (singleton->parser_map.has(p_path)) {
 		singleton->parser_map[p_path]->clear();
 	}
@@ -216,6 +224,14 @@ Ref<GDScriptParserRef> GDScriptCache::get_parser(const String &p_path, GDScriptP
 		singleton->dependencies[p_owner].insert(p_path);
 		singleton->parser_inverse_dependencies[p_path].insert(p_owner);
 	}
+	if (!singleton->parser_map.has(p_path)) {
+		ref = _claim_prefetched_parser(p_path);
+		// Waiting for the prefetching task may have let another thread create this parser.
+		if (ref.is_valid() && !singleton->parser_map.has(p_path)) {
+			ref->abandoned = false;
+			singleton->parser_map[p_path] = ref.ptr();
+		}
+	}
 	if (singleton->parser_map.has(p_path)) {
 		ref = Ref<GDScriptParserRef>(singleton->parser_map[p_path]);
 		if (ref.is_null()) {
@@ -237,6 +253,114 @@ Ref<GDScriptParserRef> GDScriptCache::get_parser(const String &p_path, GDScriptP
 	return ref;
 }
 
+void GDScriptCache::_prefetch_parser(void *p_parser_ref) {
+	GDScriptParserRef *parser_ref = static_cast<GDScriptParserRef *>(p_parser_ref);
+	// Missing files are left unparsed, for `get_parser()` to report them.
+	if (FileAccess::exists(ResourceLoader::path_remap(parser_ref->path))) {
+		parser_ref->raise_status(GDScriptParserRef::PARSED);
+	}
+}
+
+void GDScriptCache::_prefetch_dependencies(GDScriptParserRef *p_parser_ref) {
+	if (!parallel_parsing || singleton == nullptr || WorkerThreadPool::get_singleton() == nullptr) {
+		return;
+	}
+
+	List<String> paths = p_parser_ref->get_parser()->get_dependencies();
+	for (const String &E : p_parser_ref->get_parser()->get_global_class_dependencies()) {
+		paths.push_back(E);
+	}
+
+	MutexLock lock(singleton->prefetch_mutex);
+	if (singleton->cleared) {
+		return;
+	}
+	if (!singleton->prefetch_initialized) {
+		// The parser initializes some shared data on first use, which would race between threads.
+		// This runs before the first prefetching task is added.
+		GDScriptParser::get_builtin_type(StringName());
+		if (TS->has_feature(TextServer::FEATURE_UNICODE_SECURITY)) {
+			TS->spoof_check("_");
+		}
+		singleton->prefetch_initialized = true;
+	}
+
+	for (const String &path : paths) {
+		if (path == p_parser_ref->path || singleton->prefetched_parsers.has(path) || ResourceCache::has(path)) {
+			continue;
+		}
+		const String extension = ResourceLoader::path_remap(path).get_extension().to_lower();
+		if (extension != "gd" && extension != "gdc") {
+			continue;
+		}
+
+		PrefetchedParser &prefetched = singleton->prefetched_parsers[path];
+		prefetched.parser_ref.instantiate();
+		prefetched.parser_ref->path = path;
+		// Not in `parser_map` until claimed.
+		prefetched.parser_ref->abandoned = true;
+		prefetched.task_id = WorkerThreadPool::get_singleton()->add_native_task(&GDScriptCache::_prefetch_parser, prefetched.parser_ref.ptr(), false, "Parse GDScript " + path);
+	}
+}
+
+Ref<GDScriptParserRef> GDScriptCache::_claim_prefetched_parser(const String &p_path) {
+	PrefetchedParser prefetched;
+	{
+		MutexLock lock(singleton->prefetch_mutex);
+		HashMap<String, PrefetchedParser>::Iterator E = singleton->prefetched_parsers.find(p_path);
+		if (!E) {
+			return Ref<GDScriptParserRef>();
+		}
+		prefetched = E->value;
+		singleton->prefetched_parsers.remove(E);
+	}
+
+	uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(singleton->mutex);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(prefetched.task_id);
+	WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
+
+	if (prefetched.parser_ref->get_status() == GDScriptParserRef::EMPTY) {
+		return Ref<GDScriptParserRef>();
+	}
+	return prefetched.parser_ref;
+}
+
+void GDScriptCache::_discard_prefetched_parsers(const String &p_path) {
+	if (singleton == nullptr) {
+		return;
+	}
+
+	// Finished tasks may have prefetched more parsers, so repeat until none is left.
+	while (true) {
+		LocalVector<WorkerThreadPool::TaskID> tasks;
+		{
+			MutexLock lock(singleton->prefetch_mutex);
+			if (p_path.is_empty()) {
+				for (const KeyValue<String, PrefetchedParser> &E : singleton->prefetched_parsers) {
+					tasks.push_back(E.value.task_id);
+				}
+				singleton->prefetched_parsers.clear();
+			} else if (HashMap<String, PrefetchedParser>::Iterator E = singleton->prefetched_parsers.find(p_path)) {
+				tasks.push_back(E->value.task_id);
+				singleton->prefetched_parsers.remove(E);
+			}
+		}
+		if (tasks.is_empty()) {
+			return;
+		}
+
+		// Callers hold `mutex`, let the pool lift it while waiting like `_claim_prefetched_parser()` does.
+		uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(singleton->mutex);
+		for (WorkerThreadPool::TaskID task_id : tasks) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+		}
+		WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
+		if (!p_path.is_empty()) {
+			return;
+		}
+	}
+}
+
 bool GDScriptCache::has_parser(const String &p_path) {
 	MutexLock lock(singleton->mutex);
 	return singleton->parser_map.has(p_path);
@@ -295,6 +419,20 @@ Vector<uint8_t> GDScriptCache::get_binary_tokens(const String &p_path) {
 	return buffer;
 }
 
+Vector<uint8_t> GDScriptCache::get_bytecode_cache(const String &p_path, const Vector<uint8_t> &p_binary_tokens) {
+	const String cache_path = GDScriptBytecodeCache::get_cache_path(p_path);
+	if (p_binary_tokens.is_empty() || !FileAccess::exists(cache_path)) {
+		return Vector<uint8_t>();
+	}
+
+	Vector<uint8_t> buffer = FileAccess::get_file_as_bytes(cache_path);
+	if (!GDScriptBytecodeCache::is_valid(buffer, p_binary_tokens)) {
+		print_verbose(vformat(R"(GDScript: Ignoring outdated bytecode cache "%s".)", cache_path));
+		return Vector<uint8_t>();
+	}
+	return buffer;
+}
+
 Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_error, const String &p_owner) {
 	MutexLock lock(singleton->mutex);
 
@@ -319,6 +457,7 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 			r_error = ERR_FILE_CANT_READ;
 		}
 		script->set_binary_tokens_source(buffer);
+		script->bytecode_cache = get_bytecode_cache(remapped_path, buffer);
 	} else {
 		r_error = script->load_source_code(remapped_path);
 	}
@@ -327,9 +466,14 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
-	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
-	if (r_error == OK) {
-		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+	if (!script->bytecode_cache.is_empty() && GDScriptBytecodeCache::make_scripts(script.ptr(), script->bytecode_cache) == OK) {
+		// The class tree is stored with the bytecode, no need to parse.
+	} else {
+		script->bytecode_cache.clear();
+		Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
+		if (r_error == OK) {
+			GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+		}
 	}
 
 	singleton->shallow_gdscript_cache[p_path] = script;
@@ -364,6 +508,7 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 	const String remapped_path = ResourceLoader::path_remap(p_path);
 
 	if (p_update_from_disk) {
+		_discard_prefetched_parsers(p_path);
 		if (remapped_path.get_extension().to_lower() == "gdc") {
 			Vector<uint8_t> buffer = get_binary_tokens(remapped_path);
 			if (buffer.is_empty()) {
@@ -371,6 +516,7 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 				return script;
 			}
 			script->set_binary_tokens_source(buffer);
+			script->bytecode_cache.clear();
 		} else {
 			r_error = script->load_source_code(remapped_path);
 			if (r_error) {
@@ -454,7 +600,11 @@ void GDScriptCache::clear() {
 	if (singleton->cleared) {
 		return;
 	}
-	singleton->cleared = true;
+	{
+		MutexLock prefetch_lock(singleton->prefetch_mutex);
+		singleton->cleared = true;
+	}
+	_discard_prefetched_parsers();
 
 	singleton->parser_inverse_dependencies.clear();
 
@@ -487,6 +637,14 @@ void GDScriptCache::clear() {
 	singleton->full_gdscript_cache.clear();
 }
 
+void GDScriptCache::set_parallel_parsing_enabled(bool p_enabled) {
+	parallel_parsing = p_enabled;
+}
+
+bool GDScriptCache::is_parallel_parsing_enabled() {
+	return parallel_parsing;
+}
+
 GDScriptCache::GDScriptCache() {
 	singleton = this;
 }
@@ -34,6 +34,7 @@
 #include "gdscript.h"
 
 #include "core/object/ref_counted.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/safe_binary_mutex.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
@@ -87,7 +88,25 @@ class GDScriptCache {
 	HashMap<String, HashSet<String>> dependencies;
 	HashMap<String, HashSet<String>> parser_inverse_dependencies;
 
+	// Dependencies are parsed ahead of time on the WorkerThreadPool as soon as the script using them
+	// is parsed, see `_prefetch_dependencies()`. Analysis stays serial, so results don't depend on timing.
+	struct PrefetchedParser {
+		Ref<GDScriptParserRef> parser_ref;
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+	};
+	HashMap<String, PrefetchedParser> prefetched_parsers;
+	// Prefetching tasks never lock `mutex`, so they can be waited for while holding it.
+	BinaryMutex prefetch_mutex;
+	bool prefetch_initialized = false;
+	static bool parallel_parsing;
+
+	static void _prefetch_parser(void *p_parser_ref);
+	static void _prefetch_dependencies(GDScriptParserRef *p_parser_ref);
+	static Ref<GDScriptParserRef> _claim_prefetched_parser(const String &p_path);
+	static void _discard_prefetched_parsers(const String &p_path = String());
+
 	friend class GDScript;
+	friend class GDScriptBytecodeCacheWriter;
 	friend class GDScriptParserRef;
 	friend class GDScriptInstance;
 
@@ -110,6 +129,7 @@ public:
 	static void remove_parser(const String &p_path);
 	static String get_source_code(const String &p_path);
 	static Vector<uint8_t> get_binary_tokens(const String &p_path);
+	static Vector<uint8_t> get_bytecode_cache(const String &p_path, const Vector<uint8_t> &p_binary_tokens);
 	static Ref<GDScript> get_shallow_script(const String &p_path, Error &r_error, const String &p_owner = String());
 	static Ref<GDScript> get_full_script(const String &p_path, Error &r_error, const String &p_owner = String(), bool p_update_from_disk = false);
 	static Ref<GDScript> get_cached_script(const String &p_path);
@@ -117,6 +137,9 @@ public:
 	static void add_static_script(Ref<GDScript> p_script);
 	static void remove_static_script(const String &p_fqcn);
 
+	static void set_parallel_parsing_enabled(bool p_enabled);
+	static bool is_parallel_parsing_enabled();
+
 	static void clear();
 
 	GDScriptCache();
@@ -2646,6 +2646,9 @@ Error GDScriptCompiler::_prepare_compilation(GDScript *p_script, const GDScriptP
 
 	parsing_classes.insert(p_script);
 
+	// Functions and members are about to be freed and rebuilt.
+	p_script->_invalidate_inline_caches();
+
 	p_script->clearing = true;
 
 	p_script->native = Ref<GDScriptNativeClass>();
@@ -3049,6 +3052,7 @@ Error GDScriptCompiler::_compile_class(GDScript *p_script, const GDScriptParser:
 	p_script->_static_default_init();
 
 	p_script->valid = true;
+	p_script->_invalidate_inline_caches();
 	return OK;
 }
 
@@ -97,6 +97,229 @@ static String _disassemble_address(const GDScript *p_script, const GDScriptFunct
 	return "<err>";
 }
 
+static const char *opcode_names[] = {
+	"OPERATOR",
+	"OPERATOR_VALIDATED",
+	"OPERATOR_ADD_INT",
+	"OPERATOR_SUBTRACT_INT",
+	"OPERATOR_MULTIPLY_INT",
+	"OPERATOR_EQUAL_INT",
+	"OPERATOR_NOT_EQUAL_INT",
+	"OPERATOR_LESS_INT",
+	"OPERATOR_LESS_EQUAL_INT",
+	"OPERATOR_GREATER_INT",
+	"OPERATOR_GREATER_EQUAL_INT",
+	"OPERATOR_ADD_FLOAT",
+	"OPERATOR_SUBTRACT_FLOAT",
+	"OPERATOR_MULTIPLY_FLOAT",
+	"OPERATOR_DIVIDE_FLOAT",
+	"OPERATOR_EQUAL_FLOAT",
+	"OPERATOR_NOT_EQUAL_FLOAT",
+	"OPERATOR_LESS_FLOAT",
+	"OPERATOR_LESS_EQUAL_FLOAT",
+	"OPERATOR_GREATER_FLOAT",
+	"OPERATOR_GREATER_EQUAL_FLOAT",
+	"OPERATOR_EQUAL_INT_JUMP_IF_NOT",
+	"OPERATOR_NOT_EQUAL_INT_JUMP_IF_NOT",
+	"OPERATOR_LESS_INT_JUMP_IF_NOT",
+	"OPERATOR_LESS_EQUAL_INT_JUMP_IF_NOT",
+	"OPERATOR_GREATER_INT_JUMP_IF_NOT",
+	"OPERATOR_GREATER_EQUAL_INT_JUMP_IF_NOT",
+	"OPERATOR_LESS_FLOAT_JUMP_IF_NOT",
+	"OPERATOR_LESS_EQUAL_FLOAT_JUMP_IF_NOT",
+	"OPERATOR_GREATER_FLOAT_JUMP_IF_NOT",
+	"OPERATOR_GREATER_EQUAL_FLOAT_JUMP_IF_NOT",
+	"OPERATOR_VALIDATED_JUMP_IF_NOT",
+	"OPERATOR_ADD_INT_ASSIGN",
+	"OPERATOR_SUBTRACT_INT_ASSIGN",
+	"OPERATOR_MULTIPLY_INT_ASSIGN",
+	"OPERATOR_ADD_FLOAT_ASSIGN",
+	"OPERATOR_SUBTRACT_FLOAT_ASSIGN",
+	"OPERATOR_MULTIPLY_FLOAT_ASSIGN",
+	"OPERATOR_DIVIDE_FLOAT_ASSIGN",
+	"OPERATOR_VALIDATED_ASSIGN",
+	"TYPE_TEST_BUILTIN",
+	"TYPE_TEST_ARRAY",
+	"TYPE_TEST_DICTIONARY",
+	"TYPE_TEST_NATIVE",
+	"TYPE_TEST_SCRIPT",
+	"SET_KEYED",
+	"SET_KEYED_VALIDATED",
+	"SET_INDEXED_VALIDATED",
+	"SET_INDEXED_PACKED_BYTE_ARRAY",
+	"SET_INDEXED_PACKED_INT32_ARRAY",
+	"SET_INDEXED_PACKED_INT64_ARRAY",
+	"SET_INDEXED_PACKED_FLOAT32_ARRAY",
+	"SET_INDEXED_PACKED_FLOAT64_ARRAY",
+	"SET_INDEXED_PACKED_STRING_ARRAY",
+	"SET_INDEXED_PACKED_VECTOR2_ARRAY",
+	"SET_INDEXED_PACKED_VECTOR3_ARRAY",
+	"SET_INDEXED_PACKED_COLOR_ARRAY",
+	"SET_INDEXED_PACKED_VECTOR4_ARRAY",
+	"GET_KEYED",
+	"GET_KEYED_VALIDATED",
+	"GET_INDEXED_VALIDATED",
+	"GET_INDEXED_PACKED_BYTE_ARRAY",
+	"GET_INDEXED_PACKED_INT32_ARRAY",
+	"GET_INDEXED_PACKED_INT64_ARRAY",
+	"GET_INDEXED_PACKED_FLOAT32_ARRAY",
+	"GET_INDEXED_PACKED_FLOAT64_ARRAY",
+	"GET_INDEXED_PACKED_STRING_ARRAY",
+	"GET_INDEXED_PACKED_VECTOR2_ARRAY",
+	"GET_INDEXED_PACKED_VECTOR3_ARRAY",
+	"GET_INDEXED_PACKED_COLOR_ARRAY",
+	"GET_INDEXED_PACKED_VECTOR4_ARRAY",
+	"SET_NAMED",
+	"SET_NAMED_VALIDATED",
+	"GET_NAMED",
+	"GET_NAMED_VALIDATED",
+	"SET_MEMBER",
+	"GET_MEMBER",
+	"SET_STATIC_VARIABLE",
+	"GET_STATIC_VARIABLE",
+	"ASSIGN",
+	"ASSIGN_NULL",
+	"ASSIGN_TRUE",
+	"ASSIGN_FALSE",
+	"ASSIGN_TYPED_BUILTIN",
+	"ASSIGN_TYPED_ARRAY",
+	"ASSIGN_TYPED_DICTIONARY",
+	"ASSIGN_TYPED_NATIVE",
+	"ASSIGN_TYPED_SCRIPT",
+	"CAST_TO_BUILTIN",
+	"CAST_TO_NATIVE",
+	"CAST_TO_SCRIPT",
+	"CONSTRUCT",
+	"CONSTRUCT_VALIDATED",
+	"CONSTRUCT_ARRAY",
+	"CONSTRUCT_TYPED_ARRAY",
+	"CONSTRUCT_DICTIONARY",
+	"CONSTRUCT_TYPED_DICTIONARY",
+	"CALL",
+	"CALL_RETURN",
+	"CALL_ASYNC",
+	"CALL_UTILITY",
+	"CALL_UTILITY_VALIDATED",
+	"CALL_GDSCRIPT_UTILITY",
+	"CALL_BUILTIN_TYPE_VALIDATED",
+	"CALL_SELF_BASE",
+	"CALL_METHOD_BIND",
+	"CALL_METHOD_BIND_RET",
+	"CALL_BUILTIN_STATIC",
+	"CALL_NATIVE_STATIC",
+	"CALL_NATIVE_STATIC_VALIDATED_RETURN",
+	"CALL_NATIVE_STATIC_VALIDATED_NO_RETURN",
+	"CALL_METHOD_BIND_VALIDATED_RETURN",
+	"CALL_METHOD_BIND_VALIDATED_NO_RETURN",
+	"AWAIT",
+	"AWAIT_RESUME",
+	"CREATE_LAMBDA",
+	"CREATE_SELF_LAMBDA",
+	"JUMP",
+	"JUMP_IF",
+	"JUMP_IF_NOT",
+	"JUMP_TO_DEF_ARGUMENT",
+	"JUMP_IF_SHARED",
+	"RETURN",
+	"RETURN_TYPED_BUILTIN",
+	"RETURN_TYPED_ARRAY",
+	"RETURN_TYPED_DICTIONARY",
+	"RETURN_TYPED_NATIVE",
+	"RETURN_TYPED_SCRIPT",
+	"ITERATE_BEGIN",
+	"ITERATE_BEGIN_INT",
+	"ITERATE_BEGIN_FLOAT",
+	"ITERATE_BEGIN_VECTOR2",
+	"ITERATE_BEGIN_VECTOR2I",
+	"ITERATE_BEGIN_VECTOR3",
+	"ITERATE_BEGIN_VECTOR3I",
+	"ITERATE_BEGIN_STRING",
+	"ITERATE_BEGIN_DICTIONARY",
+	"ITERATE_BEGIN_ARRAY",
+	"ITERATE_BEGIN_PACKED_BYTE_ARRAY",
+	"ITERATE_BEGIN_PACKED_INT32_ARRAY",
+	"ITERATE_BEGIN_PACKED_INT64_ARRAY",
+	"ITERATE_BEGIN_PACKED_FLOAT32_ARRAY",
+	"ITERATE_BEGIN_PACKED_FLOAT64_ARRAY",
+	"ITERATE_BEGIN_PACKED_STRING_ARRAY",
+	"ITERATE_BEGIN_PACKED_VECTOR2_ARRAY",
+	"ITERATE_BEGIN_PACKED_VECTOR3_ARRAY",
+	"ITERATE_BEGIN_PACKED_COLOR_ARRAY",
+	"ITERATE_BEGIN_PACKED_VECTOR4_ARRAY",
+	"ITERATE_BEGIN_OBJECT",
+	"ITERATE",
+	"ITERATE_INT",
+	"ITERATE_FLOAT",
+	"ITERATE_VECTOR2",
+	"ITERATE_VECTOR2I",
+	"ITERATE_VECTOR3",
+	"ITERATE_VECTOR3I",
+	"ITERATE_STRING",
+	"ITERATE_DICTIONARY",
+	"ITERATE_ARRAY",
+	"ITERATE_PACKED_BYTE_ARRAY",
+	"ITERATE_PACKED_INT32_ARRAY",
+	"ITERATE_PACKED_INT64_ARRAY",
+	"ITERATE_PACKED_FLOAT32_ARRAY",
+	"ITERATE_PACKED_FLOAT64_ARRAY",
+	"ITERATE_PACKED_STRING_ARRAY",
+	"ITERATE_PACKED_VECTOR2_ARRAY",
+	"ITERATE_PACKED_VECTOR3_ARRAY",
+	"ITERATE_PACKED_COLOR_ARRAY",
+	"ITERATE_PACKED_VECTOR4_ARRAY",
+	"ITERATE_OBJECT",
+	"STORE_GLOBAL",
+	"STORE_NAMED_GLOBAL",
+	"TYPE_ADJUST_BOOL",
+	"TYPE_ADJUST_INT",
+	"TYPE_ADJUST_FLOAT",
+	"TYPE_ADJUST_STRING",
+	"TYPE_ADJUST_VECTOR2",
+	"TYPE_ADJUST_VECTOR2I",
+	"TYPE_ADJUST_RECT2",
+	"TYPE_ADJUST_RECT2I",
+	"TYPE_ADJUST_VECTOR3",
+	"TYPE_ADJUST_VECTOR3I",
+	"TYPE_ADJUST_TRANSFORM2D",
+	"TYPE_ADJUST_VECTOR4",
+	"TYPE_ADJUST_VECTOR4I",
+	"TYPE_ADJUST_PLANE",
+	"TYPE_ADJUST_QUATERNION",
+	"TYPE_ADJUST_AABB",
+	"TYPE_ADJUST_BASIS",
+	"TYPE_ADJUST_TRANSFORM3D",
+	"TYPE_ADJUST_PROJECTION",
+	"TYPE_ADJUST_COLOR",
+	"TYPE_ADJUST_STRING_NAME",
+	"TYPE_ADJUST_NODE_PATH",
+	"TYPE_ADJUST_RID",
+	"TYPE_ADJUST_OBJECT",
+	"TYPE_ADJUST_CALLABLE",
+	"TYPE_ADJUST_SIGNAL",
+	"TYPE_ADJUST_DICTIONARY",
+	"TYPE_ADJUST_ARRAY",
+	"TYPE_ADJUST_PACKED_BYTE_ARRAY",
+	"TYPE_ADJUST_PACKED_INT32_ARRAY",
+	"TYPE_ADJUST_PACKED_INT64_ARRAY",
+	"TYPE_ADJUST_PACKED_FLOAT32_ARRAY",
+	"TYPE_ADJUST_PACKED_FLOAT64_ARRAY",
+	"TYPE_ADJUST_PACKED_STRING_ARRAY",
+	"TYPE_ADJUST_PACKED_VECTOR2_ARRAY",
+	"TYPE_ADJUST_PACKED_VECTOR3_ARRAY",
+	"TYPE_ADJUST_PACKED_COLOR_ARRAY",
+	"TYPE_ADJUST_PACKED_VECTOR4_ARRAY",
+	"ASSERT",
+	"BREAKPOINT",
+	"LINE",
+	"END",
+};
+static_assert((sizeof(opcode_names) / sizeof(opcode_names[0]) == GDScriptFunction::OPCODE_END + 1), "Opcode names aren't the same as opcodes in enum.");
+
+const char *GDScriptFunction::get_opcode_name(Opcode p_opcode) {
+	ERR_FAIL_INDEX_V(p_opcode, OPCODE_END + 1, "<invalid>");
+	return opcode_names[p_opcode];
+}
+
 void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 #define DADDR(m_ip) (_disassemble_address(_script, *this, _code_ptr[ip + m_ip]))
 
@@ -141,6 +364,121 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+
+#define DISASSEMBLE_OPERATOR_TYPED(m_op_name, m_v_type, m_op) \
+	case OPCODE_OPERATOR_##m_op_name##_##m_v_type: {          \
+		text += "operator (";                                 \
+		text += #m_v_type;                                    \
+		text += ") ";                                         \
+		text += DADDR(3);                                     \
+		text += " = ";                                        \
+		text += DADDR(1);                                     \
+		text += " " m_op " ";                                 \
+		text += DADDR(2);                                     \
+		incr += 4;                                            \
+	} break
+
+				DISASSEMBLE_OPERATOR_TYPED(ADD, INT, "+");
+				DISASSEMBLE_OPERATOR_TYPED(SUBTRACT, INT, "-");
+				DISASSEMBLE_OPERATOR_TYPED(MULTIPLY, INT, "*");
+				DISASSEMBLE_OPERATOR_TYPED(EQUAL, INT, "==");
+				DISASSEMBLE_OPERATOR_TYPED(NOT_EQUAL, INT, "!=");
+				DISASSEMBLE_OPERATOR_TYPED(LESS, INT, "<");
+				DISASSEMBLE_OPERATOR_TYPED(LESS_EQUAL, INT, "<=");
+				DISASSEMBLE_OPERATOR_TYPED(GREATER, INT, ">");
+				DISASSEMBLE_OPERATOR_TYPED(GREATER_EQUAL, INT, ">=");
+				DISASSEMBLE_OPERATOR_TYPED(ADD, FLOAT, "+");
+				DISASSEMBLE_OPERATOR_TYPED(SUBTRACT, FLOAT, "-");
+				DISASSEMBLE_OPERATOR_TYPED(MULTIPLY, FLOAT, "*");
+				DISASSEMBLE_OPERATOR_TYPED(DIVIDE, FLOAT, "/");
+				DISASSEMBLE_OPERATOR_TYPED(EQUAL, FLOAT, "==");
+				DISASSEMBLE_OPERATOR_TYPED(NOT_EQUAL, FLOAT, "!=");
+				DISASSEMBLE_OPERATOR_TYPED(LESS, FLOAT, "<");
+				DISASSEMBLE_OPERATOR_TYPED(LESS_EQUAL, FLOAT, "<=");
+				DISASSEMBLE_OPERATOR_TYPED(GREATER, FLOAT, ">");
+				DISASSEMBLE_OPERATOR_TYPED(GREATER_EQUAL, FLOAT, ">=");
+
+#define DISASSEMBLE_OPERATOR_TYPED_JUMP_IF_NOT(m_op_name, m_v_type, m_op) \
+	case OPCODE_OPERATOR_##m_op_name##_##m_v_type##_JUMP_IF_NOT: {        \
+		text += "operator (";                                             \
+		text += #m_v_type;                                                \
+		text += ") ";                                                     \
+		text += DADDR(3);                                                 \
+		text += " = ";                                                    \
+		text += DADDR(1);                                                 \
+		text += " " m_op " ";                                             \
+		text += DADDR(2);                                                 \
+		text += "; jump-if-not to ";                                      \
+		text += itos(_code_ptr[ip + 6]);                                  \
+		incr += 7;                                                        \
+	} break
+
+				DISASSEMBLE_OPERATOR_TYPED_JUMP_IF_NOT(EQUAL, INT, "==");
+				DISASSEMBLE_OPERATOR_TYPED_JUMP_IF_NOT(NOT_EQUAL, INT, "!=");
+				DISASSEMBLE_OPERATOR_TYPED_JUMP_IF_NOT(LESS, INT, "<");
+				DISASSEMBLE_OPERATOR_TYPED_JUMP_IF_NOT(LESS_EQUAL, INT, "<=");
+				DISASSEMBLE_OPERATOR_TYPED_JUMP_IF_NOT(GREATER, INT, ">");
+				DISASSEMBLE_OPERATOR_TYPED_JUMP_IF_NOT(GREATER_EQUAL, INT, ">=");
+				DISASSEMBLE_OPERATOR_TYPED_JUMP_IF_NOT(LESS, FLOAT, "<");
+				DISASSEMBLE_OPERATOR_TYPED_JUMP_IF_NOT(LESS_EQUAL, FLOAT, "<=");
+				DISASSEMBLE_OPERATOR_TYPED_JUMP_IF_NOT(GREATER, FLOAT, ">");
+				DISASSEMBLE_OPERATOR_TYPED_JUMP_IF_NOT(GREATER_EQUAL, FLOAT, ">=");
+
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT: {
+				text += "validated operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+				text += "; jump-if-not to ";
+				text += itos(_code_ptr[ip + 7]);
+
+				incr += 8;
+			} break;
+
+#define DISASSEMBLE_OPERATOR_TYPED_ASSIGN(m_op_name, m_v_type, m_op) \
+	case OPCODE_OPERATOR_##m_op_name##_##m_v_type##_ASSIGN: {        \
+		text += "operator (";                                        \
+		text += #m_v_type;                                           \
+		text += ") ";                                                \
+		text += DADDR(3);                                            \
+		text += " = ";                                               \
+		text += DADDR(1);                                            \
+		text += " " m_op " ";                                        \
+		text += DADDR(2);                                            \
+		text += "; assign ";                                         \
+		text += DADDR(5);                                            \
+		incr += 7;                                                   \
+	} break
+
+				DISASSEMBLE_OPERATOR_TYPED_ASSIGN(ADD, INT, "+");
+				DISASSEMBLE_OPERATOR_TYPED_ASSIGN(SUBTRACT, INT, "-");
+				DISASSEMBLE_OPERATOR_TYPED_ASSIGN(MULTIPLY, INT, "*");
+				DISASSEMBLE_OPERATOR_TYPED_ASSIGN(ADD, FLOAT, "+");
+				DISASSEMBLE_OPERATOR_TYPED_ASSIGN(SUBTRACT, FLOAT, "-");
+				DISASSEMBLE_OPERATOR_TYPED_ASSIGN(MULTIPLY, FLOAT, "*");
+				DISASSEMBLE_OPERATOR_TYPED_ASSIGN(DIVIDE, FLOAT, "/");
+
+			case OPCODE_OPERATOR_VALIDATED_ASSIGN: {
+				text += "validated operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+				text += "; assign ";
+				text += DADDR(6);
+
+				incr += 8;
+			} break;
+
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -267,6 +605,31 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+
+#define DISASSEMBLE_PACKED_ARRAY_TYPES(m_macro) \
+	m_macro(BYTE);                              \
+	m_macro(INT32);                             \
+	m_macro(INT64);                             \
+	m_macro(FLOAT32);                           \
+	m_macro(FLOAT64);                           \
+	m_macro(STRING);                            \
+	m_macro(VECTOR2);                           \
+	m_macro(VECTOR3);                           \
+	m_macro(COLOR);                             \
+	m_macro(VECTOR4)
+
+#define DISASSEMBLE_SET_INDEXED_PACKED_ARRAY(m_var_type)             \
+	case OPCODE_SET_INDEXED_PACKED_##m_var_type##_ARRAY: {           \
+		text += "set indexed (typed PACKED_" #m_var_type "_ARRAY) "; \
+		text += DADDR(1);                                            \
+		text += "[";                                                 \
+		text += DADDR(2);                                            \
+		text += "] = ";                                              \
+		text += DADDR(3);                                            \
+		incr += 4;                                                   \
+	} break
+
+				DISASSEMBLE_PACKED_ARRAY_TYPES(DISASSEMBLE_SET_INDEXED_PACKED_ARRAY);
 			case OPCODE_GET_KEYED: {
 				text += "get keyed ";
 				text += DADDR(3);
@@ -300,6 +663,20 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+
+#define DISASSEMBLE_GET_INDEXED_PACKED_ARRAY(m_var_type)             \
+	case OPCODE_GET_INDEXED_PACKED_##m_var_type##_ARRAY: {           \
+		text += "get indexed (typed PACKED_" #m_var_type "_ARRAY) "; \
+		text += DADDR(3);                                            \
+		text += " = ";                                               \
+		text += DADDR(1);                                            \
+		text += "[";                                                 \
+		text += DADDR(2);                                            \
+		text += "]";                                                 \
+		incr += 4;                                                   \
+	} break
+
+				DISASSEMBLE_PACKED_ARRAY_TYPES(DISASSEMBLE_GET_INDEXED_PACKED_ARRAY);
 			case OPCODE_SET_NAMED: {
 				text += "set_named ";
 				text += DADDR(1);
@@ -308,7 +685,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += "\"] = ";
 				text += DADDR(2);
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_SET_NAMED_VALIDATED: {
 				text += "set_named validated ";
@@ -329,7 +706,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += _global_names_ptr[_code_ptr[ip + 3]];
 				text += "\"]";
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_GET_NAMED_VALIDATED: {
 				text += "get_named validated ";
@@ -698,7 +1075,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				}
 				text += ")";
 
-				incr = 5 + argc;
+				incr = 6 + argc;
 			} break;
 			case OPCODE_CALL_METHOD_BIND:
 			case OPCODE_CALL_METHOD_BIND_RET: {
@@ -32,6 +32,9 @@
 
 #include "gdscript.h"
 
+#include "core/object/class_db.h"
+#include "scene/scene_string_names.h"
+
 Variant GDScriptFunction::get_constant(int p_idx) const {
 	ERR_FAIL_INDEX_V(p_idx, constants.size(), "<errconst>");
 	return constants[p_idx];
@@ -104,6 +107,222 @@ void GDScriptFunction::debug_get_stack_member_state(int p_line, List<Pair<String
 	}
 }
 
+void GDScriptFunction::_update_frame_layout() {
+	argument_fast_types.resize(argument_types.size());
+	uint8_t *fast_types = argument_fast_types.ptrw();
+	for (int i = 0; i < argument_types.size(); i++) {
+		const GDScriptDataType &type = argument_types[i];
+		if (!type.has_type) {
+			fast_types[i] = ARGUMENT_ANY;
+		} else if (type.kind == GDScriptDataType::BUILTIN && !type.has_container_element_types()) {
+			// Same as is_type() without conversion: only typed containers need a deeper check.
+			fast_types[i] = type.builtin_type;
+		} else {
+			fast_types[i] = ARGUMENT_CHECKED;
+		}
+	}
+
+	stack_init_types.resize(_stack_size);
+	stack_init_types.fill(Variant::NIL);
+	for (const KeyValue<int, Variant::Type> &E : temporary_slots) {
+		ERR_CONTINUE(E.key < 0 || E.key >= _stack_size);
+		stack_init_types.write[E.key] = E.value;
+	}
+}
+
+SafeNumeric<uint64_t> GDScriptFunction::inline_cache_versions;
+Mutex GDScriptFunction::inline_cache_mutex;
+
+void GDScriptFunction::_inline_cache_resolve(InlineCacheOp p_op, const StringName &p_name, InlineCacheEntry &r_entry) {
+	r_entry.kind = InlineCacheEntry::KIND_UNCACHEABLE;
+
+	ClassDB::APIType api = ClassDB::get_api_type(r_entry.class_name);
+	if (api == ClassDB::API_EXTENSION || api == ClassDB::API_EDITOR_EXTENSION) {
+		// Extension instances may handle properties themselves, and their methods go away on unload.
+		return;
+	}
+
+	if (p_op == INLINE_CACHE_CALL) {
+		if (p_name == CoreStringName(free_) || p_name == SceneStringName(_ready)) {
+			// Both are special-cased by Object::callp() and GDScriptInstance::callp().
+			return;
+		}
+		if (ClassDB::is_parent_class(r_entry.class_name, SNAME("Script"))) {
+			// Scripts override Object::callp() to reach their static functions.
+			return;
+		}
+	}
+
+	// Mirrors the lookup order of GDScriptInstance::get(), set() and callp(), and only caches
+	// what they would resolve without side effects. Anything else stays on the generic path.
+	const GDScript *script = r_entry.script;
+	if (script) {
+		switch (p_op) {
+			case INLINE_CACHE_GET: {
+				HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = script->member_indices.find(p_name);
+				if (E) {
+					if (script->valid && E->value.getter == StringName()) {
+						r_entry.kind = InlineCacheEntry::KIND_MEMBER;
+						r_entry.member_index = E->value.index;
+					}
+					return;
+				}
+				for (const GDScript *sptr = script; sptr; sptr = sptr->_base) {
+					if (sptr->constants.has(p_name) || sptr->static_variables_indices.has(p_name) || sptr->_signals.has(p_name) || sptr->subclasses.has(p_name)) {
+						return;
+					}
+					if (sptr->valid && (sptr->member_functions.has(p_name) || sptr->member_functions.has(GDScriptLanguage::get_singleton()->strings._get))) {
+						return;
+					}
+				}
+			} break;
+			case INLINE_CACHE_SET: {
+				HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = script->member_indices.find(p_name);
+				if (E) {
+					const GDScript::MemberInfo &member = E->value;
+					if (!script->valid || member.setter != StringName()) {
+						return;
+					}
+					if (member.data_type.has_type) {
+						// Only an exact builtin type match is known to need no conversion.
+						if (member.data_type.kind != GDScriptDataType::BUILTIN || member.data_type.builtin_type == Variant::ARRAY || member.data_type.builtin_type == Variant::DICTIONARY) {
+							return;
+						}
+						r_entry.value_type = member.data_type.builtin_type;
+					}
+					r_entry.kind = InlineCacheEntry::KIND_MEMBER;
+					r_entry.member_index = member.index;
+					return;
+				}
+				for (const GDScript *sptr = script; sptr; sptr = sptr->_base) {
+					if (sptr->static_variables_indices.has(p_name)) {
+						return;
+					}
+					if (sptr->valid && sptr->member_functions.has(GDScriptLanguage::get_singleton()->strings._set)) {
+						return;
+					}
+				}
+			} break;
+			case INLINE_CACHE_CALL: {
+				for (const GDScript *sptr = script; sptr; sptr = sptr->_base) {
+					if (sptr->valid) {
+						HashMap<StringName, GDScriptFunction *>::ConstIterator E = sptr->member_functions.find(p_name);
+						if (E) {
+							r_entry.kind = InlineCacheEntry::KIND_FUNCTION;
+							r_entry.function = E->value;
+							return;
+						}
+					}
+				}
+			} break;
+		}
+	}
+
+	// Not handled by the script, the object resolves it through ClassDB.
+	switch (p_op) {
+		case INLINE_CACHE_GET: {
+			r_entry.method = ClassDB::get_property_getter_method(r_entry.class_name, p_name);
+		} break;
+		case INLINE_CACHE_SET: {
+			r_entry.method = ClassDB::get_property_setter_method(r_entry.class_name, p_name);
+		} break;
+		case INLINE_CACHE_CALL: {
+			// Other classes may override Object::callp() (e.g. the Java wrappers), nodes don't.
+			if (ClassDB::is_parent_class(r_entry.class_name, SNAME("Node"))) {
+				r_entry.method = ClassDB::get_method(r_entry.class_name, p_name);
+			}
+		} break;
+	}
+	if (r_entry.method) {
+		r_entry.kind = InlineCacheEntry::KIND_METHOD_BIND;
+	}
+}
+
+void GDScriptFunction::_inline_cache_add(InlineCache &p_cache, const InlineCacheEntry &p_entry) {
+	MutexLock lock(inline_cache_mutex);
+
+	if (p_cache.megamorphic.is_set()) {
+		return;
+	}
+
+	InlineCacheEntry entries[INLINE_CACHE_MAX_ENTRIES];
+	uint32_t kept = 0;
+	const InlineCacheBlock *old_block = p_cache.block.load(std::memory_order_relaxed);
+	for (uint32_t i = 0; old_block && i < old_block->entry_count; i++) {
+		const InlineCacheEntry &entry = old_block->entries[i];
+		if (entry.script == p_entry.script && entry.class_name == p_entry.class_name) {
+			if (entry.script_version == p_entry.script_version) {
+				return; // Added by another thread in the meantime.
+			}
+			continue; // Resolved against an older version of the script, replace it.
+		}
+		entries[kept++] = entry;
+	}
+
+	if (kept == INLINE_CACHE_MAX_ENTRIES || p_cache.updates == INLINE_CACHE_MAX_UPDATES) {
+		// Too many receiver types, or their scripts changed too often; stop paying for lookups that won't stick.
+		p_cache.megamorphic.set();
+		return;
+	}
+
+	InlineCacheBlock *block = memnew(InlineCacheBlock);
+	for (uint32_t i = 0; i < kept; i++) {
+		block->entries[i] = entries[i];
+	}
+	block->entries[kept] = p_entry;
+	block->entry_count = kept + 1;
+	block->previous = p_cache.block.load(std::memory_order_relaxed);
+	p_cache.updates++;
+
+	p_cache.block.store(block, std::memory_order_release);
+}
+
+#ifdef GDSCRIPT_OPCODE_PAIR_STATISTICS
+SafeNumeric<uint64_t> *GDScriptFunction::opcode_pair_counts = nullptr;
+
+void GDScriptFunction::start_opcode_pair_statistics() {
+	ERR_FAIL_COND(opcode_pair_counts != nullptr);
+	opcode_pair_counts = memnew_arr(SafeNumeric<uint64_t>, (OPCODE_END + 1) * (OPCODE_END + 1));
+}
+
+void GDScriptFunction::finish_opcode_pair_statistics(int p_max_pairs) {
+	if (!opcode_pair_counts) {
+		return;
+	}
+
+	struct OpcodePair {
+		uint64_t count = 0;
+		int first = 0;
+		int second = 0;
+	};
+	struct PairSort {
+		bool operator()(const OpcodePair &p_a, const OpcodePair &p_b) const {
+			return p_a.count > p_b.count;
+		}
+	};
+
+	LocalVector<OpcodePair> pairs;
+	uint64_t total = 0;
+	for (int i = 0; i < (OPCODE_END + 1) * (OPCODE_END + 1); i++) {
+		uint64_t count = opcode_pair_counts[i].get();
+		if (count > 0) {
+			pairs.push_back({ count, i / (OPCODE_END + 1), i % (OPCODE_END + 1) });
+			total += count;
+		}
+	}
+	pairs.sort_custom<PairSort>();
+
+	print_line(vformat("GDScript opcode pair statistics (%d distinct pairs, %d executed):", pairs.size(), total));
+	for (uint32_t i = 0; i < MIN(pairs.size(), (uint32_t)p_max_pairs); i++) {
+		const OpcodePair &pair = pairs[i];
+		print_line(vformat("%12d  %5.2f%%  %s -> %s", pair.count, pair.count * 100.0 / total, get_opcode_name(Opcode(pair.first)), get_opcode_name(Opcode(pair.second))));
+	}
+
+	memdelete_arr(opcode_pair_counts);
+	opcode_pair_counts = nullptr;
+}
+#endif
+
 GDScriptFunction::GDScriptFunction() {
 	name = "<anonymous>";
 #ifdef DEBUG_ENABLED
@@ -121,12 +340,26 @@ GDScriptFunction::~GDScriptFunction() {
 		memdelete(lambdas[i]);
 	}
 
+	for (int i = 0; i < _inline_caches_count; i++) {
+		InlineCacheBlock *block = _inline_caches_ptr[i].block.load(std::memory_order_relaxed);
+		while (block) {
+			InlineCacheBlock *previous = block->previous;
+			memdelete(block);
+			block = previous;
+		}
+	}
+	if (_inline_caches_ptr) {
+		memdelete_arr(_inline_caches_ptr);
+	}
+
 	for (int i = 0; i < argument_types.size(); i++) {
 		argument_types.write[i].script_type_ref = Ref<Script>();
 	}
 	return_type.script_type_ref = Ref<Script>();
 
 #ifdef DEBUG_ENABLED
+	GDScriptSamplingProfiler::forget_function(this);
+
 	MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
 	GDScriptLanguage::get_singleton()->function_list.remove(&function_list);
 #endif
@@ -238,12 +471,12 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 		}
 
 #ifdef DEBUG_ENABLED
-		if (EngineDebugger::is_active()) {
+		if (state.call_stack_tracked) {
 			GDScriptLanguage::get_singleton()->exit_function();
 		}
+#endif
 
 		_clear_stack();
-#endif
 	}
 
 	return ret;
@@ -251,13 +484,17 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 
 void GDScriptFunctionState::_clear_stack() {
 	if (state.stack_size) {
-		Variant *stack = (Variant *)state.stack.ptr();
+		Variant *stack = (Variant *)state.stack;
 		// The first 3 are special addresses and not copied to the state, so we skip them here.
 		for (int i = 3; i < state.stack_size; i++) {
 			stack[i].~Variant();
 		}
 		state.stack_size = 0;
 	}
+	if (state.stack) {
+		free_frame(state.stack, state.alloca_size);
+		state.stack = nullptr;
+	}
 }
 
 void GDScriptFunctionState::_clear_connections() {
@@ -269,6 +506,61 @@ void GDScriptFunctionState::_clear_connections() {
 	}
 }
 
+SpinLock GDScriptFunctionState::frame_pool_lock;
+LocalVector<uint8_t *> GDScriptFunctionState::frame_pool[FRAME_POOL_SIZE_CLASSES];
+
+uint32_t GDScriptFunctionState::_get_frame_size_class(uint32_t p_size) {
+	const uint32_t shift = nearest_shift(MAX(p_size, 1u << FRAME_POOL_MIN_SHIFT) - 1);
+	return shift - FRAME_POOL_MIN_SHIFT;
+}
+
+uint8_t *GDScriptFunctionState::alloc_frame(uint32_t p_size) {
+	const uint32_t size_class = _get_frame_size_class(p_size);
+	if (size_class >= FRAME_POOL_SIZE_CLASSES) {
+		return (uint8_t *)Memory::alloc_static(p_size);
+	}
+
+	uint8_t *frame = nullptr;
+	frame_pool_lock.lock();
+	if (!frame_pool[size_class].is_empty()) {
+		frame = frame_pool[size_class][frame_pool[size_class].size() - 1];
+		frame_pool[size_class].resize(frame_pool[size_class].size() - 1);
+	}
+	frame_pool_lock.unlock();
+
+	if (!frame) {
+		frame = (uint8_t *)Memory::alloc_static(1u << (size_class + FRAME_POOL_MIN_SHIFT));
+	}
+	return frame;
+}
+
+void GDScriptFunctionState::free_frame(uint8_t *p_frame, uint32_t p_size) {
+	const uint32_t size_class = _get_frame_size_class(p_size);
+	if (size_class < FRAME_POOL_SIZE_CLASSES) {
+		frame_pool_lock.lock();
+		const bool pooled = frame_pool[size_class].size() < FRAME_POOL_MAX_FREE_FRAMES;
+		if (pooled) {
+			frame_pool[size_class].push_back(p_frame);
+		}
+		frame_pool_lock.unlock();
+		if (pooled) {
+			return;
+		}
+	}
+	Memory::free_static(p_frame);
+}
+
+void GDScriptFunctionState::clear_frame_pool() {
+	frame_pool_lock.lock();
+	for (uint32_t i = 0; i < FRAME_POOL_SIZE_CLASSES; i++) {
+		for (uint8_t *frame : frame_pool[i]) {
+			Memory::free_static(frame);
+		}
+		frame_pool[i].reset();
+	}
+	frame_pool_lock.unlock();
+}
+
 void GDScriptFunctionState::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("resume", "arg"), &GDScriptFunctionState::resume, DEFVAL(Variant()));
 	ClassDB::bind_method(D_METHOD("is_valid", "extended_check"), &GDScriptFunctionState::is_valid, DEFVAL(false));
@@ -288,4 +580,5 @@ GDScriptFunctionState::~GDScriptFunctionState() {
 		scripts_list.remove_from_list();
 		instances_list.remove_from_list();
 	}
+	_clear_stack();
 }
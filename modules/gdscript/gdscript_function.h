@@ -35,8 +35,11 @@
 
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/os/mutex.h"
+#include "core/os/spin_lock.h"
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
@@ -257,6 +260,45 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_OPERATOR_ADD_INT,
+		OPCODE_OPERATOR_SUBTRACT_INT,
+		OPCODE_OPERATOR_MULTIPLY_INT,
+		OPCODE_OPERATOR_EQUAL_INT,
+		OPCODE_OPERATOR_NOT_EQUAL_INT,
+		OPCODE_OPERATOR_LESS_INT,
+		OPCODE_OPERATOR_LESS_EQUAL_INT,
+		OPCODE_OPERATOR_GREATER_INT,
+		OPCODE_OPERATOR_GREATER_EQUAL_INT,
+		OPCODE_OPERATOR_ADD_FLOAT,
+		OPCODE_OPERATOR_SUBTRACT_FLOAT,
+		OPCODE_OPERATOR_MULTIPLY_FLOAT,
+		OPCODE_OPERATOR_DIVIDE_FLOAT,
+		OPCODE_OPERATOR_EQUAL_FLOAT,
+		OPCODE_OPERATOR_NOT_EQUAL_FLOAT,
+		OPCODE_OPERATOR_LESS_FLOAT,
+		OPCODE_OPERATOR_LESS_EQUAL_FLOAT,
+		OPCODE_OPERATOR_GREATER_FLOAT,
+		OPCODE_OPERATOR_GREATER_EQUAL_FLOAT,
+		// Superinstructions, formed by GDScriptByteCodeGenerator from an operator and the instruction following it.
+		OPCODE_OPERATOR_EQUAL_INT_JUMP_IF_NOT,
+		OPCODE_OPERATOR_NOT_EQUAL_INT_JUMP_IF_NOT,
+		OPCODE_OPERATOR_LESS_INT_JUMP_IF_NOT,
+		OPCODE_OPERATOR_LESS_EQUAL_INT_JUMP_IF_NOT,
+		OPCODE_OPERATOR_GREATER_INT_JUMP_IF_NOT,
+		OPCODE_OPERATOR_GREATER_EQUAL_INT_JUMP_IF_NOT,
+		OPCODE_OPERATOR_LESS_FLOAT_JUMP_IF_NOT,
+		OPCODE_OPERATOR_LESS_EQUAL_FLOAT_JUMP_IF_NOT,
+		OPCODE_OPERATOR_GREATER_FLOAT_JUMP_IF_NOT,
+		OPCODE_OPERATOR_GREATER_EQUAL_FLOAT_JUMP_IF_NOT,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,
+		OPCODE_OPERATOR_ADD_INT_ASSIGN,
+		OPCODE_OPERATOR_SUBTRACT_INT_ASSIGN,
+		OPCODE_OPERATOR_MULTIPLY_INT_ASSIGN,
+		OPCODE_OPERATOR_ADD_FLOAT_ASSIGN,
+		OPCODE_OPERATOR_SUBTRACT_FLOAT_ASSIGN,
+		OPCODE_OPERATOR_MULTIPLY_FLOAT_ASSIGN,
+		OPCODE_OPERATOR_DIVIDE_FLOAT_ASSIGN,
+		OPCODE_OPERATOR_VALIDATED_ASSIGN,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_DICTIONARY,
@@ -265,9 +307,29 @@ public:
 		OPCODE_SET_KEYED,
 		OPCODE_SET_KEYED_VALIDATED,
 		OPCODE_SET_INDEXED_VALIDATED,
+		OPCODE_SET_INDEXED_PACKED_BYTE_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_INT32_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_INT64_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_FLOAT32_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_FLOAT64_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_STRING_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_VECTOR2_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_VECTOR3_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_COLOR_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_VECTOR4_ARRAY,
 		OPCODE_GET_KEYED,
 		OPCODE_GET_KEYED_VALIDATED,
 		OPCODE_GET_INDEXED_VALIDATED,
+		OPCODE_GET_INDEXED_PACKED_BYTE_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_INT32_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_INT64_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_STRING_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_VECTOR2_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_VECTOR3_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_COLOR_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_VECTOR4_ARRAY,
 		OPCODE_SET_NAMED,
 		OPCODE_SET_NAMED_VALIDATED,
 		OPCODE_GET_NAMED,
@@ -444,7 +506,10 @@ private:
 	friend class GDScript;
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
+	friend class GDScriptBytecodeCache;
+	friend class GDScriptBytecodeCacheWriter;
 	friend class GDScriptLanguage;
+	friend class GDScriptSamplingProfiler;
 
 	StringName name;
 	StringName source;
@@ -465,6 +530,15 @@ private:
 	HashMap<int, Variant::Type> temporary_slots;
 	List<StackDebug> stack_debug;
 
+	// Flat copies of `argument_types` and `temporary_slots` made by `_update_frame_layout()`, so
+	// that setting up a call is a single pass over the frame.
+	static constexpr uint8_t ARGUMENT_ANY = Variant::VARIANT_MAX; // Untyped, taken as is.
+	static constexpr uint8_t ARGUMENT_CHECKED = Variant::VARIANT_MAX + 1; // Needs the full type check.
+	Vector<uint8_t> argument_fast_types; // Builtin type taken as is, or one of the values above.
+	Vector<uint8_t> stack_init_types; // Initial type of each stack slot, NIL for none.
+
+	void _update_frame_layout();
+
 	Vector<int> code;
 	Vector<int> default_arguments;
 	Vector<Variant> constants;
@@ -519,6 +593,70 @@ private:
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
 
+	// Inline caches of OPCODE_GET_NAMED, OPCODE_SET_NAMED and the OPCODE_CALL family, one per
+	// instruction. They remember how a member was resolved for the last few receiver types, keyed
+	// on the receiver's GDScript (null for plain objects), its version and native class.
+	enum InlineCacheOp {
+		INLINE_CACHE_GET,
+		INLINE_CACHE_SET,
+		INLINE_CACHE_CALL,
+	};
+
+	struct InlineCacheEntry {
+		enum Kind : uint8_t {
+			KIND_UNCACHEABLE, // Resolved every time by the generic path.
+			KIND_MEMBER, // Index in GDScriptInstance::members.
+			KIND_FUNCTION, // Function in the receiver's script hierarchy.
+			KIND_METHOD_BIND, // Native getter, setter or method.
+		};
+
+		const GDScript *script = nullptr;
+		uint64_t script_version = 0;
+		StringName class_name;
+		Kind kind = KIND_UNCACHEABLE;
+		Variant::Type value_type = Variant::VARIANT_MAX; // Type a cached member assignment requires, VARIANT_MAX for any.
+		int member_index = -1;
+		GDScriptFunction *function = nullptr;
+		MethodBind *method = nullptr;
+	};
+
+	static constexpr uint32_t INLINE_CACHE_MAX_ENTRIES = 4;
+	static constexpr uint32_t INLINE_CACHE_MAX_UPDATES = 32;
+
+	// Published blocks are never modified, so readers need no lock. Updates publish a new block
+	// and keep the old one alive until the function is freed.
+	struct InlineCacheBlock {
+		uint32_t entry_count = 0;
+		InlineCacheEntry entries[INLINE_CACHE_MAX_ENTRIES];
+		InlineCacheBlock *previous = nullptr;
+	};
+
+	struct InlineCache {
+		std::atomic<InlineCacheBlock *> block = nullptr;
+		uint32_t updates = 0; // Protected by `inline_cache_mutex`.
+		SafeFlag megamorphic;
+	};
+
+	static SafeNumeric<uint64_t> inline_cache_versions;
+	static Mutex inline_cache_mutex;
+
+	InlineCache *_inline_caches_ptr = nullptr;
+	int _inline_caches_count = 0;
+
+	static const InlineCacheEntry *_inline_cache_find(InlineCache &p_cache, InlineCacheOp p_op, Object *p_object, const StringName &p_name, InlineCacheEntry &r_resolved);
+	static void _inline_cache_resolve(InlineCacheOp p_op, const StringName &p_name, InlineCacheEntry &r_entry);
+	static void _inline_cache_add(InlineCache &p_cache, const InlineCacheEntry &p_entry);
+	bool _inline_cache_get_named(InlineCache &p_cache, const Variant *p_base, const StringName &p_name, Variant &r_ret);
+	bool _inline_cache_set_named(InlineCache &p_cache, Variant *p_base, const StringName &p_name, const Variant &p_value, bool &r_valid);
+	bool _inline_cache_call(InlineCache &p_cache, Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err);
+
+#ifdef TOOLS_ENABLED
+	// For the bytecode cache: global lookups to relink by name, since global indices differ
+	// between builds, and whether the function has code that release builds compile out.
+	Vector<int> global_instructions;
+	bool has_debug_code = false;
+#endif
+
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
 	const char *_func_cname = nullptr;
@@ -542,6 +680,8 @@ private:
 		uint64_t last_frame_call_count = 0;
 		uint64_t last_frame_self_time = 0;
 		uint64_t last_frame_total_time = 0;
+		SafeNumeric<uint64_t> inline_cache_hits;
+		SafeNumeric<uint64_t> inline_cache_misses;
 		typedef struct NativeProfile {
 			uint64_t call_count;
 			uint64_t total_time;
@@ -564,8 +704,10 @@ public:
 #ifdef DEBUG_ENABLED
 		StringName function_name;
 		String script_path;
+		// Whether the resumed call entered `GDScriptLanguage::_call_stack`, and must be exited on completion.
+		bool call_stack_tracked = false;
 #endif
-		Vector<uint8_t> stack;
+		uint8_t *stack = nullptr; // `alloca_size` bytes from the frame pool of GDScriptFunctionState.
 		int stack_size = 0;
 		uint32_t alloca_size = 0;
 		int ip = 0;
@@ -589,9 +731,21 @@ public:
 	Variant call(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_err, CallState *p_state = nullptr);
 	void debug_get_stack_member_state(int p_line, List<Pair<StringName, int>> *r_stackvars) const;
 
+	static uint64_t new_inline_cache_version() { return inline_cache_versions.increment(); }
+
 #ifdef DEBUG_ENABLED
 	void _profile_native_call(uint64_t p_t_taken, const String &p_function_name, const String &p_instance_class_name = String());
 	void disassemble(const Vector<String> &p_code_lines) const;
+
+	static const char *get_opcode_name(Opcode p_opcode);
+
+#ifdef GDSCRIPT_OPCODE_PAIR_STATISTICS
+	// Executed opcode pairs, counted while "debug/settings/gdscript/opcode_pair_statistics" is enabled.
+	// Indexed by `first * (OPCODE_END + 1) + second`.
+	static SafeNumeric<uint64_t> *opcode_pair_counts;
+	static void start_opcode_pair_statistics();
+	static void finish_opcode_pair_statistics(int p_max_pairs);
+#endif
 #endif
 
 	GDScriptFunction();
@@ -609,6 +763,16 @@ class GDScriptFunctionState : public RefCounted {
 	SelfList<GDScriptFunctionState> scripts_list;
 	SelfList<GDScriptFunctionState> instances_list;
 
+	// Frames of suspended calls are recycled through free lists of power of two sizes, so
+	// coroutines awaiting in a loop don't go through the allocator on every `await`.
+	static constexpr uint32_t FRAME_POOL_MIN_SHIFT = 6; // 64 bytes.
+	static constexpr uint32_t FRAME_POOL_SIZE_CLASSES = 12; // Up to 128 KiB, larger frames aren't pooled.
+	static constexpr uint32_t FRAME_POOL_MAX_FREE_FRAMES = 1024; // Per size class.
+	static SpinLock frame_pool_lock;
+	static LocalVector<uint8_t *> frame_pool[FRAME_POOL_SIZE_CLASSES];
+
+	static uint32_t _get_frame_size_class(uint32_t p_size);
+
 protected:
 	static void _bind_methods();
 
@@ -619,6 +783,10 @@ public:
 	void _clear_stack();
 	void _clear_connections();
 
+	static uint8_t *alloc_frame(uint32_t p_size);
+	static void free_frame(uint8_t *p_frame, uint32_t p_size);
+	static void clear_frame_pool();
+
 	GDScriptFunctionState();
 	~GDScriptFunctionState();
 };
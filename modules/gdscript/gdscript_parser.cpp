@@ -172,6 +172,32 @@ void GDScriptParser::clear() {
 	*this = GDScriptParser();
 }
 
+const List<String> GDScriptParser::get_dependencies() const {
+	List<String> dependencies;
+	for (const String &E : dependency_paths) {
+		dependencies.push_back(E);
+	}
+	return dependencies;
+}
+
+const List<String> GDScriptParser::get_global_class_dependencies() const {
+	List<String> dependencies;
+	for (const StringName &E : used_identifiers) {
+		if (ScriptServer::is_global_class(E)) {
+			dependencies.push_back(ScriptServer::get_global_class_path(E));
+		}
+	}
+	return dependencies;
+}
+
+void GDScriptParser::_add_dependency_path(const String &p_path) {
+	String path = p_path;
+	if (path.is_relative_path()) {
+		path = script_path.get_base_dir().path_join(path);
+	}
+	dependency_paths.insert(path.simplify_path());
+}
+
 void GDScriptParser::push_error(const String &p_message, const Node *p_origin) {
 	// TODO: Improve error reporting by pointing at source code.
 	// TODO: Errors might point at more than one place at once (e.g. show previous declaration).
@@ -887,6 +913,9 @@ void GDScriptParser::parse_extends() {
 			push_error(vformat(R"(Only strings or identifiers can be used after "extends", found "%s" instead.)", Variant::get_type_name(previous.literal.get_type())));
 		}
 		current_class->extends_path = previous.literal;
+		if (previous.literal.get_type() == Variant::STRING) {
+			_add_dependency_path(previous.literal);
+		}
 
 		if (!match(GDScriptTokenizer::Token::PERIOD)) {
 			return;
@@ -2554,6 +2583,7 @@ GDScriptParser::ExpressionNode *GDScriptParser::parse_identifier(ExpressionNode
 		print_line("Empty identifier found.");
 	}
 	identifier->suite = current_suite;
+	used_identifiers.insert(identifier->name);
 
 	if (current_suite != nullptr && current_suite->has_local(identifier->name)) {
 		const SuiteNode::Local &declaration = current_suite->get_local(identifier->name);
@@ -3395,6 +3425,8 @@ GDScriptParser::ExpressionNode *GDScriptParser::parse_preload(ExpressionNode *p_
 
 	if (preload->path == nullptr) {
 		push_error(R"(Expected resource path after "(".)");
+	} else if (preload->path->type == Node::LITERAL && static_cast<LiteralNode *>(preload->path)->value.get_type() == Variant::STRING) {
+		_add_dependency_path(static_cast<LiteralNode *>(preload->path)->value);
 	}
 
 	pop_completion_call();
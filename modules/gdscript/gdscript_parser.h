@@ -44,6 +44,7 @@
 #include "core/string/string_name.h"
 #include "core/string/ustring.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
 #include "core/templates/list.h"
 #include "core/templates/rb_map.h"
 #include "core/templates/vector.h"
@@ -1337,6 +1338,10 @@ private:
 	bool can_continue = false;
 	List<bool> multiline_stack;
 	HashMap<String, Ref<GDScriptParserRef>> depended_parsers;
+	// Literal paths of `extends` and `preload()`, and every identifier used, which may name a global class.
+	// Known before analysis, which lets `GDScriptCache` parse dependencies ahead of time.
+	HashSet<String> dependency_paths;
+	HashSet<StringName> used_identifiers;
 
 	ClassNode *head = nullptr;
 	Node *list = nullptr;
@@ -1448,6 +1453,7 @@ private:
 		return node;
 	}
 	void clear();
+	void _add_dependency_path(const String &p_path);
 	void push_error(const String &p_message, const Node *p_origin = nullptr);
 #ifdef DEBUG_ENABLED
 	void push_warning(const Node *p_source, GDScriptWarning::Code p_code, const Vector<String> &p_symbols);
@@ -1585,10 +1591,9 @@ public:
 	bool annotation_exists(const String &p_annotation_name) const;
 
 	const List<ParserError> &get_errors() const { return errors; }
-	const List<String> get_dependencies() const {
-		// TODO: Keep track of deps.
-		return List<String>();
-	}
+	const List<String> get_dependencies() const;
+	// Paths of the global classes used by identifier, which can include false positives from shadowing.
+	const List<String> get_global_class_dependencies() const;
 #ifdef DEBUG_ENABLED
 	const List<GDScriptWarning> &get_warnings() const { return warnings; }
 	const HashSet<int> &get_unsafe_lines() const { return unsafe_lines; }
@@ -0,0 +1,285 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampling_profiler.h"
+
+#ifdef DEBUG_ENABLED
+
+#include "gdscript.h"
+
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+
+GDScriptSamplingProfiler::Data *GDScriptSamplingProfiler::data = nullptr;
+BinaryMutex GDScriptSamplingProfiler::mutex;
+Thread *GDScriptSamplingProfiler::sampler_thread = nullptr;
+SafeFlag GDScriptSamplingProfiler::running;
+SafeNumeric<uint32_t> GDScriptSamplingProfiler::sample_epoch;
+thread_local uint32_t GDScriptSamplingProfiler::thread_epoch = 0;
+String GDScriptSamplingProfiler::output_path;
+
+void GDScriptSamplingProfiler::_sampler_thread_func(void *p_userdata) {
+	const uint32_t interval = (uint32_t)(uintptr_t)p_userdata;
+	while (running.is_set()) {
+		OS::get_singleton()->delay_usec(interval);
+		sample_epoch.increment();
+	}
+}
+
+uint32_t GDScriptSamplingProfiler::_get_frame(const GDScriptFunction *p_function) {
+	HashMap<const GDScriptFunction *, uint32_t>::Iterator E = data->function_frames.find(p_function);
+	if (E) {
+		return E->value;
+	}
+
+	const String path = p_function->get_script() ? p_function->get_script()->get_script_path() : String();
+	const uint32_t frame = data->frame_names.size();
+	data->frame_names.push_back(vformat("%s (%s:%d)", p_function->get_name(), path, p_function->_initial_line));
+	data->function_frames.insert(p_function, frame);
+	return frame;
+}
+
+uint32_t GDScriptSamplingProfiler::_get_child(uint32_t p_parent, uint32_t p_frame) {
+	const uint64_t key = ((uint64_t)p_parent << 32) | p_frame;
+	HashMap<uint64_t, uint32_t>::Iterator E = data->children.find(key);
+	if (E) {
+		return E->value;
+	}
+
+	const uint32_t node = data->nodes.size();
+	Node child;
+	child.parent = p_parent;
+	child.frame = p_frame;
+	data->nodes.push_back(child);
+	data->children.insert(key, node);
+	return node;
+}
+
+void GDScriptSamplingProfiler::_get_path(uint32_t p_node, LocalVector<uint32_t> &r_path) {
+	r_path.clear();
+	for (uint32_t node = p_node; node != ROOT_NODE; node = data->nodes[node].parent) {
+		r_path.push_back(node);
+	}
+	r_path.invert();
+}
+
+void GDScriptSamplingProfiler::take_sample() {
+	const uint32_t epoch = sample_epoch.get();
+	uint32_t weight = epoch - thread_epoch;
+	thread_epoch = epoch;
+	if (!running.is_set()) {
+		return;
+	}
+
+	const GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	const GDScriptLanguage::CallStack &call_stack = GDScriptLanguage::_call_stack;
+	const int depth = MIN(call_stack.stack_pos, language->_debug_max_call_stack);
+	if (depth == 0 || call_stack.levels == nullptr) {
+		return;
+	}
+
+	MutexLock lock(mutex);
+	if (!data) {
+		return;
+	}
+
+	// Threads that were already running GDScript when the profile started were never synced.
+	weight = MIN(weight, epoch - data->start_epoch);
+
+	uint32_t node = ROOT_NODE;
+	for (int i = 0; i < depth; i++) {
+		if (call_stack.levels[i].function) {
+			node = _get_child(node, _get_frame(call_stack.levels[i].function));
+		}
+	}
+	data->nodes[node].samples += weight;
+
+	Sample sample;
+	sample.time = OS::get_singleton()->get_ticks_usec() - data->start_time;
+	sample.thread = Thread::get_caller_id();
+	sample.node = node;
+	sample.weight = weight;
+	data->samples.push_back(sample);
+}
+
+void GDScriptSamplingProfiler::forget_function(const GDScriptFunction *p_function) {
+	MutexLock lock(mutex);
+	if (data) {
+		// Another function may be allocated at the same address later.
+		data->function_frames.erase(p_function);
+	}
+}
+
+void GDScriptSamplingProfiler::start(uint32_t p_interval_usec) {
+	ERR_FAIL_COND_MSG(running.is_set(), "The GDScript sampling profiler is already running.");
+	ERR_FAIL_COND(p_interval_usec == 0);
+
+	{
+		MutexLock lock(mutex);
+		if (data) {
+			memdelete(data);
+		}
+		data = memnew(Data);
+		data->start_time = OS::get_singleton()->get_ticks_usec();
+		data->start_epoch = sample_epoch.get();
+		data->interval = p_interval_usec;
+		data->nodes.push_back(Node()); // Root.
+	}
+
+	running.set();
+	sampler_thread = memnew(Thread);
+	sampler_thread->start(_sampler_thread_func, (void *)(uintptr_t)p_interval_usec);
+}
+
+void GDScriptSamplingProfiler::stop() {
+	if (!running.is_set()) {
+		return;
+	}
+
+	running.clear();
+	sampler_thread->wait_to_finish();
+	memdelete(sampler_thread);
+	sampler_thread = nullptr;
+}
+
+void GDScriptSamplingProfiler::clear() {
+	stop();
+
+	MutexLock lock(mutex);
+	if (data) {
+		memdelete(data);
+		data = nullptr;
+	}
+}
+
+uint64_t GDScriptSamplingProfiler::get_sample_count() {
+	MutexLock lock(mutex);
+	uint64_t count = 0;
+	if (data) {
+		for (const Node &node : data->nodes) {
+			count += node.samples;
+		}
+	}
+	return count;
+}
+
+String GDScriptSamplingProfiler::get_collapsed_stacks() {
+	MutexLock lock(mutex);
+	ERR_FAIL_NULL_V(data, String());
+
+	String result;
+	LocalVector<uint32_t> path;
+	for (uint32_t i = 0; i < data->nodes.size(); i++) {
+		if (data->nodes[i].samples == 0) {
+			continue;
+		}
+
+		_get_path(i, path);
+		for (uint32_t j = 0; j < path.size(); j++) {
+			if (j > 0) {
+				result += ";";
+			}
+			result += data->frame_names[data->nodes[path[j]].frame];
+		}
+		result += " " + itos(data->nodes[i].samples) + "\n";
+	}
+	return result;
+}
+
+String GDScriptSamplingProfiler::get_chrome_trace() {
+	MutexLock lock(mutex);
+	ERR_FAIL_NULL_V(data, String());
+
+	struct Track {
+		LocalVector<uint32_t> open_nodes;
+		uint64_t end = 0;
+	};
+
+	const int pid = OS::get_singleton()->get_process_id();
+	Vector<String> events;
+	HashMap<Thread::ID, Track> tracks;
+	LocalVector<uint32_t> path;
+
+	auto close_nodes = [&](Track &r_track, Thread::ID p_thread, uint32_t p_keep, uint64_t p_time) {
+		for (uint32_t i = r_track.open_nodes.size(); i > p_keep; i--) {
+			const String &name = data->frame_names[data->nodes[r_track.open_nodes[i - 1]].frame];
+			events.push_back(vformat(R"({"name":"%s","ph":"E","ts":%d,"pid":%d,"tid":%d})", name.json_escape(), p_time, pid, p_thread));
+		}
+		r_track.open_nodes.resize(p_keep);
+	};
+
+	// Each sample covers the intervals it is weighted by. A node stays open while consecutive samples
+	// of its thread go through it.
+	for (const Sample &sample : data->samples) {
+		if (!tracks.has(sample.thread)) {
+			const String thread_name = sample.thread == Thread::get_main_id() ? String("Main thread") : vformat("Thread %d", sample.thread);
+			events.push_back(vformat(R"({"name":"thread_name","ph":"M","pid":%d,"tid":%d,"args":{"name":"%s"}})", pid, sample.thread, thread_name));
+		}
+		Track &track = tracks[sample.thread];
+
+		uint64_t begin = sample.time - MIN(sample.time, (uint64_t)sample.weight * data->interval);
+		if (begin > track.end) {
+			// The thread left GDScript after its previous sample.
+			close_nodes(track, sample.thread, 0, track.end);
+		}
+		begin = MAX(begin, track.end);
+
+		_get_path(sample.node, path);
+		uint32_t common = 0;
+		while (common < track.open_nodes.size() && common < path.size() && track.open_nodes[common] == path[common]) {
+			common++;
+		}
+		close_nodes(track, sample.thread, common, begin);
+		for (uint32_t i = common; i < path.size(); i++) {
+			const String &name = data->frame_names[data->nodes[path[i]].frame];
+			events.push_back(vformat(R"({"name":"%s","ph":"B","ts":%d,"pid":%d,"tid":%d})", name.json_escape(), begin, pid, sample.thread));
+			track.open_nodes.push_back(path[i]);
+		}
+		track.end = sample.time;
+	}
+
+	for (KeyValue<Thread::ID, Track> &E : tracks) {
+		close_nodes(E.value, E.key, 0, E.value.end);
+	}
+
+	return "{\"traceEvents\":[\n" + String(",\n").join(events) + "\n]}\n";
+}
+
+Error GDScriptSamplingProfiler::save(const String &p_path) {
+	const String contents = p_path.get_extension().to_lower() == "json" ? get_chrome_trace() : get_collapsed_stacks();
+
+	Error err;
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(file.is_null(), err, vformat(R"(Cannot save the GDScript profile to "%s".)", p_path));
+	file->store_string(contents);
+	return OK;
+}
+
+#endif // DEBUG_ENABLED
@@ -0,0 +1,121 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_SAMPLING_PROFILER_H
+#define GDSCRIPT_SAMPLING_PROFILER_H
+
+#ifdef DEBUG_ENABLED
+
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+class GDScriptFunction;
+
+// Statistical profiler for GDScript, with a much lower overhead than the instrumenting
+// one (see `GDScriptLanguage::profiling_start()`).
+// A sampler thread advances `sample_epoch` every interval. Threads running GDScript notice it
+// on their next line and record their own `GDScriptLanguage::_call_stack` into a shared call
+// tree. Each sample is weighted by the intervals elapsed since the thread entered GDScript or
+// was last sampled, so time spent in native calls is attributed to the script that made them.
+class GDScriptSamplingProfiler {
+	static constexpr uint32_t ROOT_NODE = 0;
+
+	struct Node {
+		uint32_t parent = ROOT_NODE;
+		uint32_t frame = 0;
+		uint64_t samples = 0;
+	};
+
+	struct Sample {
+		uint64_t time = 0; // Microseconds since `start()`.
+		Thread::ID thread = 0;
+		uint32_t node = ROOT_NODE;
+		uint32_t weight = 0;
+	};
+
+	struct Data {
+		uint64_t start_time = 0;
+		uint32_t start_epoch = 0;
+		uint32_t interval = 0;
+
+		HashMap<const GDScriptFunction *, uint32_t> function_frames;
+		LocalVector<String> frame_names;
+		// Child node of each (parent node << 32 | frame) pair.
+		HashMap<uint64_t, uint32_t> children;
+		LocalVector<Node> nodes;
+		LocalVector<Sample> samples;
+	};
+
+	static Data *data;
+	static BinaryMutex mutex;
+	static Thread *sampler_thread;
+	static SafeFlag running;
+	static SafeNumeric<uint32_t> sample_epoch;
+	static thread_local uint32_t thread_epoch;
+
+	static void _sampler_thread_func(void *p_userdata);
+	static uint32_t _get_frame(const GDScriptFunction *p_function);
+	static uint32_t _get_child(uint32_t p_parent, uint32_t p_frame);
+	static void _get_path(uint32_t p_node, LocalVector<uint32_t> &r_path);
+
+public:
+	static constexpr uint32_t DEFAULT_INTERVAL_USEC = 1000;
+
+	// Set with `--profile-gdscript <file>`. The whole run is then profiled and saved to it when GDScript finishes.
+	static String output_path;
+
+	_FORCE_INLINE_ static bool is_running() { return running.is_set(); }
+	// Checked by the VM on every line.
+	_FORCE_INLINE_ static bool is_sample_pending() { return sample_epoch.get() != thread_epoch; }
+	// Called when the thread enters GDScript, so the time it spent elsewhere is not counted.
+	_FORCE_INLINE_ static void sync_thread() { thread_epoch = sample_epoch.get(); }
+	static void take_sample();
+	static void forget_function(const GDScriptFunction *p_function);
+
+	// Starts a new profile, discarding the previous one.
+	static void start(uint32_t p_interval_usec = DEFAULT_INTERVAL_USEC);
+	static void stop();
+	static void clear();
+
+	static uint64_t get_sample_count();
+	// One line per call stack, as "outer;inner <samples>", which flame graph tools take as input.
+	static String get_collapsed_stacks();
+	// Trace Event Format, for chrome://tracing or Perfetto.
+	static String get_chrome_trace();
+	// Saves a Chrome trace if the extension is "json", collapsed stacks otherwise.
+	static Error save(const String &p_path);
+};
+
+#endif // DEBUG_ENABLED
+
+#endif // GDSCRIPT_SAMPLING_PROFILER_H
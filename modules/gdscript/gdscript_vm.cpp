@@ -227,166 +227,401 @@ void (*type_init_function_table[])(Variant *) = {
 	&VariantInitializer<PackedVector4Array>::init, // PACKED_VECTOR4_ARRAY.
 };
 
+_FORCE_INLINE_ const GDScriptFunction::InlineCacheEntry *GDScriptFunction::_inline_cache_find(InlineCache &p_cache, InlineCacheOp p_op, Object *p_object, const StringName &p_name, InlineCacheEntry &r_resolved) {
+	const GDScript *script = nullptr;
+	ScriptInstance *script_instance = p_object->get_script_instance();
+	if (script_instance) {
+		if (script_instance->get_language() != GDScriptLanguage::get_singleton() || script_instance->is_placeholder()) {
+			return nullptr;
+		}
+		script = static_cast<GDScriptInstance *>(script_instance)->script.ptr();
+	}
+	const StringName &class_name = p_object->get_class_name();
+	uint64_t script_version = script ? script->_get_inline_cache_version() : 0;
+
+	const InlineCacheBlock *block = p_cache.block.load(std::memory_order_acquire);
+	if (block) {
+		for (uint32_t i = 0; i < block->entry_count; i++) {
+			const InlineCacheEntry &entry = block->entries[i];
+			if (entry.script == script && entry.script_version == script_version && entry.class_name == class_name) {
+				return &entry;
+			}
+		}
+	}
+
+	if (p_cache.megamorphic.is_set()) {
+		return nullptr;
+	}
+
+	r_resolved.script = script;
+	r_resolved.script_version = script_version;
+	r_resolved.class_name = class_name;
+	_inline_cache_resolve(p_op, p_name, r_resolved);
+	_inline_cache_add(p_cache, r_resolved);
+	return &r_resolved;
+}
+
+#ifdef DEBUG_ENABLED
+#define COUNT_INLINE_CACHE(m_hit)                                                        \
+	if (unlikely(GDScriptLanguage::get_singleton()->profiling)) {                        \
+		((m_hit) ? profile.inline_cache_hits : profile.inline_cache_misses).increment(); \
+	}
+#else
+#define COUNT_INLINE_CACHE(m_hit)
+#endif
+
+bool GDScriptFunction::_inline_cache_get_named(InlineCache &p_cache, const Variant *p_base, const StringName &p_name, Variant &r_ret) {
+	if (p_base->get_type() != Variant::OBJECT) {
+		return false;
+	}
+	Object *obj = p_base->get_validated_object();
+	if (!obj) {
+		return false;
+	}
+
+	InlineCacheEntry resolved;
+	const InlineCacheEntry *entry = _inline_cache_find(p_cache, INLINE_CACHE_GET, obj, p_name, resolved);
+	bool handled = false;
+	if (entry) {
+		switch (entry->kind) {
+			case InlineCacheEntry::KIND_MEMBER: {
+				const GDScriptInstance *instance = static_cast<const GDScriptInstance *>(obj->get_script_instance());
+				if (likely(entry->member_index < instance->members.size())) {
+					r_ret = instance->members[entry->member_index];
+					handled = true;
+				}
+			} break;
+			case InlineCacheEntry::KIND_METHOD_BIND: {
+				Callable::CallError ce;
+				r_ret = entry->method->call(obj, nullptr, 0, ce);
+				handled = true;
+			} break;
+			default:
+				break;
+		}
+	}
+
+	COUNT_INLINE_CACHE(handled && entry != &resolved);
+	return handled;
+}
+
+bool GDScriptFunction::_inline_cache_set_named(InlineCache &p_cache, Variant *p_base, const StringName &p_name, const Variant &p_value, bool &r_valid) {
+	if (p_base->get_type() != Variant::OBJECT) {
+		return false;
+	}
+	Object *obj = p_base->get_validated_object();
+	if (!obj) {
+		return false;
+	}
+#ifdef TOOLS_ENABLED
+	if (!obj->is_edited()) {
+		// Object::set() flags the object as edited, let it do so once.
+		return false;
+	}
+#endif
+
+	InlineCacheEntry resolved;
+	const InlineCacheEntry *entry = _inline_cache_find(p_cache, INLINE_CACHE_SET, obj, p_name, resolved);
+	bool handled = false;
+	if (entry) {
+		switch (entry->kind) {
+			case InlineCacheEntry::KIND_MEMBER: {
+				GDScriptInstance *instance = static_cast<GDScriptInstance *>(obj->get_script_instance());
+				if (likely(entry->member_index < instance->members.size()) && (entry->value_type == Variant::VARIANT_MAX || p_value.get_type() == entry->value_type)) {
+					instance->members.write[entry->member_index] = p_value;
+					r_valid = true;
+					handled = true;
+				}
+			} break;
+			case InlineCacheEntry::KIND_METHOD_BIND: {
+				const Variant *args[1] = { &p_value };
+				Callable::CallError ce;
+				entry->method->call(obj, args, 1, ce);
+				r_valid = ce.error == Callable::CallError::CALL_OK;
+				handled = true;
+			} break;
+			default:
+				break;
+		}
+	}
+
+	COUNT_INLINE_CACHE(handled && entry != &resolved);
+	return handled;
+}
+
+bool GDScriptFunction::_inline_cache_call(InlineCache &p_cache, Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err) {
+	if (p_base->get_type() != Variant::OBJECT) {
+		return false;
+	}
+#ifdef DEBUG_ENABLED
+	Object *obj = p_base->get_validated_object();
+#else
+	Object *obj = const_cast<Object *>(*VariantInternal::get_object(p_base));
+#endif
+	if (!obj) {
+		return false;
+	}
+
+	InlineCacheEntry resolved;
+	const InlineCacheEntry *entry = _inline_cache_find(p_cache, INLINE_CACHE_CALL, obj, p_method, resolved);
+	bool handled = false;
+	if (entry) {
+		switch (entry->kind) {
+			case InlineCacheEntry::KIND_FUNCTION: {
+				// Same as Object::callp(), which locks the object against being freed by the callee.
+#ifdef DEBUG_ENABLED
+				_ObjectDebugLock debug_lock(obj);
+#endif
+				r_err.error = Callable::CallError::CALL_OK;
+				r_ret = entry->function->call(static_cast<GDScriptInstance *>(obj->get_script_instance()), p_args, p_argcount, r_err);
+				handled = true;
+			} break;
+			case InlineCacheEntry::KIND_METHOD_BIND: {
+#ifdef DEBUG_ENABLED
+				_ObjectDebugLock debug_lock(obj);
+#endif
+				r_err.error = Callable::CallError::CALL_OK;
+				r_ret = entry->method->call(obj, p_args, p_argcount, r_err);
+				handled = true;
+			} break;
+			default:
+				break;
+		}
+	}
+
+	COUNT_INLINE_CACHE(handled && entry != &resolved);
+	return handled;
+}
+
+#ifdef GDSCRIPT_OPCODE_PAIR_STATISTICS
+// `last_opcode` is the instruction that just executed, `ip` points to the next one.
+#define COUNT_OPCODE_PAIR                                                               \
+	if (unlikely(opcode_pair_counts != nullptr) && ip < _code_size) {                   \
+		opcode_pair_counts[last_opcode * (OPCODE_END + 1) + _code_ptr[ip]].increment(); \
+	}
+#else
+// Only built with the `gdscript_opcode_pair_statistics` option, it would cost every dispatch otherwise.
+#define COUNT_OPCODE_PAIR
+#endif
+
 #if defined(__GNUC__) || defined(__clang__)
-#define OPCODES_TABLE                                    \
-	static const void *switch_table_ops[] = {            \
-		&&OPCODE_OPERATOR,                               \
-		&&OPCODE_OPERATOR_VALIDATED,                     \
-		&&OPCODE_TYPE_TEST_BUILTIN,                      \
-		&&OPCODE_TYPE_TEST_ARRAY,                        \
-		&&OPCODE_TYPE_TEST_DICTIONARY,                   \
-		&&OPCODE_TYPE_TEST_NATIVE,                       \
-		&&OPCODE_TYPE_TEST_SCRIPT,                       \
-		&&OPCODE_SET_KEYED,                              \
-		&&OPCODE_SET_KEYED_VALIDATED,                    \
-		&&OPCODE_SET_INDEXED_VALIDATED,                  \
-		&&OPCODE_GET_KEYED,                              \
-		&&OPCODE_GET_KEYED_VALIDATED,                    \
-		&&OPCODE_GET_INDEXED_VALIDATED,                  \
-		&&OPCODE_SET_NAMED,                              \
-		&&OPCODE_SET_NAMED_VALIDATED,                    \
-		&&OPCODE_GET_NAMED,                              \
-		&&OPCODE_GET_NAMED_VALIDATED,                    \
-		&&OPCODE_SET_MEMBER,                             \
-		&&OPCODE_GET_MEMBER,                             \
-		&&OPCODE_SET_STATIC_VARIABLE,                    \
-		&&OPCODE_GET_STATIC_VARIABLE,                    \
-		&&OPCODE_ASSIGN,                                 \
-		&&OPCODE_ASSIGN_NULL,                            \
-		&&OPCODE_ASSIGN_TRUE,                            \
-		&&OPCODE_ASSIGN_FALSE,                           \
-		&&OPCODE_ASSIGN_TYPED_BUILTIN,                   \
-		&&OPCODE_ASSIGN_TYPED_ARRAY,                     \
-		&&OPCODE_ASSIGN_TYPED_DICTIONARY,                \
-		&&OPCODE_ASSIGN_TYPED_NATIVE,                    \
-		&&OPCODE_ASSIGN_TYPED_SCRIPT,                    \
-		&&OPCODE_CAST_TO_BUILTIN,                        \
-		&&OPCODE_CAST_TO_NATIVE,                         \
-		&&OPCODE_CAST_TO_SCRIPT,                         \
-		&&OPCODE_CONSTRUCT,                              \
-		&&OPCODE_CONSTRUCT_VALIDATED,                    \
-		&&OPCODE_CONSTRUCT_ARRAY,                        \
-		&&OPCODE_CONSTRUCT_TYPED_ARRAY,                  \
-		&&OPCODE_CONSTRUCT_DICTIONARY,                   \
-		&&OPCODE_CONSTRUCT_TYPED_DICTIONARY,             \
-		&&OPCODE_CALL,                                   \
-		&&OPCODE_CALL_RETURN,                            \
-		&&OPCODE_CALL_ASYNC,                             \
-		&&OPCODE_CALL_UTILITY,                           \
-		&&OPCODE_CALL_UTILITY_VALIDATED,                 \
-		&&OPCODE_CALL_GDSCRIPT_UTILITY,                  \
-		&&OPCODE_CALL_BUILTIN_TYPE_VALIDATED,            \
-		&&OPCODE_CALL_SELF_BASE,                         \
-		&&OPCODE_CALL_METHOD_BIND,                       \
-		&&OPCODE_CALL_METHOD_BIND_RET,                   \
-		&&OPCODE_CALL_BUILTIN_STATIC,                    \
-		&&OPCODE_CALL_NATIVE_STATIC,                     \
-		&&OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN,    \
-		&&OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN, \
-		&&OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN,      \
-		&&OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN,   \
-		&&OPCODE_AWAIT,                                  \
-		&&OPCODE_AWAIT_RESUME,                           \
-		&&OPCODE_CREATE_LAMBDA,                          \
-		&&OPCODE_CREATE_SELF_LAMBDA,                     \
-		&&OPCODE_JUMP,                                   \
-		&&OPCODE_JUMP_IF,                                \
-		&&OPCODE_JUMP_IF_NOT,                            \
-		&&OPCODE_JUMP_TO_DEF_ARGUMENT,                   \
-		&&OPCODE_JUMP_IF_SHARED,                         \
-		&&OPCODE_RETURN,                                 \
-		&&OPCODE_RETURN_TYPED_BUILTIN,                   \
-		&&OPCODE_RETURN_TYPED_ARRAY,                     \
-		&&OPCODE_RETURN_TYPED_DICTIONARY,                \
-		&&OPCODE_RETURN_TYPED_NATIVE,                    \
-		&&OPCODE_RETURN_TYPED_SCRIPT,                    \
-		&&OPCODE_ITERATE_BEGIN,                          \
-		&&OPCODE_ITERATE_BEGIN_INT,                      \
-		&&OPCODE_ITERATE_BEGIN_FLOAT,                    \
-		&&OPCODE_ITERATE_BEGIN_VECTOR2,                  \
-		&&OPCODE_ITERATE_BEGIN_VECTOR2I,                 \
-		&&OPCODE_ITERATE_BEGIN_VECTOR3,                  \
-		&&OPCODE_ITERATE_BEGIN_VECTOR3I,                 \
-		&&OPCODE_ITERATE_BEGIN_STRING,                   \
-		&&OPCODE_ITERATE_BEGIN_DICTIONARY,               \
-		&&OPCODE_ITERATE_BEGIN_ARRAY,                    \
-		&&OPCODE_ITERATE_BEGIN_PACKED_BYTE_ARRAY,        \
-		&&OPCODE_ITERATE_BEGIN_PACKED_INT32_ARRAY,       \
-		&&OPCODE_ITERATE_BEGIN_PACKED_INT64_ARRAY,       \
-		&&OPCODE_ITERATE_BEGIN_PACKED_FLOAT32_ARRAY,     \
-		&&OPCODE_ITERATE_BEGIN_PACKED_FLOAT64_ARRAY,     \
-		&&OPCODE_ITERATE_BEGIN_PACKED_STRING_ARRAY,      \
-		&&OPCODE_ITERATE_BEGIN_PACKED_VECTOR2_ARRAY,     \
-		&&OPCODE_ITERATE_BEGIN_PACKED_VECTOR3_ARRAY,     \
-		&&OPCODE_ITERATE_BEGIN_PACKED_COLOR_ARRAY,       \
-		&&OPCODE_ITERATE_BEGIN_PACKED_VECTOR4_ARRAY,     \
-		&&OPCODE_ITERATE_BEGIN_OBJECT,                   \
-		&&OPCODE_ITERATE,                                \
-		&&OPCODE_ITERATE_INT,                            \
-		&&OPCODE_ITERATE_FLOAT,                          \
-		&&OPCODE_ITERATE_VECTOR2,                        \
-		&&OPCODE_ITERATE_VECTOR2I,                       \
-		&&OPCODE_ITERATE_VECTOR3,                        \
-		&&OPCODE_ITERATE_VECTOR3I,                       \
-		&&OPCODE_ITERATE_STRING,                         \
-		&&OPCODE_ITERATE_DICTIONARY,                     \
-		&&OPCODE_ITERATE_ARRAY,                          \
-		&&OPCODE_ITERATE_PACKED_BYTE_ARRAY,              \
-		&&OPCODE_ITERATE_PACKED_INT32_ARRAY,             \
-		&&OPCODE_ITERATE_PACKED_INT64_ARRAY,             \
-		&&OPCODE_ITERATE_PACKED_FLOAT32_ARRAY,           \
-		&&OPCODE_ITERATE_PACKED_FLOAT64_ARRAY,           \
-		&&OPCODE_ITERATE_PACKED_STRING_ARRAY,            \
-		&&OPCODE_ITERATE_PACKED_VECTOR2_ARRAY,           \
-		&&OPCODE_ITERATE_PACKED_VECTOR3_ARRAY,           \
-		&&OPCODE_ITERATE_PACKED_COLOR_ARRAY,             \
-		&&OPCODE_ITERATE_PACKED_VECTOR4_ARRAY,           \
-		&&OPCODE_ITERATE_OBJECT,                         \
-		&&OPCODE_STORE_GLOBAL,                           \
-		&&OPCODE_STORE_NAMED_GLOBAL,                     \
-		&&OPCODE_TYPE_ADJUST_BOOL,                       \
-		&&OPCODE_TYPE_ADJUST_INT,                        \
-		&&OPCODE_TYPE_ADJUST_FLOAT,                      \
-		&&OPCODE_TYPE_ADJUST_STRING,                     \
-		&&OPCODE_TYPE_ADJUST_VECTOR2,                    \
-		&&OPCODE_TYPE_ADJUST_VECTOR2I,                   \
-		&&OPCODE_TYPE_ADJUST_RECT2,                      \
-		&&OPCODE_TYPE_ADJUST_RECT2I,                     \
-		&&OPCODE_TYPE_ADJUST_VECTOR3,                    \
-		&&OPCODE_TYPE_ADJUST_VECTOR3I,                   \
-		&&OPCODE_TYPE_ADJUST_TRANSFORM2D,                \
-		&&OPCODE_TYPE_ADJUST_VECTOR4,                    \
-		&&OPCODE_TYPE_ADJUST_VECTOR4I,                   \
-		&&OPCODE_TYPE_ADJUST_PLANE,                      \
-		&&OPCODE_TYPE_ADJUST_QUATERNION,                 \
-		&&OPCODE_TYPE_ADJUST_AABB,                       \
-		&&OPCODE_TYPE_ADJUST_BASIS,                      \
-		&&OPCODE_TYPE_ADJUST_TRANSFORM3D,                \
-		&&OPCODE_TYPE_ADJUST_PROJECTION,                 \
-		&&OPCODE_TYPE_ADJUST_COLOR,                      \
-		&&OPCODE_TYPE_ADJUST_STRING_NAME,                \
-		&&OPCODE_TYPE_ADJUST_NODE_PATH,                  \
-		&&OPCODE_TYPE_ADJUST_RID,                        \
-		&&OPCODE_TYPE_ADJUST_OBJECT,                     \
-		&&OPCODE_TYPE_ADJUST_CALLABLE,                   \
-		&&OPCODE_TYPE_ADJUST_SIGNAL,                     \
-		&&OPCODE_TYPE_ADJUST_DICTIONARY,                 \
-		&&OPCODE_TYPE_ADJUST_ARRAY,                      \
-		&&OPCODE_TYPE_ADJUST_PACKED_BYTE_ARRAY,          \
-		&&OPCODE_TYPE_ADJUST_PACKED_INT32_ARRAY,         \
-		&&OPCODE_TYPE_ADJUST_PACKED_INT64_ARRAY,         \
-		&&OPCODE_TYPE_ADJUST_PACKED_FLOAT32_ARRAY,       \
-		&&OPCODE_TYPE_ADJUST_PACKED_FLOAT64_ARRAY,       \
-		&&OPCODE_TYPE_ADJUST_PACKED_STRING_ARRAY,        \
-		&&OPCODE_TYPE_ADJUST_PACKED_VECTOR2_ARRAY,       \
-		&&OPCODE_TYPE_ADJUST_PACKED_VECTOR3_ARRAY,       \
-		&&OPCODE_TYPE_ADJUST_PACKED_COLOR_ARRAY,         \
-		&&OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY,       \
-		&&OPCODE_ASSERT,                                 \
-		&&OPCODE_BREAKPOINT,                             \
-		&&OPCODE_LINE,                                   \
-		&&OPCODE_END                                     \
-	};                                                   \
+#define OPCODES_TABLE                                      \
+	static const void *switch_table_ops[] = {              \
+		&&OPCODE_OPERATOR,                                 \
+		&&OPCODE_OPERATOR_VALIDATED,                       \
+		&&OPCODE_OPERATOR_ADD_INT,                         \
+		&&OPCODE_OPERATOR_SUBTRACT_INT,                    \
+		&&OPCODE_OPERATOR_MULTIPLY_INT,                    \
+		&&OPCODE_OPERATOR_EQUAL_INT,                       \
+		&&OPCODE_OPERATOR_NOT_EQUAL_INT,                   \
+		&&OPCODE_OPERATOR_LESS_INT,                        \
+		&&OPCODE_OPERATOR_LESS_EQUAL_INT,                  \
+		&&OPCODE_OPERATOR_GREATER_INT,                     \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_INT,               \
+		&&OPCODE_OPERATOR_ADD_FLOAT,                       \
+		&&OPCODE_OPERATOR_SUBTRACT_FLOAT,                  \
+		&&OPCODE_OPERATOR_MULTIPLY_FLOAT,                  \
+		&&OPCODE_OPERATOR_DIVIDE_FLOAT,                    \
+		&&OPCODE_OPERATOR_EQUAL_FLOAT,                     \
+		&&OPCODE_OPERATOR_NOT_EQUAL_FLOAT,                 \
+		&&OPCODE_OPERATOR_LESS_FLOAT,                      \
+		&&OPCODE_OPERATOR_LESS_EQUAL_FLOAT,                \
+		&&OPCODE_OPERATOR_GREATER_FLOAT,                   \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_FLOAT,             \
+		&&OPCODE_OPERATOR_EQUAL_INT_JUMP_IF_NOT,           \
+		&&OPCODE_OPERATOR_NOT_EQUAL_INT_JUMP_IF_NOT,       \
+		&&OPCODE_OPERATOR_LESS_INT_JUMP_IF_NOT,            \
+		&&OPCODE_OPERATOR_LESS_EQUAL_INT_JUMP_IF_NOT,      \
+		&&OPCODE_OPERATOR_GREATER_INT_JUMP_IF_NOT,         \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_INT_JUMP_IF_NOT,   \
+		&&OPCODE_OPERATOR_LESS_FLOAT_JUMP_IF_NOT,          \
+		&&OPCODE_OPERATOR_LESS_EQUAL_FLOAT_JUMP_IF_NOT,    \
+		&&OPCODE_OPERATOR_GREATER_FLOAT_JUMP_IF_NOT,       \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_FLOAT_JUMP_IF_NOT, \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,           \
+		&&OPCODE_OPERATOR_ADD_INT_ASSIGN,                  \
+		&&OPCODE_OPERATOR_SUBTRACT_INT_ASSIGN,             \
+		&&OPCODE_OPERATOR_MULTIPLY_INT_ASSIGN,             \
+		&&OPCODE_OPERATOR_ADD_FLOAT_ASSIGN,                \
+		&&OPCODE_OPERATOR_SUBTRACT_FLOAT_ASSIGN,           \
+		&&OPCODE_OPERATOR_MULTIPLY_FLOAT_ASSIGN,           \
+		&&OPCODE_OPERATOR_DIVIDE_FLOAT_ASSIGN,             \
+		&&OPCODE_OPERATOR_VALIDATED_ASSIGN,                \
+		&&OPCODE_TYPE_TEST_BUILTIN,                        \
+		&&OPCODE_TYPE_TEST_ARRAY,                          \
+		&&OPCODE_TYPE_TEST_DICTIONARY,                     \
+		&&OPCODE_TYPE_TEST_NATIVE,                         \
+		&&OPCODE_TYPE_TEST_SCRIPT,                         \
+		&&OPCODE_SET_KEYED,                                \
+		&&OPCODE_SET_KEYED_VALIDATED,                      \
+		&&OPCODE_SET_INDEXED_VALIDATED,                    \
+		&&OPCODE_SET_INDEXED_PACKED_BYTE_ARRAY,            \
+		&&OPCODE_SET_INDEXED_PACKED_INT32_ARRAY,           \
+		&&OPCODE_SET_INDEXED_PACKED_INT64_ARRAY,           \
+		&&OPCODE_SET_INDEXED_PACKED_FLOAT32_ARRAY,         \
+		&&OPCODE_SET_INDEXED_PACKED_FLOAT64_ARRAY,         \
+		&&OPCODE_SET_INDEXED_PACKED_STRING_ARRAY,          \
+		&&OPCODE_SET_INDEXED_PACKED_VECTOR2_ARRAY,         \
+		&&OPCODE_SET_INDEXED_PACKED_VECTOR3_ARRAY,         \
+		&&OPCODE_SET_INDEXED_PACKED_COLOR_ARRAY,           \
+		&&OPCODE_SET_INDEXED_PACKED_VECTOR4_ARRAY,         \
+		&&OPCODE_GET_KEYED,                                \
+		&&OPCODE_GET_KEYED_VALIDATED,                      \
+		&&OPCODE_GET_INDEXED_VALIDATED,                    \
+		&&OPCODE_GET_INDEXED_PACKED_BYTE_ARRAY,            \
+		&&OPCODE_GET_INDEXED_PACKED_INT32_ARRAY,           \
+		&&OPCODE_GET_INDEXED_PACKED_INT64_ARRAY,           \
+		&&OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY,         \
+		&&OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY,         \
+		&&OPCODE_GET_INDEXED_PACKED_STRING_ARRAY,          \
+		&&OPCODE_GET_INDEXED_PACKED_VECTOR2_ARRAY,         \
+		&&OPCODE_GET_INDEXED_PACKED_VECTOR3_ARRAY,         \
+		&&OPCODE_GET_INDEXED_PACKED_COLOR_ARRAY,           \
+		&&OPCODE_GET_INDEXED_PACKED_VECTOR4_ARRAY,         \
+		&&OPCODE_SET_NAMED,                                \
+		&&OPCODE_SET_NAMED_VALIDATED,                      \
+		&&OPCODE_GET_NAMED,                                \
+		&&OPCODE_GET_NAMED_VALIDATED,                      \
+		&&OPCODE_SET_MEMBER,                               \
+		&&OPCODE_GET_MEMBER,                               \
+		&&OPCODE_SET_STATIC_VARIABLE,                      \
+		&&OPCODE_GET_STATIC_VARIABLE,                      \
+		&&OPCODE_ASSIGN,                                   \
+		&&OPCODE_ASSIGN_NULL,                              \
+		&&OPCODE_ASSIGN_TRUE,                              \
+		&&OPCODE_ASSIGN_FALSE,                             \
+		&&OPCODE_ASSIGN_TYPED_BUILTIN,                     \
+		&&OPCODE_ASSIGN_TYPED_ARRAY,                       \
+		&&OPCODE_ASSIGN_TYPED_DICTIONARY,                  \
+		&&OPCODE_ASSIGN_TYPED_NATIVE,                      \
+		&&OPCODE_ASSIGN_TYPED_SCRIPT,                      \
+		&&OPCODE_CAST_TO_BUILTIN,                          \
+		&&OPCODE_CAST_TO_NATIVE,                           \
+		&&OPCODE_CAST_TO_SCRIPT,                           \
+		&&OPCODE_CONSTRUCT,                                \
+		&&OPCODE_CONSTRUCT_VALIDATED,                      \
+		&&OPCODE_CONSTRUCT_ARRAY,                          \
+		&&OPCODE_CONSTRUCT_TYPED_ARRAY,                    \
+		&&OPCODE_CONSTRUCT_DICTIONARY,                     \
+		&&OPCODE_CONSTRUCT_TYPED_DICTIONARY,               \
+		&&OPCODE_CALL,                                     \
+		&&OPCODE_CALL_RETURN,                              \
+		&&OPCODE_CALL_ASYNC,                               \
+		&&OPCODE_CALL_UTILITY,                             \
+		&&OPCODE_CALL_UTILITY_VALIDATED,                   \
+		&&OPCODE_CALL_GDSCRIPT_UTILITY,                    \
+		&&OPCODE_CALL_BUILTIN_TYPE_VALIDATED,              \
+		&&OPCODE_CALL_SELF_BASE,                           \
+		&&OPCODE_CALL_METHOD_BIND,                         \
+		&&OPCODE_CALL_METHOD_BIND_RET,                     \
+		&&OPCODE_CALL_BUILTIN_STATIC,                      \
+		&&OPCODE_CALL_NATIVE_STATIC,                       \
+		&&OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN,      \
+		&&OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN,   \
+		&&OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN,        \
+		&&OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN,     \
+		&&OPCODE_AWAIT,                                    \
+		&&OPCODE_AWAIT_RESUME,                             \
+		&&OPCODE_CREATE_LAMBDA,                            \
+		&&OPCODE_CREATE_SELF_LAMBDA,                       \
+		&&OPCODE_JUMP,                                     \
+		&&OPCODE_JUMP_IF,                                  \
+		&&OPCODE_JUMP_IF_NOT,                              \
+		&&OPCODE_JUMP_TO_DEF_ARGUMENT,                     \
+		&&OPCODE_JUMP_IF_SHARED,                           \
+		&&OPCODE_RETURN,                                   \
+		&&OPCODE_RETURN_TYPED_BUILTIN,                     \
+		&&OPCODE_RETURN_TYPED_ARRAY,                       \
+		&&OPCODE_RETURN_TYPED_DICTIONARY,                  \
+		&&OPCODE_RETURN_TYPED_NATIVE,                      \
+		&&OPCODE_RETURN_TYPED_SCRIPT,                      \
+		&&OPCODE_ITERATE_BEGIN,                            \
+		&&OPCODE_ITERATE_BEGIN_INT,                        \
+		&&OPCODE_ITERATE_BEGIN_FLOAT,                      \
+		&&OPCODE_ITERATE_BEGIN_VECTOR2,                    \
+		&&OPCODE_ITERATE_BEGIN_VECTOR2I,                   \
+		&&OPCODE_ITERATE_BEGIN_VECTOR3,                    \
+		&&OPCODE_ITERATE_BEGIN_VECTOR3I,                   \
+		&&OPCODE_ITERATE_BEGIN_STRING,                     \
+		&&OPCODE_ITERATE_BEGIN_DICTIONARY,                 \
+		&&OPCODE_ITERATE_BEGIN_ARRAY,                      \
+		&&OPCODE_ITERATE_BEGIN_PACKED_BYTE_ARRAY,          \
+		&&OPCODE_ITERATE_BEGIN_PACKED_INT32_ARRAY,         \
+		&&OPCODE_ITERATE_BEGIN_PACKED_INT64_ARRAY,         \
+		&&OPCODE_ITERATE_BEGIN_PACKED_FLOAT32_ARRAY,       \
+		&&OPCODE_ITERATE_BEGIN_PACKED_FLOAT64_ARRAY,       \
+		&&OPCODE_ITERATE_BEGIN_PACKED_STRING_ARRAY,        \
+		&&OPCODE_ITERATE_BEGIN_PACKED_VECTOR2_ARRAY,       \
+		&&OPCODE_ITERATE_BEGIN_PACKED_VECTOR3_ARRAY,       \
+		&&OPCODE_ITERATE_BEGIN_PACKED_COLOR_ARRAY,         \
+		&&OPCODE_ITERATE_BEGIN_PACKED_VECTOR4_ARRAY,       \
+		&&OPCODE_ITERATE_BEGIN_OBJECT,                     \
+		&&OPCODE_ITERATE,                                  \
+		&&OPCODE_ITERATE_INT,                              \
+		&&OPCODE_ITERATE_FLOAT,                            \
+		&&OPCODE_ITERATE_VECTOR2,                          \
+		&&OPCODE_ITERATE_VECTOR2I,                         \
+		&&OPCODE_ITERATE_VECTOR3,                          \
+		&&OPCODE_ITERATE_VECTOR3I,                         \
+		&&OPCODE_ITERATE_STRING,                           \
+		&&OPCODE_ITERATE_DICTIONARY,                       \
+		&&OPCODE_ITERATE_ARRAY,                            \
+		&&OPCODE_ITERATE_PACKED_BYTE_ARRAY,                \
+		&&OPCODE_ITERATE_PACKED_INT32_ARRAY,               \
+		&&OPCODE_ITERATE_PACKED_INT64_ARRAY,               \
+		&&OPCODE_ITERATE_PACKED_FLOAT32_ARRAY,             \
+		&&OPCODE_ITERATE_PACKED_FLOAT64_ARRAY,             \
+		&&OPCODE_ITERATE_PACKED_STRING_ARRAY,              \
+		&&OPCODE_ITERATE_PACKED_VECTOR2_ARRAY,             \
+		&&OPCODE_ITERATE_PACKED_VECTOR3_ARRAY,             \
+		&&OPCODE_ITERATE_PACKED_COLOR_ARRAY,               \
+		&&OPCODE_ITERATE_PACKED_VECTOR4_ARRAY,             \
+		&&OPCODE_ITERATE_OBJECT,                           \
+		&&OPCODE_STORE_GLOBAL,                             \
+		&&OPCODE_STORE_NAMED_GLOBAL,                       \
+		&&OPCODE_TYPE_ADJUST_BOOL,                         \
+		&&OPCODE_TYPE_ADJUST_INT,                          \
+		&&OPCODE_TYPE_ADJUST_FLOAT,                        \
+		&&OPCODE_TYPE_ADJUST_STRING,                       \
+		&&OPCODE_TYPE_ADJUST_VECTOR2,                      \
+		&&OPCODE_TYPE_ADJUST_VECTOR2I,                     \
+		&&OPCODE_TYPE_ADJUST_RECT2,                        \
+		&&OPCODE_TYPE_ADJUST_RECT2I,                       \
+		&&OPCODE_TYPE_ADJUST_VECTOR3,                      \
+		&&OPCODE_TYPE_ADJUST_VECTOR3I,                     \
+		&&OPCODE_TYPE_ADJUST_TRANSFORM2D,                  \
+		&&OPCODE_TYPE_ADJUST_VECTOR4,                      \
+		&&OPCODE_TYPE_ADJUST_VECTOR4I,                     \
+		&&OPCODE_TYPE_ADJUST_PLANE,                        \
+		&&OPCODE_TYPE_ADJUST_QUATERNION,                   \
+		&&OPCODE_TYPE_ADJUST_AABB,                         \
+		&&OPCODE_TYPE_ADJUST_BASIS,                        \
+		&&OPCODE_TYPE_ADJUST_TRANSFORM3D,                  \
+		&&OPCODE_TYPE_ADJUST_PROJECTION,                   \
+		&&OPCODE_TYPE_ADJUST_COLOR,                        \
+		&&OPCODE_TYPE_ADJUST_STRING_NAME,                  \
+		&&OPCODE_TYPE_ADJUST_NODE_PATH,                    \
+		&&OPCODE_TYPE_ADJUST_RID,                          \
+		&&OPCODE_TYPE_ADJUST_OBJECT,                       \
+		&&OPCODE_TYPE_ADJUST_CALLABLE,                     \
+		&&OPCODE_TYPE_ADJUST_SIGNAL,                       \
+		&&OPCODE_TYPE_ADJUST_DICTIONARY,                   \
+		&&OPCODE_TYPE_ADJUST_ARRAY,                        \
+		&&OPCODE_TYPE_ADJUST_PACKED_BYTE_ARRAY,            \
+		&&OPCODE_TYPE_ADJUST_PACKED_INT32_ARRAY,           \
+		&&OPCODE_TYPE_ADJUST_PACKED_INT64_ARRAY,           \
+		&&OPCODE_TYPE_ADJUST_PACKED_FLOAT32_ARRAY,         \
+		&&OPCODE_TYPE_ADJUST_PACKED_FLOAT64_ARRAY,         \
+		&&OPCODE_TYPE_ADJUST_PACKED_STRING_ARRAY,          \
+		&&OPCODE_TYPE_ADJUST_PACKED_VECTOR2_ARRAY,         \
+		&&OPCODE_TYPE_ADJUST_PACKED_VECTOR3_ARRAY,         \
+		&&OPCODE_TYPE_ADJUST_PACKED_COLOR_ARRAY,           \
+		&&OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY,         \
+		&&OPCODE_ASSERT,                                   \
+		&&OPCODE_BREAKPOINT,                               \
+		&&OPCODE_LINE,                                     \
+		&&OPCODE_END                                       \
+	};                                                     \
 	static_assert((sizeof(switch_table_ops) / sizeof(switch_table_ops[0]) == (OPCODE_END + 1)), "Opcodes in jump table aren't the same as opcodes in enum.");
 
 #define OPCODE(m_op) \
@@ -399,6 +634,7 @@ void (*type_init_function_table[])(Variant *) = {
 #define OPCODE_SWITCH(m_test) goto *switch_table_ops[m_test];
 #ifdef DEBUG_ENABLED
 #define DISPATCH_OPCODE          \
+	COUNT_OPCODE_PAIR;           \
 	last_opcode = _code_ptr[ip]; \
 	goto *switch_table_ops[last_opcode]
 #else
@@ -412,7 +648,13 @@ void (*type_init_function_table[])(Variant *) = {
 #define OPCODE_WHILE(m_test) while (m_test)
 #define OPCODES_END
 #define OPCODES_OUT
+#ifdef DEBUG_ENABLED
+#define DISPATCH_OPCODE \
+	COUNT_OPCODE_PAIR;  \
+	continue
+#else
 #define DISPATCH_OPCODE continue
+#endif
 #ifdef _MSC_VER
 #define OPCODE_SWITCH(m_test)       \
 	__assume(m_test <= OPCODE_END); \
@@ -517,14 +759,17 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	GDScript *script;
 	int ip = 0;
 	int line = _initial_line;
+	// Set when `await` moved the frame into a state, which owns it from then on. Also keeps that state,
+	// and the frame a resumed call still runs on, alive until the call returns.
+	Ref<GDScriptFunctionState> suspended_state;
 
 	if (p_state) {
 		//use existing (supplied) state (awaited)
-		stack = (Variant *)p_state->stack.ptr();
-		instruction_args = (Variant **)&p_state->stack.ptr()[sizeof(Variant) * p_state->stack_size]; //ptr() to avoid bounds check
+		stack = (Variant *)p_state->stack;
+		instruction_args = (Variant **)&p_state->stack[sizeof(Variant) * p_state->stack_size];
 		line = p_state->line;
 		ip = p_state->ip;
-		alloca_size = p_state->stack.size();
+		alloca_size = p_state->alloca_size;
 		script = p_state->script;
 		p_instance = p_state->instance;
 		defarg = p_state->defarg;
@@ -552,14 +797,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		uint8_t *aptr = (uint8_t *)alloca(alloca_size);
 		stack = (Variant *)aptr;
 
+		const uint8_t *fast_types = argument_fast_types.ptr();
 		for (int i = 0; i < p_argcount; i++) {
-			if (!argument_types[i].has_type) {
-				memnew_placement(&stack[i + 3], Variant(*p_args[i]));
-				continue;
-			}
 			// If types already match, don't call Variant::construct(). Constructors of some types
 			// (e.g. packed arrays) do copies, whereas they pass by reference when inside a Variant.
-			if (argument_types[i].is_type(*p_args[i], false)) {
+			// Untyped arguments and plain builtin types are checked without leaving this loop.
+			const uint8_t fast_type = fast_types[i];
+			if (likely(fast_type == ARGUMENT_ANY || fast_type == p_args[i]->get_type()) || (fast_type == ARGUMENT_CHECKED && argument_types[i].is_type(*p_args[i], false))) {
 				memnew_placement(&stack[i + 3], Variant(*p_args[i]));
 				continue;
 			}
@@ -596,8 +840,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				memnew_placement(&stack[i + 3], Variant(*p_args[i]));
 			}
 		}
+		// Locals start as null, typed temporaries as the default value of their type.
+		const uint8_t *init_types = stack_init_types.ptr();
 		for (int i = p_argcount + 3; i < _stack_size; i++) {
 			memnew_placement(&stack[i], Variant);
+			if (init_types[i] != Variant::NIL) {
+				type_init_function_table[init_types[i]](&stack[i]);
+			}
 		}
 
 		if (_instruction_args_size) {
@@ -605,10 +854,6 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		} else {
 			instruction_args = nullptr;
 		}
-
-		for (const KeyValue<int, Variant::Type> &E : temporary_slots) {
-			type_init_function_table[E.value](&stack[E.key]);
-		}
 	}
 
 	if (p_instance) {
@@ -625,9 +870,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 #ifdef DEBUG_ENABLED
 
-	if (EngineDebugger::is_active()) {
+	const bool track_call_stack = EngineDebugger::is_active() || GDScriptSamplingProfiler::is_running();
+	if (track_call_stack) {
 		GDScriptLanguage::get_singleton()->enter_function(p_instance, this, stack, &ip, &line);
 	}
+	if (p_state) {
+		p_state->call_stack_tracked = track_call_stack;
+	}
 
 #define GD_ERR_BREAK(m_cond)                                                                                           \
 	{                                                                                                                  \
@@ -818,6 +1067,132 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			// Operands and target are known to have the operator's types, so the payloads are used directly.
+#define OPCODE_OPERATOR_TYPED(m_op_name, m_v_type, m_getter, m_ret_getter, m_op)                                \
+	OPCODE(OPCODE_OPERATOR_##m_op_name##_##m_v_type) {                                                          \
+		CHECK_SPACE(4);                                                                                         \
+		GET_VARIANT_PTR(a, 0);                                                                                  \
+		GET_VARIANT_PTR(b, 1);                                                                                  \
+		GET_VARIANT_PTR(dst, 2);                                                                                \
+		*VariantInternal::m_ret_getter(dst) = *VariantInternal::m_getter(a) m_op *VariantInternal::m_getter(b); \
+		ip += 4;                                                                                                \
+	}                                                                                                           \
+	DISPATCH_OPCODE
+
+			OPCODE_OPERATOR_TYPED(ADD, INT, get_int, get_int, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT, INT, get_int, get_int, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY, INT, get_int, get_int, *);
+			OPCODE_OPERATOR_TYPED(EQUAL, INT, get_int, get_bool, ==);
+			OPCODE_OPERATOR_TYPED(NOT_EQUAL, INT, get_int, get_bool, !=);
+			OPCODE_OPERATOR_TYPED(LESS, INT, get_int, get_bool, <);
+			OPCODE_OPERATOR_TYPED(LESS_EQUAL, INT, get_int, get_bool, <=);
+			OPCODE_OPERATOR_TYPED(GREATER, INT, get_int, get_bool, >);
+			OPCODE_OPERATOR_TYPED(GREATER_EQUAL, INT, get_int, get_bool, >=);
+			OPCODE_OPERATOR_TYPED(ADD, FLOAT, get_float, get_float, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT, FLOAT, get_float, get_float, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY, FLOAT, get_float, get_float, *);
+			OPCODE_OPERATOR_TYPED(DIVIDE, FLOAT, get_float, get_float, /);
+			OPCODE_OPERATOR_TYPED(EQUAL, FLOAT, get_float, get_bool, ==);
+			OPCODE_OPERATOR_TYPED(NOT_EQUAL, FLOAT, get_float, get_bool, !=);
+			OPCODE_OPERATOR_TYPED(LESS, FLOAT, get_float, get_bool, <);
+			OPCODE_OPERATOR_TYPED(LESS_EQUAL, FLOAT, get_float, get_bool, <=);
+			OPCODE_OPERATOR_TYPED(GREATER, FLOAT, get_float, get_bool, >);
+			OPCODE_OPERATOR_TYPED(GREATER_EQUAL, FLOAT, get_float, get_bool, >=);
+
+			// Superinstructions execute an operator together with the JUMP_IF_NOT or ASSIGN that consumes its result.
+			// The second instruction is left in place after them, so jumps landing on it still work.
+#define OPCODE_OPERATOR_TYPED_JUMP_IF_NOT(m_op_name, m_v_type, m_getter, m_op)          \
+	OPCODE(OPCODE_OPERATOR_##m_op_name##_##m_v_type##_JUMP_IF_NOT) {                    \
+		CHECK_SPACE(7);                                                                 \
+		GET_VARIANT_PTR(a, 0);                                                          \
+		GET_VARIANT_PTR(b, 1);                                                          \
+		GET_VARIANT_PTR(test, 2);                                                       \
+		bool result = *VariantInternal::m_getter(a) m_op *VariantInternal::m_getter(b); \
+		*VariantInternal::get_bool(test) = result;                                      \
+		if (!result) {                                                                  \
+			int to = _code_ptr[ip + 6];                                                 \
+			GD_ERR_BREAK(to < 0 || to > _code_size);                                    \
+			ip = to;                                                                    \
+		} else {                                                                        \
+			ip += 7;                                                                    \
+		}                                                                               \
+	}                                                                                   \
+	DISPATCH_OPCODE
+
+			OPCODE_OPERATOR_TYPED_JUMP_IF_NOT(EQUAL, INT, get_int, ==);
+			OPCODE_OPERATOR_TYPED_JUMP_IF_NOT(NOT_EQUAL, INT, get_int, !=);
+			OPCODE_OPERATOR_TYPED_JUMP_IF_NOT(LESS, INT, get_int, <);
+			OPCODE_OPERATOR_TYPED_JUMP_IF_NOT(LESS_EQUAL, INT, get_int, <=);
+			OPCODE_OPERATOR_TYPED_JUMP_IF_NOT(GREATER, INT, get_int, >);
+			OPCODE_OPERATOR_TYPED_JUMP_IF_NOT(GREATER_EQUAL, INT, get_int, >=);
+			OPCODE_OPERATOR_TYPED_JUMP_IF_NOT(LESS, FLOAT, get_float, <);
+			OPCODE_OPERATOR_TYPED_JUMP_IF_NOT(LESS_EQUAL, FLOAT, get_float, <=);
+			OPCODE_OPERATOR_TYPED_JUMP_IF_NOT(GREATER, FLOAT, get_float, >);
+			OPCODE_OPERATOR_TYPED_JUMP_IF_NOT(GREATER_EQUAL, FLOAT, get_float, >=);
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) {
+				CHECK_SPACE(8);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(test, 2);
+
+				operator_func(a, b, test);
+
+				if (!test->booleanize()) {
+					int to = _code_ptr[ip + 7];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 8;
+				}
+			}
+			DISPATCH_OPCODE;
+
+#define OPCODE_OPERATOR_TYPED_ASSIGN(m_op_name, m_v_type, m_getter, m_op)                                      \
+	OPCODE(OPCODE_OPERATOR_##m_op_name##_##m_v_type##_ASSIGN) {                                                \
+		CHECK_SPACE(7);                                                                                        \
+		GET_VARIANT_PTR(a, 0);                                                                                 \
+		GET_VARIANT_PTR(b, 1);                                                                                 \
+		GET_VARIANT_PTR(result, 2);                                                                            \
+		GET_VARIANT_PTR(dst, 4);                                                                               \
+		*VariantInternal::m_getter(result) = *VariantInternal::m_getter(a) m_op *VariantInternal::m_getter(b); \
+		*dst = *result;                                                                                        \
+		ip += 7;                                                                                               \
+	}                                                                                                          \
+	DISPATCH_OPCODE
+
+			OPCODE_OPERATOR_TYPED_ASSIGN(ADD, INT, get_int, +);
+			OPCODE_OPERATOR_TYPED_ASSIGN(SUBTRACT, INT, get_int, -);
+			OPCODE_OPERATOR_TYPED_ASSIGN(MULTIPLY, INT, get_int, *);
+			OPCODE_OPERATOR_TYPED_ASSIGN(ADD, FLOAT, get_float, +);
+			OPCODE_OPERATOR_TYPED_ASSIGN(SUBTRACT, FLOAT, get_float, -);
+			OPCODE_OPERATOR_TYPED_ASSIGN(MULTIPLY, FLOAT, get_float, *);
+			OPCODE_OPERATOR_TYPED_ASSIGN(DIVIDE, FLOAT, get_float, /);
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_ASSIGN) {
+				CHECK_SPACE(8);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(result, 2);
+				GET_VARIANT_PTR(dst, 5);
+
+				operator_func(a, b, result);
+				*dst = *result;
+
+				ip += 8;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1057,6 +1432,48 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#ifdef DEBUG_ENABLED
+#define PACKED_ARRAY_OOB_BREAK(m_access, m_base, m_index)                                                             \
+	err_text = "Out of bounds " m_access " index '" + itos(m_index) + "' (on base: '" + _get_var_type(m_base) + "')"; \
+	OPCODE_BREAK
+#else
+#define PACKED_ARRAY_OOB_BREAK(m_access, m_base, m_index)
+#endif
+
+			// The container is known to be the packed array, the index an int and the value its element type,
+			// so elements are accessed directly instead of through the validated indexed setter and getter.
+#define OPCODE_SET_INDEXED_PACKED_ARRAY(m_var_type, m_elem_type, m_get_func, m_value_get_func) \
+	OPCODE(OPCODE_SET_INDEXED_PACKED_##m_var_type##_ARRAY) {                                   \
+		CHECK_SPACE(4);                                                                        \
+		GET_VARIANT_PTR(dst, 0);                                                               \
+		GET_VARIANT_PTR(index, 1);                                                             \
+		GET_VARIANT_PTR(value, 2);                                                             \
+		Vector<m_elem_type> *array = VariantInternal::m_get_func(dst);                         \
+		int64_t int_index = *VariantInternal::get_int(index);                                  \
+		const int64_t size = array->size();                                                    \
+		if (int_index < 0) {                                                                   \
+			int_index += size;                                                                 \
+		}                                                                                      \
+		if (likely(int_index >= 0 && int_index < size)) {                                      \
+			array->ptrw()[int_index] = m_elem_type(*VariantInternal::m_value_get_func(value)); \
+		} else {                                                                               \
+			PACKED_ARRAY_OOB_BREAK("set", dst, *VariantInternal::get_int(index));              \
+		}                                                                                      \
+		ip += 4;                                                                               \
+	}                                                                                          \
+	DISPATCH_OPCODE
+
+			OPCODE_SET_INDEXED_PACKED_ARRAY(BYTE, uint8_t, get_byte_array, get_int);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(INT32, int32_t, get_int32_array, get_int);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(INT64, int64_t, get_int64_array, get_int);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(FLOAT32, float, get_float32_array, get_float);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(FLOAT64, double, get_float64_array, get_float);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(STRING, String, get_string_array, get_string);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(VECTOR2, Vector2, get_vector2_array, get_vector2);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(VECTOR3, Vector3, get_vector3_array, get_vector3);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(COLOR, Color, get_color_array, get_color);
+			OPCODE_SET_INDEXED_PACKED_ARRAY(VECTOR4, Vector4, get_vector4_array, get_vector4);
+
 			OPCODE(OPCODE_GET_KEYED) {
 				CHECK_SPACE(3);
 
@@ -1161,8 +1578,41 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_GET_INDEXED_PACKED_ARRAY(m_var_type, m_elem_type, m_get_func, m_ret_type, m_ret_get_func) \
+	OPCODE(OPCODE_GET_INDEXED_PACKED_##m_var_type##_ARRAY) {                                             \
+		CHECK_SPACE(4);                                                                                  \
+		GET_VARIANT_PTR(src, 0);                                                                         \
+		GET_VARIANT_PTR(index, 1);                                                                       \
+		GET_VARIANT_PTR(dst, 2);                                                                         \
+		const Vector<m_elem_type> *array = VariantInternal::m_get_func((const Variant *)src);            \
+		int64_t int_index = *VariantInternal::get_int(index);                                            \
+		const int64_t size = array->size();                                                              \
+		if (int_index < 0) {                                                                             \
+			int_index += size;                                                                           \
+		}                                                                                                \
+		if (likely(int_index >= 0 && int_index < size)) {                                                \
+			VariantTypeChanger<m_ret_type>::change(dst);                                                 \
+			*VariantInternal::m_ret_get_func(dst) = array->ptr()[int_index];                             \
+		} else {                                                                                         \
+			PACKED_ARRAY_OOB_BREAK("get", src, *VariantInternal::get_int(index));                        \
+		}                                                                                                \
+		ip += 4;                                                                                         \
+	}                                                                                                    \
+	DISPATCH_OPCODE
+
+			OPCODE_GET_INDEXED_PACKED_ARRAY(BYTE, uint8_t, get_byte_array, int64_t, get_int);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(INT32, int32_t, get_int32_array, int64_t, get_int);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(INT64, int64_t, get_int64_array, int64_t, get_int);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(FLOAT32, float, get_float32_array, double, get_float);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(FLOAT64, double, get_float64_array, double, get_float);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(STRING, String, get_string_array, String, get_string);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(VECTOR2, Vector2, get_vector2_array, Vector2, get_vector2);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(VECTOR3, Vector3, get_vector3_array, Vector3, get_vector3);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(COLOR, Color, get_color_array, Color, get_color);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(VECTOR4, Vector4, get_vector4_array, Vector4, get_vector4);
+
 			OPCODE(OPCODE_SET_NAMED) {
-				CHECK_SPACE(3);
+				CHECK_SPACE(4);
 
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
@@ -1172,8 +1622,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+
 				bool valid;
-				dst->set_named(*index, *value, valid);
+				if (!_inline_cache_set_named(_inline_caches_ptr[cache_idx], dst, *index, *value, valid)) {
+					dst->set_named(*index, *value, valid);
+				}
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1194,7 +1649,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1214,7 +1669,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
@@ -1224,22 +1679,23 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
-#ifdef DEBUG_ENABLED
-				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, valid);
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
 
-#else
-				*dst = src->get_named(*index, valid);
-#endif
+				// Not written to `dst` directly, `src` may live at the same stack position.
+				bool valid = true;
+				Variant ret;
+				if (!_inline_cache_get_named(_inline_caches_ptr[cache_idx], src, *index, ret)) {
+					ret = src->get_named(*index, valid);
+				}
 #ifdef DEBUG_ENABLED
 				if (!valid) {
 					err_text = "Invalid access to property or key '" + index->operator String() + "' on a base object of type '" + _get_var_type(src) + "'.";
 					OPCODE_BREAK;
 				}
-				*dst = ret;
 #endif
-				ip += 4;
+				*dst = ret;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1858,7 +2314,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1869,6 +2325,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int cache_idx = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+				InlineCache &inline_cache = _inline_caches_ptr[cache_idx];
+
 				GET_INSTRUCTION_ARG(base, argc);
 				Variant **argptrs = instruction_args;
 
@@ -1887,7 +2347,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Callable::CallError err;
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					if (!_inline_cache_call(inline_cache, base, *methodname, (const Variant **)argptrs, argc, temp_ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					}
 					*ret = temp_ret;
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
@@ -1917,7 +2379,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					}
 #endif
 				} else {
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					if (!_inline_cache_call(inline_cache, base, *methodname, (const Variant **)argptrs, argc, temp_ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					}
 				}
 #ifdef DEBUG_ENABLED
 
@@ -1967,7 +2431,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -2533,12 +2997,19 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					Ref<GDScriptFunctionState> gdfs = memnew(GDScriptFunctionState);
 					gdfs->function = this;
 
-					gdfs->state.stack.resize(alloca_size);
-
-					// First 3 stack addresses are special, so we just skip them here.
-					for (int i = 3; i < _stack_size; i++) {
-						memnew_placement(&gdfs->state.stack.write[sizeof(Variant) * i], Variant(stack[i]));
+					// The frame is moved to the state, not copied. Variants don't point to themselves, so they
+					// are relocated bitwise and the originals aren't destroyed. A resumed call hands over the
+					// frame it runs on, so awaiting in a loop neither allocates nor copies the stack.
+					if (p_state) {
+						gdfs->state.stack = p_state->stack;
+						p_state->stack = nullptr;
+						p_state->stack_size = 0;
+					} else {
+						gdfs->state.stack = GDScriptFunctionState::alloc_frame(alloca_size);
+						// First 3 stack addresses are special, so we just skip them here.
+						memcpy(gdfs->state.stack + sizeof(Variant) * 3, (void *)&stack[3], sizeof(Variant) * (_stack_size - 3));
 					}
+					suspended_state = gdfs;
 					gdfs->state.stack_size = _stack_size;
 					gdfs->state.alloca_size = alloca_size;
 					gdfs->state.ip = ip + 2;
@@ -3244,7 +3715,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			GET_VARIANT_PTR(iterator, 2);                                                                                  \
 			VariantInternal::initialize(iterator, Variant::m_var_ret_type);                                                \
 			m_ret_type *it = VariantInternal::m_ret_get_func(iterator);                                                    \
-			*it = array->get(0);                                                                                           \
+			*it = array->ptr()[0];                                                                                         \
 			ip += 5;                                                                                                       \
 		} else {                                                                                                           \
 			int jumpto = _code_ptr[ip + 4];                                                                                \
@@ -3584,7 +4055,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			ip = jumpto;                                                                            \
 		} else {                                                                                    \
 			GET_VARIANT_PTR(iterator, 2);                                                           \
-			*VariantInternal::m_ret_get_func(iterator) = array->get(*idx);                          \
+			*VariantInternal::m_ret_get_func(iterator) = array->ptr()[*idx];                        \
 			ip += 5;                                                                                \
 		}                                                                                           \
 	}                                                                                               \
@@ -3778,6 +4249,12 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				line = _code_ptr[ip + 1];
 				ip += 2;
 
+#ifdef DEBUG_ENABLED
+				if (unlikely(GDScriptSamplingProfiler::is_sample_pending())) {
+					GDScriptSamplingProfiler::take_sample();
+				}
+#endif
+
 				if (EngineDebugger::is_active()) {
 					// line
 					bool do_break = false;
@@ -3874,19 +4351,18 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	// Check if this is not the last time it was interrupted by `await` or if it's the first time executing.
 	// If that is the case then we exit the function as normal. Otherwise we postpone it until the last `await` is completed.
 	// This ensures the call stack can be properly shown when using `await`, showing what resumed the function.
-	if (!p_state || awaited) {
-		if (EngineDebugger::is_active()) {
-			GDScriptLanguage::get_singleton()->exit_function();
-		}
+	if ((!p_state || awaited) && track_call_stack) {
+		GDScriptLanguage::get_singleton()->exit_function();
+	}
 #endif
 
-		// Free stack, except reserved addresses.
+	// Free stack, except reserved addresses. A suspended frame belongs to its state now, and a
+	// resumed one is freed by `GDScriptFunctionState::resume()` once the call completes.
+	if (!p_state && suspended_state.is_null()) {
 		for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
 			stack[i].~Variant();
 		}
-#ifdef DEBUG_ENABLED
 	}
-#endif
 
 	// Always free reserved addresses, since they are never copied.
 	for (int i = 0; i < FIXED_ADDRESSES_MAX; i++) {
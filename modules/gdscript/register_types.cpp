@@ -32,6 +32,7 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_tokenizer.h"
 #include "gdscript_tokenizer_buffer.h"
@@ -84,8 +85,24 @@ class EditorExportGDScript : public EditorExportPlugin {
 
 	static constexpr int DEFAULT_SCRIPT_MODE = EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED;
 	int script_mode = DEFAULT_SCRIPT_MODE;
+	GDScriptBytecodeCacheWriter *bytecode_cache_writer = nullptr;
+
+	GDScriptTokenizerBuffer::CompressMode _get_compress_mode() const {
+		return script_mode == EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED ? GDScriptTokenizerBuffer::COMPRESS_ZSTD : GDScriptTokenizerBuffer::COMPRESS_NONE;
+	}
+
+	void _clear_bytecode_cache_writer() {
+		if (bytecode_cache_writer) {
+			memdelete(bytecode_cache_writer);
+			bytecode_cache_writer = nullptr;
+		}
+	}
 
 protected:
+	virtual void _get_export_options(const Ref<EditorExportPlatform> &p_platform, List<EditorExportPlatform::ExportOption> *r_options) const override {
+		r_options->push_back(EditorExportPlatform::ExportOption(PropertyInfo(Variant::BOOL, "gdscript/export_bytecode_cache"), false));
+	}
+
 	virtual void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override {
 		script_mode = DEFAULT_SCRIPT_MODE;
 
@@ -93,6 +110,15 @@ protected:
 		if (preset.is_valid()) {
 			script_mode = preset->get_script_export_mode();
 		}
+
+		_clear_bytecode_cache_writer();
+		if (script_mode != EditorExportPreset::MODE_SCRIPT_TEXT && bool(get_option("gdscript/export_bytecode_cache"))) {
+			bytecode_cache_writer = memnew(GDScriptBytecodeCacheWriter(_get_compress_mode()));
+		}
+	}
+
+	virtual void _export_end() override {
+		_clear_bytecode_cache_writer();
 	}
 
 	virtual void _export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) override {
@@ -107,17 +133,29 @@ protected:
 
 		String source;
 		source.parse_utf8(reinterpret_cast<const char *>(file.ptr()), file.size());
-		GDScriptTokenizerBuffer::CompressMode compress_mode = script_mode == EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED ? GDScriptTokenizerBuffer::COMPRESS_ZSTD : GDScriptTokenizerBuffer::COMPRESS_NONE;
-		file = GDScriptTokenizerBuffer::parse_code_string(source, compress_mode);
+		file = GDScriptTokenizerBuffer::parse_code_string(source, _get_compress_mode());
 		if (file.is_empty()) {
 			return;
 		}
 
 		add_file(p_path.get_basename() + ".gdc", file, true);
+
+		if (bytecode_cache_writer) {
+			// The tokens stay in the pack, scripts whose cache is rejected at runtime compile from them.
+			Ref<GDScript> script = ResourceLoader::load(p_path);
+			Vector<uint8_t> bytecode;
+			if (script.is_valid() && bytecode_cache_writer->write(script, file, bytecode) == OK) {
+				add_file(GDScriptBytecodeCache::get_cache_path(p_path), bytecode, false);
+			}
+		}
 	}
 
 public:
 	virtual String get_name() const override { return "GDScript"; }
+
+	~EditorExportGDScript() {
+		_clear_bytecode_cache_writer();
+	}
 };
 
 static void _editor_init() {
@@ -33,7 +33,14 @@
 
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_bytecode_cache.h"
+#include "../gdscript_cache.h"
+#include "../gdscript_sampling_profiler.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 namespace GDScriptTests {
 
@@ -70,6 +77,552 @@ func _init():
 	ref_counted->set_script(gdscript);
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
+TEST_CASE("[Stress][Modules][GDScript] Typed arithmetic in numeric loops") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func typed_loop(count: int) -> float:
+	var sum: int = 0
+	var acc: float = 0.0
+	var i: int = 0
+	while i < count:
+		sum = sum + i * 3 - 1
+		acc = acc * 0.5 + 1.0
+		i += 1
+	return sum + acc
+
+func untyped_loop(count):
+	var sum = 0
+	var acc = 0.0
+	var i = 0
+	while i < count:
+		sum = sum + i * 3 - 1
+		acc = acc * 0.5 + 1.0
+		i += 1
+	return sum + acc
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	const int iterations = 10000000;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	const double typed_result = ref_counted->call("typed_loop", iterations);
+	const uint64_t typed_usec = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	const double untyped_result = ref_counted->call("untyped_loop", iterations);
+	const uint64_t untyped_usec = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+	CHECK(typed_result == untyped_result);
+	MESSAGE("Typed loop: ", typed_usec / 1000, " ms, untyped loop: ", untyped_usec / 1000, " ms (", (double)untyped_usec / typed_usec, "x).");
+}
+
+TEST_CASE("[Stress][Modules][GDScript] Call overhead") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func add_typed(a: int, b: int, c: Vector2) -> int:
+	return a + b + int(c.x)
+
+func add_untyped(a, b, c):
+	return a + b + int(c.x)
+
+func add_converted(a: float, b: float, c: Vector2) -> int:
+	return int(a + b + c.x)
+
+func typed_calls(count: int) -> int:
+	var total: int = 0
+	var offset := Vector2(1, 0)
+	for i in count:
+		total = add_typed(total, i, offset)
+	return total
+
+func untyped_calls(count):
+	var total = 0
+	var offset = Vector2(1, 0)
+	for i in count:
+		total = add_untyped(total, i, offset)
+	return total
+
+func converted_calls(count: int) -> int:
+	var total: int = 0
+	var offset := Vector2(1, 0)
+	for i in count:
+		total = add_converted(total, i, offset)
+	return total
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	const int iterations = 2000000;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	const int64_t typed_result = ref_counted->call("typed_calls", iterations);
+	const uint64_t typed_usec = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	const int64_t untyped_result = ref_counted->call("untyped_calls", iterations);
+	const uint64_t untyped_usec = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	const int64_t converted_result = ref_counted->call("converted_calls", iterations);
+	const uint64_t converted_usec = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+	CHECK(typed_result == untyped_result);
+	CHECK(typed_result == converted_result);
+	MESSAGE("Per call: ", (double)typed_usec * 1000 / iterations, " ns typed, ", (double)untyped_usec * 1000 / iterations, " ns untyped, ", (double)converted_usec * 1000 / iterations, " ns with argument conversion.");
+}
+
+TEST_CASE("[Stress][Modules][GDScript] Packed array element access") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func smooth_typed(heights: PackedFloat32Array, passes: int) -> float:
+	var size := heights.size()
+	for _p in passes:
+		for i in range(1, size - 1):
+			heights[i] = (heights[i - 1] + heights[i] + heights[i + 1]) / 3.0
+	return heights[size / 2]
+
+func smooth_untyped(heights, passes):
+	var size = heights.size()
+	for _p in passes:
+		for i in range(1, size - 1):
+			heights[i] = (heights[i - 1] + heights[i] + heights[i + 1]) / 3.0
+	return heights[size / 2]
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	PackedFloat32Array heights;
+	heights.resize(1 << 16);
+	for (int i = 0; i < heights.size(); i++) {
+		heights.write[i] = (i * 7919) % 101;
+	}
+	const PackedFloat32Array untyped_heights = heights.duplicate();
+
+	const int passes = 20;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	const double typed_result = ref_counted->call("smooth_typed", heights, passes);
+	const uint64_t typed_usec = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	const double untyped_result = ref_counted->call("smooth_untyped", untyped_heights, passes);
+	const uint64_t untyped_usec = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+	CHECK(typed_result == untyped_result);
+	MESSAGE("Typed packed array: ", typed_usec / 1000, " ms, untyped: ", untyped_usec / 1000, " ms (", (double)untyped_usec / typed_usec, "x).");
+}
+
+TEST_CASE("[Stress][Modules][GDScript] Concurrently awaiting coroutines") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+signal tick
+
+var resumed := 0
+
+func worker(steps: int):
+	var label := "worker"
+	var history: Array[int] = []
+	for i in steps:
+		await tick
+		history.append(i)
+		resumed += 1
+	return label
+
+func start(count: int, steps: int):
+	for i in count:
+		worker(steps)
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	const int coroutines = 100000;
+	const int steps = 10;
+	const uint64_t memory_before = Memory::get_mem_usage();
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	ref_counted->call("start", coroutines, steps);
+	const uint64_t start_usec = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+	const uint64_t memory_suspended = Memory::get_mem_usage() - memory_before;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < steps; i++) {
+		ref_counted->emit_signal(SNAME("tick"));
+	}
+	const uint64_t resume_usec = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+	CHECK(int64_t(ref_counted->get("resumed")) == int64_t(coroutines) * steps);
+	MESSAGE(coroutines, " coroutines: ", memory_suspended / coroutines, " bytes each while suspended, ", (double)start_usec * 1000 / coroutines, " ns to start, ", (double)resume_usec * 1000 / (coroutines * steps), " ns per resume.");
+}
+
+TEST_CASE("[Modules][GDScript] Inline caches hit on repeated receiver types") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+class Counter:
+	var value = 0
+
+	func step():
+		value += 1
+
+func run(count):
+	var counters = [Counter.new(), Counter.new()]
+	var total = 0
+	for i in count:
+		var counter = counters[i % 2]
+		counter.step()
+		total += counter.value
+	return total
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
+	lang->profiling_start();
+	const int64_t total = ref_counted->call("run", 1000);
+	lang->profiling_stop();
+
+	uint64_t hits = 0;
+	uint64_t misses = 0;
+	lang->profiling_get_inline_cache_data(hits, misses);
+
+	CHECK(total == 250500);
+	// `counter.step()` and `counter.value` miss once each. Calls on the class itself, as in
+	// `Counter.new()`, are never cached.
+	CHECK(hits == 1998);
+	CHECK(misses <= 4);
+}
+
+TEST_CASE("[Modules][GDScript] Sampling profiler records call stacks") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func busy(count):
+	var sum = 0
+	for i in count:
+		sum += i
+	return sum
+
+func run(count):
+	return busy(count)
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	GDScriptSamplingProfiler::start(100);
+	const int64_t sum = ref_counted->call("run", 1000000);
+	GDScriptSamplingProfiler::stop();
+
+	CHECK(sum == 499999500000);
+	CHECK(GDScriptSamplingProfiler::get_sample_count() > 0);
+	CHECK_MESSAGE(GDScriptSamplingProfiler::get_collapsed_stacks().contains("run (:11);busy (:4) "), "Samples should be attributed to the innermost function, under its caller.");
+
+	const String trace = GDScriptSamplingProfiler::get_chrome_trace();
+	CHECK(trace.begins_with("{\"traceEvents\":["));
+	CHECK(trace.contains("{\"name\":\"busy (:4)\",\"ph\":\"B\""));
+	CHECK(trace.count(R"("ph":"B")") == trace.count(R"("ph":"E")"));
+
+	GDScriptSamplingProfiler::clear();
+}
+
+static Vector<uint8_t> write_script_tokens(const String &p_path, const String &p_source) {
+	Vector<uint8_t> tokens = GDScriptTokenizerBuffer::parse_code_string(p_source, GDScriptTokenizerBuffer::COMPRESS_NONE);
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE);
+	file->store_buffer(tokens.ptr(), tokens.size());
+	return tokens;
+}
+
+static Error write_bytecode_cache(const String &p_path, const Vector<uint8_t> &p_tokens) {
+	Error error = OK;
+	Ref<GDScript> script = GDScriptCache::get_full_script(p_path, error);
+	if (error != OK) {
+		return error;
+	}
+
+	Vector<uint8_t> bytecode;
+	GDScriptBytecodeCacheWriter writer(GDScriptTokenizerBuffer::COMPRESS_NONE);
+	error = writer.write(script, p_tokens, bytecode);
+	if (error != OK) {
+		return error;
+	}
+
+	Ref<FileAccess> file = FileAccess::open(GDScriptBytecodeCache::get_cache_path(p_path), FileAccess::WRITE);
+	file->store_buffer(bytecode.ptr(), bytecode.size());
+	return OK;
+}
+
+TEST_CASE("[Modules][GDScript] Load scripts from the bytecode cache") {
+	const String dir = TestUtils::get_temp_path("gdscript_bytecode_cache");
+	DirAccess::make_dir_recursive_absolute(dir);
+	const String helper_path = dir.path_join("helper.gdc");
+	const String main_path = dir.path_join("main.gdc");
+
+	const Vector<uint8_t> helper_tokens = write_script_tokens(helper_path, R"(
+extends RefCounted
+
+static func twice(x: int) -> int:
+	return x * 2
+)");
+	const String main_source = vformat(R"(
+extends RefCounted
+
+const Helper = preload("%s")
+const NAMES: Array[String] = ["a", "b"]
+
+class Inner:
+	var scale := 2
+
+	func apply(x: int) -> int:
+		return x * scale
+
+static var calls := 0
+var offset := 1
+
+func run(x: int) -> int:
+	calls += 1
+	var inner := Inner.new()
+	var add := func(v): return v + offset
+	return add.call(inner.apply(x)) + Helper.twice(x) + NAMES.size() + Vector2i(x, 0).x + absi(-1) + calls
+)",
+			helper_path);
+	const Vector<uint8_t> main_tokens = write_script_tokens(main_path, main_source);
+
+	ERR_PRINT_OFF;
+	REQUIRE(write_bytecode_cache(helper_path, helper_tokens) == OK);
+	REQUIRE(write_bytecode_cache(main_path, main_tokens) == OK);
+	ERR_PRINT_ON;
+
+	const Vector<uint8_t> bytecode = FileAccess::get_file_as_bytes(GDScriptBytecodeCache::get_cache_path(main_path));
+	CHECK(GDScriptBytecodeCache::is_valid(bytecode, main_tokens));
+	CHECK_FALSE_MESSAGE(GDScriptBytecodeCache::is_valid(bytecode, helper_tokens), "The cache should be rejected when the tokens changed.");
+
+	// Drop the compiled scripts so the next load goes through the cache.
+	GDScriptCache::remove_static_script(main_path);
+	GDScriptCache::remove_script(main_path);
+	GDScriptCache::remove_script(helper_path);
+
+	Error error = OK;
+	Ref<GDScript> script = GDScriptCache::get_full_script(main_path, error);
+	REQUIRE(error == OK);
+	REQUIRE(script->is_valid());
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(script);
+	CHECK(int(ref_counted->call("run", 5)) == 30);
+	CHECK(int(ref_counted->call("run", 5)) == 31);
+
+	GDScriptCache::remove_script(main_path);
+	GDScriptCache::remove_script(helper_path);
+}
+
+TEST_CASE("[Modules][GDScript] Only assertions keep release builds from using the bytecode cache") {
+	const String dir = TestUtils::get_temp_path("gdscript_bytecode_cache_debug_code");
+	DirAccess::make_dir_recursive_absolute(dir);
+	const String plain_path = dir.path_join("plain.gdc");
+	const String asserting_path = dir.path_join("asserting.gdc");
+
+	// Debug builds emit line markers before each statement, and for typed fields in the implicit initializer.
+	const Vector<uint8_t> plain_tokens = write_script_tokens(plain_path, R"(
+extends RefCounted
+
+var count: int = 1
+
+func run(x: int) -> int:
+	var total := x
+	for i in 3:
+		total += i * count
+	return total
+)");
+	const Vector<uint8_t> asserting_tokens = write_script_tokens(asserting_path, R"(
+extends RefCounted
+
+func run(x: int) -> int:
+	assert(x > 0)
+	return x
+)");
+
+	REQUIRE(write_bytecode_cache(plain_path, plain_tokens) == OK);
+	REQUIRE(write_bytecode_cache(asserting_path, asserting_tokens) == OK);
+
+	CHECK_FALSE(GDScriptBytecodeCache::has_debug_code(FileAccess::get_file_as_bytes(GDScriptBytecodeCache::get_cache_path(plain_path))));
+	CHECK(GDScriptBytecodeCache::has_debug_code(FileAccess::get_file_as_bytes(GDScriptBytecodeCache::get_cache_path(asserting_path))));
+
+	GDScriptCache::remove_script(plain_path);
+	GDScriptCache::remove_script(asserting_path);
+}
+
+// Writes a binary tree of scripts preloading their children, the total of which is the sum of their IDs.
+static Vector<String> write_script_tree(const String &p_dir, int p_count, int p_broken = -1) {
+	DirAccess::make_dir_recursive_absolute(p_dir);
+	Vector<String> paths;
+	for (int i = 0; i < p_count; i++) {
+		String source = "extends RefCounted\n\n";
+		String total = vformat("\treturn %d", i);
+		for (int child = 2 * i + 1; child <= 2 * i + 2 && child < p_count; child++) {
+			source += vformat("const Child%d = preload(\"script_%d.gd\")\n", child, child);
+			total += vformat(" + Child%d.total()", child);
+		}
+		source += "\nvar values: Array[int] = []\n\n";
+		source += "func fill(count: int) -> void:\n\tfor j in count:\n\t\tvalues.push_back(j * 2)\n\n";
+		source += "func average() -> float:\n\tvar sum := 0\n\tfor value in values:\n\t\tsum += value\n\treturn float(sum) / maxi(values.size(), 1)\n\n";
+		source += "static func total() -> int:\n" + total + (i == p_broken ? " +\n" : "\n");
+
+		paths.push_back(p_dir.path_join(vformat("script_%d.gd", i)));
+		Ref<FileAccess> file = FileAccess::open(paths[i], FileAccess::WRITE);
+		file->store_string(source);
+	}
+	return paths;
+}
+
+static Error load_script_tree(const Vector<String> &p_paths, bool p_parallel, int64_t &r_total) {
+	GDScriptCache::set_parallel_parsing_enabled(p_parallel);
+	Error error = OK;
+	Ref<GDScript> root = GDScriptCache::get_full_script(p_paths[0], error);
+	GDScriptCache::set_parallel_parsing_enabled(true);
+
+	r_total = -1;
+	if (error == OK) {
+		r_total = root->call("total");
+	}
+
+	root.unref();
+	for (const String &path : p_paths) {
+		GDScriptCache::remove_script(path);
+	}
+	return error;
+}
+
+TEST_CASE("[Modules][GDScript] Parallel parsing gives the same results") {
+	const int count = 63;
+	const Vector<String> paths = write_script_tree(TestUtils::get_temp_path("gdscript_parallel_parsing"), count);
+
+	int64_t serial_total = 0;
+	int64_t parallel_total = 0;
+	CHECK(load_script_tree(paths, false, serial_total) == OK);
+	CHECK(load_script_tree(paths, true, parallel_total) == OK);
+	CHECK(serial_total == count * (count - 1) / 2);
+	CHECK(parallel_total == serial_total);
+
+	const Vector<String> broken_paths = write_script_tree(TestUtils::get_temp_path("gdscript_parallel_parsing_broken"), count, count - 1);
+	ERR_PRINT_OFF;
+	const Error serial_error = load_script_tree(broken_paths, false, serial_total);
+	const Error parallel_error = load_script_tree(broken_paths, true, parallel_total);
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(serial_error != OK, "A parse error in a dependency should fail the load.");
+	CHECK(parallel_error == serial_error);
+}
+
+TEST_CASE("[Stress][Modules][GDScript] Load a project of 5,000 scripts") {
+	const int count = 5000;
+	const Vector<String> paths = write_script_tree(TestUtils::get_temp_path("gdscript_parallel_parsing_stress"), count);
+
+	int64_t serial_total = 0;
+	int64_t parallel_total = 0;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	REQUIRE(load_script_tree(paths, false, serial_total) == OK);
+	const uint64_t serial_usec = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	REQUIRE(load_script_tree(paths, true, parallel_total) == OK);
+	const uint64_t parallel_usec = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+	CHECK(parallel_total == serial_total);
+	MESSAGE("Loaded ", count, " scripts in ", serial_usec / 1000, " ms serially, ", parallel_usec / 1000, " ms with parallel parsing (", (double)serial_usec / parallel_usec, "x).");
+}
+
+TEST_CASE("[Stress][Modules][GDScript] Startup with cached bytecode") {
+	const String dir = TestUtils::get_temp_path("gdscript_bytecode_cache_stress");
+	DirAccess::make_dir_recursive_absolute(dir);
+
+	const int count = 2000;
+	Vector<String> paths;
+	Vector<Vector<uint8_t>> tokens;
+	for (int i = 0; i < count; i++) {
+		paths.push_back(dir.path_join(vformat("script_%d.gdc", i)));
+		const String source = vformat(R"(
+extends RefCounted
+
+const ID = %d
+var values: Array[int] = []
+
+func fill(count: int) -> void:
+	for i in count:
+		values.push_back(i * ID)
+
+func sum() -> int:
+	var total := 0
+	for value in values:
+		total += value
+	return total
+)",
+				i);
+		tokens.push_back(write_script_tokens(paths[i], source));
+	}
+
+	// Compile from tokens first, the cache files are written from the compiled scripts.
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		Error error = OK;
+		GDScriptCache::get_full_script(paths[i], error);
+		REQUIRE(error == OK);
+	}
+	const uint64_t compile_usec = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+	for (int i = 0; i < count; i++) {
+		REQUIRE(write_bytecode_cache(paths[i], tokens[i]) == OK);
+		GDScriptCache::remove_script(paths[i]);
+	}
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		Error error = OK;
+		GDScriptCache::get_full_script(paths[i], error);
+		REQUIRE(error == OK);
+	}
+	const uint64_t cached_usec = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+	for (int i = 0; i < count; i++) {
+		GDScriptCache::remove_script(paths[i]);
+	}
+
+	MESSAGE("Compiled ", count, " scripts in ", compile_usec / 1000, " ms, loaded from the bytecode cache in ", cached_usec / 1000, " ms (", (double)compile_usec / cached_usec, "x).");
+}
 #endif // TOOLS_ENABLED
 
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
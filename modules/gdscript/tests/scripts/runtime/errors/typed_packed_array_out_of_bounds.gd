@@ -0,0 +1,4 @@
+func test():
+	var heights := PackedFloat32Array([0.5, 1.5])
+	var index := 2
+	print(heights[index])
@@ -0,0 +1,34 @@
+# Suspended frames are moved between states on every `await`, locals must survive that.
+class Payload:
+	var value := 0
+
+signal tick(step)
+
+func counter(name: String, count: int):
+	var steps: Array[int] = []
+	var label := name + ":"
+	for i in count:
+		var step = await tick
+		steps.append(step * 10 + i)
+	print(label, " ", steps)
+
+func hold(payload: Payload):
+	await tick
+	print(payload.value)
+
+func test():
+	counter("a", 3)
+	counter("b", 5)
+	for step in 6:
+		tick.emit(step)
+
+	var payload := Payload.new()
+	var payload_ref := weakref(payload)
+	hold(payload)
+	payload = null
+	print(payload_ref.get_ref() != null)
+
+	# Dropping the connection frees the state, and with it the locals of its frame.
+	for connection in tick.get_connections():
+		tick.disconnect(connection.callable)
+	print(payload_ref.get_ref() == null)
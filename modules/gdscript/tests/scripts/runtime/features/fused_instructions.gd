@@ -0,0 +1,62 @@
+# Operators followed by a conditional jump or an assignment are fused into a single instruction.
+
+func test():
+	var i: int = 0
+	var total: int = 0
+	while i < 10:
+		total += i
+		i += 1
+	print(total)
+
+	var x: float = 0.0
+	var steps: int = 0
+	while x <= 1.0:
+		x += 0.25
+		steps += 1
+	print(steps)
+	print(x)
+
+	var countdown: int = 3
+	while countdown != 0:
+		countdown -= 1
+	print(countdown)
+
+	var position := Vector2(1, 2)
+	if position == Vector2(1, 2):
+		print("vector equal")
+	if position != Vector2(1, 2):
+		print("unexpected")
+	position += Vector2(0.5, 0.5)
+	print(position)
+
+	var scale: float = 3.0
+	scale /= 2.0
+	scale *= 4.0
+	scale -= 1.0
+	print(scale)
+
+	var product: int = 2
+	product *= 3
+	product -= 1
+	print(product)
+
+	var untyped = 0
+	var a: int = 2
+	var b: int = 3
+	untyped = a * b
+	print(untyped)
+
+	var sum: int = 0
+	for k in 5:
+		if k >= 3:
+			break
+		sum += k
+	print(sum)
+
+	var z: float = 10.0
+	if z > 5.0:
+		print("greater")
+	if z < 5.0:
+		print("unexpected")
+	if z >= 10.0:
+		print("greater or equal")
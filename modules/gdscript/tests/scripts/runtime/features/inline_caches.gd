@@ -0,0 +1,93 @@
+# Property accesses and calls on untyped receivers go through per-instruction inline caches,
+# which must keep each receiver type's own lookup semantics.
+
+class A:
+	var value = 1
+	var typed: float = 0.0
+	var with_setter = 0:
+		set(v):
+			with_setter = v * 2
+
+	func name():
+		return "A"
+
+class B extends A:
+	func _init():
+		value = 2
+
+	func name():
+		return "B"
+
+class C:
+	var value = "c"
+
+	func name():
+		return "C"
+
+class Dynamic:
+	var written = []
+
+	func _get(property):
+		if property == &"value":
+			return "dynamic"
+		return null
+
+	func _set(property, v):
+		written.push_back([property, v])
+		return true
+
+	func name():
+		return "Dynamic"
+
+class D:
+	func name():
+		return "D"
+
+class E:
+	func name():
+		return "E"
+
+func read_value(obj):
+	return obj.value
+
+func write_value(obj, v):
+	obj.value = v
+
+func call_name(obj):
+	return obj.name()
+
+func test():
+	var receivers = [A.new(), B.new(), C.new(), Dynamic.new()]
+	for _i in 2:
+		for obj in receivers:
+			print(read_value(obj), " ", call_name(obj))
+
+	for obj in receivers:
+		write_value(obj, 5)
+	print(receivers[0].value, " ", receivers[1].value, " ", receivers[2].value, " ", receivers[3].written)
+
+	# More receiver types than a cache holds.
+	var many = [A.new(), B.new(), C.new(), Dynamic.new(), D.new(), E.new()]
+	for _i in 2:
+		var names = []
+		for obj in many:
+			names.push_back(call_name(obj))
+		print(names)
+
+	# Setters still run, and typed members still convert their value.
+	var a = A.new()
+	for v in [1, 2, 3]:
+		a.with_setter = v
+		print(a.with_setter)
+	for v in [1, 2.5, 3]:
+		a.typed = v
+		print(a.typed, " ", type_string(typeof(a.typed)))
+
+	# Native properties and methods.
+	var node = Node2D.new()
+	for i in 3:
+		node.position = Vector2(i, i)
+		print(node.position == Vector2(i, i))
+		node.name = "Node%d" % i
+		print(node.name, " ", node.get_child_count())
+	node.free()
@@ -0,0 +1,47 @@
+var member_int: int = 10
+var member_float: float = 2.5
+
+func test():
+	var a: int = 7
+	var b: int = 3
+	print(a + b)
+	print(a - b)
+	print(a * b)
+	print(a == b, " ", a != b)
+	print(a < b, " ", a <= b, " ", a > b, " ", a >= b)
+	print(a * b + a - b)
+
+	var x: float = 1.5
+	var y: float = 0.5
+	print(x + y)
+	print(x - y)
+	print(x * y)
+	print(x / y)
+	print(x == y, " ", x != y)
+	print(x < y, " ", x <= y, " ", x > y, " ", x >= y)
+
+	var zero: float = 0.0
+	print(x / zero)
+	var nan_value: float = NAN
+	print(nan_value == nan_value, " ", nan_value != nan_value)
+
+	member_int += a
+	print(member_int * 2)
+	print(member_float * x)
+
+	var sum: int = 0
+	var i: int = 0
+	while i < 100:
+		sum += i
+		i += 1
+	print(sum)
+
+	var acc: float = 0.0
+	for j in 4:
+		acc += j * 0.25
+	print(acc)
+
+	var untyped = a * b
+	untyped = "text"
+	print(untyped)
+	print(a < b or x > y)
@@ -0,0 +1,43 @@
+# Indexing statically typed packed arrays uses dedicated instructions for reads and writes.
+
+func scale_heights(heights: PackedFloat32Array, factor: float) -> void:
+	for i in heights.size():
+		heights[i] = heights[i] * factor
+
+func test():
+	var heights := PackedFloat32Array([0.5, 1.5, 2.5])
+	scale_heights(heights, 2.0)
+	print(heights)
+	print(heights[-1])
+
+	var bytes := PackedByteArray([1, 2, 3])
+	bytes[0] = 255
+	bytes[1] += 10
+	print(bytes)
+
+	var counts := PackedInt64Array([10, 20])
+	counts[-2] = counts[1] * 3
+	print(counts)
+
+	var names := PackedStringArray(["a", "b"])
+	names[1] = names[0] + "c"
+	print(names[1])
+
+	var vertices := PackedVector3Array([Vector3(0.5, 1.5, 2.5)])
+	var vertex: Vector3 = vertices[0]
+	vertices[0] = vertex * 2.0
+	print(vertices[0])
+
+	var colors := PackedColorArray([Color.RED])
+	colors[0] = colors[0].lerp(Color.BLUE, 0.5)
+	print(colors[0])
+
+	var copy := heights.duplicate()
+	copy[0] = 42.0
+	print(heights[0])
+	print(copy[0])
+
+	var total := 0.0
+	for height in heights:
+		total += height
+	print(total)
@@ -611,6 +611,39 @@ void GodotBody2D::integrate_forces(real_t p_step) {
 	contact_count = 0;
 }
 
+// Sine and cosine computed with basic arithmetic only, which is correctly rounded everywhere, so the
+// results are the same on all platforms unlike those of the C math library.
+static void _deterministic_sin_cos(real_t p_angle, real_t &r_sin, real_t &r_cos) {
+	// Reduce to [-PI/4, PI/4] around the closest multiple of PI/2, which is split in two parts so that
+	// the first product is exact.
+	const double quadrant = Math::floor(p_angle * (2.0 / Math_PI) + 0.5);
+	const double x = ((double)p_angle - quadrant * 1.57079632673412561417e+00) - quadrant * 6.07710050650619224932e-11;
+	const double x2 = x * x;
+
+	// Taylor series, the first omitted terms are below double precision in this range.
+	const double s = x * (1.0 + x2 * (-1.0 / 6.0 + x2 * (1.0 / 120.0 + x2 * (-1.0 / 5040.0 + x2 * (1.0 / 362880.0 + x2 * (-1.0 / 39916800.0 + x2 * (1.0 / 6227020800.0 + x2 * (-1.0 / 1307674368000.0))))))));
+	const double c = 1.0 + x2 * (-1.0 / 2.0 + x2 * (1.0 / 24.0 + x2 * (-1.0 / 720.0 + x2 * (1.0 / 40320.0 + x2 * (-1.0 / 3628800.0 + x2 * (1.0 / 479001600.0 + x2 * (-1.0 / 87178291200.0 + x2 * (1.0 / 20922789888000.0))))))));
+
+	switch ((int64_t)quadrant & 3) {
+		case 0: {
+			r_sin = s;
+			r_cos = c;
+		} break;
+		case 1: {
+			r_sin = c;
+			r_cos = -s;
+		} break;
+		case 2: {
+			r_sin = -s;
+			r_cos = -c;
+		} break;
+		default: {
+			r_sin = -c;
+			r_cos = s;
+		} break;
+	}
+}
+
 void GodotBody2D::integrate_velocities(real_t p_step) {
 	if (mode == PhysicsServer2D::BODY_MODE_STATIC) {
 		return;
@@ -635,15 +668,38 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 	Vector2 total_linear_velocity = linear_velocity + biased_linear_velocity;
 
 	real_t angle_delta = total_angular_velocity * p_step;
-	real_t angle = get_transform().get_rotation() + angle_delta;
 	Vector2 pos = get_transform().get_origin() + total_linear_velocity * p_step;
 
-	if (center_of_mass.length_squared() > CMP_EPSILON2) {
-		// Calculate displacement due to center of mass offset.
-		pos += center_of_mass - center_of_mass.rotated(angle_delta);
-	}
+	if (get_space()->is_deterministic()) {
+		// Rotate the basis directly, as going through the angle needs atan2(), sin() and cos() from
+		// the math library.
+		real_t sine = 0.0;
+		real_t cosine = 1.0;
+		_deterministic_sin_cos(angle_delta, sine, cosine);
 
-	_set_transform(Transform2D(angle, pos), continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED);
+		Transform2D transform = get_transform();
+		for (int i = 0; i < 2; i++) {
+			const Vector2 axis = transform.columns[i];
+			transform.columns[i] = Vector2(axis.x * cosine - axis.y * sine, axis.x * sine + axis.y * cosine);
+		}
+		transform.orthonormalize();
+
+		if (center_of_mass.length_squared() > CMP_EPSILON2) {
+			pos += center_of_mass - Vector2(center_of_mass.x * cosine - center_of_mass.y * sine, center_of_mass.x * sine + center_of_mass.y * cosine);
+		}
+		transform.columns[2] = pos;
+
+		_set_transform(transform, continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED);
+	} else {
+		real_t angle = get_transform().get_rotation() + angle_delta;
+
+		if (center_of_mass.length_squared() > CMP_EPSILON2) {
+			// Calculate displacement due to center of mass offset.
+			pos += center_of_mass - center_of_mass.rotated(angle_delta);
+		}
+
+		_set_transform(Transform2D(angle, pos), continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED);
+	}
 	_set_inv_transform(get_transform().inverse());
 
 	if (continuous_cd_mode != PhysicsServer2D::CCD_MODE_DISABLED) {
@@ -36,6 +36,7 @@
 
 #include "core/templates/list.h"
 #include "core/templates/pair.h"
+#include "core/templates/small_vector.h"
 #include "core/templates/vset.h"
 
 class GodotConstraint2D;
@@ -120,7 +121,8 @@ class GodotBody2D : public GodotCollisionObject2D {
 		}
 	};
 
-	Vector<AreaCMP> areas;
+	// Bodies overlap few areas at a time, entering and leaving them shouldn't allocate.
+	SmallVector<AreaCMP, 2> areas;
 
 	struct Contact {
 		Vector2 local_pos;
@@ -157,6 +159,13 @@ class GodotBody2D : public GodotCollisionObject2D {
 	friend class GodotPhysicsDirectBodyState2D; // i give up, too many functions to expose
 
 public:
+	// Orders bodies by RID, which doesn't depend on the order they were added and removed in.
+	struct RIDComparator {
+		_FORCE_INLINE_ bool operator()(const GodotBody2D *p_a, const GodotBody2D *p_b) const {
+			return p_a->get_self().get_id() < p_b->get_self().get_id();
+		}
+	};
+
 	void set_state_sync_callback(const Callable &p_callable);
 	void set_force_integration_callback(const Callable &p_callable, const Variant &p_udata = Variant());
 
@@ -165,7 +174,7 @@ public:
 	_FORCE_INLINE_ void add_area(GodotArea2D *p_area) {
 		int index = areas.find(AreaCMP(p_area));
 		if (index > -1) {
-			areas.write[index].refCount += 1;
+			areas[index].refCount += 1;
 		} else {
 			areas.ordered_insert(AreaCMP(p_area));
 		}
@@ -174,7 +183,7 @@ public:
 	_FORCE_INLINE_ void remove_area(GodotArea2D *p_area) {
 		int index = areas.find(AreaCMP(p_area));
 		if (index > -1) {
-			areas.write[index].refCount -= 1;
+			areas[index].refCount -= 1;
 			if (areas[index].refCount < 1) {
 				areas.remove_at(index);
 			}
@@ -94,6 +94,8 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual OrderKey get_order_key() const override { return make_order_key(A->get_self(), shape_A, B->get_self(), shape_B); }
+
 	GodotBodyPair2D(GodotBody2D *p_A, int p_shape_A, GodotBody2D *p_B, int p_shape_B);
 	~GodotBodyPair2D();
 };
@@ -34,6 +34,40 @@
 #include "godot_body_2d.h"
 
 class GodotConstraint2D {
+public:
+	// Orders constraints by the RIDs and shapes they link, which are the same on every run unlike their
+	// addresses or the order in which they were created.
+	struct OrderKey {
+		uint64_t first = 0;
+		uint64_t second = 0;
+		uint64_t shapes = 0;
+
+		_FORCE_INLINE_ bool operator<(const OrderKey &p_other) const {
+			if (first != p_other.first) {
+				return first < p_other.first;
+			}
+			if (second != p_other.second) {
+				return second < p_other.second;
+			}
+			return shapes < p_other.shapes;
+		}
+	};
+
+	static _FORCE_INLINE_ OrderKey make_order_key(const RID &p_a, int p_shape_a, const RID &p_b, int p_shape_b) {
+		OrderKey key;
+		if (p_b.get_id() < p_a.get_id()) {
+			key.first = p_b.get_id();
+			key.second = p_a.get_id();
+			key.shapes = ((uint64_t)(uint32_t)p_shape_b << 32) | (uint32_t)p_shape_a;
+		} else {
+			key.first = p_a.get_id();
+			key.second = p_b.get_id();
+			key.shapes = ((uint64_t)(uint32_t)p_shape_a << 32) | (uint32_t)p_shape_b;
+		}
+		return key;
+	}
+
+private:
 	GodotBody2D **_body_ptr;
 	int _body_count;
 	uint64_t island_step = 0;
@@ -60,6 +94,13 @@ public:
 	_FORCE_INLINE_ void disable_collisions_between_bodies(const bool p_disabled) { disabled_collisions_between_bodies = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
+	// Joints are ordered by their own RID, pairs by what they link.
+	virtual OrderKey get_order_key() const {
+		OrderKey key;
+		key.first = self.get_id();
+		return key;
+	}
+
 	virtual bool setup(real_t p_step) = 0;
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
@@ -276,6 +276,13 @@ int GodotPhysicsServer2D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+uint64_t GodotPhysicsServer2D::space_get_state_hash(RID p_space) const {
+	GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, 0);
+	ERR_FAIL_COND_V_MSG(space->is_locked(), 0, "Space state is inaccessible while it is stepping.");
+	return space->get_state_hash();
+}
+
 PhysicsDirectSpaceState2D *GodotPhysicsServer2D::space_get_direct_state(RID p_space) {
 	GodotSpace2D *space = space_owner.get_or_null(p_space);
 	ERR_FAIL_NULL_V(space, nullptr);
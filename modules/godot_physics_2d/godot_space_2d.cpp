@@ -1211,6 +1211,67 @@ bool GodotSpace2D::is_locked() const {
 	return locked;
 }
 
+// Two murmur3 lanes with different seeds, as a single one only gives 32 bits.
+struct StateHash2D {
+	uint32_t low = HASH_MURMUR3_SEED;
+	uint32_t high = 0x9E3779B9;
+
+	_FORCE_INLINE_ void add(uint32_t p_value) {
+		low = hash_murmur3_one_32(p_value, low);
+		high = hash_murmur3_one_32(p_value, high);
+	}
+
+	// Unlike hash_murmur3_one_real(), signed zeros and NaNs are not normalized.
+	_FORCE_INLINE_ void add_real_bits(real_t p_value) {
+#ifdef REAL_T_IS_DOUBLE
+		uint64_t bits;
+		memcpy(&bits, &p_value, sizeof(bits));
+		add(bits & 0xFFFFFFFF);
+		add(bits >> 32);
+#else
+		uint32_t bits;
+		memcpy(&bits, &p_value, sizeof(bits));
+		add(bits);
+#endif
+	}
+
+	_FORCE_INLINE_ uint64_t get() const {
+		return ((uint64_t)hash_fmix32(high) << 32) | hash_fmix32(low);
+	}
+};
+
+uint64_t GodotSpace2D::get_state_hash() const {
+	// Visited by RID, as the order of the objects depends on how they were added and removed.
+	LocalVector<const GodotBody2D *> bodies;
+	for (const GodotCollisionObject2D *object : objects) {
+		if (object->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+			bodies.push_back(static_cast<const GodotBody2D *>(object));
+		}
+	}
+	bodies.sort_custom<GodotBody2D::RIDComparator>();
+
+	// The exact bits are hashed, as any difference leads simulations apart. RIDs themselves are left out,
+	// so that the same scene created again gives the same hash.
+	StateHash2D hash;
+	hash.add(bodies.size());
+	for (const GodotBody2D *body : bodies) {
+		hash.add(body->get_mode());
+		hash.add(body->is_active());
+
+		const Transform2D &transform = body->get_transform();
+		for (int i = 0; i < 3; i++) {
+			hash.add_real_bits(transform.columns[i].x);
+			hash.add_real_bits(transform.columns[i].y);
+		}
+		const Vector2 linear_velocity = body->get_linear_velocity();
+		hash.add_real_bits(linear_velocity.x);
+		hash.add_real_bits(linear_velocity.y);
+		hash.add_real_bits(body->get_angular_velocity());
+	}
+
+	return hash.get();
+}
+
 GodotPhysicsDirectSpaceState2D *GodotSpace2D::get_direct_state() {
 	return direct_access;
 }
@@ -1225,6 +1286,7 @@ GodotSpace2D::GodotSpace2D() {
 	contact_max_allowed_penetration = GLOBAL_GET("physics/2d/solver/contact_max_allowed_penetration");
 	contact_bias = GLOBAL_GET("physics/2d/solver/default_contact_bias");
 	constraint_bias = GLOBAL_GET("physics/2d/solver/default_constraint_bias");
+	deterministic = GLOBAL_GET("physics/2d/solver/deterministic");
 
 	broadphase = GodotBroadPhase2D::create_func();
 	broadphase->set_pair_callback(_broadphase_pair, this);
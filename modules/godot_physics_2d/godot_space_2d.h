@@ -103,6 +103,7 @@ private:
 	real_t contact_max_allowed_penetration = 0.0;
 	real_t contact_bias = 0.0;
 	real_t constraint_bias = 0.0;
+	bool deterministic = false;
 
 	enum {
 		INTERSECTION_QUERY_MAX = 2048
@@ -167,6 +168,7 @@ public:
 	_FORCE_INLINE_ real_t get_body_linear_velocity_sleep_threshold() const { return body_linear_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_angular_velocity_sleep_threshold() const { return body_angular_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_time_to_sleep() const { return body_time_to_sleep; }
+	_FORCE_INLINE_ bool is_deterministic() const { return deterministic; }
 
 	void update();
 	void setup();
@@ -190,6 +192,8 @@ public:
 
 	int get_collision_pairs() const { return collision_pairs; }
 
+	uint64_t get_state_hash() const;
+
 	bool test_body_motion(GodotBody2D *p_body, const PhysicsServer2D::MotionParameters &p_parameters, PhysicsServer2D::MotionResult *r_result);
 
 	void set_debug_contacts(int p_amount) { contact_debug.resize(p_amount); }
@@ -39,6 +39,12 @@
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
 
+struct ConstraintOrderComparator {
+	_FORCE_INLINE_ bool operator()(const GodotConstraint2D *p_a, const GodotConstraint2D *p_b) const {
+		return p_a->get_order_key() < p_b->get_order_key();
+	}
+};
+
 void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
 
@@ -134,6 +140,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	iterations = p_space->get_solver_iterations();
 	delta = p_delta;
+	deterministic = p_space->is_deterministic();
 
 	const SelfList<GodotBody2D>::List *body_list = &p_space->get_active_body_list();
 
@@ -192,13 +199,21 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
+	active_bodies.clear();
 	b = body_list->first();
+	while (b) {
+		active_bodies.push_back(b->self());
+		b = b->next();
+	}
 
-	uint32_t body_island_count = 0;
+	if (deterministic) {
+		// The active list is in wake up order, which depends on the history of the simulation.
+		active_bodies.sort_custom<GodotBody2D::RIDComparator>();
+	}
 
-	while (b) {
-		GodotBody2D *body = b->self();
+	uint32_t body_island_count = 0;
 
+	for (GodotBody2D *body : active_bodies) {
 		if (body->get_island_step() != _step) {
 			++body_island_count;
 			if (body_islands.size() < body_island_count) {
@@ -218,6 +233,11 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 			_populate_island(body, body_island, constraint_island);
 
+			if (deterministic) {
+				// Constraints are reached in the order they were created in, which depends on the broadphase.
+				constraint_island.sort_custom<ConstraintOrderComparator>();
+			}
+
 			if (body_island.is_empty()) {
 				--body_island_count;
 			}
@@ -226,7 +246,6 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 				--island_count;
 			}
 		}
-		b = b->next();
 	}
 
 	p_space->set_island_count((int)island_count);
@@ -239,9 +258,16 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
+	// In deterministic mode, everything runs on this thread so the outcome can't depend on scheduling.
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	if (deterministic) {
+		for (uint32_t constraint_index = 0; constraint_index < total_constraint_count; ++constraint_index) {
+			_setup_constraint(constraint_index);
+		}
+	} else {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -260,8 +286,14 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics2DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	if (deterministic) {
+		for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+			_solve_island(island_index);
+		}
+	} else {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics2DConstraintSolveIslands"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -170,11 +170,7 @@ void GodotBody3D::reset_mass_properties() {
 	_mass_properties_changed();
 }
 
-void GodotBody3D::set_active(bool p_active) {
-	if (active == p_active) {
-		return;
-	}
-
+void GodotBody3D::_set_active(bool p_active) {
 	active = p_active;
 
 	if (active) {
@@ -189,6 +185,42 @@ void GodotBody3D::set_active(bool p_active) {
 	}
 }
 
+void GodotBody3D::set_active(bool p_active) {
+	if (active == p_active) {
+		return;
+	}
+
+	_set_active(p_active);
+
+	if (active && mode > PhysicsServer3D::BODY_MODE_KINEMATIC && island && island->valid) {
+		// Sleeping islands wake up as a unit.
+		for (GodotBody3D *body : island->bodies) {
+			if (!body->active) {
+				body->_set_active(true);
+			}
+		}
+	}
+}
+
+void GodotBody3D::set_island(GodotIsland3D *p_island) {
+	if (island == p_island) {
+		return;
+	}
+
+	if (island) {
+		island->member_count--;
+		if (island->member_count == 0) {
+			memdelete(island);
+		}
+	}
+
+	island = p_island;
+
+	if (island) {
+		island->member_count++;
+	}
+}
+
 void GodotBody3D::set_param(PhysicsServer3D::BodyParameter p_param, const Variant &p_value) {
 	switch (p_param) {
 		case PhysicsServer3D::BODY_PARAM_BOUNCE: {
@@ -296,6 +328,20 @@ Variant GodotBody3D::get_param(PhysicsServer3D::BodyParameter p_param) const {
 }
 
 void GodotBody3D::set_mode(PhysicsServer3D::BodyMode p_mode) {
+	_invalidate_island();
+	if ((mode == PhysicsServer3D::BODY_MODE_STATIC) != (p_mode == PhysicsServer3D::BODY_MODE_STATIC)) {
+		// Static bodies don't connect islands, so the neighbouring ones are split or merged.
+		for (const KeyValue<GodotConstraint3D *, int> &E : constraint_map) {
+			for (int i = 0; i < E.key->get_body_count(); i++) {
+				E.key->get_body_ptr()[i]->_invalidate_island();
+			}
+		}
+	}
+	if (p_mode == PhysicsServer3D::BODY_MODE_STATIC) {
+		// Static bodies don't belong to islands.
+		set_island(nullptr);
+	}
+
 	PhysicsServer3D::BodyMode prev = mode;
 	mode = p_mode;
 
@@ -438,6 +484,9 @@ Variant GodotBody3D::get_state(PhysicsServer3D::BodyState p_state) const {
 }
 
 void GodotBody3D::set_space(GodotSpace3D *p_space) {
+	_invalidate_island();
+	set_island(nullptr);
+
 	if (get_space()) {
 		if (mass_properties_update_list.in_list()) {
 			get_space()->body_remove_from_mass_properties_update_list(&mass_properties_update_list);
@@ -832,6 +881,8 @@ GodotBody3D::GodotBody3D() :
 }
 
 GodotBody3D::~GodotBody3D() {
+	_invalidate_island();
+	set_island(nullptr);
 	if (fi_callback_data) {
 		memdelete(fi_callback_data);
 	}
@@ -33,7 +33,9 @@
 
 #include "godot_area_3d.h"
 #include "godot_collision_object_3d.h"
+#include "godot_island_3d.h"
 
+#include "core/templates/small_vector.h"
 #include "core/templates/vset.h"
 
 class GodotConstraint3D;
@@ -114,7 +116,8 @@ class GodotBody3D : public GodotCollisionObject3D {
 
 	HashMap<GodotConstraint3D *, int> constraint_map;
 
-	Vector<AreaCMP> areas;
+	// Bodies overlap few areas at a time, entering and leaving them shouldn't allocate.
+	SmallVector<AreaCMP, 2> areas;
 
 	struct Contact {
 		Vector3 local_pos;
@@ -145,8 +148,16 @@ class GodotBody3D : public GodotCollisionObject3D {
 	GodotPhysicsDirectBodyState3D *direct_state = nullptr;
 
 	uint64_t island_step = 0;
+	GodotIsland3D *island = nullptr;
 
 	void _update_transform_dependent();
+	void _set_active(bool p_active);
+
+	_FORCE_INLINE_ void _invalidate_island() {
+		if (island) {
+			island->valid = false;
+		}
+	}
 
 	friend class GodotPhysicsDirectBodyState3D; // i give up, too many functions to expose
 
@@ -159,7 +170,7 @@ public:
 	_FORCE_INLINE_ void add_area(GodotArea3D *p_area) {
 		int index = areas.find(AreaCMP(p_area));
 		if (index > -1) {
-			areas.write[index].refCount += 1;
+			areas[index].refCount += 1;
 		} else {
 			areas.ordered_insert(AreaCMP(p_area));
 		}
@@ -168,7 +179,7 @@ public:
 	_FORCE_INLINE_ void remove_area(GodotArea3D *p_area) {
 		int index = areas.find(AreaCMP(p_area));
 		if (index > -1) {
-			areas.write[index].refCount -= 1;
+			areas[index].refCount -= 1;
 			if (areas[index].refCount < 1) {
 				areas.remove_at(index);
 			}
@@ -195,8 +206,17 @@ public:
 	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
 	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
 
-	_FORCE_INLINE_ void add_constraint(GodotConstraint3D *p_constraint, int p_pos) { constraint_map[p_constraint] = p_pos; }
-	_FORCE_INLINE_ void remove_constraint(GodotConstraint3D *p_constraint) { constraint_map.erase(p_constraint); }
+	_FORCE_INLINE_ GodotIsland3D *get_island() const { return island; }
+	void set_island(GodotIsland3D *p_island);
+
+	_FORCE_INLINE_ void add_constraint(GodotConstraint3D *p_constraint, int p_pos) {
+		constraint_map[p_constraint] = p_pos;
+		_invalidate_island();
+	}
+	_FORCE_INLINE_ void remove_constraint(GodotConstraint3D *p_constraint) {
+		constraint_map.erase(p_constraint);
+		_invalidate_island();
+	}
 	const HashMap<GodotConstraint3D *, int> &get_constraint_map() const { return constraint_map; }
 	_FORCE_INLINE_ void clear_constraint_map() { constraint_map.clear(); }
 
@@ -217,7 +237,9 @@ public:
 	_FORCE_INLINE_ Vector3 get_prev_linear_velocity() const { return prev_linear_velocity; }
 	_FORCE_INLINE_ Vector3 get_prev_angular_velocity() const { return prev_angular_velocity; }
 
+	_FORCE_INLINE_ void set_biased_linear_velocity(const Vector3 &p_velocity) { biased_linear_velocity = p_velocity; }
 	_FORCE_INLINE_ const Vector3 &get_biased_linear_velocity() const { return biased_linear_velocity; }
+	_FORCE_INLINE_ void set_biased_angular_velocity(const Vector3 &p_velocity) { biased_angular_velocity = p_velocity; }
 	_FORCE_INLINE_ const Vector3 &get_biased_angular_velocity() const { return biased_angular_velocity; }
 
 	_FORCE_INLINE_ void apply_central_impulse(const Vector3 &p_impulse) {
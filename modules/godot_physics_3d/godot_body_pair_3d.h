@@ -37,8 +37,14 @@
 
 #include "core/templates/local_vector.h"
 
+real_t combine_bounce(GodotBody3D *A, GodotBody3D *B);
+real_t combine_friction(GodotBody3D *A, GodotBody3D *B);
+
 class GodotBodyContact3D : public GodotConstraint3D {
 protected:
+	static constexpr real_t MIN_VELOCITY = 0.0001;
+	static constexpr real_t MAX_BIAS_ROTATION = Math_PI / 8;
+
 	struct Contact {
 		Vector3 position;
 		Vector3 normal;
@@ -71,6 +77,8 @@ protected:
 };
 
 class GodotBodyPair3D : public GodotBodyContact3D {
+	friend class GodotContactSolver3D;
+
 	enum {
 		MAX_CONTACTS = 4
 	};
@@ -109,6 +117,8 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual bool is_body_pair() const override { return true; }
+
 	GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B);
 	~GodotBodyPair3D();
 };
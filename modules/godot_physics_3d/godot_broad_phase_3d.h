@@ -33,6 +33,7 @@
 
 #include "core/math/aabb.h"
 #include "core/math/math_funcs.h"
+#include "core/templates/local_vector.h"
 
 class GodotCollisionObject3D;
 
@@ -61,6 +62,17 @@ public:
 	virtual int cull_segment(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) = 0;
 	virtual int cull_aabb(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) = 0;
 
+	struct CullHit {
+		uint32_t query = 0; // Index of the segment or AABB that hit.
+		int subindex = 0;
+		GodotCollisionObject3D *object = nullptr;
+	};
+
+	// Batched culls, appending hits in the same order as single culls for each query. Several
+	// can run at once on different threads, as long as the broadphase isn't modified meanwhile.
+	virtual void cull_segments(const Vector3 *p_from, const Vector3 *p_to, int p_count, LocalVector<CullHit> &r_hits) = 0;
+	virtual void cull_aabbs(const AABB *p_aabbs, int p_count, LocalVector<CullHit> &r_hits) = 0;
+
 	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata) = 0;
 	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) = 0;
 
@@ -32,6 +32,8 @@
 
 #include "godot_collision_object_3d.h"
 
+#include "core/config/project_settings.h"
+
 GodotBroadPhase3DBVH::ID GodotBroadPhase3DBVH::create(GodotCollisionObject3D *p_object, int p_subindex, const AABB &p_aabb, bool p_static) {
 	uint32_t tree_id = p_static ? TREE_STATIC : TREE_DYNAMIC;
 	uint32_t tree_collision_mask = p_static ? TREE_FLAG_DYNAMIC : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC);
@@ -86,6 +88,24 @@ int GodotBroadPhase3DBVH::cull_aabb(const AABB &p_aabb, GodotCollisionObject3D *
 	return bvh.cull_aabb(p_aabb, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices);
 }
 
+struct GodotBroadPhase3DBVHCullHits {
+	LocalVector<GodotBroadPhase3D::CullHit> &hits;
+
+	void hit(uint32_t p_query, GodotCollisionObject3D *p_object, int p_subindex) {
+		hits.push_back({ p_query, p_subindex, p_object });
+	}
+};
+
+void GodotBroadPhase3DBVH::cull_segments(const Vector3 *p_from, const Vector3 *p_to, int p_count, LocalVector<CullHit> &r_hits) {
+	GodotBroadPhase3DBVHCullHits hits = { r_hits };
+	bvh.cull_segments(p_from, p_to, p_count, hits, nullptr);
+}
+
+void GodotBroadPhase3DBVH::cull_aabbs(const AABB *p_aabbs, int p_count, LocalVector<CullHit> &r_hits) {
+	GodotBroadPhase3DBVHCullHits hits = { r_hits };
+	bvh.cull_aabbs(p_aabbs, p_count, hits, nullptr);
+}
+
 void *GodotBroadPhase3DBVH::_pair_callback(void *self, uint32_t p_A, GodotCollisionObject3D *p_object_A, int subindex_A, uint32_t p_B, GodotCollisionObject3D *p_object_B, int subindex_B) {
 	GodotBroadPhase3DBVH *bpo = static_cast<GodotBroadPhase3DBVH *>(self);
 	if (!bpo->pair_callback) {
@@ -125,4 +145,5 @@ GodotBroadPhase3D *GodotBroadPhase3DBVH::_create() {
 GodotBroadPhase3DBVH::GodotBroadPhase3DBVH() {
 	bvh.set_pair_callback(_pair_callback, this);
 	bvh.set_unpair_callback(_unpair_callback, this);
+	bvh.params_set_parallel_update(GLOBAL_GET("physics/3d/parallel_broadphase_update"));
 }
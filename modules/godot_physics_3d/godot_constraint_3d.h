@@ -65,6 +65,9 @@ public:
 	virtual GodotSoftBody3D *get_soft_body_ptr(int p_index) const { return nullptr; }
 	virtual int get_soft_body_count() const { return 0; }
 
+	// Contacts between two rigid bodies, which GodotContactSolver3D can solve in batches.
+	virtual bool is_body_pair() const { return false; }
+
 	_FORCE_INLINE_ void set_priority(int p_priority) { priority = p_priority; }
 	_FORCE_INLINE_ int get_priority() const { return priority; }
 
@@ -0,0 +1,542 @@
+/**************************************************************************/
+/*  godot_contact_solver_3d.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "godot_contact_solver_3d.h"
+
+#if !defined(REAL_T_IS_DOUBLE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define CONTACT_SOLVER_SSE2
+#include <emmintrin.h>
+#elif !defined(REAL_T_IS_DOUBLE) && defined(__ARM_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+#define CONTACT_SOLVER_NEON
+#include <arm_neon.h>
+#endif
+
+static_assert(GodotContactSolver3D::LANES == 4, "The SIMD lanes below hold 4 values.");
+
+namespace {
+
+// One value per contact of a batch, in a single SIMD register when available. The solver is written
+// once against these operators, with masks selecting lanes where GodotBodyPair3D::solve() branches.
+#if defined(CONTACT_SOLVER_SSE2)
+struct Real4 {
+	__m128 v;
+
+	static _FORCE_INLINE_ Real4 load(const real_t *p_ptr) { return { _mm_loadu_ps(p_ptr) }; }
+	static _FORCE_INLINE_ Real4 splat(real_t p_value) { return { _mm_set1_ps(p_value) }; }
+	_FORCE_INLINE_ void store(real_t *p_ptr) const { _mm_storeu_ps(p_ptr, v); }
+};
+
+struct Mask4 {
+	__m128 v;
+};
+
+_FORCE_INLINE_ Real4 operator+(Real4 p_a, Real4 p_b) { return { _mm_add_ps(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Real4 operator-(Real4 p_a, Real4 p_b) { return { _mm_sub_ps(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Real4 operator*(Real4 p_a, Real4 p_b) { return { _mm_mul_ps(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Real4 operator/(Real4 p_a, Real4 p_b) { return { _mm_div_ps(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Real4 min4(Real4 p_a, Real4 p_b) { return { _mm_min_ps(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Real4 max4(Real4 p_a, Real4 p_b) { return { _mm_max_ps(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Real4 abs4(Real4 p_a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), p_a.v) }; }
+_FORCE_INLINE_ Real4 sqrt4(Real4 p_a) { return { _mm_sqrt_ps(p_a.v) }; }
+_FORCE_INLINE_ Mask4 greater4(Real4 p_a, Real4 p_b) { return { _mm_cmpgt_ps(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Mask4 operator&(Mask4 p_a, Mask4 p_b) { return { _mm_and_ps(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Mask4 operator|(Mask4 p_a, Mask4 p_b) { return { _mm_or_ps(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Real4 select4(Mask4 p_mask, Real4 p_a, Real4 p_b) { return { _mm_or_ps(_mm_and_ps(p_mask.v, p_a.v), _mm_andnot_ps(p_mask.v, p_b.v)) }; }
+#elif defined(CONTACT_SOLVER_NEON)
+struct Real4 {
+	float32x4_t v;
+
+	static _FORCE_INLINE_ Real4 load(const real_t *p_ptr) { return { vld1q_f32(p_ptr) }; }
+	static _FORCE_INLINE_ Real4 splat(real_t p_value) { return { vdupq_n_f32(p_value) }; }
+	_FORCE_INLINE_ void store(real_t *p_ptr) const { vst1q_f32(p_ptr, v); }
+};
+
+struct Mask4 {
+	uint32x4_t v;
+};
+
+_FORCE_INLINE_ Real4 operator+(Real4 p_a, Real4 p_b) { return { vaddq_f32(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Real4 operator-(Real4 p_a, Real4 p_b) { return { vsubq_f32(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Real4 operator*(Real4 p_a, Real4 p_b) { return { vmulq_f32(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Real4 operator/(Real4 p_a, Real4 p_b) { return { vdivq_f32(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Real4 min4(Real4 p_a, Real4 p_b) { return { vminq_f32(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Real4 max4(Real4 p_a, Real4 p_b) { return { vmaxq_f32(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Real4 abs4(Real4 p_a) { return { vabsq_f32(p_a.v) }; }
+_FORCE_INLINE_ Real4 sqrt4(Real4 p_a) { return { vsqrtq_f32(p_a.v) }; }
+_FORCE_INLINE_ Mask4 greater4(Real4 p_a, Real4 p_b) { return { vcgtq_f32(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Mask4 operator&(Mask4 p_a, Mask4 p_b) { return { vandq_u32(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Mask4 operator|(Mask4 p_a, Mask4 p_b) { return { vorrq_u32(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Real4 select4(Mask4 p_mask, Real4 p_a, Real4 p_b) { return { vbslq_f32(p_mask.v, p_a.v, p_b.v) }; }
+#else
+struct Real4 {
+	real_t v[4];
+
+	static _FORCE_INLINE_ Real4 load(const real_t *p_ptr) { return { { p_ptr[0], p_ptr[1], p_ptr[2], p_ptr[3] } }; }
+	static _FORCE_INLINE_ Real4 splat(real_t p_value) { return { { p_value, p_value, p_value, p_value } }; }
+	_FORCE_INLINE_ void store(real_t *p_ptr) const {
+		for (int i = 0; i < 4; i++) {
+			p_ptr[i] = v[i];
+		}
+	}
+};
+
+struct Mask4 {
+	bool v[4];
+};
+
+#define CONTACT_SOLVER_LANE_OP(m_type, m_expr) \
+	m_type r;                                  \
+	for (int i = 0; i < 4; i++) {              \
+		r.v[i] = m_expr;                       \
+	}                                          \
+	return r;
+
+_FORCE_INLINE_ Real4 operator+(Real4 p_a, Real4 p_b) { CONTACT_SOLVER_LANE_OP(Real4, p_a.v[i] + p_b.v[i]) }
+_FORCE_INLINE_ Real4 operator-(Real4 p_a, Real4 p_b) { CONTACT_SOLVER_LANE_OP(Real4, p_a.v[i] - p_b.v[i]) }
+_FORCE_INLINE_ Real4 operator*(Real4 p_a, Real4 p_b) { CONTACT_SOLVER_LANE_OP(Real4, p_a.v[i] * p_b.v[i]) }
+_FORCE_INLINE_ Real4 operator/(Real4 p_a, Real4 p_b) { CONTACT_SOLVER_LANE_OP(Real4, p_a.v[i] / p_b.v[i]) }
+_FORCE_INLINE_ Real4 min4(Real4 p_a, Real4 p_b) { CONTACT_SOLVER_LANE_OP(Real4, MIN(p_a.v[i], p_b.v[i])) }
+_FORCE_INLINE_ Real4 max4(Real4 p_a, Real4 p_b) { CONTACT_SOLVER_LANE_OP(Real4, MAX(p_a.v[i], p_b.v[i])) }
+_FORCE_INLINE_ Real4 abs4(Real4 p_a) { CONTACT_SOLVER_LANE_OP(Real4, Math::abs(p_a.v[i])) }
+_FORCE_INLINE_ Real4 sqrt4(Real4 p_a) { CONTACT_SOLVER_LANE_OP(Real4, Math::sqrt(p_a.v[i])) }
+_FORCE_INLINE_ Mask4 greater4(Real4 p_a, Real4 p_b) { CONTACT_SOLVER_LANE_OP(Mask4, p_a.v[i] > p_b.v[i]) }
+_FORCE_INLINE_ Mask4 operator&(Mask4 p_a, Mask4 p_b) { CONTACT_SOLVER_LANE_OP(Mask4, p_a.v[i] && p_b.v[i]) }
+_FORCE_INLINE_ Mask4 operator|(Mask4 p_a, Mask4 p_b) { CONTACT_SOLVER_LANE_OP(Mask4, p_a.v[i] || p_b.v[i]) }
+_FORCE_INLINE_ Real4 select4(Mask4 p_mask, Real4 p_a, Real4 p_b) { CONTACT_SOLVER_LANE_OP(Real4, p_mask.v[i] ? p_a.v[i] : p_b.v[i]) }
+
+#undef CONTACT_SOLVER_LANE_OP
+#endif
+
+// One Vector3 per contact of a batch.
+struct Vector3x4 {
+	Real4 x, y, z;
+
+	static _FORCE_INLINE_ Vector3x4 load(const real_t (*p_ptr)[GodotContactSolver3D::LANES]) { return { Real4::load(p_ptr[0]), Real4::load(p_ptr[1]), Real4::load(p_ptr[2]) }; }
+	_FORCE_INLINE_ void store(real_t (*p_ptr)[GodotContactSolver3D::LANES]) const {
+		x.store(p_ptr[0]);
+		y.store(p_ptr[1]);
+		z.store(p_ptr[2]);
+	}
+
+	_FORCE_INLINE_ Vector3x4 operator+(const Vector3x4 &p_other) const { return { x + p_other.x, y + p_other.y, z + p_other.z }; }
+	_FORCE_INLINE_ Vector3x4 operator-(const Vector3x4 &p_other) const { return { x - p_other.x, y - p_other.y, z - p_other.z }; }
+	_FORCE_INLINE_ Vector3x4 operator*(Real4 p_scalar) const { return { x * p_scalar, y * p_scalar, z * p_scalar }; }
+	_FORCE_INLINE_ Vector3x4 operator/(Real4 p_scalar) const { return { x / p_scalar, y / p_scalar, z / p_scalar }; }
+
+	_FORCE_INLINE_ Real4 dot(const Vector3x4 &p_other) const { return x * p_other.x + y * p_other.y + z * p_other.z; }
+	_FORCE_INLINE_ Vector3x4 cross(const Vector3x4 &p_other) const {
+		return { y * p_other.z - z * p_other.y, z * p_other.x - x * p_other.z, x * p_other.y - y * p_other.x };
+	}
+	_FORCE_INLINE_ Real4 length() const { return sqrt4(dot(*this)); }
+};
+
+_FORCE_INLINE_ Vector3x4 select4(Mask4 p_mask, const Vector3x4 &p_a, const Vector3x4 &p_b) {
+	return { select4(p_mask, p_a.x, p_b.x), select4(p_mask, p_a.y, p_b.y), select4(p_mask, p_a.z, p_b.z) };
+}
+
+// Multiplies by a matrix stored row by row.
+_FORCE_INLINE_ Vector3x4 xform4(const real_t (*p_rows)[GodotContactSolver3D::LANES], const Vector3x4 &p_vector) {
+	Vector3x4 r;
+	r.x = Real4::load(p_rows[0]) * p_vector.x + Real4::load(p_rows[1]) * p_vector.y + Real4::load(p_rows[2]) * p_vector.z;
+	r.y = Real4::load(p_rows[3]) * p_vector.x + Real4::load(p_rows[4]) * p_vector.y + Real4::load(p_rows[5]) * p_vector.z;
+	r.z = Real4::load(p_rows[6]) * p_vector.x + Real4::load(p_rows[7]) * p_vector.y + Real4::load(p_rows[8]) * p_vector.z;
+	return r;
+}
+
+_FORCE_INLINE_ Vector3x4 gather4(const LocalVector<real_t> *p_arrays, const uint32_t *p_indices) {
+	real_t lanes[3][GodotContactSolver3D::LANES];
+	for (int axis = 0; axis < 3; axis++) {
+		for (int i = 0; i < GodotContactSolver3D::LANES; i++) {
+			lanes[axis][i] = p_arrays[axis][p_indices[i]];
+		}
+	}
+	return Vector3x4::load(lanes);
+}
+
+// Only dynamic bodies are written, the velocities of the others don't change.
+_FORCE_INLINE_ void scatter4(LocalVector<real_t> *r_arrays, const uint32_t *p_indices, const LocalVector<bool> &p_dynamic, const Vector3x4 &p_values) {
+	real_t lanes[3][GodotContactSolver3D::LANES];
+	p_values.store(lanes);
+	for (int i = 0; i < GodotContactSolver3D::LANES; i++) {
+		if (p_dynamic[p_indices[i]]) {
+			for (int axis = 0; axis < 3; axis++) {
+				r_arrays[axis][p_indices[i]] = lanes[axis][i];
+			}
+		}
+	}
+}
+
+} // namespace
+
+uint32_t GodotContactSolver3D::_get_body_index(GodotBody3D *p_body) {
+	HashMap<GodotBody3D *, uint32_t>::Iterator E = body_indices.find(p_body);
+	if (E) {
+		return E->value;
+	}
+
+	uint32_t index = bodies.size();
+	body_indices.insert(p_body, index);
+	bodies.push_back(p_body);
+	body_dynamic.push_back(p_body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC);
+
+	const Vector3 &linear = p_body->get_linear_velocity();
+	const Vector3 &angular = p_body->get_angular_velocity();
+	const Vector3 &biased_linear = p_body->get_biased_linear_velocity();
+	const Vector3 &biased_angular = p_body->get_biased_angular_velocity();
+	for (int axis = 0; axis < 3; axis++) {
+		velocities.linear[axis].push_back(linear[axis]);
+		velocities.angular[axis].push_back(angular[axis]);
+		velocities.biased_linear[axis].push_back(biased_linear[axis]);
+		velocities.biased_angular[axis].push_back(biased_angular[axis]);
+	}
+
+	return index;
+}
+
+uint32_t GodotContactSolver3D::_find_batch(uint32_t p_body_A, uint32_t p_body_B, uint32_t &r_first_open_batch) {
+	while (r_first_open_batch < batches.size() && batch_lanes[r_first_open_batch] == LANES) {
+		r_first_open_batch++;
+	}
+
+	const bool dynamic_A = body_dynamic[p_body_A];
+	const bool dynamic_B = body_dynamic[p_body_B];
+	const uint32_t search_end = MIN(batches.size(), r_first_open_batch + MAX_BATCH_SEARCH);
+
+	for (uint32_t batch_index = r_first_open_batch; batch_index < search_end; batch_index++) {
+		const uint32_t lanes = batch_lanes[batch_index];
+		if (lanes == LANES) {
+			continue;
+		}
+
+		const Batch &batch = batches[batch_index];
+		bool conflict = false;
+		for (uint32_t i = 0; i < lanes && !conflict; i++) {
+			conflict = (dynamic_A && (batch.body_A[i] == p_body_A || batch.body_B[i] == p_body_A)) ||
+					(dynamic_B && (batch.body_A[i] == p_body_B || batch.body_B[i] == p_body_B));
+		}
+		if (!conflict) {
+			return batch_index;
+		}
+	}
+
+	// Unused lanes stay inactive, pointing at the empty body.
+	batches.push_back(Batch());
+	batch_lanes.push_back(0);
+	return batches.size() - 1;
+}
+
+void GodotContactSolver3D::_add_contact(Batch &r_batch, uint32_t p_lane, GodotBodyPair3D *p_pair, GodotBodyPair3D::Contact &p_contact, uint32_t p_body_A, uint32_t p_body_B) {
+	GodotBody3D *A = p_pair->A;
+	GodotBody3D *B = p_pair->B;
+
+	Basis zero_basis;
+	zero_basis.set_zero();
+
+	const Basis &inv_inertia_tensor_A = p_pair->collide_A ? A->get_inv_inertia_tensor() : zero_basis;
+	const Basis &inv_inertia_tensor_B = p_pair->collide_B ? B->get_inv_inertia_tensor() : zero_basis;
+
+	const Vector3 &rA = p_contact.rA;
+	const Vector3 &rB = p_contact.rB;
+	const Vector3 normal_angular_A = inv_inertia_tensor_A.xform(rA.cross(p_contact.normal));
+	const Vector3 normal_angular_B = inv_inertia_tensor_B.xform(rB.cross(p_contact.normal));
+	const Basis impulse_angular_A = inv_inertia_tensor_A * Basis(0, -rA.z, rA.y, rA.z, 0, -rA.x, -rA.y, rA.x, 0);
+	const Basis impulse_angular_B = inv_inertia_tensor_B * Basis(0, -rB.z, rB.y, rB.z, 0, -rB.x, -rB.y, rB.x, 0);
+
+	r_batch.body_A[p_lane] = p_body_A;
+	r_batch.body_B[p_lane] = p_body_B;
+	r_batch.contacts[p_lane] = &p_contact;
+
+	for (int axis = 0; axis < 3; axis++) {
+		r_batch.normal[axis][p_lane] = p_contact.normal[axis];
+		r_batch.rA[axis][p_lane] = rA[axis];
+		r_batch.rB[axis][p_lane] = rB[axis];
+		r_batch.normal_angular_A[axis][p_lane] = normal_angular_A[axis];
+		r_batch.normal_angular_B[axis][p_lane] = normal_angular_B[axis];
+		r_batch.acc_tangent_impulse[axis][p_lane] = p_contact.acc_tangent_impulse[axis];
+		r_batch.acc_impulse[axis][p_lane] = p_contact.acc_impulse[axis];
+		for (int column = 0; column < 3; column++) {
+			r_batch.impulse_angular_A[axis * 3 + column][p_lane] = impulse_angular_A.rows[axis][column];
+			r_batch.impulse_angular_B[axis * 3 + column][p_lane] = impulse_angular_B.rows[axis][column];
+		}
+	}
+
+	r_batch.inv_mass_A[p_lane] = p_pair->collide_A ? A->get_inv_mass() : 0.0;
+	r_batch.inv_mass_B[p_lane] = p_pair->collide_B ? B->get_inv_mass() : 0.0;
+	r_batch.normal_angular_A_length[p_lane] = normal_angular_A.length();
+	r_batch.normal_angular_B_length[p_lane] = normal_angular_B.length();
+	r_batch.mass_normal[p_lane] = p_contact.mass_normal;
+	r_batch.bias[p_lane] = p_contact.bias;
+	r_batch.bounce[p_lane] = p_contact.bounce;
+	r_batch.friction[p_lane] = combine_friction(A, B);
+
+	r_batch.acc_normal_impulse[p_lane] = p_contact.acc_normal_impulse;
+	r_batch.acc_bias_impulse[p_lane] = p_contact.acc_bias_impulse;
+	r_batch.acc_bias_impulse_center_of_mass[p_lane] = p_contact.acc_bias_impulse_center_of_mass;
+	r_batch.active[p_lane] = 1.0;
+}
+
+void GodotContactSolver3D::clear() {
+	batches.clear();
+	batch_lanes.clear();
+	bodies.clear();
+	body_dynamic.clear();
+	body_indices.clear();
+	for (int axis = 0; axis < 3; axis++) {
+		velocities.linear[axis].clear();
+		velocities.angular[axis].clear();
+		velocities.biased_linear[axis].clear();
+		velocities.biased_angular[axis].clear();
+	}
+}
+
+bool GodotContactSolver3D::setup(const LocalVector<GodotConstraint3D *> &p_constraints, real_t p_step) {
+	uint32_t contact_count = 0;
+	for (const GodotConstraint3D *constraint : p_constraints) {
+		if (!constraint->is_body_pair()) {
+			return false;
+		}
+		const GodotBodyPair3D *pair = static_cast<const GodotBodyPair3D *>(constraint);
+		for (int i = 0; i < pair->contact_count; i++) {
+			if (pair->contacts[i].active) {
+				contact_count++;
+			}
+		}
+	}
+
+	if (contact_count < MIN_CONTACTS) {
+		return false;
+	}
+
+	max_bias_angular_velocity = GodotBodyPair3D::MAX_BIAS_ROTATION / p_step;
+
+	// The empty body, for unused lanes.
+	bodies.push_back(nullptr);
+	body_dynamic.push_back(false);
+	for (int axis = 0; axis < 3; axis++) {
+		velocities.linear[axis].push_back(0.0);
+		velocities.angular[axis].push_back(0.0);
+		velocities.biased_linear[axis].push_back(0.0);
+		velocities.biased_angular[axis].push_back(0.0);
+	}
+
+	batches.reserve(contact_count / LANES + 1);
+	uint32_t first_open_batch = 0;
+
+	for (GodotConstraint3D *constraint : p_constraints) {
+		GodotBodyPair3D *pair = static_cast<GodotBodyPair3D *>(constraint);
+		if (!pair->collided) {
+			continue;
+		}
+
+		for (int i = 0; i < pair->contact_count; i++) {
+			GodotBodyPair3D::Contact &contact = pair->contacts[i];
+			if (!contact.active) {
+				continue;
+			}
+
+			const uint32_t body_A = _get_body_index(pair->A);
+			const uint32_t body_B = _get_body_index(pair->B);
+			const uint32_t batch_index = _find_batch(body_A, body_B, first_open_batch);
+			_add_contact(batches[batch_index], batch_lanes[batch_index]++, pair, contact, body_A, body_B);
+		}
+	}
+
+	return true;
+}
+
+void GodotContactSolver3D::_solve_batch(Batch &r_batch) {
+	const Real4 zero = Real4::splat(0.0);
+	const Real4 one = Real4::splat(1.0);
+	const Real4 min_velocity = Real4::splat(GodotBodyPair3D::MIN_VELOCITY);
+	const Real4 max_bias_av = Real4::splat(max_bias_angular_velocity);
+
+	Vector3x4 lv_A = gather4(velocities.linear, r_batch.body_A);
+	Vector3x4 av_A = gather4(velocities.angular, r_batch.body_A);
+	Vector3x4 blv_A = gather4(velocities.biased_linear, r_batch.body_A);
+	Vector3x4 bav_A = gather4(velocities.biased_angular, r_batch.body_A);
+	Vector3x4 lv_B = gather4(velocities.linear, r_batch.body_B);
+	Vector3x4 av_B = gather4(velocities.angular, r_batch.body_B);
+	Vector3x4 blv_B = gather4(velocities.biased_linear, r_batch.body_B);
+	Vector3x4 bav_B = gather4(velocities.biased_angular, r_batch.body_B);
+
+	const Vector3x4 normal = Vector3x4::load(r_batch.normal);
+	const Vector3x4 rA = Vector3x4::load(r_batch.rA);
+	const Vector3x4 rB = Vector3x4::load(r_batch.rB);
+	const Vector3x4 normal_angular_A = Vector3x4::load(r_batch.normal_angular_A);
+	const Vector3x4 normal_angular_B = Vector3x4::load(r_batch.normal_angular_B);
+	const Real4 inv_mass_A = Real4::load(r_batch.inv_mass_A);
+	const Real4 inv_mass_B = Real4::load(r_batch.inv_mass_B);
+	const Real4 mass_normal = Real4::load(r_batch.mass_normal);
+	const Real4 bias = Real4::load(r_batch.bias);
+
+	const Mask4 active = greater4(Real4::load(r_batch.active), zero);
+
+	// Bias impulse.
+
+	Vector3x4 dbv = blv_B + bav_B.cross(rB) - blv_A - bav_A.cross(rA);
+	Real4 vbn = dbv.dot(normal);
+
+	const Mask4 bias_mask = active & greater4(abs4(bias - vbn), min_velocity);
+	const Real4 jbn = (bias - vbn) * mass_normal;
+	const Real4 jbn_old = Real4::load(r_batch.acc_bias_impulse);
+	const Real4 acc_bias_impulse = select4(bias_mask, max4(jbn_old + jbn, zero), jbn_old);
+	const Real4 jb = acc_bias_impulse - jbn_old;
+	acc_bias_impulse.store(r_batch.acc_bias_impulse);
+
+	// The angular velocity changes are clamped like in `GodotBody3D::apply_bias_impulse()`.
+	const Real4 bav_length_A = abs4(jb) * Real4::load(r_batch.normal_angular_A_length);
+	const Real4 bav_length_B = abs4(jb) * Real4::load(r_batch.normal_angular_B_length);
+	const Real4 bav_scale_A = select4(greater4(bav_length_A, max_bias_av), max_bias_av / bav_length_A, one);
+	const Real4 bav_scale_B = select4(greater4(bav_length_B, max_bias_av), max_bias_av / bav_length_B, one);
+	blv_A = blv_A - normal * (jb * inv_mass_A);
+	bav_A = bav_A - normal_angular_A * (jb * bav_scale_A);
+	blv_B = blv_B + normal * (jb * inv_mass_B);
+	bav_B = bav_B + normal_angular_B * (jb * bav_scale_B);
+
+	dbv = blv_B + bav_B.cross(rB) - blv_A - bav_A.cross(rA);
+	vbn = dbv.dot(normal);
+
+	const Mask4 bias_com_mask = bias_mask & greater4(abs4(bias - vbn), min_velocity);
+	const Real4 jbn_com = (bias - vbn) / (inv_mass_A + inv_mass_B);
+	const Real4 jbn_com_old = Real4::load(r_batch.acc_bias_impulse_center_of_mass);
+	const Real4 acc_bias_impulse_com = select4(bias_com_mask, max4(jbn_com_old + jbn_com, zero), jbn_com_old);
+	const Real4 jb_com = acc_bias_impulse_com - jbn_com_old;
+	acc_bias_impulse_com.store(r_batch.acc_bias_impulse_center_of_mass);
+
+	blv_A = blv_A - normal * (jb_com * inv_mass_A);
+	blv_B = blv_B + normal * (jb_com * inv_mass_B);
+
+	Mask4 still_active = bias_mask;
+
+	// Normal impulse.
+
+	Vector3x4 acc_impulse = Vector3x4::load(r_batch.acc_impulse);
+
+	const Vector3x4 dv = lv_B + av_B.cross(rB) - lv_A - av_A.cross(rA);
+	const Real4 vn = dv.dot(normal);
+
+	const Mask4 normal_mask = active & greater4(abs4(vn), min_velocity);
+	const Real4 jn = (zero - (Real4::load(r_batch.bounce) + vn)) * mass_normal;
+	const Real4 jn_old = Real4::load(r_batch.acc_normal_impulse);
+	const Real4 acc_normal_impulse = select4(normal_mask, max4(jn_old + jn, zero), jn_old);
+	const Real4 j = acc_normal_impulse - jn_old;
+	acc_normal_impulse.store(r_batch.acc_normal_impulse);
+
+	lv_A = lv_A - normal * (j * inv_mass_A);
+	av_A = av_A - normal_angular_A * j;
+	lv_B = lv_B + normal * (j * inv_mass_B);
+	av_B = av_B + normal_angular_B * j;
+	acc_impulse = acc_impulse - normal * j;
+
+	still_active = still_active | normal_mask;
+
+	// Friction impulse.
+
+	const Vector3x4 dtv = lv_B + av_B.cross(rB) - lv_A - av_A.cross(rA);
+	const Real4 tn = normal.dot(dtv);
+	Vector3x4 tv = dtv - normal * tn;
+	const Real4 tvl = tv.length();
+
+	const Mask4 friction_mask = active & greater4(tvl, min_velocity);
+	tv = tv / select4(friction_mask, tvl, one);
+
+	const Vector3x4 temp1 = xform4(r_batch.impulse_angular_A, tv);
+	const Vector3x4 temp2 = xform4(r_batch.impulse_angular_B, tv);
+	const Real4 t = (zero - tvl) / (inv_mass_A + inv_mass_B + tv.dot(temp1.cross(rA) + temp2.cross(rB)));
+
+	const Vector3x4 jt_old = Vector3x4::load(r_batch.acc_tangent_impulse);
+	Vector3x4 acc_tangent_impulse = jt_old + tv * t;
+	const Real4 fi_len = acc_tangent_impulse.length();
+	const Real4 jt_max = acc_normal_impulse * Real4::load(r_batch.friction);
+	const Mask4 friction_limit = greater4(fi_len, Real4::splat(CMP_EPSILON)) & greater4(fi_len, jt_max);
+	acc_tangent_impulse = acc_tangent_impulse * select4(friction_limit, jt_max / fi_len, one);
+	acc_tangent_impulse = select4(friction_mask, acc_tangent_impulse, jt_old);
+	const Vector3x4 jt = acc_tangent_impulse - jt_old;
+	acc_tangent_impulse.store(r_batch.acc_tangent_impulse);
+
+	lv_A = lv_A - jt * inv_mass_A;
+	av_A = av_A - xform4(r_batch.impulse_angular_A, jt);
+	lv_B = lv_B + jt * inv_mass_B;
+	av_B = av_B + xform4(r_batch.impulse_angular_B, jt);
+	acc_impulse = acc_impulse - jt;
+	acc_impulse.store(r_batch.acc_impulse);
+
+	still_active = still_active | friction_mask;
+	select4(still_active, one, zero).store(r_batch.active);
+
+	// Bodies are only once in a batch, so each lane writes different ones. A is written first so that
+	// the B side wins for the empty body, which is never read as a dynamic body anyway.
+	scatter4(velocities.linear, r_batch.body_A, body_dynamic, lv_A);
+	scatter4(velocities.angular, r_batch.body_A, body_dynamic, av_A);
+	scatter4(velocities.biased_linear, r_batch.body_A, body_dynamic, blv_A);
+	scatter4(velocities.biased_angular, r_batch.body_A, body_dynamic, bav_A);
+	scatter4(velocities.linear, r_batch.body_B, body_dynamic, lv_B);
+	scatter4(velocities.angular, r_batch.body_B, body_dynamic, av_B);
+	scatter4(velocities.biased_linear, r_batch.body_B, body_dynamic, blv_B);
+	scatter4(velocities.biased_angular, r_batch.body_B, body_dynamic, bav_B);
+}
+
+void GodotContactSolver3D::solve() {
+	for (Batch &batch : batches) {
+		_solve_batch(batch);
+	}
+}
+
+void GodotContactSolver3D::finish() {
+	for (const Batch &batch : batches) {
+		for (int i = 0; i < LANES; i++) {
+			GodotBodyPair3D::Contact *contact = batch.contacts[i];
+			if (!contact) {
+				continue;
+			}
+
+			contact->acc_normal_impulse = batch.acc_normal_impulse[i];
+			contact->acc_bias_impulse = batch.acc_bias_impulse[i];
+			contact->acc_bias_impulse_center_of_mass = batch.acc_bias_impulse_center_of_mass[i];
+			for (int axis = 0; axis < 3; axis++) {
+				contact->acc_tangent_impulse[axis] = batch.acc_tangent_impulse[axis][i];
+				contact->acc_impulse[axis] = batch.acc_impulse[axis][i];
+			}
+			contact->active = batch.active[i] > 0.0;
+		}
+	}
+
+	for (uint32_t i = 1; i < bodies.size(); i++) {
+		if (!body_dynamic[i]) {
+			continue;
+		}
+
+		GodotBody3D *body = bodies[i];
+		body->set_linear_velocity(Vector3(velocities.linear[0][i], velocities.linear[1][i], velocities.linear[2][i]));
+		body->set_angular_velocity(Vector3(velocities.angular[0][i], velocities.angular[1][i], velocities.angular[2][i]));
+		body->set_biased_linear_velocity(Vector3(velocities.biased_linear[0][i], velocities.biased_linear[1][i], velocities.biased_linear[2][i]));
+		body->set_biased_angular_velocity(Vector3(velocities.biased_angular[0][i], velocities.biased_angular[1][i], velocities.biased_angular[2][i]));
+	}
+}
@@ -0,0 +1,124 @@
+/**************************************************************************/
+/*  godot_contact_solver_3d.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GODOT_CONTACT_SOLVER_3D_H
+#define GODOT_CONTACT_SOLVER_3D_H
+
+#include "godot_body_pair_3d.h"
+
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+// Solves the contacts of an island made of rigid body pairs only, several contacts at a time.
+// Contacts are packed in batches of LANES, in structure of arrays, where no rigid body appears twice so
+// their impulses can be applied at once. Each contact goes through the same sequential impulse steps
+// as in GodotBodyPair3D::solve(), but the order in which contacts are visited within an iteration
+// differs, as each batch is filled with the first contacts that don't share a body.
+class GodotContactSolver3D {
+public:
+	enum {
+		LANES = 4,
+		// Smaller islands are solved one contact at a time, as packing them costs more than it saves.
+		MIN_CONTACTS = 16,
+	};
+
+private:
+	enum {
+		// How many batches with free lanes are tried before opening a new one.
+		MAX_BATCH_SEARCH = 16,
+	};
+
+	struct Batch {
+		// Indices in the body arrays, unused lanes point at the empty body 0.
+		uint32_t body_A[LANES];
+		uint32_t body_B[LANES];
+		GodotBodyPair3D::Contact *contacts[LANES];
+
+		real_t normal[3][LANES];
+		real_t rA[3][LANES];
+		real_t rB[3][LANES];
+		real_t inv_mass_A[LANES];
+		real_t inv_mass_B[LANES];
+		// Angular velocity change of a unit impulse along the normal, and its length.
+		real_t normal_angular_A[3][LANES];
+		real_t normal_angular_B[3][LANES];
+		real_t normal_angular_A_length[LANES];
+		real_t normal_angular_B_length[LANES];
+		// Inverse inertia tensor times the cross product matrix of rA and rB, row by row, giving the
+		// angular velocity change of any impulse.
+		real_t impulse_angular_A[9][LANES];
+		real_t impulse_angular_B[9][LANES];
+		real_t mass_normal[LANES];
+		real_t bias[LANES];
+		real_t bounce[LANES];
+		real_t friction[LANES];
+
+		real_t acc_normal_impulse[LANES];
+		real_t acc_bias_impulse[LANES];
+		real_t acc_bias_impulse_center_of_mass[LANES];
+		real_t acc_tangent_impulse[3][LANES];
+		real_t acc_impulse[3][LANES];
+		real_t active[LANES]; // 1 or 0.
+	};
+
+	// Velocities of the bodies, in structure of arrays.
+	struct BodyVelocities {
+		LocalVector<real_t> linear[3];
+		LocalVector<real_t> angular[3];
+		LocalVector<real_t> biased_linear[3];
+		LocalVector<real_t> biased_angular[3];
+	};
+
+	LocalVector<Batch> batches;
+	LocalVector<uint32_t> batch_lanes; // Used lanes of each batch, while packing.
+	LocalVector<GodotBody3D *> bodies; // Body 0 is empty, for unused lanes.
+	LocalVector<bool> body_dynamic; // Only dynamic bodies receive impulses and can't be twice in a batch.
+	HashMap<GodotBody3D *, uint32_t> body_indices;
+	BodyVelocities velocities;
+	real_t max_bias_angular_velocity = 0.0;
+
+	uint32_t _get_body_index(GodotBody3D *p_body);
+	uint32_t _find_batch(uint32_t p_body_A, uint32_t p_body_B, uint32_t &r_first_open_batch);
+	void _add_contact(Batch &r_batch, uint32_t p_lane, GodotBodyPair3D *p_pair, GodotBodyPair3D::Contact &p_contact, uint32_t p_body_A, uint32_t p_body_B);
+	void _solve_batch(Batch &r_batch);
+
+public:
+	// Forgets the last island but keeps the allocations, so a solver can be reused every step.
+	void clear();
+	// Returns false without changing anything when the island has other constraints or too few contacts,
+	// otherwise packs its active contacts, which must have been pre-solved.
+	bool setup(const LocalVector<GodotConstraint3D *> &p_constraints, real_t p_step);
+	// One iteration over all the contacts.
+	void solve();
+	// Writes the accumulated impulses and the velocities back to the pairs and the bodies.
+	void finish();
+};
+
+#endif // GODOT_CONTACT_SOLVER_3D_H
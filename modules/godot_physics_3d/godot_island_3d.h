@@ -0,0 +1,55 @@
+/**************************************************************************/
+/*  godot_island_3d.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GODOT_ISLAND_3D_H
+#define GODOT_ISLAND_3D_H
+
+#include "core/templates/local_vector.h"
+
+class GodotBody3D;
+class GodotConstraint3D;
+
+// Bodies and constraints connected together, kept between steps while none of them changes so the
+// island doesn't need to be populated again. Owned by its members, freed when the last one leaves.
+class GodotIsland3D {
+public:
+	// Non-static bodies of the island, including kinematic ones.
+	LocalVector<GodotBody3D *> members;
+	// Rigid bodies, which sleep and wake up together.
+	LocalVector<GodotBody3D *> bodies;
+	LocalVector<GodotConstraint3D *> constraints;
+
+	// Bodies still pointing at this island.
+	uint32_t member_count = 0;
+	// Cleared when a member gains or loses a constraint, or changes mode or space.
+	bool valid = true;
+};
+
+#endif // GODOT_ISLAND_3D_H
@@ -34,11 +34,12 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
 
-_FORCE_INLINE_ static bool _can_collide_with(GodotCollisionObject3D *p_object, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+_FORCE_INLINE_ static bool _can_collide_with(const GodotCollisionObject3D *p_object, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 	if (!(p_object->get_collision_layer() & p_collision_mask)) {
 		return false;
 	}
@@ -105,18 +106,12 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V(space->locked, false);
-
-	Vector3 begin, end;
+// Keeps the closest hit of a ray among the broadphase candidates, for single and batched ray queries.
+struct GodotRayQuery3D {
+	const PhysicsDirectSpaceState3D::RayParameters &parameters;
+	Vector3 begin;
+	Vector3 end;
 	Vector3 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
-	normal = (end - begin).normalized();
-
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-
-	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
 	bool collided = false;
 	Vector3 res_point, res_normal;
@@ -125,50 +120,51 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	const GodotCollisionObject3D *res_obj = nullptr;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
-			continue;
-		}
+	GodotRayQuery3D(const PhysicsDirectSpaceState3D::RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to) :
+			parameters(p_parameters), begin(p_from), end(p_to), normal((p_to - p_from).normalized()) {}
 
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
-			continue;
+	// Returns false once the remaining candidates don't matter anymore.
+	bool test(const GodotCollisionObject3D *p_object, int p_shape_idx) {
+		if (!_can_collide_with(p_object, parameters.collision_mask, parameters.collide_with_bodies, parameters.collide_with_areas)) {
+			return true;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
-			continue;
+		if (parameters.pick_ray && !(p_object->is_ray_pickable())) {
+			return true;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		if (parameters.exclude.has(p_object->get_self())) {
+			return true;
+		}
 
-		int shape_idx = space->intersection_query_subindex_results[i];
-		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
+		Transform3D inv_xform = p_object->get_shape_inv_transform(p_shape_idx) * p_object->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
 		Vector3 local_to = inv_xform.xform(end);
 
-		const GodotShape3D *shape = col_obj->get_shape(shape_idx);
+		const GodotShape3D *shape = p_object->get_shape(p_shape_idx);
 
 		Vector3 shape_point, shape_normal;
 		int shape_face_index = -1;
 
 		if (shape->intersect_point(local_from)) {
-			if (p_parameters.hit_from_inside) {
+			if (parameters.hit_from_inside) {
 				// Hit shape at starting point.
 				min_d = 0;
 				res_point = begin;
 				res_normal = Vector3();
-				res_shape = shape_idx;
-				res_obj = col_obj;
+				res_shape = p_shape_idx;
+				res_obj = p_object;
 				collided = true;
-				break;
+				return false;
 			} else {
 				// Ignore shape when starting inside.
-				continue;
+				return true;
 			}
 		}
 
-		if (shape->intersect_segment(local_from, local_to, shape_point, shape_normal, shape_face_index, p_parameters.hit_back_faces)) {
-			Transform3D xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
+		if (shape->intersect_segment(local_from, local_to, shape_point, shape_normal, shape_face_index, parameters.hit_back_faces)) {
+			Transform3D xform = p_object->get_transform() * p_object->get_shape_transform(p_shape_idx);
 			shape_point = xform.xform(shape_point);
 
 			real_t ld = normal.dot(shape_point);
@@ -178,29 +174,81 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 				res_point = shape_point;
 				res_normal = inv_xform.basis.xform_inv(shape_normal).normalized();
 				res_face_index = shape_face_index;
-				res_shape = shape_idx;
-				res_obj = col_obj;
+				res_shape = p_shape_idx;
+				res_obj = p_object;
 				collided = true;
 			}
 		}
+
+		return true;
+	}
+
+	bool get_result(PhysicsDirectSpaceState3D::RayResult &r_result) const {
+		if (!collided) {
+			return false;
+		}
+		ERR_FAIL_NULL_V(res_obj, false); // Shouldn't happen but silences warning.
+
+		r_result.collider_id = res_obj->get_instance_id();
+		if (r_result.collider_id.is_valid()) {
+			r_result.collider = ObjectDB::get_instance(r_result.collider_id);
+		} else {
+			r_result.collider = nullptr;
+		}
+		r_result.normal = res_normal;
+		r_result.face_index = res_face_index;
+		r_result.position = res_point;
+		r_result.rid = res_obj->get_self();
+		r_result.shape = res_shape;
+
+		return true;
+	}
+};
+
+bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
+
+	GodotRayQuery3D query(p_parameters, p_parameters.from, p_parameters.to);
+
+	int amount = space->broadphase->cull_segment(query.begin, query.end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
+
+	for (int i = 0; i < amount; i++) {
+		if (!query.test(space->intersection_query_results[i], space->intersection_query_subindex_results[i])) {
+			break;
+		}
 	}
 
-	if (!collided) {
+	return query.get_result(r_result);
+}
+
+// Tests one broadphase candidate of a shape query, filling r_result (if any) when they overlap.
+static bool _intersect_shape_candidate(const PhysicsDirectSpaceState3D::ShapeParameters &p_parameters, const GodotShape3D *p_shape, const Transform3D &p_transform, const GodotCollisionObject3D *p_object, int p_shape_idx, PhysicsDirectSpaceState3D::ShapeResult *r_result) {
+	if (!_can_collide_with(p_object, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 		return false;
 	}
-	ERR_FAIL_NULL_V(res_obj, false); // Shouldn't happen but silences warning.
 
-	r_result.collider_id = res_obj->get_instance_id();
-	if (r_result.collider_id.is_valid()) {
-		r_result.collider = ObjectDB::get_instance(r_result.collider_id);
-	} else {
-		r_result.collider = nullptr;
+	//area can't be picked by ray (default)
+
+	if (p_parameters.exclude.has(p_object->get_self())) {
+		return false;
+	}
+
+	if (!GodotCollisionSolver3D::solve_static(p_shape, p_transform, p_object->get_shape(p_shape_idx), p_object->get_transform() * p_object->get_shape_transform(p_shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
+		return false;
+	}
+
+	if (r_result) {
+		r_result->collider_id = p_object->get_instance_id();
+		if (r_result->collider_id.is_valid()) {
+			r_result->collider = ObjectDB::get_instance(r_result->collider_id);
+		} else {
+			r_result->collider = nullptr;
+		}
+		r_result->rid = p_object->get_self();
+		r_result->shape = p_shape_idx;
 	}
-	r_result.normal = res_normal;
-	r_result.face_index = res_face_index;
-	r_result.position = res_point;
-	r_result.rid = res_obj->get_self();
-	r_result.shape = res_shape;
 
 	return true;
 }
@@ -226,38 +274,232 @@ int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_par
 			break;
 		}
 
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
-			continue;
+		if (_intersect_shape_candidate(p_parameters, shape, p_parameters.transform, space->intersection_query_results[i], space->intersection_query_subindex_results[i], r_results ? &r_results[cc] : nullptr)) {
+			cc++;
 		}
+	}
 
-		//area can't be picked by ray (default)
+	return cc;
+}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
-			continue;
+struct GodotQuerySortKey3D {
+	uint32_t key = 0;
+	uint32_t index = 0;
+
+	bool operator<(const GodotQuerySortKey3D &p_other) const {
+		return key < p_other.key;
+	}
+};
+
+// Spreads the lower 10 bits of p_value so that there are two zero bits between each of them.
+static _FORCE_INLINE_ uint32_t _morton_spread_bits(uint32_t p_value) {
+	p_value &= 0x3FF;
+	p_value = (p_value | (p_value << 16)) & 0x030000FF;
+	p_value = (p_value | (p_value << 8)) & 0x0300F00F;
+	p_value = (p_value | (p_value << 4)) & 0x030C30C3;
+	p_value = (p_value | (p_value << 2)) & 0x09249249;
+	return p_value;
+}
+
+// Orders batched queries along a Z-order curve over their bounds, so that each packet holds queries
+// close to each other, which mostly walk down the same branches of the broadphase.
+// The midpoint of p_points_a and p_points_b is used when the latter is given.
+static void _sort_queries_spatially(const Vector3 *p_points_a, const Vector3 *p_points_b, int p_count, uint32_t p_packet_size, LocalVector<uint32_t> &r_order) {
+	r_order.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		r_order[i] = i;
+	}
+
+	if (uint32_t(p_count) <= p_packet_size) {
+		return;
+	}
+
+	// The temporaries below come from the frame arena, which is given back on the way out,
+	// as queries can also be made from threads that never rewind it otherwise.
+	const uint64_t frame_arena_mark = FrameAllocator::get_mark();
+	{
+		FrameLocalVector<Vector3> points;
+		points.resize(p_count);
+		AABB bounds;
+		for (int i = 0; i < p_count; i++) {
+			points[i] = p_points_b ? (p_points_a[i] + p_points_b[i]) * 0.5 : p_points_a[i];
+			if (i == 0) {
+				bounds.position = points[i];
+			} else {
+				bounds.expand_to(points[i]);
+			}
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		Vector3 scale;
+		for (int axis = 0; axis < 3; axis++) {
+			scale[axis] = bounds.size[axis] > CMP_EPSILON ? 1023.0 / bounds.size[axis] : 0.0;
+		}
 
-		if (!GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
-			continue;
+		FrameLocalVector<GodotQuerySortKey3D> keys;
+		keys.resize(p_count);
+		for (int i = 0; i < p_count; i++) {
+			Vector3 cell = (points[i] - bounds.position) * scale;
+			keys[i].key = _morton_spread_bits(uint32_t(cell.x)) | (_morton_spread_bits(uint32_t(cell.y)) << 1) | (_morton_spread_bits(uint32_t(cell.z)) << 2);
+			keys[i].index = i;
 		}
+		keys.sort();
 
-		if (r_results) {
-			r_results[cc].collider_id = col_obj->get_instance_id();
-			if (r_results[cc].collider_id.is_valid()) {
-				r_results[cc].collider = ObjectDB::get_instance(r_results[cc].collider_id);
-			} else {
-				r_results[cc].collider = nullptr;
+		for (int i = 0; i < p_count; i++) {
+			r_order[i] = keys[i].index;
+		}
+	}
+	FrameAllocator::rewind(frame_arena_mark);
+}
+
+// Sorts the hits of a packet by query, keeping the broadphase order within each query.
+// r_offsets receives where the hits of each query start, plus the end of the last one.
+static void _sort_packet_hits(const LocalVector<GodotBroadPhase3D::CullHit> &p_hits, uint32_t p_query_count, LocalVector<GodotBroadPhase3D::CullHit> &r_sorted, uint32_t *r_offsets) {
+	for (uint32_t i = 0; i <= p_query_count; i++) {
+		r_offsets[i] = 0;
+	}
+	for (const GodotBroadPhase3D::CullHit &hit : p_hits) {
+		r_offsets[hit.query]++;
+	}
+	for (uint32_t i = 1; i <= p_query_count; i++) {
+		r_offsets[i] += r_offsets[i - 1];
+	}
+
+	// Filling backwards from the end of each query leaves the offsets at their start.
+	r_sorted.resize(p_hits.size());
+	for (int64_t i = int64_t(p_hits.size()) - 1; i >= 0; i--) {
+		r_sorted[--r_offsets[p_hits[i].query]] = p_hits[i];
+	}
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_ray_packet(uint32_t p_packet, RayBatch *p_batch) {
+	const uint32_t first = p_packet * QUERY_PACKET_SIZE;
+	const uint32_t count = MIN(QUERY_PACKET_SIZE, p_batch->order.size() - first);
+
+	Vector3 from[QUERY_PACKET_SIZE];
+	Vector3 to[QUERY_PACKET_SIZE];
+	for (uint32_t i = 0; i < count; i++) {
+		const uint32_t index = p_batch->order[first + i];
+		from[i] = p_batch->from[index];
+		to[i] = p_batch->to[index];
+	}
+
+	LocalVector<GodotBroadPhase3D::CullHit> hits;
+	space->broadphase->cull_segments(from, to, count, hits);
+
+	LocalVector<GodotBroadPhase3D::CullHit> sorted_hits;
+	uint32_t offsets[QUERY_PACKET_SIZE + 1];
+	_sort_packet_hits(hits, count, sorted_hits, offsets);
+
+	for (uint32_t i = 0; i < count; i++) {
+		GodotRayQuery3D query(*p_batch->parameters, from[i], to[i]);
+		for (uint32_t j = offsets[i]; j < offsets[i + 1]; j++) {
+			if (!query.test(sorted_hits[j].object, sorted_hits[j].subindex)) {
+				break;
 			}
-			r_results[cc].rid = col_obj->get_self();
-			r_results[cc].shape = shape_idx;
 		}
 
-		cc++;
+		RayResult &result = p_batch->results[p_batch->order[first + i]];
+		result = RayResult();
+		query.get_result(result);
 	}
+}
 
-	return cc;
+int GodotPhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results) {
+	ERR_FAIL_COND_V(space->locked, 0);
+	if (p_count <= 0) {
+		return 0;
+	}
+
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.results = r_results;
+	_sort_queries_spatially(p_from, p_to, p_count, QUERY_PACKET_SIZE, batch.order);
+
+	const uint32_t packet_count = (uint32_t(p_count) + QUERY_PACKET_SIZE - 1) / QUERY_PACKET_SIZE;
+	if (packet_count == 1) {
+		_intersect_ray_packet(0, &batch);
+	} else {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_ray_packet, &batch, packet_count, -1, true, SNAME("Physics3DIntersectRays"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	int hit_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		if (r_results[i].rid.is_valid()) {
+			hit_count++;
+		}
+	}
+
+	return hit_count;
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_shape_packet(uint32_t p_packet, ShapeBatch *p_batch) {
+	const uint32_t first = p_packet * QUERY_PACKET_SIZE;
+	const uint32_t count = MIN(QUERY_PACKET_SIZE, p_batch->order.size() - first);
+
+	AABB aabbs[QUERY_PACKET_SIZE];
+	for (uint32_t i = 0; i < count; i++) {
+		aabbs[i] = p_batch->local_aabb;
+		aabbs[i].position += p_batch->origins[p_batch->order[first + i]];
+	}
+
+	LocalVector<GodotBroadPhase3D::CullHit> hits;
+	space->broadphase->cull_aabbs(aabbs, count, hits);
+
+	LocalVector<GodotBroadPhase3D::CullHit> sorted_hits;
+	uint32_t offsets[QUERY_PACKET_SIZE + 1];
+	_sort_packet_hits(hits, count, sorted_hits, offsets);
+
+	for (uint32_t i = 0; i < count; i++) {
+		const uint32_t index = p_batch->order[first + i];
+		Transform3D transform = p_batch->parameters->transform;
+		transform.origin = p_batch->origins[index];
+
+		ShapeResult *results = &p_batch->results[index * p_batch->result_max];
+		int cc = 0;
+		for (uint32_t j = offsets[i]; j < offsets[i + 1] && cc < p_batch->result_max; j++) {
+			if (_intersect_shape_candidate(*p_batch->parameters, p_batch->shape, transform, sorted_hits[j].object, sorted_hits[j].subindex, &results[cc])) {
+				cc++;
+			}
+		}
+		p_batch->result_counts[index] = cc;
+	}
+}
+
+void GodotPhysicsDirectSpaceState3D::intersect_shapes(const ShapeParameters &p_parameters, const Vector3 *p_origins, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) {
+	ERR_FAIL_COND(space->locked);
+	if (p_count <= 0) {
+		return;
+	}
+	if (p_result_max <= 0) {
+		for (int i = 0; i < p_count; i++) {
+			r_result_counts[i] = 0;
+		}
+		return;
+	}
+
+	const GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL(shape);
+
+	ShapeBatch batch;
+	batch.parameters = &p_parameters;
+	batch.shape = shape;
+	batch.local_aabb = Transform3D(p_parameters.transform.basis, Vector3()).xform(shape->get_aabb());
+	batch.origins = p_origins;
+	batch.results = r_results;
+	batch.result_max = p_result_max;
+	batch.result_counts = r_result_counts;
+	_sort_queries_spatially(p_origins, nullptr, p_count, QUERY_PACKET_SIZE, batch.order);
+
+	const uint32_t packet_count = (uint32_t(p_count) + QUERY_PACKET_SIZE - 1) / QUERY_PACKET_SIZE;
+	if (packet_count == 1) {
+		_intersect_shape_packet(0, &batch);
+	} else {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_shape_packet, &batch, packet_count, -1, true, SNAME("Physics3DIntersectShapes"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
 }
 
 bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) {
@@ -1262,6 +1504,7 @@ GodotSpace3D::GodotSpace3D() {
 	contact_max_separation = GLOBAL_GET("physics/3d/solver/contact_max_separation");
 	contact_max_allowed_penetration = GLOBAL_GET("physics/3d/solver/contact_max_allowed_penetration");
 	contact_bias = GLOBAL_GET("physics/3d/solver/default_contact_bias");
+	batch_contacts = GLOBAL_GET("physics/3d/solver/batch_contacts");
 
 	broadphase = GodotBroadPhase3D::create_func();
 	broadphase->set_pair_callback(_broadphase_pair, this);
@@ -46,6 +46,32 @@
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	// Batched queries are sorted so that nearby ones follow each other, then culled together in
+	// packets of this many, which are spread over the worker threads.
+	static constexpr uint32_t QUERY_PACKET_SIZE = 32;
+
+	struct RayBatch {
+		const RayParameters *parameters = nullptr;
+		const Vector3 *from = nullptr;
+		const Vector3 *to = nullptr;
+		RayResult *results = nullptr;
+		LocalVector<uint32_t> order;
+	};
+
+	struct ShapeBatch {
+		const ShapeParameters *parameters = nullptr;
+		const GodotShape3D *shape = nullptr;
+		AABB local_aabb;
+		const Vector3 *origins = nullptr;
+		ShapeResult *results = nullptr;
+		int result_max = 0;
+		int *result_counts = nullptr;
+		LocalVector<uint32_t> order;
+	};
+
+	void _intersect_ray_packet(uint32_t p_packet, RayBatch *p_batch);
+	void _intersect_shape_packet(uint32_t p_packet, ShapeBatch *p_batch);
+
 public:
 	GodotSpace3D *space = nullptr;
 
@@ -57,6 +83,9 @@ public:
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
 	virtual Vector3 get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const override;
 
+	virtual int intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results) override;
+	virtual void intersect_shapes(const ShapeParameters &p_parameters, const Vector3 *p_origins, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) override;
+
 	GodotPhysicsDirectSpaceState3D();
 };
 
@@ -99,6 +128,7 @@ private:
 	real_t contact_max_separation = 0.0;
 	real_t contact_max_allowed_penetration = 0.0;
 	real_t contact_bias = 0.0;
+	bool batch_contacts = false;
 
 	enum {
 		INTERSECTION_QUERY_MAX = 2048
@@ -165,6 +195,7 @@ public:
 	_FORCE_INLINE_ real_t get_contact_max_separation() const { return contact_max_separation; }
 	_FORCE_INLINE_ real_t get_contact_max_allowed_penetration() const { return contact_max_allowed_penetration; }
 	_FORCE_INLINE_ real_t get_contact_bias() const { return contact_bias; }
+	_FORCE_INLINE_ bool is_batch_contacts_enabled() const { return batch_contacts; }
 	_FORCE_INLINE_ real_t get_body_linear_velocity_sleep_threshold() const { return body_linear_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_angular_velocity_sleep_threshold() const { return body_angular_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_time_to_sleep() const { return body_time_to_sleep; }
@@ -43,6 +43,7 @@
 
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
+	island_members.push_back(p_body);
 
 	if (p_body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
 		// Only rigid bodies are tested for activation.
@@ -52,6 +53,10 @@ void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D
 	for (const KeyValue<GodotConstraint3D *, int> &E : p_body->get_constraint_map()) {
 		GodotConstraint3D *constraint = const_cast<GodotConstraint3D *>(E.key);
 		if (constraint->get_island_step() == _step) {
+			if (constraint->get_body_count() == 0) {
+				// Area pairs are only reached from their body, this one was taken by a moving area.
+				island_area_constraints.push_back(constraint);
+			}
 			continue; // Already processed.
 		}
 		constraint->set_island_step(_step);
@@ -87,6 +92,7 @@ void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D
 
 void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_soft_body->set_island_step(_step);
+	island_has_soft_bodies = true;
 
 	for (const GodotConstraint3D *E : p_soft_body->get_constraints()) {
 		GodotConstraint3D *constraint = const_cast<GodotConstraint3D *>(E);
@@ -112,6 +118,52 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 	}
 }
 
+void GodotStep3D::_build_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
+	island_members.clear();
+	island_area_constraints.clear();
+	island_has_soft_bodies = false;
+
+	_populate_island(p_body, p_body_island, p_constraint_island);
+
+	if (island_has_soft_bodies) {
+		// Soft body constraints aren't tracked, so these islands are populated again every step.
+		for (GodotBody3D *body : island_members) {
+			body->set_island(nullptr);
+		}
+		return;
+	}
+
+	GodotIsland3D *island = memnew(GodotIsland3D);
+	island->members = island_members;
+	island->bodies = p_body_island;
+	island->constraints = p_constraint_island;
+	for (GodotConstraint3D *constraint : island_area_constraints) {
+		island->constraints.push_back(constraint);
+	}
+
+	for (GodotBody3D *body : island_members) {
+		body->set_island(island);
+	}
+}
+
+void GodotStep3D::_reuse_island(const GodotIsland3D *p_island, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
+	for (GodotBody3D *body : p_island->members) {
+		body->set_island_step(_step);
+	}
+
+	p_body_island = p_island->bodies;
+
+	for (GodotConstraint3D *constraint : p_island->constraints) {
+		if (constraint->get_island_step() == _step) {
+			continue; // Taken by a moving area.
+		}
+		constraint->set_island_step(_step);
+		p_constraint_island.push_back(constraint);
+
+		all_constraints.push_back(constraint);
+	}
+}
+
 void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
@@ -133,6 +185,19 @@ void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constrai
 void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
 
+	if (batch_contacts) {
+		// Body pairs all have the lowest priority, so they are only solved in the first round.
+		GodotContactSolver3D &contact_solver = contact_solvers[p_island_index];
+		contact_solver.clear();
+		if (contact_solver.setup(constraint_island, delta)) {
+			for (int i = 0; i < iterations; i++) {
+				contact_solver.solve();
+			}
+			contact_solver.finish();
+			return;
+		}
+	}
+
 	int current_priority = 1;
 
 	uint32_t constraint_count = constraint_island.size();
@@ -190,6 +255,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	p_space->set_last_step(p_delta);
 
 	iterations = p_space->get_solver_iterations();
+	batch_contacts = p_space->is_batch_contacts_enabled();
 	delta = p_delta;
 
 	const SelfList<GodotBody3D>::List *body_list = &p_space->get_active_body_list();
@@ -284,7 +350,13 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 			constraint_island.clear();
 			constraint_island.reserve(ISLAND_SIZE_RESERVE);
 
-			_populate_island(body, body_island, constraint_island);
+			// Islands are only populated again when their bodies or constraints changed.
+			GodotIsland3D *island = body->get_island();
+			if (island && island->valid) {
+				_reuse_island(island, body_island, constraint_island);
+			} else {
+				_build_island(body, body_island, constraint_island);
+			}
 
 			if (body_island.is_empty()) {
 				--body_island_count;
@@ -362,6 +434,10 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
+	if (batch_contacts && contact_solvers.size() < island_count) {
+		contact_solvers.resize(island_count);
+	}
+
 	// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
 	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
@@ -403,6 +479,8 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	}
 
 	all_constraints.clear();
+	island_members.clear();
+	island_area_constraints.clear();
 
 	p_space->unlock();
 	_step++;
@@ -31,6 +31,7 @@
 #ifndef GODOT_STEP_3D_H
 #define GODOT_STEP_3D_H
 
+#include "godot_contact_solver_3d.h"
 #include "godot_space_3d.h"
 
 #include "core/templates/local_vector.h"
@@ -39,14 +40,23 @@ class GodotStep3D {
 	uint64_t _step = 1;
 
 	int iterations = 0;
+	bool batch_contacts = false;
 	real_t delta = 0.0;
 
 	LocalVector<LocalVector<GodotBody3D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
+	LocalVector<GodotContactSolver3D> contact_solvers; // One per island, kept to reuse their allocations.
 	LocalVector<GodotConstraint3D *> all_constraints;
 
+	// Gathered while populating an island, to keep it for the next steps.
+	LocalVector<GodotBody3D *> island_members;
+	LocalVector<GodotConstraint3D *> island_area_constraints;
+	bool island_has_soft_bodies = false;
+
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _build_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _reuse_island(const GodotIsland3D *p_island, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
@@ -145,6 +145,8 @@ def configure(env: "SConsEnvironment"):
     if env["use_safe_heap"]:
         env.Append(LINKFLAGS=["-sSAFE_HEAP=1"])
 
+    env.Append(CCFLAGS=["-ffp-contract=off"])
+
     # Closure compiler
     if env["use_closure_compiler"]:
         # For emscripten support code.
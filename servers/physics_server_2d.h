@@ -276,6 +276,9 @@ public:
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	// Hash of the state of the bodies, to detect when simulations diverge.
+	virtual uint64_t space_get_state_hash(RID p_space) const { return 0; }
+
 	//missing space parameters
 
 	/* AREA API */
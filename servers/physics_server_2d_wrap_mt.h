@@ -123,6 +123,11 @@ public:
 		return physics_server_2d->space_get_contact_count(p_space);
 	}
 
+	virtual uint64_t space_get_state_hash(RID p_space) const override {
+		ERR_FAIL_COND_V(!Thread::is_main_thread(), 0);
+		return physics_server_2d->space_get_state_hash(p_space);
+	}
+
 	/* AREA API */
 
 	//FUNC0RID(area);
@@ -476,6 +476,97 @@ Dictionary PhysicsDirectSpaceState3D::_get_rest_info(const Ref<PhysicsShapeQuery
 	return r;
 }
 
+Dictionary PhysicsDirectSpaceState3D::_intersect_rays(const Vector<Vector3> &p_from, const Vector<Vector3> &p_to, const Ref<PhysicsRayQueryParameters3D> &p_ray_query) {
+	ERR_FAIL_COND_V(!p_ray_query.is_valid(), Dictionary());
+	ERR_FAIL_COND_V_MSG(p_from.size() != p_to.size(), Dictionary(), "The arrays of ray starts and ends must have the same size.");
+
+	const int count = p_from.size();
+	Vector<RayResult> results;
+	results.resize(count);
+	intersect_rays(p_ray_query->get_parameters(), p_from.ptr(), p_to.ptr(), count, results.ptrw());
+
+	PackedVector3Array positions;
+	PackedVector3Array normals;
+	PackedInt64Array collider_ids;
+	PackedInt32Array shapes;
+	PackedInt32Array face_indices;
+	positions.resize(count);
+	normals.resize(count);
+	collider_ids.resize(count);
+	shapes.resize(count);
+	face_indices.resize(count);
+
+	for (int i = 0; i < count; i++) {
+		const RayResult &result = results[i];
+		const bool hit = result.rid.is_valid();
+		positions.write[i] = result.position;
+		normals.write[i] = result.normal;
+		collider_ids.write[i] = hit ? (int64_t)result.collider_id : 0;
+		shapes.write[i] = hit ? result.shape : -1;
+		face_indices.write[i] = hit ? result.face_index : -1;
+	}
+
+	Dictionary d;
+	d["position"] = positions;
+	d["normal"] = normals;
+	d["collider_id"] = collider_ids;
+	d["shape"] = shapes;
+	d["face_index"] = face_indices;
+	return d;
+}
+
+Dictionary PhysicsDirectSpaceState3D::_intersect_shapes(const Vector<Vector3> &p_origins, const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results) {
+	ERR_FAIL_COND_V(!p_shape_query.is_valid(), Dictionary());
+	ERR_FAIL_COND_V(p_max_results <= 0, Dictionary());
+
+	const int count = p_origins.size();
+	Vector<ShapeResult> results;
+	results.resize(count * p_max_results);
+	Vector<int> result_counts;
+	result_counts.resize(count);
+	intersect_shapes(p_shape_query->get_parameters(), p_origins.ptr(), count, results.ptrw(), p_max_results, result_counts.ptrw());
+
+	PackedInt32Array queries;
+	PackedInt64Array collider_ids;
+	PackedInt32Array shapes;
+	for (int i = 0; i < count; i++) {
+		for (int j = 0; j < result_counts[i]; j++) {
+			const ShapeResult &result = results[i * p_max_results + j];
+			queries.push_back(i);
+			collider_ids.push_back((int64_t)result.collider_id);
+			shapes.push_back(result.shape);
+		}
+	}
+
+	Dictionary d;
+	d["query"] = queries;
+	d["collider_id"] = collider_ids;
+	d["shape"] = shapes;
+	return d;
+}
+
+int PhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results) {
+	RayParameters parameters = p_parameters;
+	int hits = 0;
+	for (int i = 0; i < p_count; i++) {
+		parameters.from = p_from[i];
+		parameters.to = p_to[i];
+		r_results[i] = RayResult();
+		if (intersect_ray(parameters, r_results[i])) {
+			hits++;
+		}
+	}
+	return hits;
+}
+
+void PhysicsDirectSpaceState3D::intersect_shapes(const ShapeParameters &p_parameters, const Vector3 *p_origins, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) {
+	ShapeParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.transform.origin = p_origins[i];
+		r_result_counts[i] = intersect_shape(parameters, &r_results[i * p_result_max], p_result_max);
+	}
+}
+
 PhysicsDirectSpaceState3D::PhysicsDirectSpaceState3D() {
 }
 
@@ -486,6 +577,8 @@ void PhysicsDirectSpaceState3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState3D::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_collide_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("get_rest_info", "parameters"), &PhysicsDirectSpaceState3D::_get_rest_info);
+	ClassDB::bind_method(D_METHOD("intersect_rays", "from", "to", "parameters"), &PhysicsDirectSpaceState3D::_intersect_rays);
+	ClassDB::bind_method(D_METHOD("intersect_shapes", "origins", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_intersect_shapes, DEFVAL(32));
 }
 
 ///////////////////////////////
@@ -1134,11 +1227,13 @@ PhysicsServer3D::PhysicsServer3D() {
 	GLOBAL_DEF("physics/3d/sleep_threshold_linear", 0.1);
 	GLOBAL_DEF("physics/3d/sleep_threshold_angular", Math::deg_to_rad(8.0));
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/time_before_sleep", PROPERTY_HINT_RANGE, "0,5,0.01,or_greater"), 0.5);
+	GLOBAL_DEF("physics/3d/parallel_broadphase_update", true);
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "physics/3d/solver/solver_iterations", PROPERTY_HINT_RANGE, "1,32,1,or_greater"), 16);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_recycle_radius", PROPERTY_HINT_RANGE, "0,0.1,0.001,or_greater"), 0.01);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_separation", PROPERTY_HINT_RANGE, "0,0.1,0.001,or_greater"), 0.05);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_allowed_penetration", PROPERTY_HINT_RANGE, "0.001,0.1,0.001,or_greater"), 0.01);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/default_contact_bias", PROPERTY_HINT_RANGE, "0,1,0.01"), 0.8);
+	GLOBAL_DEF("physics/3d/solver/batch_contacts", false);
 }
 
 PhysicsServer3D::~PhysicsServer3D() {
@@ -129,6 +129,8 @@ private:
 	Vector<real_t> _cast_motion(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query);
 	TypedArray<Vector3> _collide_shape(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results = 32);
 	Dictionary _get_rest_info(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query);
+	Dictionary _intersect_rays(const Vector<Vector3> &p_from, const Vector<Vector3> &p_to, const Ref<PhysicsRayQueryParameters3D> &p_ray_query);
+	Dictionary _intersect_shapes(const Vector<Vector3> &p_origins, const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results = 32);
 
 protected:
 	static void _bind_methods();
@@ -207,6 +209,13 @@ public:
 
 	virtual Vector3 get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const = 0;
 
+	// Batched queries, run one by one unless the server answers them in bulk. `from` and `to` of
+	// `p_parameters` are ignored. Rays that don't hit anything get an invalid `rid`, the number of hits is returned.
+	virtual int intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results);
+	// Each query is the shape of `p_parameters` with its origin moved to one of `p_origins`. The results of query
+	// `i` start at `r_results[i * p_result_max]`, and their count is stored in `r_result_counts[i]`.
+	virtual void intersect_shapes(const ShapeParameters &p_parameters, const Vector3 *p_origins, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts);
+
 	PhysicsDirectSpaceState3D();
 };
 
@@ -3253,10 +3253,12 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 
 	Vector<RID> directional_lights;
 	// directional lights
+	// Scenes may be rendered on the render thread, which never rewinds the frame arena otherwise.
+	const uint64_t frame_arena_mark = FrameAllocator::get_mark();
 	{
 		cull.shadow_count = 0;
 
-		Vector<Instance *> lights_with_shadow;
+		FrameLocalVector<Instance *> lights_with_shadow;
 
 		for (Instance *E : scenario->directional_lights) {
 			if (!E->visible || !(E->layer_mask & p_visible_layers)) {
@@ -3282,10 +3284,11 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 
 		RSG::light_storage->set_directional_shadow_count(lights_with_shadow.size());
 
-		for (int i = 0; i < lights_with_shadow.size(); i++) {
+		for (uint32_t i = 0; i < lights_with_shadow.size(); i++) {
 			_light_instance_setup_directional_shadow(i, lights_with_shadow[i], p_camera_data->main_transform, p_camera_data->main_projection, p_camera_data->is_orthogonal, p_camera_data->vaspect);
 		}
 	}
+	FrameAllocator::rewind(frame_arena_mark);
 
 	{ //sdfgi
 		cull.sdfgi.region_count = 0;
@@ -0,0 +1,150 @@
+/**************************************************************************/
+/*  test_memory_profiler.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MEMORY_PROFILER_H
+#define TEST_MEMORY_PROFILER_H
+
+#include "core/debugger/memory_profiler.h"
+#include "core/object/worker_thread_pool.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMemoryProfiler {
+
+#ifdef DEBUG_ENABLED
+
+// Sized so that nothing else is likely to be sampled with the same amount of bytes.
+static constexpr size_t TEST_ALLOC_SIZE = 12345;
+static constexpr int TEST_ALLOC_COUNT = 3;
+
+static void *test_allocs[TEST_ALLOC_COUNT] = {};
+
+static void alloc_task(void *p_userdata) {
+	for (int i = 0; i < TEST_ALLOC_COUNT; i++) {
+		test_allocs[i] = memalloc(TEST_ALLOC_SIZE);
+	}
+}
+
+static void free_task(void *p_userdata) {
+	for (int i = 0; i < TEST_ALLOC_COUNT; i++) {
+		memfree(test_allocs[i]);
+		test_allocs[i] = nullptr;
+	}
+}
+
+static void run_task(void (*p_func)(void *), const String &p_description) {
+	WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_native_task(p_func, nullptr, true, p_description);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+}
+
+// Returns the index in the snapshot of the entry of the site with the given name, or -1.
+static int find_snapshot_site(const Ref<MemoryProfiler> &p_profiler, const Array &p_snapshot, const String &p_name) {
+	for (int i = 3; i + 2 < p_snapshot.size(); i += 3) {
+		if (p_profiler->get_site_name(p_snapshot[i]) == p_name) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+TEST_CASE("[MemoryProfiler] Sampled allocations are attributed to the running task") {
+	Ref<MemoryProfiler> profiler;
+	profiler.instantiate();
+	Array options;
+	options.push_back(1); // Sample every allocation.
+	profiler->toggle(true, options);
+
+	run_task(alloc_task, "MemoryProfilerAlloc");
+
+	Array snapshot = profiler->get_heap_snapshot();
+	int site = find_snapshot_site(profiler, snapshot, "Task: MemoryProfilerAlloc");
+	REQUIRE_MESSAGE(site != -1, "The allocations of the task should be reported as live.");
+	CHECK((uint64_t)snapshot[site + 1] >= TEST_ALLOC_COUNT);
+	CHECK((uint64_t)snapshot[site + 2] >= TEST_ALLOC_COUNT * TEST_ALLOC_SIZE);
+
+	run_task(free_task, "MemoryProfilerFree");
+}
+
+TEST_CASE("[MemoryProfiler] Freed allocations are no longer live") {
+	Ref<MemoryProfiler> profiler;
+	profiler.instantiate();
+	Array options;
+	options.push_back(1);
+	profiler->toggle(true, options);
+
+	run_task(alloc_task, "MemoryProfilerAlloc");
+	run_task(free_task, "MemoryProfilerFree");
+
+	Array snapshot = profiler->get_heap_snapshot();
+	int site = find_snapshot_site(profiler, snapshot, "Task: MemoryProfilerAlloc");
+	if (site != -1) {
+		// Only allocations done by the pool itself while running the task may remain.
+		CHECK((uint64_t)snapshot[site + 2] < TEST_ALLOC_SIZE);
+	}
+}
+
+TEST_CASE("[MemoryProfiler] Heap snapshot contents") {
+	Ref<MemoryProfiler> profiler;
+	profiler.instantiate();
+	Array options;
+	options.push_back(4);
+	profiler->toggle(true, options);
+
+	run_task(alloc_task, "MemoryProfilerAlloc");
+
+	Array snapshot = profiler->get_heap_snapshot();
+	REQUIRE(snapshot.size() >= 3);
+	REQUIRE((snapshot.size() - 3) % 3 == 0);
+	CHECK((uint32_t)snapshot[0] == 4);
+
+	// Totals are the sum of the sites, which are sorted by decreasing amount of bytes.
+	uint64_t samples = 0;
+	uint64_t bytes = 0;
+	uint64_t previous_bytes = UINT64_MAX;
+	bool sorted = true;
+	for (int i = 3; i < snapshot.size(); i += 3) {
+		CHECK(!profiler->get_site_name(snapshot[i]).is_empty());
+		samples += (uint64_t)snapshot[i + 1];
+		bytes += (uint64_t)snapshot[i + 2];
+		sorted &= (uint64_t)snapshot[i + 2] <= previous_bytes;
+		previous_bytes = snapshot[i + 2];
+	}
+	CHECK((uint64_t)snapshot[1] == samples);
+	CHECK((uint64_t)snapshot[2] == bytes);
+	CHECK(sorted);
+
+	run_task(free_task, "MemoryProfilerFree");
+}
+
+#endif // DEBUG_ENABLED
+
+} // namespace TestMemoryProfiler
+
+#endif // TEST_MEMORY_PROFILER_H
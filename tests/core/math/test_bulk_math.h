@@ -0,0 +1,155 @@
+/**************************************************************************/
+/*  test_bulk_math.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_BULK_MATH_H
+#define TEST_BULK_MATH_H
+
+#include "core/math/bulk_math.h"
+#include "core/variant/variant.h"
+
+#include "tests/test_macros.h"
+
+namespace TestBulkMath {
+
+// Sizes around the register widths, so both the vector loops and the scalar tails are covered.
+static const int64_t test_sizes[] = { 0, 1, 2, 3, 4, 5, 7, 8, 9, 16, 17, 33 };
+
+template <typename T>
+static Vector<T> make_values(int64_t p_count, T p_scale, T p_offset) {
+	Vector<T> values;
+	values.resize(p_count);
+	for (int64_t i = 0; i < p_count; i++) {
+		values.write[i] = Math::sin(T(i) * p_scale) * T(10) + p_offset;
+	}
+	return values;
+}
+
+TEST_CASE_TEMPLATE("[BulkMath] Element-wise operations match scalar results", T, float, double) {
+	for (int64_t count : test_sizes) {
+		const Vector<T> a = make_values<T>(count, T(0.7), T(1));
+		const Vector<T> b = make_values<T>(count, T(1.3), T(-2));
+
+		Vector<T> added = a;
+		BulkMath::add(added.ptrw(), b.ptr(), count);
+		Vector<T> multiplied = a;
+		BulkMath::multiply(multiplied.ptrw(), b.ptr(), count);
+		Vector<T> interpolated = a;
+		BulkMath::lerp(interpolated.ptrw(), b.ptr(), T(0.25), count);
+		Vector<T> clamped = a;
+		BulkMath::clamp(clamped.ptrw(), T(-3), T(4), count);
+
+		for (int64_t i = 0; i < count; i++) {
+			CHECK(added[i] == a[i] + b[i]);
+			CHECK(multiplied[i] == a[i] * b[i]);
+			CHECK(interpolated[i] == doctest::Approx(Math::lerp(a[i], b[i], T(0.25))));
+			CHECK(clamped[i] == CLAMP(a[i], T(-3), T(4)));
+		}
+	}
+}
+
+TEST_CASE_TEMPLATE("[BulkMath] Reductions match scalar results", T, float, double) {
+	for (int64_t count : test_sizes) {
+		const Vector<T> a = make_values<T>(count, T(0.7), T(1));
+		const Vector<T> b = make_values<T>(count, T(1.3), T(-2));
+
+		double sum = 0.0;
+		double dot = 0.0;
+		for (int64_t i = 0; i < count; i++) {
+			sum += a[i];
+			dot += a[i] * b[i];
+		}
+		CHECK(BulkMath::sum(a.ptr(), count) == doctest::Approx(sum));
+		CHECK(BulkMath::dot(a.ptr(), b.ptr(), count) == doctest::Approx(dot));
+
+		if (count > 0) {
+			T min = a[0];
+			T max = a[0];
+			for (int64_t i = 1; i < count; i++) {
+				min = MIN(min, a[i]);
+				max = MAX(max, a[i]);
+			}
+			CHECK(BulkMath::min(a.ptr(), count) == min);
+			CHECK(BulkMath::max(a.ptr(), count) == max);
+		}
+	}
+}
+
+TEST_CASE("[BulkMath] Transforming points matches xform()") {
+	const Transform2D transform_2d = Transform2D(0.3, Size2(2, 0.5), 0.1, Vector2(4, -1));
+	const Transform3D transform_3d = Transform3D(Basis(Vector3(1, 2, 3).normalized(), 0.7).scaled(Vector3(2, 1, 3)), Vector3(5, -1, 2));
+
+	for (int64_t count : test_sizes) {
+		Vector<Vector2> points_2d;
+		Vector<Vector3> points_3d;
+		for (int64_t i = 0; i < count; i++) {
+			points_2d.push_back(Vector2(i, 1.5 - i));
+			points_3d.push_back(Vector3(i, 2 * i - 1, 0.5 * i));
+		}
+		const Vector<Vector2> original_2d = points_2d;
+		const Vector<Vector3> original_3d = points_3d;
+
+		BulkMath::transform(points_2d.ptrw(), transform_2d, count);
+		BulkMath::transform(points_3d.ptrw(), transform_3d, count);
+
+		for (int64_t i = 0; i < count; i++) {
+			CHECK(points_2d[i].is_equal_approx(transform_2d.xform(original_2d[i])));
+			CHECK(points_3d[i].is_equal_approx(transform_3d.xform(original_3d[i])));
+		}
+	}
+}
+
+TEST_CASE("[BulkMath] Packed array methods") {
+	PackedFloat32Array values = { 1, -2, 3, -4, 5 };
+	Variant array = values;
+
+	array.call("add_array", values);
+	CHECK(PackedFloat32Array(array) == PackedFloat32Array({ 2, -4, 6, -8, 10 }));
+
+	CHECK(double(array.call("sum")) == doctest::Approx(6));
+	CHECK(double(array.call("min")) == doctest::Approx(-8));
+	CHECK(double(array.call("max")) == doctest::Approx(10));
+
+	array.call("clamp", -5, 5);
+	CHECK(PackedFloat32Array(array) == PackedFloat32Array({ 2, -4, 5, -5, 5 }));
+
+	Variant points = PackedVector3Array({ Vector3(1, 0, 0), Vector3(0, 1, 0) });
+	const Transform3D transform = Transform3D(Basis(), Vector3(1, 2, 3));
+	points.call("transform", transform);
+	CHECK(PackedVector3Array(points) == PackedVector3Array({ Vector3(2, 2, 3), Vector3(1, 3, 3) }));
+
+	ERR_PRINT_OFF;
+	array.call("add_array", PackedFloat32Array({ 1 }));
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(PackedFloat32Array(array) == PackedFloat32Array({ 2, -4, 5, -5, 5 }), "Arrays of different sizes should be rejected.");
+}
+
+} // namespace TestBulkMath
+
+#endif // TEST_BULK_MATH_H
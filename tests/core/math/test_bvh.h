@@ -0,0 +1,155 @@
+/**************************************************************************/
+/*  test_bvh.h                                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_BVH_H
+#define TEST_BVH_H
+
+#include "core/math/bvh.h"
+#include "core/math/random_pcg.h"
+
+#include "tests/test_macros.h"
+
+namespace TestBVH {
+
+struct TestItem {
+	uint32_t id = 0;
+};
+
+template <typename T>
+class TestPairFunction {
+public:
+	static bool user_pair_check(const T *p_a, const T *p_b) {
+		// Skip some pairs, like collision layers would.
+		return (p_a->id + p_b->id) % 7 != 0;
+	}
+};
+
+template <typename T>
+class TestCullFunction {
+public:
+	static bool user_cull_check(const T *p_a, const T *p_b) {
+		return true;
+	}
+};
+
+// Configured like the 3D physics broadphase, with a static and a dynamic tree.
+typedef BVH_Manager<TestItem, 2, true, 128, TestPairFunction<TestItem>, TestCullFunction<TestItem>> TestBVH;
+
+// Runs the same moving scene on a BVH and records its pair callbacks.
+class PairingScene {
+	static void *_pair(void *p_self, uint32_t p_a, TestItem *p_item_a, int, uint32_t p_b, TestItem *p_item_b, int) {
+		static_cast<PairingScene *>(p_self)->events.push_back(((uint64_t)p_item_a->id << 32) | p_item_b->id);
+		return nullptr;
+	}
+
+	static void _unpair(void *p_self, uint32_t p_a, TestItem *p_item_a, int, uint32_t p_b, TestItem *p_item_b, int, void *) {
+		static_cast<PairingScene *>(p_self)->events.push_back(((uint64_t)p_item_a->id << 32) | p_item_b->id | (1ull << 63));
+	}
+
+	TestBVH bvh;
+	LocalVector<TestItem> items;
+	LocalVector<uint32_t> handles;
+	LocalVector<AABB> aabbs;
+	RandomPCG rng;
+
+public:
+	LocalVector<uint64_t> events;
+	uint64_t update_usec = 0;
+
+	PairingScene(uint32_t p_count, bool p_parallel) :
+			rng(1234) {
+		bvh.set_pair_callback(_pair, this);
+		bvh.set_unpair_callback(_unpair, this);
+		bvh.params_set_parallel_update(p_parallel);
+
+		// Roughly 10 items per cubic unit, a tenth of them static.
+		const real_t extent = Math::pow(real_t(p_count) / 10, real_t(1.0 / 3.0));
+		items.resize(p_count);
+		handles.resize(p_count);
+		aabbs.resize(p_count);
+		for (uint32_t i = 0; i < p_count; i++) {
+			items[i].id = i;
+			aabbs[i] = AABB(Vector3(rng.randf(), rng.randf(), rng.randf()) * extent, Vector3(0.4, 0.4, 0.4));
+			const bool is_static = i % 10 == 0;
+			handles[i] = bvh.create(&items[i], true, is_static ? 0 : 1, is_static ? 2 : 3, aabbs[i]);
+		}
+		bvh.update();
+	}
+
+	void step() {
+		for (uint32_t i = 0; i < items.size(); i++) {
+			if (i % 10 != 0) {
+				aabbs[i].position += Vector3(rng.randf() - 0.5, rng.randf() - 0.5, rng.randf() - 0.5) * 0.2;
+				bvh.move(handles[i], aabbs[i]);
+			}
+		}
+
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		bvh.update();
+		update_usec += OS::get_singleton()->get_ticks_usec() - begin;
+	}
+};
+
+TEST_CASE("[BVH] Parallel update pairs in the same order as a serial one") {
+	// Enough items and leaves for both the parallel refit and the parallel pairing to be used.
+	PairingScene serial(20000, false);
+	PairingScene parallel(20000, true);
+	CHECK(serial.events.size() > 0);
+
+	for (int i = 0; i < 5; i++) {
+		serial.step();
+		parallel.step();
+	}
+
+	REQUIRE(serial.events.size() == parallel.events.size());
+	bool same = true;
+	for (uint32_t i = 0; i < serial.events.size(); i++) {
+		same = same && serial.events[i] == parallel.events[i];
+	}
+	CHECK_MESSAGE(same, "Pair and unpair callbacks should be sent in the same order.");
+}
+
+TEST_CASE("[Stress][BVH] Parallel update of many moving items") {
+	for (uint32_t count : { 10000u, 50000u }) {
+		PairingScene serial(count, false);
+		PairingScene parallel(count, true);
+		for (int i = 0; i < 10; i++) {
+			serial.step();
+			parallel.step();
+		}
+
+		MESSAGE(count, " items: ", serial.update_usec / 10, " usec serial, ", parallel.update_usec / 10, " usec on ", WorkerThreadPool::get_singleton()->get_thread_count(), " threads per update.");
+		CHECK(serial.events.size() == parallel.events.size());
+	}
+}
+
+} // namespace TestBVH
+
+#endif // TEST_BVH_H
@@ -34,6 +34,9 @@
 #include "core/object/class_db.h"
 #include "core/object/object.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "core/variant/typed_array.h"
 
 #include "tests/test_macros.h"
 
@@ -59,12 +62,16 @@ protected:
 	static void _bind_methods() {
 		ClassDB::bind_method(D_METHOD("set_property", "property"), &_TestDerivedObject::set_property);
 		ClassDB::bind_method(D_METHOD("get_property"), &_TestDerivedObject::get_property);
+		ClassDB::bind_method(D_METHOD("set_integers", "integers"), &_TestDerivedObject::set_integers);
 		ADD_PROPERTY(PropertyInfo(Variant::INT, "property"), "set_property", "get_property");
 	}
 
 public:
+	Array integers;
+
 	void set_property(int value) { property_value = value; }
 	int get_property() const { return property_value; }
+	void set_integers(const TypedArray<int> &p_integers) { integers = p_integers; }
 };
 
 namespace TestObject {
@@ -510,6 +517,253 @@ public:
 	}
 };
 
+TEST_CASE("[Object] Signals connected to methods with typed arguments") {
+	GDREGISTER_CLASS(_TestDerivedObject);
+	Object emitter;
+	emitter.add_user_signal(MethodInfo("value_changed", PropertyInfo(Variant::INT, "value")));
+	_TestDerivedObject *target = memnew(_TestDerivedObject);
+	target->set_property(0);
+	emitter.connect("value_changed", Callable(target, "set_property"));
+
+	SUBCASE("Arguments matching the method types") {
+		CHECK(emitter.emit_signal("value_changed", 42) == OK);
+		CHECK(target->get_property() == 42);
+	}
+
+	SUBCASE("Arguments needing a conversion") {
+		CHECK(emitter.emit_signal("value_changed", 12.0) == OK);
+		CHECK(target->get_property() == 12);
+	}
+
+	SUBCASE("A script instance attached after connecting takes precedence") {
+		target->set_script_instance(memnew(_MockScriptInstance));
+		CHECK(emitter.emit_signal("value_changed", 42) == OK);
+		CHECK(target->get_property() == 0);
+	}
+
+	SUBCASE("Deleted target") {
+		memdelete(target);
+		target = nullptr;
+		CHECK(emitter.emit_signal("value_changed", 42) == OK);
+	}
+
+	if (target) {
+		memdelete(target);
+	}
+}
+
+TEST_CASE("[Object] Signals connected to methods with typed array arguments") {
+	GDREGISTER_CLASS(_TestDerivedObject);
+	Object emitter;
+	emitter.add_user_signal(MethodInfo("integers_changed", PropertyInfo(Variant::ARRAY, "integers")));
+	_TestDerivedObject target;
+	emitter.connect("integers_changed", Callable(&target, "set_integers"));
+
+	// Matching the container type isn't enough, the untyped array must still be converted.
+	Array untyped;
+	untyped.push_back(1);
+	untyped.push_back(2);
+	CHECK(emitter.emit_signal("integers_changed", untyped) == OK);
+	CHECK(target.integers.size() == 2);
+	CHECK(target.integers.is_typed());
+	CHECK(target.integers.get_typed_builtin() == Variant::INT);
+}
+
+class SignalReceiverObject : public Object {
+	GDCLASS(SignalReceiverObject, Object);
+
+public:
+	Object *emitter = nullptr;
+	Callable to_connect;
+	Callable to_disconnect;
+	int calls = 0;
+
+	void on_emitted() {
+		calls++;
+		if (to_connect.is_valid()) {
+			emitter->connect("emitted", to_connect);
+			to_connect = Callable();
+		}
+		if (to_disconnect.is_valid()) {
+			emitter->disconnect("emitted", to_disconnect);
+			to_disconnect = Callable();
+		}
+	}
+};
+
+TEST_CASE("[Object] Changing connections while emitting") {
+	Object emitter;
+	emitter.add_user_signal(MethodInfo("emitted"));
+	SignalReceiverObject first;
+	SignalReceiverObject second;
+	first.emitter = &emitter;
+	emitter.connect("emitted", callable_mp(&first, &SignalReceiverObject::on_emitted));
+
+	SUBCASE("Disconnected slots are still called by the emission in progress") {
+		emitter.connect("emitted", callable_mp(&second, &SignalReceiverObject::on_emitted));
+		first.to_disconnect = callable_mp(&second, &SignalReceiverObject::on_emitted);
+		emitter.emit_signal("emitted");
+		CHECK(first.calls == 1);
+		CHECK(second.calls == 1);
+
+		emitter.emit_signal("emitted");
+		CHECK(first.calls == 2);
+		CHECK(second.calls == 1);
+	}
+
+	SUBCASE("Connected slots are called from the next emission") {
+		first.to_connect = callable_mp(&second, &SignalReceiverObject::on_emitted);
+		emitter.emit_signal("emitted");
+		CHECK(first.calls == 1);
+		CHECK(second.calls == 0);
+
+		emitter.emit_signal("emitted");
+		CHECK(first.calls == 2);
+		CHECK(second.calls == 1);
+	}
+
+	SUBCASE("One-shot connections") {
+		emitter.connect("emitted", callable_mp(&second, &SignalReceiverObject::on_emitted), Object::CONNECT_ONE_SHOT);
+		emitter.emit_signal("emitted");
+		emitter.emit_signal("emitted");
+		CHECK(first.calls == 2);
+		CHECK(second.calls == 1);
+	}
+}
+
+class ThreadedSignalReceiverObject : public Object {
+	GDCLASS(ThreadedSignalReceiverObject, Object);
+
+public:
+	SafeNumeric<uint32_t> calls;
+
+	void on_emitted() {
+		calls.increment();
+	}
+};
+
+static Object *threaded_emitter = nullptr;
+
+static void static_signal_emission_task(void *p_userdata, uint32_t p_index) {
+	for (int i = 0; i < 100; i++) {
+		threaded_emitter->emit_signal("emitted");
+	}
+}
+
+TEST_CASE("[Object] Emitting a signal from many threads") {
+	Object emitter;
+	emitter.add_user_signal(MethodInfo("emitted"));
+	ThreadedSignalReceiverObject receivers[10];
+	threaded_emitter = &emitter;
+
+	for (int round = 0; round < 10; round++) {
+		// Connecting drops the snapshot, so the threads race to build the next one.
+		emitter.connect("emitted", callable_mp(&receivers[round], &ThreadedSignalReceiverObject::on_emitted));
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_signal_emission_task, nullptr, 8);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	}
+	threaded_emitter = nullptr;
+
+	for (int i = 0; i < 10; i++) {
+		CHECK(receivers[i].calls.get() == uint32_t(10 - i) * 8 * 100);
+	}
+}
+
+#ifdef DEBUG_ENABLED
+static SafeNumeric<uint32_t> signal_emission_allocations;
+static Thread::ID signal_emission_thread;
+
+static bool _count_signal_emission_allocation(void *p_ptr, size_t p_bytes, void *p_callsite) {
+	// Other threads may be allocating meanwhile.
+	if (Thread::get_caller_id() == signal_emission_thread) {
+		signal_emission_allocations.increment();
+	}
+	return false;
+}
+
+TEST_CASE("[Object] Emitting a signal does not allocate") {
+	Object emitter;
+	emitter.add_user_signal(MethodInfo("emitted"));
+	SignalReceiverObject receivers[10];
+	for (SignalReceiverObject &receiver : receivers) {
+		emitter.connect("emitted", callable_mp(&receiver, &SignalReceiverObject::on_emitted));
+	}
+	const StringName signal_name = "emitted";
+
+	// The first emission after connecting builds the connection snapshot.
+	emitter.emit_signalp(signal_name, nullptr, 0);
+
+	signal_emission_allocations.set(0);
+	signal_emission_thread = Thread::get_caller_id();
+	Memory::set_alloc_sampling(1, _count_signal_emission_allocation, nullptr);
+	for (int i = 0; i < 100; i++) {
+		emitter.emit_signalp(signal_name, nullptr, 0);
+	}
+	Memory::set_alloc_sampling(0, nullptr, nullptr);
+
+	CHECK(signal_emission_allocations.get() == 0);
+	for (const SignalReceiverObject &receiver : receivers) {
+		CHECK(receiver.calls == 101);
+	}
+}
+#endif // DEBUG_ENABLED
+
+TEST_CASE("[Stress][Object] Signal emission throughput") {
+	GDREGISTER_CLASS(_TestDerivedObject);
+	Object emitter;
+	emitter.add_user_signal(MethodInfo("value_changed", PropertyInfo(Variant::INT, "value")));
+	_TestDerivedObject target;
+	emitter.connect("value_changed", Callable(&target, "set_property"));
+
+	const int emissions = 1000000;
+	const Variant typed_argument = 1;
+	const Variant converted_argument = 1.0;
+
+	// Arguments needing a conversion take the regular Object::callp() path.
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < emissions; i++) {
+		emitter.emit_signal("value_changed", converted_argument);
+	}
+	uint64_t regular_usec = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < emissions; i++) {
+		emitter.emit_signal("value_changed", typed_argument);
+	}
+	uint64_t validated_usec = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+	CHECK(target.get_property() == 1);
+	MESSAGE("Regular call: ", (uint64_t)emissions * 1000000 / regular_usec, " emissions/s, validated call: ", (uint64_t)emissions * 1000000 / validated_usec, " emissions/s.");
+}
+
+TEST_CASE("[Stress][Object] Signal emission to many slots") {
+	const StringName signal_name = "emitted";
+	const int slot_counts[] = { 1, 10, 100 };
+	for (int slot_count : slot_counts) {
+		Object emitter;
+		emitter.add_user_signal(MethodInfo("emitted"));
+		LocalVector<SignalReceiverObject *> receivers;
+		for (int i = 0; i < slot_count; i++) {
+			receivers.push_back(memnew(SignalReceiverObject));
+			emitter.connect(signal_name, callable_mp(receivers[i], &SignalReceiverObject::on_emitted));
+		}
+
+		const int emissions = 1000000 / slot_count;
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < emissions; i++) {
+			emitter.emit_signalp(signal_name, nullptr, 0);
+		}
+		uint64_t usec = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+		CHECK(receivers[0]->calls == emissions);
+		MESSAGE(slot_count, " slot(s): ", (uint64_t)emissions * 1000000 / usec, " emissions/s.");
+
+		for (SignalReceiverObject *receiver : receivers) {
+			memdelete(receiver);
+		}
+	}
+}
+
 TEST_CASE("[Object] Notification order") { // GH-52325
 	NotificationObject2 *test_notification_object = memnew(NotificationObject2);
 
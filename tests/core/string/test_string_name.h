@@ -0,0 +1,162 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_STRING_NAME_H
+#define TEST_STRING_NAME_H
+
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "core/string/string_name.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	StringName a = "test_string_name_interning";
+	StringName b = String("test_string_name_interning");
+	StringName c = StringName(StaticCString::create("test_string_name_interning"));
+
+	CHECK(a == b);
+	CHECK(b == c);
+	CHECK(a.data_unique_pointer() == c.data_unique_pointer());
+	CHECK(a == "test_string_name_interning");
+	CHECK(a != StringName("test_string_name_interning_other"));
+	CHECK(StringName("").is_empty());
+	CHECK(StringName(String()) == StringName());
+}
+
+TEST_CASE("[StringName] Search") {
+	CHECK(StringName::search("test_string_name_never_created") == StringName());
+
+	StringName name = "test_string_name_search";
+	CHECK(StringName::search("test_string_name_search") == name);
+	CHECK(StringName::search(U"test_string_name_search") == name);
+	CHECK(StringName::search(String("test_string_name_search")) == name);
+}
+
+TEST_CASE("[StringName] Many names") {
+	// Enough names to grow the buckets of every shard.
+	const int count = 200000;
+	LocalVector<StringName> names;
+	names.resize(count);
+	for (int i = 0; i < count; i++) {
+		names[i] = StringName("test_string_name_many_" + itos(i));
+	}
+
+	bool all_found = true;
+	for (int i = 0; i < count; i++) {
+		all_found = all_found && StringName::search("test_string_name_many_" + itos(i)) == names[i];
+	}
+	CHECK(all_found);
+
+	// Released names are removed from the table.
+	names.clear();
+	CHECK(StringName::search("test_string_name_many_0") == StringName());
+	CHECK(StringName::search("test_string_name_many_199999") == StringName());
+}
+
+static const int THREADED_NAMES = 1024;
+static LocalVector<StringName> threaded_names[THREADED_NAMES];
+static LocalVector<String> threaded_strings;
+
+static void static_create_names(void *p_userdata, uint32_t p_index) {
+	LocalVector<StringName> &names = threaded_names[p_index];
+	names.resize(threaded_strings.size());
+	for (uint32_t i = 0; i < threaded_strings.size(); i++) {
+		// Create and release a name first, so creation races with releases from other threads.
+		{
+			StringName temp = threaded_strings[(i + p_index) % threaded_strings.size()];
+		}
+		names[i] = threaded_strings[i];
+	}
+}
+
+TEST_CASE("[StringName] Create the same names from many threads") {
+	threaded_strings.resize(512);
+	for (uint32_t i = 0; i < threaded_strings.size(); i++) {
+		threaded_strings[i] = "test_string_name_threaded_" + itos(i);
+	}
+
+	for (int round = 0; round < 4; round++) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_create_names, nullptr, THREADED_NAMES);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+		// Every thread must have got the same unique name for each string.
+		bool unique = true;
+		for (int i = 1; i < THREADED_NAMES; i++) {
+			for (uint32_t j = 0; j < threaded_strings.size(); j++) {
+				unique = unique && threaded_names[i][j].data_unique_pointer() == threaded_names[0][j].data_unique_pointer();
+			}
+		}
+		CHECK(unique);
+
+		for (int i = 0; i < THREADED_NAMES; i++) {
+			threaded_names[i].clear();
+		}
+	}
+	threaded_strings.clear();
+}
+
+static const int CONTENTION_NAMES = 4096;
+static LocalVector<String> contention_strings;
+
+static void static_intern_names(void *p_userdata, uint32_t p_index) {
+	const uint32_t offset = p_index * 7919;
+	for (int i = 0; i < CONTENTION_NAMES; i++) {
+		StringName name = contention_strings[(offset + i) % CONTENTION_NAMES];
+	}
+}
+
+TEST_CASE("[Stress][StringName] Intern from all worker threads") {
+	contention_strings.resize(CONTENTION_NAMES);
+	for (int i = 0; i < CONTENTION_NAMES; i++) {
+		contention_strings[i] = "test_string_name_contention_" + itos(i);
+	}
+	// Keep half of them alive, the other half is created and released every time.
+	LocalVector<StringName> kept;
+	for (int i = 0; i < CONTENTION_NAMES; i += 2) {
+		kept.push_back(contention_strings[i]);
+	}
+
+	const int tasks = MAX(1, WorkerThreadPool::get_singleton()->get_thread_count()) * 64;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_intern_names, nullptr, tasks);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	uint64_t elapsed = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+	MESSAGE(WorkerThreadPool::get_singleton()->get_thread_count(), " threads: ", (uint64_t)tasks * CONTENTION_NAMES * 1000000 / elapsed, " StringName(String) per second.");
+	CHECK(StringName::search(contention_strings[0]) == kept[0]);
+	contention_strings.clear();
+}
+
+} // namespace TestStringName
+
+#endif // TEST_STRING_NAME_H
@@ -244,6 +244,40 @@ TEST_CASE("[LocalVector] Size / Resize / Reserve.") {
 	CHECK(vector.size() == 4);
 	CHECK(vector.get_capacity() >= 4);
 }
+
+TEST_CASE("[LocalVector] Frame allocator") {
+	uint64_t mark = FrameAllocator::get_mark();
+
+	FrameLocalVector<int> vector;
+	FrameLocalVector<int> other;
+	for (int i = 0; i < 1000; i++) {
+		// Interleaved, so growing in place isn't always possible.
+		vector.push_back(i);
+		if (i % 2) {
+			other.push_back(-i);
+		}
+	}
+
+	bool all_match = true;
+	for (int i = 0; i < 1000; i++) {
+		all_match &= vector[i] == i;
+	}
+	for (int i = 0; i < 500; i++) {
+		all_match &= other[i] == -(i * 2 + 1);
+	}
+	CHECK(all_match);
+
+	// Larger than a whole arena block, so it comes from the heap.
+	vector.resize(FrameAllocator::BLOCK_SIZE);
+	CHECK(vector[999] == 999);
+	vector[FrameAllocator::BLOCK_SIZE - 1] = 1;
+	vector.reset();
+	other.reset();
+
+	FrameAllocator::rewind(mark);
+	CHECK(FrameAllocator::get_mark() == mark);
+}
+
 } // namespace TestLocalVector
 
 #endif // TEST_LOCAL_VECTOR_H
@@ -31,7 +31,11 @@
 #ifndef TEST_RID_H
 #define TEST_RID_H
 
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "core/templates/hash_set.h"
 #include "core/templates/rid.h"
+#include "core/templates/rid_owner.h"
 
 #include "tests/test_macros.h"
 
@@ -96,6 +100,152 @@ TEST_CASE("[RID] 'get_local_index'") {
 	CHECK(RID::from_uint64(4'294'967'295).get_local_index() == 4'294'967'295);
 	CHECK(RID::from_uint64(4'294'967'297).get_local_index() == 1);
 }
+
+TEST_CASE("[RID_Owner] Allocate, get and free") {
+	RID_Owner<int, false> owner;
+	RID a = owner.make_rid(1);
+	RID b = owner.make_rid(2);
+
+	CHECK(owner.get_rid_count() == 2);
+	CHECK(owner.owns(a));
+	CHECK(*owner.get_or_null(a) == 1);
+	CHECK(*owner.get_or_null(b) == 2);
+
+	owner.free(a);
+	CHECK_FALSE(owner.owns(a));
+	CHECK(owner.get_or_null(a) == nullptr);
+	CHECK(owner.get_rid_count() == 1);
+
+	// The freed slot is reused, but the old RID stays invalid.
+	RID c = owner.make_rid(3);
+	CHECK(c.get_local_index() == a.get_local_index());
+	CHECK(c != a);
+	CHECK(owner.get_or_null(a) == nullptr);
+	CHECK(*owner.get_or_null(c) == 3);
+
+	List<RID> owned;
+	owner.get_owned_list(&owned);
+	CHECK(owned.size() == 2);
+
+	owner.free(b);
+	owner.free(c);
+	CHECK(owner.get_rid_count() == 0);
+}
+
+static const int THREADED_RIDS = 256;
+static RID_Owner<int, true> threaded_owner(1024, 65536);
+static LocalVector<RID> threaded_shared_rids;
+static SafeNumeric<uint32_t> threaded_errors;
+
+static void static_rid_owner_task(void *p_userdata, uint32_t p_index) {
+	RID own[THREADED_RIDS];
+	for (int i = 0; i < THREADED_RIDS; i++) {
+		own[i] = threaded_owner.make_rid(p_index);
+	}
+	for (uint32_t i = 0; i < threaded_shared_rids.size(); i++) {
+		const int *value = threaded_owner.get_or_null(threaded_shared_rids[i]);
+		if (!value || *value != -int(i)) {
+			threaded_errors.increment();
+		}
+	}
+	for (int i = 0; i < THREADED_RIDS; i++) {
+		const int *value = threaded_owner.get_or_null(own[i]);
+		if (!value || *value != int(p_index)) {
+			threaded_errors.increment();
+		}
+		threaded_owner.free(own[i]);
+		if (threaded_owner.owns(own[i])) {
+			threaded_errors.increment();
+		}
+	}
+}
+
+TEST_CASE("[RID_Owner] Allocate, get and free from many threads") {
+	for (int i = 0; i < 1000; i++) {
+		threaded_shared_rids.push_back(threaded_owner.make_rid(-i));
+	}
+	threaded_errors.set(0);
+
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_rid_owner_task, nullptr, 200);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	CHECK(threaded_errors.get() == 0);
+	CHECK(threaded_owner.get_rid_count() == threaded_shared_rids.size());
+
+	for (const RID &rid : threaded_shared_rids) {
+		threaded_owner.free(rid);
+	}
+	threaded_shared_rids.clear();
+	CHECK(threaded_owner.get_rid_count() == 0);
+}
+
+static void static_rid_free_task(void *p_userdata, uint32_t p_index) {
+	for (const RID &rid : threaded_shared_rids) {
+		threaded_owner.free(rid);
+	}
+}
+
+TEST_CASE("[RID_Owner] Free the same RIDs from many threads") {
+	for (int i = 0; i < 1000; i++) {
+		threaded_shared_rids.push_back(threaded_owner.make_rid(i));
+	}
+
+	// All but one free of each RID fail.
+	ERR_PRINT_OFF;
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_rid_free_task, nullptr, 8);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	ERR_PRINT_ON;
+
+	CHECK(threaded_owner.get_rid_count() == 0);
+
+	// Each index went back to the free lists once, so reallocating them never hands out the same one twice.
+	HashSet<uint32_t> indices;
+	LocalVector<RID> rids;
+	for (uint32_t i = 0; i < threaded_shared_rids.size(); i++) {
+		RID rid = threaded_owner.make_rid(i);
+		rids.push_back(rid);
+		indices.insert(rid.get_local_index());
+	}
+	CHECK(indices.size() == rids.size());
+
+	for (const RID &rid : rids) {
+		threaded_owner.free(rid);
+	}
+	threaded_shared_rids.clear();
+}
+
+static void static_rid_lookup_task(void *p_userdata, uint32_t p_index) {
+	uint32_t found = 0;
+	for (int r = 0; r < 100; r++) {
+		for (const RID &rid : threaded_shared_rids) {
+			found += threaded_owner.get_or_null(rid) != nullptr;
+		}
+	}
+	if (found != threaded_shared_rids.size() * 100) {
+		threaded_errors.increment();
+	}
+}
+
+TEST_CASE("[Stress][RID_Owner] Lookups from all worker threads") {
+	for (int i = 0; i < 10000; i++) {
+		threaded_shared_rids.push_back(threaded_owner.make_rid(i));
+	}
+	threaded_errors.set(0);
+
+	const int tasks = MAX(1, WorkerThreadPool::get_singleton()->get_thread_count()) * 4;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_rid_lookup_task, nullptr, tasks);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	uint64_t elapsed = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+	CHECK(threaded_errors.get() == 0);
+	MESSAGE(WorkerThreadPool::get_singleton()->get_thread_count(), " threads: ", (uint64_t)tasks * threaded_shared_rids.size() * 100 * 1000000 / elapsed, " lookups per second.");
+
+	for (const RID &rid : threaded_shared_rids) {
+		threaded_owner.free(rid);
+	}
+	threaded_shared_rids.clear();
+}
 } // namespace TestRID
 
 #endif // TEST_RID_H
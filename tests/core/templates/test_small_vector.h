@@ -0,0 +1,247 @@
+/**************************************************************************/
+/*  test_small_vector.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SMALL_VECTOR_H
+#define TEST_SMALL_VECTOR_H
+
+#include "core/os/thread.h"
+#include "core/templates/small_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSmallVector {
+
+TEST_CASE("[SmallVector] List initialization") {
+	SmallVector<int, 4> vector{ 0, 1, 2 };
+
+	CHECK(vector.size() == 3);
+	CHECK(vector.is_inline());
+	CHECK(vector[0] == 0);
+	CHECK(vector[1] == 1);
+	CHECK(vector[2] == 2);
+}
+
+TEST_CASE("[SmallVector] Push back past the inline capacity") {
+	SmallVector<String, 4> vector;
+	for (int i = 0; i < 4; i++) {
+		vector.push_back(itos(i));
+	}
+	CHECK(vector.is_inline());
+
+	// Pushing one of its own elements must survive the move to the heap.
+	vector.push_back(vector[0]);
+	CHECK(!vector.is_inline());
+	CHECK(vector.size() == 5);
+	CHECK(vector[0] == "0");
+	CHECK(vector[3] == "3");
+	CHECK(vector[4] == "0");
+
+	for (int i = 0; i < 100; i++) {
+		vector.push_back(itos(i));
+	}
+	CHECK(vector.size() == 105);
+	CHECK(vector[104] == "99");
+
+	vector.clear();
+	CHECK(vector.is_empty());
+	CHECK(vector.is_inline());
+}
+
+TEST_CASE("[SmallVector] Remove, erase and find") {
+	SmallVector<int, 8> vector{ 0, 1, 2, 3, 4 };
+	vector.remove_at(1);
+	CHECK(vector.size() == 4);
+	CHECK(vector[1] == 2);
+
+	CHECK(vector.erase(3));
+	CHECK(!vector.erase(3));
+	CHECK(vector.size() == 3);
+	CHECK(vector.find(4) == 2);
+	CHECK(vector.has(0));
+	CHECK(!vector.has(1));
+
+	ERR_PRINT_OFF;
+	vector.remove_at(3);
+	ERR_PRINT_ON;
+	CHECK(vector.size() == 3);
+}
+
+TEST_CASE("[SmallVector] Insert and sort") {
+	SmallVector<int, 4> vector{ 1, 3 };
+	vector.insert(1, 2);
+	vector.insert(0, 0);
+	CHECK(vector.is_inline());
+	CHECK(vector.size() == 4);
+	for (int i = 0; i < 4; i++) {
+		CHECK(vector[i] == i);
+	}
+
+	// Inserting one of its own elements must survive the move to the heap.
+	vector.insert(2, vector[3]);
+	CHECK(!vector.is_inline());
+	CHECK(vector.size() == 5);
+	CHECK(vector[2] == 3);
+	CHECK(vector[3] == 2);
+
+	SmallVector<int, 4> ordered;
+	for (int value : { 5, 1, 4, 2 }) {
+		ordered.ordered_insert(value);
+	}
+	CHECK(ordered.is_inline());
+	CHECK(ordered[0] == 1);
+	CHECK(ordered[1] == 2);
+	CHECK(ordered[2] == 4);
+	CHECK(ordered[3] == 5);
+
+	SmallVector<int, 4> unsorted{ 3, 0, 2, 1 };
+	unsorted.sort();
+	for (int i = 0; i < 4; i++) {
+		CHECK(unsorted[i] == i);
+	}
+}
+
+TEST_CASE("[SmallVector] Resize") {
+	SmallVector<int, 4> vector;
+	vector.resize(3);
+	CHECK(vector.size() == 3);
+	CHECK(vector.is_inline());
+	vector.set(2, 5);
+
+	vector.resize(10);
+	CHECK(vector.size() == 10);
+	CHECK(!vector.is_inline());
+	CHECK(vector[2] == 5);
+
+	vector.resize(1);
+	CHECK(vector.size() == 1);
+}
+
+TEST_CASE("[SmallVector] Conversion from and to Vector") {
+	SmallVector<int, 4> small{ 1, 2, 3 };
+	Vector<int> vector = small;
+	CHECK(vector.size() == 3);
+	CHECK(vector[2] == 3);
+
+	// Large vectors share the copy-on-write storage.
+	SmallVector<int, 4> large;
+	large.resize(16);
+	large[15] = 42;
+	Vector<int> shared = large.to_vector();
+	CHECK(shared.ptr() == large.ptr());
+	large[15] = 0;
+	CHECK(shared[15] == 42);
+
+	SmallVector<int, 4> adopted = shared;
+	CHECK(adopted.ptr() == shared.ptr());
+	CHECK(adopted[15] == 42);
+
+	int sum = 0;
+	for (int value : adopted) {
+		sum += value;
+	}
+	CHECK(sum == 42);
+}
+
+TEST_CASE("[SmallVector] Copy") {
+	SmallVector<String, 2> a{ "a", "b" };
+	SmallVector<String, 2> b = a;
+	b[0] = "c";
+	CHECK(a[0] == "a");
+	CHECK(b[0] == "c");
+
+	a.push_back("d");
+	b = a;
+	b[0] = "e";
+	CHECK(a[0] == "a");
+	CHECK(b[2] == "d");
+}
+
+#ifdef DEBUG_ENABLED
+static uint32_t small_vector_allocations = 0;
+static Thread::ID small_vector_thread;
+
+static bool _count_small_vector_allocation(void *p_ptr, size_t p_bytes, void *p_callsite) {
+	// Other threads may be allocating meanwhile.
+	if (Thread::get_caller_id() != small_vector_thread) {
+		return false;
+	}
+	small_vector_allocations++;
+	return true; // Tracked, so that growing it is counted too.
+}
+
+static void _ignore_small_vector_free(void *p_ptr, size_t p_bytes) {}
+
+template <typename V>
+static uint32_t _count_push_back_allocations(int p_count) {
+	small_vector_allocations = 0;
+	{
+		V vector;
+		for (int i = 0; i < p_count; i++) {
+			vector.push_back(Vector3(i, i, i));
+		}
+	}
+	return small_vector_allocations;
+}
+
+TEST_CASE("[SmallVector] Allocations compared to Vector") {
+	small_vector_thread = Thread::get_caller_id();
+	Memory::set_alloc_sampling(1, _count_small_vector_allocation, _ignore_small_vector_free);
+	// A previous sampling interval may still be counting down on this thread.
+	small_vector_allocations = 0;
+	while (small_vector_allocations == 0) {
+		memfree(memalloc(1));
+	}
+
+	String vector_counts;
+	String small_vector_counts;
+	for (int count = 1; count <= 8; count++) {
+		const uint32_t vector_allocations = _count_push_back_allocations<Vector<Vector3>>(count);
+		const uint32_t small_allocations = _count_push_back_allocations<SmallVector<Vector3, 4>>(count);
+		vector_counts += " " + itos(vector_allocations);
+		small_vector_counts += " " + itos(small_allocations);
+
+		CHECK(vector_allocations > 0);
+		if (count <= 4) {
+			CHECK(small_allocations == 0);
+		} else {
+			CHECK(small_allocations > 0);
+		}
+	}
+	Memory::set_alloc_sampling(0, nullptr, nullptr);
+
+	MESSAGE("Allocations, including reallocations, to push back 1 to 8 Vector3:");
+	MESSAGE("Vector:", vector_counts);
+	MESSAGE("SmallVector<Vector3, 4>:", small_vector_counts);
+}
+#endif // DEBUG_ENABLED
+
+} // namespace TestSmallVector
+
+#endif // TEST_SMALL_VECTOR_H
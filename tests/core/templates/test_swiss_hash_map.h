@@ -0,0 +1,296 @@
+/**************************************************************************/
+/*  test_swiss_hash_map.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SWISS_HASH_MAP_H
+#define TEST_SWISS_HASH_MAP_H
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/oa_hash_map.h"
+#include "core/templates/swiss_hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSwissHashMap {
+
+TEST_CASE("[SwissHashMap] Insert element") {
+	SwissHashMap<int, int> map;
+	SwissHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map[42] == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+}
+
+TEST_CASE("[SwissHashMap] Overwrite element") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(42, 1234);
+
+	CHECK(map[42] == 1234);
+	CHECK(map.size() == 1);
+}
+
+TEST_CASE("[SwissHashMap] Erase via element") {
+	SwissHashMap<int, int> map;
+	SwissHashMap<int, int>::Iterator e = map.insert(42, 84);
+	map.remove(e);
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+}
+
+TEST_CASE("[SwissHashMap] Erase via key") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	CHECK(map.erase(42));
+	CHECK(!map.erase(42));
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+}
+
+TEST_CASE("[SwissHashMap] Size") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(123, 84);
+	map.insert(123, 84);
+	map.insert(0, 84);
+	map.insert(123485, 84);
+
+	CHECK(map.size() == 4);
+}
+
+TEST_CASE("[SwissHashMap] Iteration") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(123, 12385);
+	map.insert(0, 12934);
+	map.insert(123485, 1238888);
+	map.insert(123, 111111);
+
+	// Iteration follows slot order, check every pair is visited once.
+	HashMap<int, int> expected;
+	expected.insert(42, 84);
+	expected.insert(123, 111111);
+	expected.insert(0, 12934);
+	expected.insert(123485, 1238888);
+
+	for (const KeyValue<int, int> &E : map) {
+		REQUIRE(expected.has(E.key));
+		CHECK(expected[E.key] == E.value);
+		expected.erase(E.key);
+	}
+	CHECK(expected.is_empty());
+}
+
+TEST_CASE("[SwissHashMap] Erase while iterating") {
+	SwissHashMap<int, int> map;
+	for (int i = 0; i < 1000; i++) {
+		map.insert(i, i * 2);
+	}
+
+	for (SwissHashMap<int, int>::Iterator it = map.begin(); it; ++it) {
+		if (it->key % 2 == 1) {
+			map.remove(it);
+		}
+	}
+
+	CHECK(map.size() == 500);
+	for (int i = 0; i < 1000; i++) {
+		CHECK(map.has(i) == (i % 2 == 0));
+	}
+}
+
+TEST_CASE("[SwissHashMap] Grow, erase and reinsert") {
+	SwissHashMap<String, int> map;
+	const int count = 10000;
+	for (int i = 0; i < count; i++) {
+		map[itos(i)] = i;
+	}
+	CHECK(map.size() == count);
+	CHECK(map.get_capacity() >= (uint32_t)count);
+
+	// Deleted slots are reused or reclaimed by rehashing without growing forever.
+	const uint32_t capacity = map.get_capacity();
+	for (int round = 0; round < 10; round++) {
+		for (int i = 0; i < count; i++) {
+			map.erase(itos(i));
+		}
+		CHECK(map.is_empty());
+		for (int i = 0; i < count; i++) {
+			map.insert(itos(i), i + round);
+		}
+	}
+	CHECK(map.get_capacity() == capacity);
+
+	bool all_found = true;
+	for (int i = 0; i < count; i++) {
+		const int *value = map.getptr(itos(i));
+		all_found = all_found && value && *value == i + 9;
+	}
+	CHECK(all_found);
+	CHECK(!map.has("missing"));
+}
+
+TEST_CASE("[SwissHashMap] Copy and clear") {
+	SwissHashMap<int, String> map;
+	for (int i = 0; i < 100; i++) {
+		map.insert(i, itos(i));
+	}
+	map.erase(50);
+
+	const SwissHashMap<int, String> copy = map;
+	CHECK(copy.size() == 99);
+	CHECK(copy[10] == "10");
+	CHECK(!copy.has(50));
+
+	map.clear();
+	CHECK(map.is_empty());
+	CHECK(!map.has(10));
+	CHECK(copy.has(10));
+	CHECK(map.begin() == map.end());
+}
+
+template <typename T>
+static uint64_t insert_benchmark(T &r_map, const LocalVector<uint32_t> &p_keys) {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t i = 0; i < p_keys.size(); i++) {
+		r_map.insert(p_keys[i], i);
+	}
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+template <typename T>
+static uint64_t lookup_benchmark(T &r_map, const LocalVector<uint32_t> &p_keys, uint64_t &r_sum) {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t i = 0; i < p_keys.size(); i++) {
+		// Half hits, half (most likely) misses.
+		const uint32_t *value = r_map.getptr(p_keys[i]);
+		r_sum += value ? *value : 0;
+		r_sum += r_map.has(~p_keys[i]);
+	}
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+template <typename T>
+static uint64_t iterate_benchmark(T &r_map, uint64_t &r_sum) {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (const KeyValue<uint32_t, uint32_t> &E : r_map) {
+		r_sum += E.value;
+	}
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+template <typename T>
+static uint64_t erase_benchmark(T &r_map, const LocalVector<uint32_t> &p_keys) {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t i = 0; i < p_keys.size(); i++) {
+		r_map.erase(p_keys[i]);
+	}
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+// OAHashMap has its own API.
+static uint64_t insert_benchmark(OAHashMap<uint32_t, uint32_t> &r_map, const LocalVector<uint32_t> &p_keys) {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t i = 0; i < p_keys.size(); i++) {
+		r_map.set(p_keys[i], i);
+	}
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+static uint64_t lookup_benchmark(OAHashMap<uint32_t, uint32_t> &r_map, const LocalVector<uint32_t> &p_keys, uint64_t &r_sum) {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t i = 0; i < p_keys.size(); i++) {
+		const uint32_t *value = r_map.lookup_ptr(p_keys[i]);
+		r_sum += value ? *value : 0;
+		r_sum += r_map.has(~p_keys[i]);
+	}
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+static uint64_t iterate_benchmark(OAHashMap<uint32_t, uint32_t> &r_map, uint64_t &r_sum) {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (OAHashMap<uint32_t, uint32_t>::Iterator it = r_map.iter(); it.valid; it = r_map.next_iter(it)) {
+		r_sum += *it.value;
+	}
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+static uint64_t erase_benchmark(OAHashMap<uint32_t, uint32_t> &r_map, const LocalVector<uint32_t> &p_keys) {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t i = 0; i < p_keys.size(); i++) {
+		r_map.remove(p_keys[i]);
+	}
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+template <typename T>
+static void run_benchmark(const char *p_name, const LocalVector<uint32_t> &p_keys, uint64_t &r_sum) {
+	// Repeat small sizes so that the timings are meaningful.
+	const uint32_t repeats = MAX(1u, 1000000u / p_keys.size());
+	uint64_t insert_usec = 0;
+	uint64_t lookup_usec = 0;
+	uint64_t iterate_usec = 0;
+	uint64_t erase_usec = 0;
+	for (uint32_t i = 0; i < repeats; i++) {
+		T map;
+		insert_usec += insert_benchmark(map, p_keys);
+		lookup_usec += lookup_benchmark(map, p_keys, r_sum);
+		iterate_usec += iterate_benchmark(map, r_sum);
+		erase_usec += erase_benchmark(map, p_keys);
+	}
+	const double ns = 1000.0 / (double(p_keys.size()) * repeats);
+	MESSAGE(vformat("%-12s %8d elements: insert %.1f ns, lookup %.1f ns, iterate %.1f ns, erase %.1f ns.", p_name, p_keys.size(), insert_usec * ns, lookup_usec * ns, iterate_usec * ns, erase_usec * ns));
+}
+
+TEST_CASE("[Stress][SwissHashMap] Compare against HashMap and OAHashMap") {
+	RandomPCG rng(42);
+	uint64_t sum = 0;
+	for (uint32_t size = 10; size <= 10000000; size *= 10) {
+		LocalVector<uint32_t> keys;
+		keys.resize(size);
+		for (uint32_t i = 0; i < size; i++) {
+			keys[i] = rng.rand();
+		}
+
+		run_benchmark<SwissHashMap<uint32_t, uint32_t>>("SwissHashMap", keys, sum);
+		run_benchmark<HashMap<uint32_t, uint32_t>>("HashMap", keys, sum);
+		run_benchmark<OAHashMap<uint32_t, uint32_t>>("OAHashMap", keys, sum);
+	}
+	CHECK(sum > 0);
+}
+
+} // namespace TestSwissHashMap
+
+#endif // TEST_SWISS_HASH_MAP_H
@@ -0,0 +1,81 @@
+/**************************************************************************/
+/*  test_work_stealing_deque.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_WORK_STEALING_DEQUE_H
+#define TEST_WORK_STEALING_DEQUE_H
+
+#include "core/templates/work_stealing_deque.h"
+
+#include "tests/test_macros.h"
+
+namespace TestWorkStealingDeque {
+
+TEST_CASE("[WorkStealingDeque] Owner pops LIFO, thieves steal FIFO") {
+	WorkStealingDeque<int, 8> deque;
+	int values[4] = { 0, 1, 2, 3 };
+
+	CHECK(deque.is_empty());
+	CHECK(deque.pop() == nullptr);
+	CHECK(deque.steal() == nullptr);
+
+	for (int i = 0; i < 4; i++) {
+		CHECK(deque.push(&values[i]));
+	}
+	CHECK_FALSE(deque.is_empty());
+
+	CHECK(deque.pop() == &values[3]);
+	CHECK(deque.steal() == &values[0]);
+	CHECK(deque.pop() == &values[2]);
+	CHECK(deque.steal() == &values[1]);
+
+	CHECK(deque.is_empty());
+	CHECK(deque.pop() == nullptr);
+	CHECK(deque.steal() == nullptr);
+}
+
+TEST_CASE("[WorkStealingDeque] Push fails when full") {
+	WorkStealingDeque<int, 4> deque;
+	int values[5] = { 0, 1, 2, 3, 4 };
+
+	for (int i = 0; i < 4; i++) {
+		CHECK(deque.push(&values[i]));
+	}
+	CHECK_FALSE(deque.push(&values[4]));
+
+	// Stealing frees a slot at the other end, so the ring wraps around.
+	CHECK(deque.steal() == &values[0]);
+	CHECK(deque.push(&values[4]));
+	CHECK(deque.pop() == &values[4]);
+	CHECK(deque.pop() == &values[3]);
+}
+
+} // namespace TestWorkStealingDeque
+
+#endif // TEST_WORK_STEALING_DEQUE_H
@@ -173,6 +173,160 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+static const int NESTED_SUBTASKS = 64;
+
+static void static_nested_leaf(void *p_arg) {
+	counter[(uint64_t)p_arg].increment();
+}
+
+static void static_nested_spawner(void *p_arg) {
+	// Subtasks posted from a pool thread land in its local queue and are either
+	// popped back while waiting or stolen by other threads.
+	WorkerThreadPool::TaskID sub_ids[NESTED_SUBTASKS];
+	for (int i = 0; i < NESTED_SUBTASKS; i++) {
+		sub_ids[i] = WorkerThreadPool::get_singleton()->add_native_task(static_nested_leaf, p_arg, i % 2);
+	}
+	for (int i = 0; i < NESTED_SUBTASKS; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(sub_ids[i]);
+	}
+}
+
+static void static_nested_group_spawner(void *p_arg) {
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_group_test, p_arg, counter.size());
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+}
+
+TEST_CASE("[WorkerThreadPool] Process tasks posted from pool threads") {
+	for (int iterations = 0; iterations < 50; iterations++) {
+		const int count = Math::pow(2.0f, Math::random(0.0f, 5.0f));
+
+		counter.clear();
+		counter.resize(count);
+
+		LocalVector<WorkerThreadPool::TaskID> spawners;
+		spawners.resize(count);
+		for (int i = 0; i < count; i++) {
+			spawners[i] = WorkerThreadPool::get_singleton()->add_native_task(static_nested_spawner, (void *)(uintptr_t)i, true);
+		}
+		for (int i = 0; i < count; i++) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(spawners[i]);
+		}
+
+		bool all_run = true;
+		for (int i = 0; i < count; i++) {
+			all_run &= counter[i].get() == NESTED_SUBTASKS;
+		}
+		CHECK(all_run);
+	}
+
+	counter.clear();
+	counter.resize(256);
+	WorkerThreadPool::TaskID group_spawner = WorkerThreadPool::get_singleton()->add_native_task(static_nested_group_spawner, nullptr, true);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(group_spawner);
+	bool all_run_once = true;
+	for (uint32_t i = 0; i < counter.size(); i++) {
+		all_run_once &= counter[i].get() == 1;
+	}
+	CHECK(all_run_once);
+}
+
+static const int PIPELINE_ELEMENTS = 64;
+static SafeNumeric<int> pipeline_stage[3];
+static SafeFlag pipeline_out_of_order;
+
+static void static_pipeline_setup(void *p_arg, uint32_t p_index) {
+	pipeline_stage[0].increment();
+}
+
+static void static_pipeline_solve(void *p_arg) {
+	if (pipeline_stage[0].get() != PIPELINE_ELEMENTS) {
+		pipeline_out_of_order.set();
+	}
+	pipeline_stage[1].increment();
+}
+
+static void static_pipeline_integrate(void *p_arg, uint32_t p_index) {
+	if (pipeline_stage[1].get() != (int)(uintptr_t)p_arg) {
+		pipeline_out_of_order.set();
+	}
+	pipeline_stage[2].increment();
+}
+
+TEST_CASE("[WorkerThreadPool] Run a task graph without waiting between stages") {
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int solvers = Math::pow(2.0f, Math::random(0.0f, 4.0f));
+		const bool low_priority = Math::rand() % 2;
+
+		for (int i = 0; i < 3; i++) {
+			pipeline_stage[i].set(0);
+		}
+		pipeline_out_of_order.clear();
+
+		WorkerThreadPool::GroupID setup = WorkerThreadPool::get_singleton()->add_native_group_task(static_pipeline_setup, nullptr, PIPELINE_ELEMENTS, -1, !low_priority);
+
+		Vector<WorkerThreadPool::TaskID> solve_ids;
+		for (int i = 0; i < solvers; i++) {
+			solve_ids.push_back(WorkerThreadPool::get_singleton()->add_native_task_with_dependencies({ setup }, static_pipeline_solve, nullptr, low_priority));
+		}
+
+		WorkerThreadPool::GroupID integrate = WorkerThreadPool::get_singleton()->add_native_group_task_with_dependencies(solve_ids, static_pipeline_integrate, (void *)(uintptr_t)solvers, PIPELINE_ELEMENTS, -1, !low_priority);
+
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(integrate);
+		CHECK(pipeline_stage[2].get() == PIPELINE_ELEMENTS);
+
+		// Everything upstream is already completed, so these don't block.
+		for (int i = 0; i < solvers; i++) {
+			CHECK(WorkerThreadPool::get_singleton()->is_task_completed(solve_ids[i]));
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(solve_ids[i]);
+		}
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(setup);
+
+		CHECK(pipeline_stage[1].get() == solvers);
+		CHECK_FALSE(pipeline_out_of_order.is_set());
+	}
+
+	// Dependencies already completed and awaited are ignored.
+	pipeline_stage[1].set(0);
+	pipeline_stage[0].set(PIPELINE_ELEMENTS);
+	WorkerThreadPool::TaskID first = WorkerThreadPool::get_singleton()->add_native_task(static_pipeline_solve, nullptr, true);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(first);
+	WorkerThreadPool::TaskID second = WorkerThreadPool::get_singleton()->add_native_task_with_dependencies({ first }, static_pipeline_solve, nullptr, true);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(second);
+	CHECK(pipeline_stage[1].get() == 2);
+}
+
+TEST_CASE("[Stress][WorkerThreadPool] Task throughput with an increasing number of spawning threads") {
+	const int num_threads = WorkerThreadPool::get_singleton()->get_thread_count();
+	const int total_subtasks = 20000;
+
+	for (int spawner_count = 1; spawner_count <= MAX(1, num_threads); spawner_count *= 2) {
+		const int rounds = MAX(1, total_subtasks / (spawner_count * NESTED_SUBTASKS));
+
+		counter.clear();
+		counter.resize(spawner_count);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int r = 0; r < rounds; r++) {
+			LocalVector<WorkerThreadPool::TaskID> spawners;
+			spawners.resize(spawner_count);
+			for (int i = 0; i < spawner_count; i++) {
+				spawners[i] = WorkerThreadPool::get_singleton()->add_native_task(static_nested_spawner, (void *)(uintptr_t)i, true);
+			}
+			for (int i = 0; i < spawner_count; i++) {
+				WorkerThreadPool::get_singleton()->wait_for_task_completion(spawners[i]);
+			}
+		}
+		uint64_t elapsed = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+		int processed = 0;
+		for (int i = 0; i < spawner_count; i++) {
+			processed += counter[i].get();
+		}
+		CHECK(processed == rounds * spawner_count * NESTED_SUBTASKS);
+		MESSAGE(spawner_count, " spawner(s): ", (uint64_t)processed * 1000000 / elapsed, " tasks/s.");
+	}
+}
+
 } // namespace TestWorkerThreadPool
 
 #endif // TEST_WORKER_THREAD_POOL_H
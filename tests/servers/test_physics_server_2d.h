@@ -0,0 +1,152 @@
+/**************************************************************************/
+/*  test_physics_server_2d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_2D_H
+#define TEST_PHYSICS_SERVER_2D_H
+
+#include "core/config/project_settings.h"
+#include "servers/physics_server_2d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer2D {
+
+// Boxes and circles thrown at each other above a static floor, stepped in deterministic mode.
+struct DeterministicScene {
+	RID space;
+	RID floor_shape;
+	RID box_shape;
+	RID circle_shape;
+	RID floor;
+	LocalVector<RID> bodies;
+
+	DeterministicScene() {
+		PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+
+		// Read by spaces when they are created.
+		const Variant deterministic = GLOBAL_GET("physics/2d/solver/deterministic");
+		ProjectSettings::get_singleton()->set_setting("physics/2d/solver/deterministic", true);
+		space = ps->space_create();
+		ProjectSettings::get_singleton()->set_setting("physics/2d/solver/deterministic", deterministic);
+		ps->space_set_active(space, true);
+		// The space RID stands for its default area.
+		ps->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY, 980.0);
+		ps->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY_VECTOR, Vector2(0, 1));
+
+		floor_shape = ps->rectangle_shape_create();
+		ps->shape_set_data(floor_shape, Vector2(1000, 20));
+		box_shape = ps->rectangle_shape_create();
+		ps->shape_set_data(box_shape, Vector2(10, 10));
+		circle_shape = ps->circle_shape_create();
+		ps->shape_set_data(circle_shape, 10);
+
+		floor = ps->body_create();
+		ps->body_set_mode(floor, PhysicsServer2D::BODY_MODE_STATIC);
+		ps->body_set_space(floor, space);
+		ps->body_add_shape(floor, floor_shape);
+		ps->body_set_state(floor, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(0, 20)));
+
+		for (int i = 0; i < 30; i++) {
+			RID body = ps->body_create();
+			ps->body_set_space(body, space);
+			ps->body_add_shape(body, i % 2 ? circle_shape : box_shape);
+			ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(i * 0.3, Vector2((i % 6) * 25 - 60, -30 - (i / 6) * 25)));
+			ps->body_set_state(body, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY, Vector2((i % 3 - 1) * 80, 0));
+			ps->body_set_state(body, PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY, (i % 5 - 2) * 1.5);
+			bodies.push_back(body);
+		}
+	}
+
+	~DeterministicScene() {
+		PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+		for (const RID &body : bodies) {
+			ps->free(body);
+		}
+		ps->free(floor);
+		ps->free(circle_shape);
+		ps->free(box_shape);
+		ps->free(floor_shape);
+		ps->free(space);
+	}
+
+	LocalVector<uint64_t> step(int p_steps) const {
+		PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+		LocalVector<uint64_t> hashes;
+		for (int i = 0; i < p_steps; i++) {
+			ps->step(1.0 / 60.0);
+			hashes.push_back(ps->space_get_state_hash(space));
+		}
+		return hashes;
+	}
+};
+
+TEST_CASE("[SceneTree][PhysicsServer2D] Deterministic mode steps the same scene the same way") {
+	LocalVector<uint64_t> first_hashes;
+	LocalVector<uint64_t> second_hashes;
+	{
+		DeterministicScene scene;
+		first_hashes = scene.step(180);
+	}
+	{
+		DeterministicScene scene;
+		second_hashes = scene.step(180);
+	}
+
+	REQUIRE(first_hashes.size() == second_hashes.size());
+	for (uint32_t i = 0; i < first_hashes.size(); i++) {
+		CHECK_MESSAGE(first_hashes[i] == second_hashes[i], "Step ", i, " should give the same state hash.");
+	}
+	CHECK_MESSAGE(first_hashes[0] != first_hashes[first_hashes.size() - 1], "Bodies should have moved between the first and last step.");
+}
+
+TEST_CASE("[SceneTree][PhysicsServer2D] State hash detects diverging simulations") {
+	// Both spaces are active, so each server step moves them together.
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	DeterministicScene scene;
+	DeterministicScene other_scene;
+	for (int i = 0; i < 10; i++) {
+		ps->step(1.0 / 60.0);
+	}
+	REQUIRE(ps->space_get_state_hash(scene.space) == ps->space_get_state_hash(other_scene.space));
+
+	// A tiny nudge is enough to change the hash.
+	Vector2 velocity = ps->body_get_state(other_scene.bodies[0], PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY);
+	ps->body_set_state(other_scene.bodies[0], PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY, velocity + Vector2(0.001, 0));
+	CHECK(ps->space_get_state_hash(scene.space) != ps->space_get_state_hash(other_scene.space));
+
+	for (int i = 0; i < 10; i++) {
+		ps->step(1.0 / 60.0);
+	}
+	CHECK(ps->space_get_state_hash(scene.space) != ps->space_get_state_hash(other_scene.space));
+}
+
+} // namespace TestPhysicsServer2D
+
+#endif // TEST_PHYSICS_SERVER_2D_H
@@ -0,0 +1,365 @@
+/**************************************************************************/
+/*  test_physics_server_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_3D_H
+#define TEST_PHYSICS_SERVER_3D_H
+
+#include "core/config/project_settings.h"
+#include "servers/physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3D {
+
+// A grid of static boxes and spheres, alternating, on the XZ plane.
+struct QueryScene {
+	RID space;
+	RID box;
+	RID sphere;
+	LocalVector<RID> bodies;
+
+	QueryScene(int p_size) {
+		PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+		space = ps->space_create();
+
+		box = ps->box_shape_create();
+		ps->shape_set_data(box, Vector3(0.4, 0.4, 0.4));
+		sphere = ps->sphere_shape_create();
+		ps->shape_set_data(sphere, 0.45);
+
+		for (int x = 0; x < p_size; x++) {
+			for (int z = 0; z < p_size; z++) {
+				RID body = ps->body_create();
+				ps->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+				ps->body_set_space(body, space);
+				ps->body_add_shape(body, (x + z) % 2 ? sphere : box);
+				ps->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(x, (x * z) % 3 * 0.25, z)));
+				bodies.push_back(body);
+			}
+		}
+	}
+
+	~QueryScene() {
+		PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+		for (const RID &body : bodies) {
+			ps->free(body);
+		}
+		ps->free(box);
+		ps->free(sphere);
+		ps->free(space);
+	}
+};
+
+// Slanted rays crossing the grid from above, some of them missing it.
+static void make_rays(int p_count, real_t p_extent, LocalVector<Vector3> &r_from, LocalVector<Vector3> &r_to) {
+	r_from.resize(p_count);
+	r_to.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		r_from[i] = Vector3(Math::fmod(i * 0.37, (double)p_extent + 2) - 1, 3, Math::fmod(i * 0.71, (double)p_extent + 2) - 1);
+		r_to[i] = r_from[i] + Vector3(0.5 - (i % 5) * 0.25, -6, (i % 3) * 0.25 - 0.25);
+	}
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Batched ray queries match single ones") {
+	QueryScene scene(8);
+	PhysicsDirectSpaceState3D *state = PhysicsServer3D::get_singleton()->space_get_direct_state(scene.space);
+	REQUIRE(state);
+
+	// More than a packet of rays, so that they are sorted and split between threads.
+	LocalVector<Vector3> from;
+	LocalVector<Vector3> to;
+	make_rays(300, 8, from, to);
+
+	PhysicsDirectSpaceState3D::RayParameters parameters;
+	LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+	results.resize(from.size());
+	int hits = state->intersect_rays(parameters, from.ptr(), to.ptr(), from.size(), results.ptr());
+
+	int expected_hits = 0;
+	for (uint32_t i = 0; i < from.size(); i++) {
+		parameters.from = from[i];
+		parameters.to = to[i];
+		PhysicsDirectSpaceState3D::RayResult expected;
+		bool hit = state->intersect_ray(parameters, expected);
+		CHECK_MESSAGE(results[i].rid.is_valid() == hit, "Ray ", i, " should hit the same as a single query.");
+		if (hit) {
+			expected_hits++;
+			CHECK(results[i].rid == expected.rid);
+			CHECK(results[i].shape == expected.shape);
+			CHECK(results[i].position.is_equal_approx(expected.position));
+			CHECK(results[i].normal.is_equal_approx(expected.normal));
+		}
+	}
+	CHECK(hits == expected_hits);
+	CHECK_MESSAGE(hits > 0, "Some rays should hit the grid.");
+	CHECK_MESSAGE(hits < (int)from.size(), "Some rays should miss the grid.");
+
+	// Excluded bodies are skipped like in single queries.
+	parameters.exclude.insert(scene.bodies[0]);
+	Vector3 down_from = Vector3(0, 3, 0);
+	Vector3 down_to = Vector3(0, -3, 0);
+	PhysicsDirectSpaceState3D::RayResult excluded;
+	CHECK(state->intersect_rays(parameters, &down_from, &down_to, 1, &excluded) == 0);
+	CHECK_FALSE(excluded.rid.is_valid());
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Batched shape queries match single ones") {
+	QueryScene scene(8);
+	PhysicsDirectSpaceState3D *state = PhysicsServer3D::get_singleton()->space_get_direct_state(scene.space);
+	REQUIRE(state);
+
+	RID query_shape = PhysicsServer3D::get_singleton()->sphere_shape_create();
+	PhysicsServer3D::get_singleton()->shape_set_data(query_shape, 0.6);
+
+	LocalVector<Vector3> origins;
+	for (int i = 0; i < 100; i++) {
+		origins.push_back(Vector3(Math::fmod(i * 0.53, 9.0) - 0.5, 0.2, Math::fmod(i * 0.29, 9.0) - 0.5));
+	}
+
+	const int result_max = 4;
+	PhysicsDirectSpaceState3D::ShapeParameters parameters;
+	parameters.shape_rid = query_shape;
+	LocalVector<PhysicsDirectSpaceState3D::ShapeResult> results;
+	results.resize(origins.size() * result_max);
+	LocalVector<int> result_counts;
+	result_counts.resize(origins.size());
+	state->intersect_shapes(parameters, origins.ptr(), origins.size(), results.ptr(), result_max, result_counts.ptr());
+
+	for (uint32_t i = 0; i < origins.size(); i++) {
+		parameters.transform.origin = origins[i];
+		PhysicsDirectSpaceState3D::ShapeResult expected[result_max];
+		int expected_count = state->intersect_shape(parameters, expected, result_max);
+		REQUIRE_MESSAGE(result_counts[i] == expected_count, "Query ", i, " should find as many shapes as a single query.");
+		for (int j = 0; j < expected_count; j++) {
+			bool found = false;
+			for (int k = 0; k < expected_count; k++) {
+				found = found || results[i * result_max + k].rid == expected[j].rid;
+			}
+			CHECK(found);
+		}
+	}
+
+	PhysicsServer3D::get_singleton()->free(query_shape);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Script bindings of batched queries") {
+	QueryScene scene(4);
+	PhysicsDirectSpaceState3D *state = PhysicsServer3D::get_singleton()->space_get_direct_state(scene.space);
+	REQUIRE(state);
+
+	Ref<PhysicsRayQueryParameters3D> ray_query;
+	ray_query.instantiate();
+	Dictionary rays = state->call("intersect_rays", PackedVector3Array({ Vector3(0, 3, 0), Vector3(-5, 3, -5) }), PackedVector3Array({ Vector3(0, -3, 0), Vector3(-5, -3, -5) }), ray_query);
+	PackedInt32Array shapes = rays["shape"];
+	PackedVector3Array positions = rays["position"];
+	REQUIRE(shapes.size() == 2);
+	CHECK(shapes[0] == 0);
+	CHECK(positions[0].is_equal_approx(Vector3(0, 0.4, 0)));
+	CHECK_MESSAGE(shapes[1] == -1, "Missing rays should have no shape.");
+
+	Ref<PhysicsShapeQueryParameters3D> shape_query;
+	shape_query.instantiate();
+	shape_query->set_shape_rid(scene.box);
+	Dictionary shape_hits = state->call("intersect_shapes", PackedVector3Array({ Vector3(10, 0, 10), Vector3(0, 0, 0) }), shape_query);
+	PackedInt32Array queries = shape_hits["query"];
+	REQUIRE(queries.size() == 1);
+	CHECK(queries[0] == 1);
+}
+
+TEST_CASE("[Stress][SceneTree][PhysicsServer3D] Batched against single ray queries") {
+	QueryScene scene(32);
+	PhysicsDirectSpaceState3D *state = PhysicsServer3D::get_singleton()->space_get_direct_state(scene.space);
+	REQUIRE(state);
+
+	LocalVector<Vector3> from;
+	LocalVector<Vector3> to;
+	make_rays(50000, 32, from, to);
+
+	PhysicsDirectSpaceState3D::RayParameters parameters;
+	LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+	results.resize(from.size());
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	int single_hits = 0;
+	for (uint32_t i = 0; i < from.size(); i++) {
+		parameters.from = from[i];
+		parameters.to = to[i];
+		if (state->intersect_ray(parameters, results[i])) {
+			single_hits++;
+		}
+	}
+	uint64_t single_elapsed = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	int batched_hits = state->intersect_rays(parameters, from.ptr(), to.ptr(), from.size(), results.ptr());
+	uint64_t batched_elapsed = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+	MESSAGE(from.size(), " rays: ", single_elapsed, " usec one by one, ", batched_elapsed, " usec batched on ", WorkerThreadPool::get_singleton()->get_thread_count(), " threads.");
+	CHECK(batched_hits == single_hits);
+}
+
+// Columns of boxes resting on a static floor, each column being its own island.
+struct BoxColumnsScene {
+	RID space;
+	RID floor_shape;
+	RID box_shape;
+	RID floor;
+	LocalVector<RID> boxes;
+
+	BoxColumnsScene(bool p_batch_contacts, int p_columns, int p_height) {
+		PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+
+		// Read by spaces when they are created.
+		const Variant batch_contacts = GLOBAL_GET("physics/3d/solver/batch_contacts");
+		ProjectSettings::get_singleton()->set_setting("physics/3d/solver/batch_contacts", p_batch_contacts);
+		space = ps->space_create();
+		ProjectSettings::get_singleton()->set_setting("physics/3d/solver/batch_contacts", batch_contacts);
+		ps->space_set_active(space, true);
+
+		floor_shape = ps->box_shape_create();
+		ps->shape_set_data(floor_shape, Vector3(p_columns * 2, 0.5, p_columns * 2));
+		box_shape = ps->box_shape_create();
+		ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+		floor = ps->body_create();
+		ps->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+		ps->body_set_space(floor, space);
+		ps->body_add_shape(floor, floor_shape);
+		ps->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -0.5, 0)));
+
+		for (int column = 0; column < p_columns; column++) {
+			for (int level = 0; level < p_height; level++) {
+				RID box = ps->body_create();
+				ps->body_set_space(box, space);
+				ps->body_add_shape(box, box_shape);
+				ps->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), get_start(column, level)));
+				boxes.push_back(box);
+			}
+		}
+	}
+
+	~BoxColumnsScene() {
+		PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+		for (const RID &box : boxes) {
+			ps->free(box);
+		}
+		ps->free(floor);
+		ps->free(box_shape);
+		ps->free(floor_shape);
+		ps->free(space);
+	}
+
+	static Vector3 get_start(int p_column, int p_level) {
+		return Vector3(p_column * 2, p_level + 0.5, (p_column % 3) * 2);
+	}
+
+	bool is_sleeping(uint32_t p_box) const {
+		return PhysicsServer3D::get_singleton()->body_get_state(boxes[p_box], PhysicsServer3D::BODY_STATE_SLEEPING);
+	}
+
+	void step(int p_steps) const {
+		for (int i = 0; i < p_steps; i++) {
+			PhysicsServer3D::get_singleton()->step(1.0 / 60.0);
+		}
+	}
+};
+
+// Simulates columns of resting boxes and returns where the boxes end up.
+static LocalVector<Vector3> simulate_box_columns(bool p_batch_contacts, int p_columns, int p_height, int p_steps, uint64_t *r_elapsed_usec = nullptr) {
+	BoxColumnsScene scene(p_batch_contacts, p_columns, p_height);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	scene.step(p_steps);
+	if (r_elapsed_usec) {
+		*r_elapsed_usec = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+	}
+
+	LocalVector<Vector3> positions;
+	for (const RID &box : scene.boxes) {
+		Transform3D transform = PhysicsServer3D::get_singleton()->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		positions.push_back(transform.origin);
+	}
+	return positions;
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Batched contact solver keeps boxes stacked") {
+	// Each column is an island with enough contacts to be batched.
+	const int columns = 3;
+	const int height = 6;
+	LocalVector<Vector3> batched = simulate_box_columns(true, columns, height, 120);
+	LocalVector<Vector3> single = simulate_box_columns(false, columns, height, 120);
+	REQUIRE(batched.size() == single.size());
+
+	for (int column = 0; column < columns; column++) {
+		for (int level = 0; level < height; level++) {
+			const uint32_t index = column * height + level;
+			const Vector3 start = BoxColumnsScene::get_start(column, level);
+			CHECK_MESSAGE(batched[index].distance_to(start) < 0.1, "Box ", index, " should stay in its column.");
+			CHECK_MESSAGE(batched[index].distance_to(single[index]) < 0.1, "Box ", index, " should rest where the contacts solved one by one leave it.");
+		}
+	}
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Sleeping islands wake up as a unit") {
+	BoxColumnsScene scene(false, 2, 3);
+	scene.step(240);
+	for (uint32_t i = 0; i < scene.boxes.size(); i++) {
+		REQUIRE_MESSAGE(scene.is_sleeping(i), "Box ", i, " should be sleeping after resting for a while.");
+	}
+
+	// Waking the bottom box of the first column wakes its whole column right away, not the other one.
+	PhysicsServer3D::get_singleton()->body_set_state(scene.boxes[0], PhysicsServer3D::BODY_STATE_SLEEPING, false);
+	for (uint32_t i = 0; i < 3; i++) {
+		CHECK_FALSE_MESSAGE(scene.is_sleeping(i), "Box ", i, " should be woken with its island.");
+	}
+	for (uint32_t i = 3; i < 6; i++) {
+		CHECK_MESSAGE(scene.is_sleeping(i), "Box ", i, " is on another island and should keep sleeping.");
+	}
+
+	// The column is still resting, so it goes back to sleep as a whole.
+	scene.step(240);
+	for (uint32_t i = 0; i < scene.boxes.size(); i++) {
+		CHECK_MESSAGE(scene.is_sleeping(i), "Box ", i, " should be sleeping again.");
+	}
+}
+
+TEST_CASE("[Stress][SceneTree][PhysicsServer3D] Batched against single contact solving") {
+	uint64_t single_elapsed = 0;
+	uint64_t batched_elapsed = 0;
+	LocalVector<Vector3> single = simulate_box_columns(false, 100, 10, 300, &single_elapsed);
+	LocalVector<Vector3> batched = simulate_box_columns(true, 100, 10, 300, &batched_elapsed);
+
+	MESSAGE(single.size(), " boxes for 300 steps: ", single_elapsed, " usec one contact at a time, ", batched_elapsed, " usec batched.");
+	CHECK(batched.size() == single.size());
+}
+
+} // namespace TestPhysicsServer3D
+
+#endif // TEST_PHYSICS_SERVER_3D_H
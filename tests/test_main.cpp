@@ -38,6 +38,7 @@
 #endif // TOOLS_ENABLED
 
 #include "tests/core/config/test_project_settings.h"
+#include "tests/core/debugger/test_memory_profiler.h"
 #include "tests/core/input/test_input_event.h"
 #include "tests/core/input/test_input_event_key.h"
 #include "tests/core/input/test_input_event_mouse.h"
@@ -59,6 +60,8 @@
 #include "tests/core/math/test_aabb.h"
 #include "tests/core/math/test_astar.h"
 #include "tests/core/math/test_basis.h"
+#include "tests/core/math/test_bulk_math.h"
+#include "tests/core/math/test_bvh.h"
 #include "tests/core/math/test_color.h"
 #include "tests/core/math/test_expression.h"
 #include "tests/core/math/test_geometry_2d.h"
@@ -84,6 +87,7 @@
 #include "tests/core/os/test_os.h"
 #include "tests/core/string/test_node_path.h"
 #include "tests/core/string/test_string.h"
+#include "tests/core/string/test_string_name.h"
 #include "tests/core/string/test_translation.h"
 #include "tests/core/string/test_translation_server.h"
 #include "tests/core/templates/test_command_queue.h"
@@ -95,7 +99,10 @@
 #include "tests/core/templates/test_oa_hash_map.h"
 #include "tests/core/templates/test_paged_array.h"
 #include "tests/core/templates/test_rid.h"
+#include "tests/core/templates/test_small_vector.h"
+#include "tests/core/templates/test_swiss_hash_map.h"
 #include "tests/core/templates/test_vector.h"
+#include "tests/core/templates/test_work_stealing_deque.h"
 #include "tests/core/test_crypto.h"
 #include "tests/core/test_hashing_context.h"
 #include "tests/core/test_time.h"
@@ -137,6 +144,10 @@
 #include "tests/servers/test_text_server.h"
 #include "tests/test_validate_testing.h"
 
+#ifdef MODULE_GODOT_PHYSICS_2D_ENABLED
+#include "tests/servers/test_physics_server_2d.h"
+#endif // MODULE_GODOT_PHYSICS_2D_ENABLED
+
 #ifndef ADVANCED_GUI_DISABLED
 #include "tests/scene/test_code_edit.h"
 #include "tests/scene/test_color_picker.h"
@@ -168,6 +179,10 @@
 #include "tests/scene/test_primitives.h"
 #include "tests/scene/test_skeleton_3d.h"
 #include "tests/scene/test_sky.h"
+
+#ifdef MODULE_GODOT_PHYSICS_3D_ENABLED
+#include "tests/servers/test_physics_server_3d.h"
+#endif // MODULE_GODOT_PHYSICS_3D_ENABLED
 #endif // _3D_DISABLED
 
 #include "modules/modules_tests.gen.h"